@@ -0,0 +1,189 @@
+#include "buffer_pool.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace AgpuCommon
+{
+
+static agpu_device_size alignedTo(agpu_device_size value, agpu_device_size alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+BufferPool::BufferPool(const agpu::device_ref &device, const agpu_buffer_description &blockDescription, agpu_device_size alignment)
+    : device(device), blockDescription(blockDescription), alignment(alignment)
+{
+}
+
+BufferPool::~BufferPool()
+{
+}
+
+agpu::buffer_pool_ref BufferPool::create(const agpu::device_ref &device, agpu_buffer_description *blockDescription, agpu_device_size alignment)
+{
+    if(!blockDescription || blockDescription->size == 0)
+        return agpu::buffer_pool_ref();
+
+    auto actualAlignment = computeAlignmentFor(device, *blockDescription, alignment);
+
+    // Keep the blocks made of whole ranges.
+    auto description = *blockDescription;
+    description.size = alignedTo(description.size, actualAlignment);
+    return agpu::makeObject<BufferPool> (device, description, actualAlignment);
+}
+
+agpu_device_size BufferPool::computeAlignmentFor(const agpu::device_ref &device, const agpu_buffer_description &blockDescription, agpu_device_size requestedAlignment)
+{
+    agpu_device_size result = std::max(requestedAlignment, agpu_device_size(4));
+    auto usageModes = blockDescription.usage_modes;
+    if(usageModes & AGPU_UNIFORM_BUFFER)
+        result = std::max(result, agpu_device_size(device->getLimitValue(AGPU_LIMIT_MIN_UNIFORM_BUFFER_OFFSET_ALIGNMENT)));
+    if(usageModes & AGPU_STORAGE_BUFFER)
+        result = std::max(result, agpu_device_size(device->getLimitValue(AGPU_LIMIT_MIN_STORAGE_BUFFER_OFFSET_ALIGNMENT)));
+    if(usageModes & (AGPU_UNIFORM_TEXEL_BUFFER | AGPU_STORAGE_TEXEL_BUFFER))
+        result = std::max(result, agpu_device_size(device->getLimitValue(AGPU_LIMIT_MIN_TEXEL_BUFFER_OFFSET_ALIGNMENT)));
+    if(usageModes & AGPU_ELEMENT_ARRAY_BUFFER)
+        result = std::max(result, agpu_device_size(blockDescription.stride));
+
+    // The ranges of a mapped buffer that is not coherent are flushed separately.
+    if(blockDescription.mapping_flags && (blockDescription.mapping_flags & AGPU_MAP_COHERENT_BIT) == 0)
+        result = std::max(result, agpu_device_size(device->getLimitValue(AGPU_LIMIT_NON_COHERENT_ATOM_SIZE)));
+
+    return result;
+}
+
+agpu::buffer_ptr BufferPool::allocateRange(agpu_device_size size, agpu_device_size *offset)
+{
+    if(!offset || size == 0)
+        return nullptr;
+
+    auto alignedSize = alignedTo(size, alignment);
+    std::unique_lock<std::mutex> l(mutex);
+
+    // The ranges that do not fit in a block get their own buffer.
+    if(alignedSize > blockDescription.size)
+    {
+        auto block = createBlock(alignedSize, true);
+        if(!block)
+            return nullptr;
+
+        allocateInBlock(block, alignedSize, offset);
+        return block->buffer.disownedNewRef();
+    }
+
+    for(auto &block : blocks)
+    {
+        if(!block->isDedicated && allocateInBlock(block.get(), alignedSize, offset))
+            return block->buffer.disownedNewRef();
+    }
+
+    auto block = createBlock(blockDescription.size, false);
+    if(!block)
+        return nullptr;
+
+    allocateInBlock(block, alignedSize, offset);
+    return block->buffer.disownedNewRef();
+}
+
+agpu_error BufferPool::freeRange(const agpu::buffer_ref &buffer, agpu_device_size offset)
+{
+    if(!buffer)
+        return AGPU_NULL_POINTER;
+
+    std::unique_lock<std::mutex> l(mutex);
+    auto blockIt = blockByBuffer.find(buffer);
+    if(blockIt == blockByBuffer.end())
+        return AGPU_INVALID_PARAMETER;
+
+    auto block = blockIt->second;
+    auto rangeIt = block->allocatedRanges.find(offset);
+    if(rangeIt == block->allocatedRanges.end())
+        return AGPU_INVALID_PARAMETER;
+
+    auto size = rangeIt->second;
+    block->allocatedRanges.erase(rangeIt);
+
+    if(block->isDedicated)
+    {
+        blockByBuffer.erase(blockIt);
+        blocks.erase(std::find_if(blocks.begin(), blocks.end(), [&](const std::unique_ptr<BufferPoolBlock> &b) {
+            return b.get() == block;
+        }));
+        return AGPU_OK;
+    }
+
+    // Coalesce with the following free range.
+    auto &freeRanges = block->freeRanges;
+    auto next = freeRanges.lower_bound(offset);
+    if(next != freeRanges.end() && offset + size == next->first)
+    {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    // Coalesce with the previous free range.
+    if(next != freeRanges.begin())
+    {
+        auto previous = std::prev(next);
+        if(previous->first + previous->second == offset)
+        {
+            previous->second += size;
+            return AGPU_OK;
+        }
+    }
+
+    freeRanges.insert(next, std::make_pair(offset, size));
+    return AGPU_OK;
+}
+
+agpu_device_size BufferPool::getAlignment()
+{
+    return alignment;
+}
+
+BufferPoolBlock *BufferPool::createBlock(agpu_device_size size, bool isDedicated)
+{
+    auto description = blockDescription;
+    description.size = size;
+
+    auto buffer = agpu::buffer_ref(device->createBuffer(&description, nullptr));
+    if(!buffer)
+        return nullptr;
+
+    std::unique_ptr<BufferPoolBlock> block(new BufferPoolBlock());
+    block->buffer = buffer;
+    block->size = size;
+    block->isDedicated = isDedicated;
+    block->freeRanges.insert(std::make_pair(agpu_device_size(0), size));
+
+    auto result = block.get();
+    blockByBuffer.insert(std::make_pair(buffer, result));
+    blocks.push_back(std::move(block));
+    return result;
+}
+
+bool BufferPool::allocateInBlock(BufferPoolBlock *block, agpu_device_size size, agpu_device_size *offset)
+{
+    // Every range is a multiple of the alignment, so the free ranges are
+    // always aligned.
+    auto &freeRanges = block->freeRanges;
+    for(auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        if(it->second < size)
+            continue;
+
+        auto rangeOffset = it->first;
+        auto remainingSize = it->second - size;
+        freeRanges.erase(it);
+        if(remainingSize > 0)
+            freeRanges.insert(std::make_pair(rangeOffset + size, remainingSize));
+
+        block->allocatedRanges.insert(std::make_pair(rangeOffset, size));
+        *offset = rangeOffset;
+        return true;
+    }
+
+    return false;
+}
+
+} // End of namespace AgpuCommon
@@ -0,0 +1,65 @@
+#ifndef AGPU_COMMON_BUFFER_POOL_HPP
+#define AGPU_COMMON_BUFFER_POOL_HPP
+
+#include <AGPU/agpu_impl.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace AgpuCommon
+{
+
+/**
+ * I am one of the buffers of a buffer pool, together with the bookkeeping of
+ * its free and allocated ranges. A dedicated block holds a single allocation
+ * that is larger than the block size of the pool.
+ */
+struct BufferPoolBlock
+{
+    agpu::buffer_ref buffer;
+    agpu_device_size size;
+    bool isDedicated;
+
+    // Free ranges sorted by offset, so that neighbours can be coalesced.
+    std::map<agpu_device_size, agpu_device_size> freeRanges;
+    std::unordered_map<agpu_device_size, agpu_device_size> allocatedRanges;
+};
+
+/**
+ * I sub-allocate aligned ranges of a few large buffers that share the same
+ * description. The ranges are handed out with a first fit policy over the
+ * free ranges of each block, which are coalesced when the ranges are freed.
+ * The users of a range bind the shared buffer with its offset.
+ */
+class BufferPool : public agpu::buffer_pool
+{
+public:
+    BufferPool(const agpu::device_ref &device, const agpu_buffer_description &blockDescription, agpu_device_size alignment);
+    ~BufferPool();
+
+    static agpu::buffer_pool_ref create(const agpu::device_ref &device, agpu_buffer_description *blockDescription, agpu_device_size alignment);
+
+    virtual agpu::buffer_ptr allocateRange(agpu_device_size size, agpu_device_size *offset) override;
+    virtual agpu_error freeRange(const agpu::buffer_ref &buffer, agpu_device_size offset) override;
+    virtual agpu_device_size getAlignment() override;
+
+private:
+    static agpu_device_size computeAlignmentFor(const agpu::device_ref &device, const agpu_buffer_description &blockDescription, agpu_device_size requestedAlignment);
+
+    BufferPoolBlock *createBlock(agpu_device_size size, bool isDedicated);
+    bool allocateInBlock(BufferPoolBlock *block, agpu_device_size size, agpu_device_size *offset);
+
+    agpu::device_ref device;
+    agpu_buffer_description blockDescription;
+    agpu_device_size alignment;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<BufferPoolBlock>> blocks;
+    std::unordered_map<agpu::buffer_ref, BufferPoolBlock*> blockByBuffer;
+};
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_BUFFER_POOL_HPP
@@ -0,0 +1,229 @@
+#include "compute_mipmap_generator.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace AgpuCommon
+{
+
+static const uint32_t LocalSizeX = 8;
+static const uint32_t LocalSizeY = 8;
+
+static const char computeMipmapShaderSource[] = R"mipmapShader(
+layout(local_size_x = 8, local_size_y = 8) in;
+
+#ifdef IMAGE_ARRAY
+#define IMAGE_TYPE image2DArray
+#define IMAGE_EXTENT(image) imageSize(image)
+#define IMAGE_COORD(coord) (coord)
+#else
+#define IMAGE_TYPE image2D
+#define IMAGE_EXTENT(image) ivec3(imageSize(image), 1)
+#define IMAGE_COORD(coord) (coord).xy
+#endif
+
+layout(set = 0, binding = 0, IMAGE_FORMAT) uniform readonly IMAGE_TYPE sourceLevel;
+layout(set = 0, binding = 1, IMAGE_FORMAT) uniform writeonly IMAGE_TYPE destLevel;
+
+void main()
+{
+    ivec3 sourceExtent = IMAGE_EXTENT(sourceLevel);
+    ivec3 destExtent = IMAGE_EXTENT(destLevel);
+    ivec3 destCoord = ivec3(gl_GlobalInvocationID);
+    if(any(greaterThanEqual(destCoord, destExtent)))
+        return;
+
+    // Odd extents are handled by clamping the box to the source level.
+    ivec3 sourceCoord = ivec3(destCoord.xy*2, destCoord.z);
+    ivec3 maxSourceCoord = sourceExtent - 1;
+    vec4 sum = imageLoad(sourceLevel, IMAGE_COORD(sourceCoord))
+        + imageLoad(sourceLevel, IMAGE_COORD(min(sourceCoord + ivec3(1, 0, 0), maxSourceCoord)))
+        + imageLoad(sourceLevel, IMAGE_COORD(min(sourceCoord + ivec3(0, 1, 0), maxSourceCoord)))
+        + imageLoad(sourceLevel, IMAGE_COORD(min(sourceCoord + ivec3(1, 1, 0), maxSourceCoord)));
+    imageStore(destLevel, IMAGE_COORD(destCoord), sum*0.25);
+}
+)mipmapShader";
+
+static const char *imageFormatQualifierFor(agpu_texture_format format)
+{
+    switch(format)
+    {
+    case AGPU_TEXTURE_FORMAT_R32G32B32A32_FLOAT: return "rgba32f";
+    case AGPU_TEXTURE_FORMAT_R16G16B16A16_FLOAT: return "rgba16f";
+    case AGPU_TEXTURE_FORMAT_R16G16B16A16_UNORM: return "rgba16";
+    case AGPU_TEXTURE_FORMAT_R32G32_FLOAT: return "rg32f";
+    case AGPU_TEXTURE_FORMAT_R10G10B10A2_UNORM: return "rgb10_a2";
+    case AGPU_TEXTURE_FORMAT_R11G11B10_FLOAT: return "r11f_g11f_b10f";
+    case AGPU_TEXTURE_FORMAT_R8G8B8A8_UNORM: return "rgba8";
+    case AGPU_TEXTURE_FORMAT_R16G16_FLOAT: return "rg16f";
+    case AGPU_TEXTURE_FORMAT_R16G16_UNORM: return "rg16";
+    case AGPU_TEXTURE_FORMAT_R32_FLOAT: return "r32f";
+    case AGPU_TEXTURE_FORMAT_R8G8_UNORM: return "rg8";
+    case AGPU_TEXTURE_FORMAT_R16_FLOAT: return "r16f";
+    case AGPU_TEXTURE_FORMAT_R16_UNORM: return "r16";
+    case AGPU_TEXTURE_FORMAT_R8_UNORM: return "r8";
+    default: return nullptr;
+    }
+}
+
+ComputeMipmapGenerator::ComputeMipmapGenerator(const agpu::device_ref &device)
+    : device(device)
+{
+}
+
+ComputeMipmapGenerator::~ComputeMipmapGenerator()
+{
+}
+
+bool ComputeMipmapGenerator::isTextureSupported(const agpu_texture_description &description)
+{
+    // imageFormatQualifierFor() has no sRGB formats, because they cannot be
+    // used as storage images. The backends filter them with blits instead.
+    return (description.type == AGPU_TEXTURE_2D || description.type == AGPU_TEXTURE_CUBE) &&
+        (description.usage_modes & AGPU_TEXTURE_USAGE_STORAGE) != 0 &&
+        description.sample_count <= 1 &&
+        imageFormatQualifierFor(description.format) != nullptr;
+}
+
+agpu_error ComputeMipmapGenerator::generate(const agpu::command_list_ref &commandList, const agpu::texture_ref &texture, ComputeMipmapGenerationResources &resources)
+{
+    agpu_texture_description description;
+    auto error = texture->getDescription(&description);
+    if(error)
+        return error;
+    if(!isTextureSupported(description))
+        return AGPU_UNSUPPORTED;
+    if(description.miplevels <= 1)
+        return AGPU_OK;
+
+    if(!shaderSignature && !createShaderSignature())
+        return AGPU_ERROR;
+
+    auto isArray = description.layers > 1;
+    auto pipeline = getOrCreatePipelineFor(description.format, isArray);
+    if(!pipeline)
+        return AGPU_ERROR;
+
+    // Create a storage view for each level.
+    agpu_texture_view_description viewDescription;
+    error = texture->getFullViewDescription(&viewDescription);
+    if(error)
+        return error;
+
+    viewDescription.type = AGPU_TEXTURE_2D;
+    viewDescription.usage_mode = AGPU_TEXTURE_USAGE_STORAGE;
+    viewDescription.subresource_range.level_count = 1;
+
+    auto firstViewIndex = resources.views.size();
+    for(agpu_uint level = 0; level < description.miplevels; ++level)
+    {
+        viewDescription.subresource_range.base_miplevel = level;
+        auto view = agpu::texture_view_ref(texture->createView(&viewDescription));
+        if(!view)
+            return AGPU_ERROR;
+        resources.views.push_back(view);
+    }
+
+    // Create the bindings for each level transition.
+    auto firstBindingIndex = resources.bindings.size();
+    for(agpu_uint level = 1; level < description.miplevels; ++level)
+    {
+        auto binding = agpu::shader_resource_binding_ref(shaderSignature->createShaderResourceBinding(0));
+        if(!binding)
+            return AGPU_ERROR;
+
+        binding->bindStorageImageView(0, resources.views[firstViewIndex + level - 1]);
+        binding->bindStorageImageView(1, resources.views[firstViewIndex + level]);
+        resources.bindings.push_back(binding);
+    }
+
+    // Record the generation.
+    agpu_texture_subresource_range wholeRange = viewDescription.subresource_range;
+    wholeRange.base_miplevel = 0;
+    wholeRange.level_count = description.miplevels;
+
+    error = commandList->pushTextureTransitionBarrier(texture, description.main_usage_mode, AGPU_TEXTURE_USAGE_STORAGE, &wholeRange);
+    if(error)
+        return error;
+
+    commandList->setShaderSignature(shaderSignature);
+    commandList->usePipelineState(pipeline);
+    for(agpu_uint level = 1; level < description.miplevels; ++level)
+    {
+        auto width = std::max(description.width >> level, 1u);
+        auto height = std::max(description.height >> level, 1u);
+
+        commandList->useComputeShaderResources(resources.bindings[firstBindingIndex + level - 1]);
+        commandList->dispatchCompute((width + LocalSizeX - 1) / LocalSizeX, (height + LocalSizeY - 1) / LocalSizeY, description.layers);
+
+        // The next level reads the texels that have just been written.
+        commandList->memoryBarrier(AGPU_PIPELINE_STAGE_COMPUTE_SHADER, AGPU_PIPELINE_STAGE_COMPUTE_SHADER,
+            AGPU_ACCESS_SHADER_WRITE, AGPU_ACCESS_SHADER_READ);
+    }
+
+    return commandList->popTextureTransitionBarrier();
+}
+
+bool ComputeMipmapGenerator::createShaderSignature()
+{
+    auto builder = agpu::shader_signature_builder_ref(device->createShaderSignatureBuilder());
+    if(!builder)
+        return false;
+
+    builder->beginBindingBank(1000);
+    builder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_STORAGE_IMAGE, 1); // Source level
+    builder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_STORAGE_IMAGE, 1); // Destination level
+
+    shaderSignature = agpu::shader_signature_ref(builder->build());
+    return (bool)shaderSignature;
+}
+
+agpu::pipeline_state_ref ComputeMipmapGenerator::getOrCreatePipelineFor(agpu_texture_format format, bool isArray)
+{
+    auto key = (uint32_t(format) << 1) | uint32_t(isArray);
+    auto it = pipelines.find(key);
+    if(it != pipelines.end())
+        return it->second;
+
+    std::string sourceCode = "#version 450\n";
+    sourceCode += "#define IMAGE_FORMAT ";
+    sourceCode += imageFormatQualifierFor(format);
+    sourceCode += "\n";
+    if(isArray)
+        sourceCode += "#define IMAGE_ARRAY\n";
+    sourceCode += computeMipmapShaderSource;
+
+    agpu::pipeline_state_ref pipeline;
+    auto compiler = agpu::offline_shader_compiler_ref(device->createOfflineShaderCompiler());
+    if(compiler)
+    {
+        compiler->setShaderSource(AGPU_SHADER_LANGUAGE_VGLSL, AGPU_COMPUTE_SHADER, sourceCode.c_str(), sourceCode.size());
+        auto error = compiler->compileShader(AGPU_SHADER_LANGUAGE_DEVICE_SHADER, "");
+        if(error)
+        {
+            auto logLength = compiler->getCompilationLogLength();
+            std::unique_ptr<char[]> log(new char[logLength + 1]);
+            compiler->getCompilationLog(logLength, log.get());
+            log[logLength] = 0;
+            printError("Failed to compile the mipmap generation shader:\n%s\n", log.get());
+        }
+        else
+        {
+            auto shader = agpu::shader_ref(compiler->getResultAsShader());
+            auto builder = agpu::compute_pipeline_builder_ref(device->createComputePipelineBuilder());
+            if(shader && builder)
+            {
+                builder->setShaderSignature(shaderSignature);
+                builder->attachShader(shader);
+                pipeline = agpu::pipeline_state_ref(builder->build());
+            }
+        }
+    }
+
+    // Failed variants are kept, since they would fail again.
+    pipelines.insert(std::make_pair(key, pipeline));
+    return pipeline;
+}
+
+} // End of namespace AgpuCommon
@@ -0,0 +1,60 @@
+#ifndef AGPU_COMPUTE_MIPMAP_GENERATOR_HPP
+#define AGPU_COMPUTE_MIPMAP_GENERATOR_HPP
+
+#include <AGPU/agpu_impl.hpp>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace AgpuCommon
+{
+
+/**
+ * I hold the views and the shader resource bindings that are used by a
+ * recorded mipmap generation. They must be kept alive until the command list
+ * that uses them has finished executing.
+ */
+struct ComputeMipmapGenerationResources
+{
+    void clear()
+    {
+        bindings.clear();
+        views.clear();
+    }
+
+    std::vector<agpu::texture_view_ref> views;
+    std::vector<agpu::shader_resource_binding_ref> bindings;
+};
+
+/**
+ * I generate the mipmaps of a texture with a box filter in a compute shader.
+ * I am the fallback for the formats that cannot be downsampled with a linear
+ * filter by the fixed function hardware. Each level is produced from the
+ * previous one, for all of the layers of the texture in a single dispatch.
+ *
+ * I only use the public interface of the command list, so the compute
+ * pipeline and the compute shader resources of the command list are not
+ * preserved.
+ */
+class ComputeMipmapGenerator
+{
+public:
+    ComputeMipmapGenerator(const agpu::device_ref &device);
+    ~ComputeMipmapGenerator();
+
+    static bool isTextureSupported(const agpu_texture_description &description);
+
+    agpu_error generate(const agpu::command_list_ref &commandList, const agpu::texture_ref &texture, ComputeMipmapGenerationResources &resources);
+
+private:
+    bool createShaderSignature();
+    agpu::pipeline_state_ref getOrCreatePipelineFor(agpu_texture_format format, bool isArray);
+
+    agpu::device_ref device;
+    agpu::shader_signature_ref shaderSignature;
+    std::unordered_map<uint32_t, agpu::pipeline_state_ref> pipelines;
+};
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMPUTE_MIPMAP_GENERATOR_HPP
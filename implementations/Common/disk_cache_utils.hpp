@@ -0,0 +1,112 @@
+#ifndef AGPU_COMMON_DISK_CACHE_UTILS_HPP
+#define AGPU_COMMON_DISK_CACHE_UTILS_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace AgpuCommon
+{
+
+typedef void (*DiskCacheErrorReporter)(const char *format, ...);
+
+inline std::string getStringFromEnvironment(const char *varname)
+{
+#ifdef _WIN32
+    char *buffer;
+    size_t size;
+    auto error = _dupenv_s(&buffer, &size, varname);
+    if (error) return std::string();
+    if (!buffer) return std::string();
+    std::string res = buffer;
+    free(buffer);
+    return res;
+#else
+    auto value = getenv(varname);
+    if (!value)
+        return std::string();
+    return value;
+#endif
+}
+
+inline int getCurrentProcessID()
+{
+#ifdef _WIN32
+    return _getpid();
+#else
+    return int(getpid());
+#endif
+}
+
+/**
+ * I return the number of bytes between the current position of a file and its
+ * end, or -1 on failure. The position of the file is preserved.
+ */
+inline long getRemainingFileSize(FILE *file)
+{
+    auto position = ftell(file);
+    if(position < 0 || fseek(file, 0, SEEK_END) != 0)
+        return -1;
+
+    auto end = ftell(file);
+    if(fseek(file, position, SEEK_SET) != 0 || end < position)
+        return -1;
+
+    return end - position;
+}
+
+/**
+ * I write a header followed by its payload into a cache file. The file is
+ * written under a name private to this process, and then it replaces the old
+ * file in a single step so that readers never observe a partial write.
+ */
+inline bool writeFileAtomically(const std::string &fileName,
+    const void *header, size_t headerSize, const void *data, size_t dataSize,
+    const char *fileKind, DiskCacheErrorReporter reportError)
+{
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%d.tmp", getCurrentProcessID());
+    auto temporaryFileName = fileName + suffix;
+
+    auto file = fopen(temporaryFileName.c_str(), "wb");
+    if(!file)
+    {
+        reportError("Failed to create the %s %s\n", fileKind, temporaryFileName.c_str());
+        return false;
+    }
+
+    auto success = (headerSize == 0 || fwrite(header, headerSize, 1, file) == 1) &&
+        (dataSize == 0 || fwrite(data, dataSize, 1, file) == 1);
+    success = fclose(file) == 0 && success;
+    if(!success)
+    {
+        reportError("Failed to write the %s %s\n", fileKind, temporaryFileName.c_str());
+        remove(temporaryFileName.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    success = MoveFileExA(temporaryFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    success = rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+#endif
+    if(!success)
+    {
+        reportError("Failed to replace the %s %s\n", fileKind, fileName.c_str());
+        remove(temporaryFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_DISK_CACHE_UTILS_HPP
@@ -0,0 +1,75 @@
+#ifndef AGPU_COMMON_FENCE_WAIT_HPP
+#define AGPU_COMMON_FENCE_WAIT_HPP
+
+#include <AGPU/agpu_impl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace AgpuCommon
+{
+
+/**
+ * I wait for several fences through their public interface, for the backends
+ * that cannot wait for a group of fences natively. Waiting for all of the
+ * fences is done one fence at a time with the remaining time. Waiting for any
+ * of them polls the fences, with a sleep that grows up to a millisecond.
+ */
+inline agpu_error waitForFencesByPolling(agpu_uint count, agpu::fence_ref *fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+{
+    if(count == 0)
+        return AGPU_OK;
+    if(!fences)
+        return AGPU_NULL_POINTER;
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        if(!fences[i])
+            return AGPU_NULL_POINTER;
+    }
+
+    typedef std::chrono::steady_clock clock;
+    // Timeouts that cannot be represented as a deadline are infinite.
+    auto hasDeadline = timeout_ns < agpu_ulong(INT64_MAX/2);
+    auto deadline = clock::now() + std::chrono::nanoseconds(hasDeadline ? timeout_ns : 0);
+    auto remainingTime = [&]() -> agpu_ulong {
+        if(!hasDeadline)
+            return UINT64_MAX;
+
+        auto now = clock::now();
+        return now < deadline ? agpu_ulong(std::chrono::duration_cast<std::chrono::nanoseconds> (deadline - now).count()) : 0;
+    };
+
+    if(wait_all)
+    {
+        for(agpu_uint i = 0; i < count; ++i)
+        {
+            auto error = fences[i]->waitWithTimeout(remainingTime());
+            if(error)
+                return error;
+        }
+
+        return AGPU_OK;
+    }
+
+    auto sleepTime = std::chrono::microseconds(10);
+    for(;;)
+    {
+        for(agpu_uint i = 0; i < count; ++i)
+        {
+            if(fences[i]->isSignaled())
+                return AGPU_OK;
+        }
+
+        auto remaining = remainingTime();
+        if(remaining == 0)
+            return AGPU_TIMEOUT;
+
+        auto sleepDuration = std::min(std::chrono::nanoseconds(sleepTime), std::chrono::nanoseconds(std::min(remaining, agpu_ulong(INT64_MAX/2))));
+        std::this_thread::sleep_for(sleepDuration);
+        sleepTime = std::min(sleepTime*2, std::chrono::microseconds(1000));
+    }
+}
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_FENCE_WAIT_HPP
@@ -1,4 +1,6 @@
 #include "immediate_renderer.hpp"
+#include "state_tracker.hpp"
+#include "worker_pool.hpp"
 #include <stddef.h>
 #include <math.h>
 #include <memory>
@@ -93,35 +95,112 @@ std::string ImmediateShaderCompilationParameters::shaderOptionsString(agpu_shade
 	return options;
 }
 
+ImmediateShaderLibrary::ImmediateShaderLibrary()
+{
+	uberShaderSourceHash = hashBytes(uberShaderSourceCode, strlen(uberShaderSourceCode));
+}
+
+ImmediateShaderLibrary::~ImmediateShaderLibrary()
+{
+}
+
+void ImmediateShaderLibrary::setCacheDirectory(const std::string &directory)
+{
+	diskCache.setDirectory(directory);
+}
+
 agpu::shader_ref ImmediateShaderLibrary::getOrCreateWithCompilationParameters(const agpu::device_ref &device, const ImmediateShaderCompilationParameters &params, agpu_shader_type type)
 {
-	std::unique_lock<std::mutex> l(shaderCompilationMutex);
-	auto &shaderCache = (type == AGPU_VERTEX_SHADER) ? vertexShaderCache : fragmentShaderCache;
-	auto it = shaderCache.find(params);
-	if(it != shaderCache.end())
-		return it->second;
+	std::promise<agpu::shader_ref> compilationPromise;
+	std::shared_future<agpu::shader_ref> result;
+	bool mustCompile = false;
+
+	{
+		std::unique_lock<std::mutex> l(shaderCompilationMutex);
+		auto &shaderCache = (type == AGPU_VERTEX_SHADER) ? vertexShaderCache : fragmentShaderCache;
+		auto it = shaderCache.find(params);
+		if(it == shaderCache.end())
+		{
+			result = compilationPromise.get_future().share();
+			shaderCache.insert(std::make_pair(params, result));
+			mustCompile = true;
+		}
+		else
+		{
+			result = it->second;
+		}
+	}
 
-	auto sourceCode = params.shaderOptionsString(type);
-	sourceCode += uberShaderSourceCode;
+	// Failed compilations are kept, since they would fail again.
+	if(mustCompile)
+		compilationPromise.set_value(compileVariant(device, params, type));
 
-	auto compiler = agpu::offline_shader_compiler_ref(device->createOfflineShaderCompiler());
-	compiler->setShaderSource(AGPU_SHADER_LANGUAGE_VGLSL, type, sourceCode.c_str(), sourceCode.size());
-	auto error = compiler->compileShader(AGPU_SHADER_LANGUAGE_DEVICE_SHADER, "");
+	return result.get();
+}
+
+agpu::shader_ref ImmediateShaderLibrary::compileVariant(const agpu::device_ref &device, const ImmediateShaderCompilationParameters &params, agpu_shader_type type)
+{
+	auto options = params.shaderOptionsString(type);
+	auto cacheKey = hashBytes(options.data(), options.size(), uberShaderSourceHash);
+
+	std::vector<uint32_t> spirv;
+	if(!diskCache.load(cacheKey, spirv))
+	{
+		auto sourceCode = options + uberShaderSourceCode;
+		auto compiler = agpu::offline_shader_compiler_ref(device->createOfflineShaderCompiler());
+		compiler->setShaderSource(AGPU_SHADER_LANGUAGE_VGLSL, type, sourceCode.c_str(), sourceCode.size());
+		auto error = compiler->compileShader(AGPU_SHADER_LANGUAGE_SPIR_V, "");
+		if(error)
+		{
+			auto logLength = compiler->getCompilationLogLength();
+			std::unique_ptr<char[]> log(new char[logLength + 1]);
+			compiler->getCompilationLog(logLength, log.get());
+			log[logLength] = 0;
+			fprintf(stderr, "Failed to compile immediate renderer shader:\n%s\nCompilation error:\n%s\n", sourceCode.c_str(), log.get());
+			return agpu::shader_ref();
+		}
+
+		spirv.resize(compiler->getCompilationResultLength() / 4);
+		compiler->getCompilationResult(spirv.size()*4, reinterpret_cast<agpu_string_buffer> (spirv.data()));
+		diskCache.store(cacheKey, spirv);
+	}
+
+	auto shader = agpu::shader_ref(device->createShader(type));
+	if(!shader)
+		return agpu::shader_ref();
+
+	auto error = shader->setShaderSource(AGPU_SHADER_LANGUAGE_SPIR_V, reinterpret_cast<agpu_cstring> (spirv.data()), spirv.size()*4);
+	if(!error)
+		error = shader->compileShader(nullptr);
 	if(error)
 	{
-		fprintf(stderr, "Failed to compile immediate renderer shader:\n%s\n", sourceCode.c_str());
-
-		auto logLength = compiler->getCompilationLogLength();
-		std::unique_ptr<char[]> log(new char[logLength + 1]);
-		compiler->getCompilationLog(logLength, log.get());
-		log[logLength] = 0;
-		fprintf(stderr, "Compilation error:\n%s\n", log.get());
-		abort();
+		fprintf(stderr, "Failed to create the device shader for an immediate renderer shader variant.\n");
+		return agpu::shader_ref();
 	}
 
-	auto result = agpu::shader_ref(compiler->getResultAsShader());
-	shaderCache.insert(std::make_pair(params, result));
-	return result;
+	return shader;
+}
+
+agpu_error ImmediateShaderLibrary::precompileVariants(const agpu::device_ref &device, const std::vector<ImmediateShaderCompilationParameters> &variants, size_t workerCount)
+{
+	std::atomic<bool> hasFailed(false);
+	{
+		WorkerPool workerPool(workerCount);
+		for(auto &variant : variants)
+		{
+			for(auto type : {AGPU_VERTEX_SHADER, AGPU_FRAGMENT_SHADER})
+			{
+				workerPool.addJob([this, &device, &hasFailed, variant, type] {
+					if(!getOrCreateWithCompilationParameters(device, variant, type))
+						hasFailed = true;
+				});
+			}
+		}
+
+		workerPool.waitForPendingJobs();
+	}
+
+	return hasFailed ? AGPU_COMPILATION_ERROR : AGPU_OK;
 }
 
 inline bool isSyntheticTopology(agpu_primitive_topology type)
@@ -129,6 +208,27 @@ inline bool isSyntheticTopology(agpu_primitive_topology type)
 	return type >= AGPU_IMMEDIATE_TRIANGLE_FAN;
 }
 
+/**
+ * The number of vertices of each primitive of a topology where consecutive
+ * draws can be concatenated, or zero. The synthetic topologies are drawn as
+ * triangle lists.
+ */
+inline agpu_uint mergeablePrimitiveVertexCount(agpu_primitive_topology type)
+{
+    if(isSyntheticTopology(type))
+        return 3;
+
+    switch(type)
+    {
+    case AGPU_POINTS: return 1;
+    case AGPU_LINES: return 2;
+    case AGPU_LINES_ADJACENCY: return 4;
+    case AGPU_TRIANGLES: return 3;
+    case AGPU_TRIANGLES_ADJACENCY: return 6;
+    default: return 0;
+    }
+}
+
 size_t ImmediateTextureBindingSet::hash() const
 {
     return std::hash<agpu::texture_ref>()(albedoTexture) ^
@@ -157,6 +257,29 @@ bool ImmediateTextureBindingSet::operator!=(const ImmediateTextureBindingSet& ot
     return !(*this == other);
 }
 
+bool ImmediateRenderingState::operator==(const ImmediateRenderingState &other) const
+{
+    return activePrimitiveTopology == other.activePrimitiveTopology &&
+        flatShading == other.flatShading &&
+        lightingEnabled == other.lightingEnabled &&
+        lightingModel == other.lightingModel &&
+        texturingEnabled == other.texturingEnabled &&
+        tangentSpaceEnabled == other.tangentSpaceEnabled &&
+        skinningEnabled == other.skinningEnabled &&
+        samplingStateBinding == other.samplingStateBinding &&
+        lightingStateBinding == other.lightingStateBinding &&
+        extraRenderingStateBinding == other.extraRenderingStateBinding &&
+        materialStateBinding == other.materialStateBinding &&
+        transformationStateBinding == other.transformationStateBinding &&
+        skinningStateBinding == other.skinningStateBinding &&
+        textureBindingSet == other.textureBindingSet;
+}
+
+bool ImmediateRenderingState::operator!=(const ImmediateRenderingState &other) const
+{
+    return !(*this == other);
+}
+
 bool TransformationState::operator==(const TransformationState &other) const
 {
 	return projectionMatrix == other.projectionMatrix &&
@@ -648,6 +771,8 @@ bool StateTrackerCache::ensureImmediateRendererObjectsExists()
     {
         immediateShaderLibrary.reset(new ImmediateShaderLibrary());
         if(!immediateShaderLibrary) return false;
+        if(hasShaderCacheDirectory)
+            immediateShaderLibrary->setCacheDirectory(shaderCacheDirectory);
     }
 
     immediateSharedRenderingStates.reset(new ImmediateSharedRenderingStates());
@@ -795,11 +920,13 @@ ImmediateRenderer::ImmediateRenderer(const agpu::state_tracker_cache_ref &stateT
     transformationStateBuffer(immediateShaderSignature),
 	skinningStateBuffer(immediateShaderSignature)
 {
-    vertexBufferCapacity = 0;
-    indexBufferCapacity = 0;
+    currentFrameIndex = 0;
+    hasBegunFrame = false;
     usedTextureBindingCount = 0;
     activeMatrixStack = nullptr;
 	haveFlushedRenderingState = false;
+    currentPrimitivesRenderingState = 0;
+    hasRecordedImmediateVertices = false;
 
     auto impl = stateTrackerCache.as<StateTrackerCache> ();
     device = impl->device;
@@ -811,6 +938,7 @@ ImmediateRenderer::ImmediateRenderer(const agpu::state_tracker_cache_ref &stateT
 
 ImmediateRenderer::~ImmediateRenderer()
 {
+    retireAllFrameResources();
 }
 
 agpu::immediate_renderer_ref ImmediateRenderer::create(const agpu::state_tracker_cache_ref &cache)
@@ -819,13 +947,81 @@ agpu::immediate_renderer_ref ImmediateRenderer::create(const agpu::state_tracker
     if(!cacheImpl->ensureImmediateRendererObjectsExists())
         return agpu::immediate_renderer_ref();
 
-    auto vertexBinding = agpu::vertex_binding_ref(cacheImpl->device->createVertexBinding(cacheImpl->immediateVertexLayout));
-    if(!vertexBinding)
-        return agpu::immediate_renderer_ref();
-
     auto result = agpu::makeObject<ImmediateRenderer> (cache);
-    result.as<ImmediateRenderer> ()->vertexBinding = vertexBinding;
+    auto renderer = result.as<ImmediateRenderer> ();
+    for(auto &frame : renderer->frameResources)
+    {
+        frame.vertexBinding = agpu::vertex_binding_ref(cacheImpl->device->createVertexBinding(cacheImpl->immediateVertexLayout));
+        if(!frame.vertexBinding)
+            return agpu::immediate_renderer_ref();
+
+        frame.fence = agpu::fence_ref(cacheImpl->device->createFence());
+        if(!frame.fence)
+            return agpu::immediate_renderer_ref();
+    }
+
+    return result;
+}
+
+agpu_error ImmediateRenderer::beginFrameResources(const agpu::command_queue_ref &commandQueue)
+{
+    // The commands of the previous frame have already been submitted, so we
+    // can mark its completion before reusing the frame resources.
+    if(hasBegunFrame)
+    {
+        auto &previousFrame = currentFrameResources();
+        if(previousFrame.commandQueue)
+        {
+            auto error = previousFrame.commandQueue->signalFence(previousFrame.fence);
+            if(error) return error;
+            previousFrame.hasPendingFence = true;
+        }
+
+        currentFrameIndex = (currentFrameIndex + 1) % ImmediateRendererFrameCount;
+    }
+
+    auto &frame = currentFrameResources();
+    if(frame.hasPendingFence)
+    {
+        auto error = frame.fence->waitOnClient();
+        if(error) return error;
+        frame.hasPendingFence = false;
+    }
+
+    frame.commandQueue = commandQueue;
+    hasBegunFrame = true;
+    return AGPU_OK;
+}
+
+agpu_error ImmediateRenderer::retireAllFrameResources()
+{
+    agpu_error result = AGPU_OK;
+    if(hasBegunFrame)
+    {
+        auto &lastFrame = currentFrameResources();
+        if(lastFrame.commandQueue)
+        {
+            auto error = lastFrame.commandQueue->signalFence(lastFrame.fence);
+            if(!error)
+                lastFrame.hasPendingFence = true;
+            else
+                result = error;
+        }
+    }
+
+    for(auto &frame : frameResources)
+    {
+        if(frame.hasPendingFence)
+        {
+            auto error = frame.fence->waitOnClient();
+            if(error)
+                result = error;
+            frame.hasPendingFence = false;
+        }
+        frame.commandQueue.reset();
+    }
 
+    hasBegunFrame = false;
     return result;
 }
 
@@ -836,6 +1032,13 @@ agpu_error ImmediateRenderer::beginRendering(const agpu::state_tracker_ref &stat
     if(currentStateTracker)
         return AGPU_INVALID_OPERATION;
 
+    // Wait for the resources of the frame that we are going to overwrite.
+    {
+        auto stateTracker = state_tracker.as<AbstractStateTracker> ();
+        auto error = beginFrameResources(stateTracker->getCommandQueue());
+        if(error) return error;
+    }
+
     currentStateTracker = state_tracker;
     activeMatrixStack = nullptr;
     activeMatrixStackDirtyFlag = nullptr;
@@ -854,10 +1057,10 @@ agpu_error ImmediateRenderer::beginRendering(const agpu::state_tracker_ref &stat
     textureMatrixStackDirtyFlag = true;
 
 	// Reset the transformation state buffer.
-    transformationStateBuffer.reset();
+    transformationStateBuffer.reset(currentFrameIndex);
 
 	// Reset the skinning state buffer.
-	skinningStateBuffer.reset();
+	skinningStateBuffer.reset(currentFrameIndex);
 
     // Reset the rendering state.
     currentRenderingState = ImmediateRenderingState();
@@ -868,13 +1071,13 @@ agpu_error ImmediateRenderer::beginRendering(const agpu::state_tracker_ref &stat
     usedTextureBindingCount = 0;
 
     // Reset the lighting state.
-    lightingStateBuffer.reset();
+    lightingStateBuffer.reset(currentFrameIndex);
 
     // Reset the material state.
-    materialStateBuffer.reset();
+    materialStateBuffer.reset(currentFrameIndex);
 
     // Reset the extra rendering state.
-    extraRenderingStateBuffer.reset();
+    extraRenderingStateBuffer.reset(currentFrameIndex);
 
     // Reset the vertices.
     lastDrawnVertexIndex = 0;
@@ -906,112 +1109,96 @@ agpu_error ImmediateRenderer::endRendering()
 	haveFlushedRenderingState = false;
     for(auto &command : pendingRenderingCommands)
 	{
-        command();
+        executeRenderingCommand(command);
 	}
 
 	lastFlushedRenderingState = ImmediateRenderingState();
 	haveFlushedRenderingState = false;
     pendingRenderingCommands.clear();
+    pendingRenderingStates.clear();
+    pendingVertexBindings.clear();
+    pendingIndexBuffers.clear();
+    hasRecordedImmediateVertices = false;
     currentStateTracker.reset();
     return AGPU_OK;
 }
 
 agpu_error ImmediateRenderer::setBlendState(agpu_int renderTargetMask, agpu_bool enabled)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setBlendState(renderTargetMask, enabled);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetBlendState, renderTargetMask, enabled);
 }
 
 agpu_error ImmediateRenderer::setBlendFunction(agpu_int renderTargetMask, agpu_blending_factor sourceFactor, agpu_blending_factor destFactor, agpu_blending_operation colorOperation, agpu_blending_factor sourceAlphaFactor, agpu_blending_factor destAlphaFactor, agpu_blending_operation alphaOperation)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setBlendFunction(renderTargetMask, sourceFactor, destFactor, colorOperation, sourceAlphaFactor, destAlphaFactor, alphaOperation);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetBlendFunction, renderTargetMask, sourceFactor, destFactor, colorOperation, sourceAlphaFactor, destAlphaFactor, alphaOperation);
 }
 
 agpu_error ImmediateRenderer::setColorMask(agpu_int renderTargetMask, agpu_bool redEnabled, agpu_bool greenEnabled, agpu_bool blueEnabled, agpu_bool alphaEnabled)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setColorMask(renderTargetMask, redEnabled, greenEnabled, blueEnabled, alphaEnabled);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetColorMask, renderTargetMask, redEnabled, greenEnabled, blueEnabled, alphaEnabled);
 }
 
 agpu_error ImmediateRenderer::setFrontFace(agpu_face_winding winding)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setFrontFace(winding);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetFrontFace, winding);
 }
 
 agpu_error ImmediateRenderer::setCullMode(agpu_cull_mode mode)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setCullMode(mode);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetCullMode, mode);
 }
 
 agpu_error ImmediateRenderer::setDepthBias(agpu_float constant_factor, agpu_float clamp, agpu_float slope_factor)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setDepthBias(constant_factor, clamp, slope_factor);
-    });
+    if(!currentStateTracker)
+        return AGPU_INVALID_OPERATION;
+
+    ImmediateRenderingCommand command(ImmediateRenderingCommandType::SetDepthBias);
+    command.floats[0] = constant_factor;
+    command.floats[1] = clamp;
+    command.floats[2] = slope_factor;
+    pendingRenderingCommands.push_back(command);
+    return AGPU_OK;
 }
 
 agpu_error ImmediateRenderer::setDepthState(agpu_bool enabled, agpu_bool writeMask, agpu_compare_function function)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setDepthState(enabled, writeMask, function);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetDepthState, enabled, writeMask, function);
 }
 
 agpu_error ImmediateRenderer::setPolygonMode(agpu_polygon_mode mode)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setPolygonMode(mode);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetPolygonMode, mode);
 }
 
 agpu_error ImmediateRenderer::setStencilState(agpu_bool enabled, agpu_int writeMask, agpu_int readMask)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setStencilState(enabled, writeMask, readMask);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetStencilState, enabled, writeMask, readMask);
 }
 
 agpu_error ImmediateRenderer::setStencilFrontFace(agpu_stencil_operation stencilFailOperation, agpu_stencil_operation depthFailOperation, agpu_stencil_operation stencilDepthPassOperation, agpu_compare_function stencilFunction)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setStencilFrontFace(stencilFailOperation, depthFailOperation, stencilDepthPassOperation, stencilFunction);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetStencilFrontFace, stencilFailOperation, depthFailOperation, stencilDepthPassOperation, stencilFunction);
 }
 
 agpu_error ImmediateRenderer::setStencilBackFace(agpu_stencil_operation stencilFailOperation, agpu_stencil_operation depthFailOperation, agpu_stencil_operation stencilDepthPassOperation, agpu_compare_function stencilFunction)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setStencilBackFace(stencilFailOperation, depthFailOperation, stencilDepthPassOperation, stencilFunction);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetStencilBackFace, stencilFailOperation, depthFailOperation, stencilDepthPassOperation, stencilFunction);
 }
 
 agpu_error ImmediateRenderer::setViewport(agpu_int x, agpu_int y, agpu_int w, agpu_int h)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setViewport(x, y, w, h);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetViewport, x, y, w, h);
 }
 
 agpu_error ImmediateRenderer::setScissor(agpu_int x, agpu_int y, agpu_int w, agpu_int h)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setScissor(x, y, w, h);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetScissor, x, y, w, h);
 }
 
 agpu_error ImmediateRenderer::setStencilReference(agpu_uint reference)
 {
-    return delegateToStateTracker([=]{
-        currentStateTracker->setStencilReference(reference);
-    });
+    return recordStateTrackerCommand(ImmediateRenderingCommandType::SetStencilReference, reference);
 }
 
 agpu_error ImmediateRenderer::setFlatShading(agpu_bool enabled)
@@ -1577,11 +1764,7 @@ agpu_error ImmediateRenderer::beginPrimitives(agpu_primitive_topology type)
 
     auto stateToRender = currentRenderingState;
 	stateToRender.tangentSpaceEnabled = false;
-    pendingRenderingCommands.push_back([=]{
-        flushRenderingState(stateToRender);
-    });
-
-
+    currentPrimitivesRenderingState = recordRenderingState(stateToRender);
     return AGPU_OK;
 }
 
@@ -1617,10 +1800,13 @@ agpu_error ImmediateRenderer::endPrimitives()
         auto vertexStart = lastDrawnVertexIndex;
 		// In the case of synthetic primitive topologies, we need to generate the indices manually.
 		auto synthetic = isSyntheticTopology(currentRenderingState.activePrimitiveTopology);
+		recordImmediateVertices();
 		if (synthetic)
 		{
+			// The base vertex is added to the indices, so that consecutive
+			// primitives can be merged into a single draw.
 			auto firstIndex = indices.size();
-			auto baseVertex = lastDrawnVertexIndex;
+			auto baseVertex = uint32_t(lastDrawnVertexIndex);
 			switch (currentRenderingState.activePrimitiveTopology)
 			{
 			case AGPU_IMMEDIATE_POLYGON:
@@ -1629,9 +1815,9 @@ agpu_error ImmediateRenderer::endPrimitives()
 				{
 					for (size_t i = 2; i < vertexCount; ++i)
 					{
-						indices.push_back(0);
-						indices.push_back(i-1);
-						indices.push_back(i);
+						indices.push_back(baseVertex);
+						indices.push_back(baseVertex + i - 1);
+						indices.push_back(baseVertex + i);
 					}
 				}
 				break;
@@ -1639,7 +1825,7 @@ agpu_error ImmediateRenderer::endPrimitives()
 				if (vertexCount >= 4)
 				{
 					size_t quadCount = vertexCount / 4;
-					auto quadBaseIndex = 0;
+					auto quadBaseIndex = baseVertex;
 					for (size_t i = 0; i < quadCount; ++i)
 					{
 						auto qi0 = quadBaseIndex;
@@ -1664,27 +1850,11 @@ agpu_error ImmediateRenderer::endPrimitives()
 			}
 			auto indexCount = indices.size() - firstIndex;
 			if (indexCount > 0)
-			{
-				pendingRenderingCommands.push_back([=] {
-					auto error = flushImmediateVertexRenderingState();
-					if (!error)
-					{
-						currentStateTracker->useIndexBuffer(indexBuffer);
-						currentStateTracker->drawElements(indexCount, 1, firstIndex, baseVertex, 0);
-					}
-				});
-			}
+				recordDraw(ImmediateRenderingCommandType::DrawElements, currentPrimitivesRenderingState, agpu_uint(indexCount), 1, agpu_uint(firstIndex), 0, 0);
 		}
 		else
 		{
-			pendingRenderingCommands.push_back([=] {
-				auto error = flushImmediateVertexRenderingState();
-				if (!error)
-				{
-					currentStateTracker->drawArrays(vertexCount, 1, vertexStart, 0);
-				}
-			});
-
+			recordDraw(ImmediateRenderingCommandType::DrawArrays, currentPrimitivesRenderingState, agpu_uint(vertexCount), 1, agpu_uint(vertexStart), 0, 0);
 		}
 
     }
@@ -1802,10 +1972,139 @@ agpu_error ImmediateRenderer::validateExtraRenderingState()
 agpu_error ImmediateRenderer::flushImmediateVertexRenderingState()
 {
     currentStateTracker->setVertexLayout(immediateVertexLayout);
-    currentStateTracker->useVertexBinding(vertexBinding);
+    currentStateTracker->useVertexBinding(currentFrameResources().vertexBinding);
     return AGPU_OK;
 }
 
+uint32_t ImmediateRenderer::recordRenderingState(const ImmediateRenderingState &state)
+{
+    // Consecutive draws usually share their state, which is required for
+    // merging them.
+    if(pendingRenderingStates.empty() || pendingRenderingStates.back() != state)
+        pendingRenderingStates.push_back(state);
+    return uint32_t(pendingRenderingStates.size() - 1);
+}
+
+void ImmediateRenderer::recordImmediateVertices()
+{
+    if(hasRecordedImmediateVertices)
+        return;
+
+    pendingRenderingCommands.push_back(ImmediateRenderingCommand(ImmediateRenderingCommandType::UseImmediateVertices));
+    hasRecordedImmediateVertices = true;
+}
+
+void ImmediateRenderer::recordDraw(ImmediateRenderingCommandType type, uint32_t renderingState, agpu_uint count, agpu_uint instanceCount, agpu_uint first, agpu_int baseVertex, agpu_uint baseInstance)
+{
+    // Try to append the range into the previous draw.
+    if(!pendingRenderingCommands.empty() && pendingRenderingCommands.back().type == type)
+    {
+        auto &last = pendingRenderingCommands.back().draw;
+        auto primitiveVertexCount = mergeablePrimitiveVertexCount(pendingRenderingStates[renderingState].activePrimitiveTopology);
+        if(last.renderingState == renderingState &&
+            primitiveVertexCount != 0 &&
+            last.count % primitiveVertexCount == 0 && count % primitiveVertexCount == 0 &&
+            last.instanceCount == 1 && instanceCount == 1 &&
+            last.baseInstance == baseInstance &&
+            last.baseVertex == baseVertex &&
+            last.first + last.count == first)
+        {
+            last.count += count;
+            return;
+        }
+    }
+
+    ImmediateRenderingCommand command(type);
+    command.draw.renderingState = renderingState;
+    command.draw.count = count;
+    command.draw.instanceCount = instanceCount;
+    command.draw.first = first;
+    command.draw.baseVertex = baseVertex;
+    command.draw.baseInstance = baseInstance;
+    pendingRenderingCommands.push_back(command);
+}
+
+void ImmediateRenderer::executeRenderingCommand(const ImmediateRenderingCommand &command)
+{
+    auto &arguments = command.integers;
+    switch(command.type)
+    {
+    case ImmediateRenderingCommandType::SetBlendState:
+        currentStateTracker->setBlendState(arguments[0], arguments[1]);
+        break;
+    case ImmediateRenderingCommandType::SetBlendFunction:
+        currentStateTracker->setBlendFunction(arguments[0],
+            agpu_blending_factor(arguments[1]), agpu_blending_factor(arguments[2]), agpu_blending_operation(arguments[3]),
+            agpu_blending_factor(arguments[4]), agpu_blending_factor(arguments[5]), agpu_blending_operation(arguments[6]));
+        break;
+    case ImmediateRenderingCommandType::SetColorMask:
+        currentStateTracker->setColorMask(arguments[0], arguments[1], arguments[2], arguments[3], arguments[4]);
+        break;
+    case ImmediateRenderingCommandType::SetFrontFace:
+        currentStateTracker->setFrontFace(agpu_face_winding(arguments[0]));
+        break;
+    case ImmediateRenderingCommandType::SetCullMode:
+        currentStateTracker->setCullMode(agpu_cull_mode(arguments[0]));
+        break;
+    case ImmediateRenderingCommandType::SetDepthBias:
+        currentStateTracker->setDepthBias(command.floats[0], command.floats[1], command.floats[2]);
+        break;
+    case ImmediateRenderingCommandType::SetDepthState:
+        currentStateTracker->setDepthState(arguments[0], arguments[1], agpu_compare_function(arguments[2]));
+        break;
+    case ImmediateRenderingCommandType::SetPolygonMode:
+        currentStateTracker->setPolygonMode(agpu_polygon_mode(arguments[0]));
+        break;
+    case ImmediateRenderingCommandType::SetStencilState:
+        currentStateTracker->setStencilState(arguments[0], arguments[1], arguments[2]);
+        break;
+    case ImmediateRenderingCommandType::SetStencilFrontFace:
+        currentStateTracker->setStencilFrontFace(agpu_stencil_operation(arguments[0]), agpu_stencil_operation(arguments[1]), agpu_stencil_operation(arguments[2]), agpu_compare_function(arguments[3]));
+        break;
+    case ImmediateRenderingCommandType::SetStencilBackFace:
+        currentStateTracker->setStencilBackFace(agpu_stencil_operation(arguments[0]), agpu_stencil_operation(arguments[1]), agpu_stencil_operation(arguments[2]), agpu_compare_function(arguments[3]));
+        break;
+    case ImmediateRenderingCommandType::SetViewport:
+        currentStateTracker->setViewport(arguments[0], arguments[1], arguments[2], arguments[3]);
+        break;
+    case ImmediateRenderingCommandType::SetScissor:
+        currentStateTracker->setScissor(arguments[0], arguments[1], arguments[2], arguments[3]);
+        break;
+    case ImmediateRenderingCommandType::SetStencilReference:
+        currentStateTracker->setStencilReference(agpu_uint(arguments[0]));
+        break;
+    case ImmediateRenderingCommandType::UseImmediateVertices:
+        {
+            flushImmediateVertexRenderingState();
+            auto &indexBuffer = currentFrameResources().indexBuffer.buffer;
+            if(indexBuffer)
+                currentStateTracker->useIndexBuffer(indexBuffer);
+        }
+        break;
+    case ImmediateRenderingCommandType::UseVertexBinding:
+        {
+            auto &binding = pendingVertexBindings[command.vertexBinding];
+            currentStateTracker->setVertexLayout(binding.layout);
+            currentStateTracker->useVertexBinding(binding.vertices);
+            auto &indexBuffer = currentFrameResources().indexBuffer.buffer;
+            if(indexBuffer)
+                currentStateTracker->useIndexBuffer(indexBuffer);
+        }
+        break;
+    case ImmediateRenderingCommandType::UseIndexBuffer:
+        currentStateTracker->useIndexBufferAt(pendingIndexBuffers[command.indexBuffer.index], command.indexBuffer.offset, command.indexBuffer.indexSize);
+        break;
+    case ImmediateRenderingCommandType::DrawArrays:
+        if(!flushRenderingState(pendingRenderingStates[command.draw.renderingState]))
+            currentStateTracker->drawArrays(command.draw.count, command.draw.instanceCount, command.draw.first, command.draw.baseInstance);
+        break;
+    case ImmediateRenderingCommandType::DrawElements:
+        if(!flushRenderingState(pendingRenderingStates[command.draw.renderingState]))
+            currentStateTracker->drawElements(command.draw.count, command.draw.instanceCount, command.draw.first, command.draw.baseVertex, command.draw.baseInstance);
+        break;
+    }
+}
+
 agpu_error ImmediateRenderer::flushShadersForRenderingState(const ImmediateRenderingState &state)
 {
 	if(!haveFlushedRenderingState)
@@ -1831,15 +2130,21 @@ agpu_error ImmediateRenderer::flushShadersForRenderingState(const ImmediateRende
     parameters.skinningEnabled = state.skinningEnabled;
 	parameters.lightingEnabled = state.lightingEnabled;
 	parameters.lightingModel = state.lightingModel;
-	currentStateTracker->setVertexStage(immediateShaderLibrary->getOrCreateWithCompilationParameters(device, parameters, AGPU_VERTEX_SHADER), "main");
-	currentStateTracker->setFragmentStage(immediateShaderLibrary->getOrCreateWithCompilationParameters(device, parameters, AGPU_FRAGMENT_SHADER), "main");
+	auto vertexShader = immediateShaderLibrary->getOrCreateWithCompilationParameters(device, parameters, AGPU_VERTEX_SHADER);
+	auto fragmentShader = immediateShaderLibrary->getOrCreateWithCompilationParameters(device, parameters, AGPU_FRAGMENT_SHADER);
+	if(!vertexShader || !fragmentShader)
+		return AGPU_COMPILATION_ERROR;
+
+	currentStateTracker->setVertexStage(vertexShader, "main");
+	currentStateTracker->setFragmentStage(fragmentShader, "main");
 
 	return AGPU_OK;
 }
 
 agpu_error ImmediateRenderer::flushRenderingState(const ImmediateRenderingState &state)
 {
-	flushShadersForRenderingState(state);
+	auto error = flushShadersForRenderingState(state);
+	if(error) return error;
 
 	if(!haveFlushedRenderingState || state.activePrimitiveTopology != lastFlushedRenderingState.activePrimitiveTopology)
     	currentStateTracker->setPrimitiveType(isSyntheticTopology(state.activePrimitiveTopology) ? AGPU_TRIANGLES : state.activePrimitiveTopology);
@@ -1889,66 +2194,26 @@ agpu_error ImmediateRenderer::flushRenderingState(const ImmediateRenderingState
 
 agpu_error ImmediateRenderer::flushRenderingData()
 {
-    static constexpr size_t GpuBufferDataThreshold = 1024*256;
-
-    // Upload the vertices.
-    // TODO: Use an immediate state buffer for the vertices and the indices.
-    agpu_error error = AGPU_OK;
-    if(!vertexBuffer || vertexBufferCapacity < vertices.size())
-    {
-        vertexBufferCapacity = nextPowerOfTwo(vertices.size());
-        if(vertexBufferCapacity < 32)
-            vertexBufferCapacity = 32;
-
-        auto requiredSize = vertexBufferCapacity*sizeof(ImmediateRendererVertex);
-        agpu_buffer_description bufferDescription = {};
-        bufferDescription.size = requiredSize;
-        bufferDescription.heap_type = requiredSize >= GpuBufferDataThreshold
-            ? AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL : AGPU_MEMORY_HEAP_TYPE_HOST_TO_DEVICE;
-        bufferDescription.usage_modes = bufferDescription.main_usage_mode = AGPU_ARRAY_BUFFER;
-        bufferDescription.mapping_flags = AGPU_MAP_DYNAMIC_STORAGE_BIT;
-        bufferDescription.stride = sizeof(ImmediateRendererVertex);
-
-        vertexBuffer = agpu::buffer_ref(device->createBuffer(&bufferDescription, nullptr));
-        if(!vertexBuffer)
-            return AGPU_OUT_OF_MEMORY;
-
-        vertexBinding->bindVertexBuffers(1, &vertexBuffer);
-    }
+    // Stream the vertices and the indices into the persistently mapped
+    // buffers of the current frame. They were waited in beginRendering.
+    auto &frame = currentFrameResources();
+    bool hasChanged = false;
+    agpu_error error = frame.vertexBuffer.ensureCapacity(device, vertices.size(), sizeof(ImmediateRendererVertex), AGPU_ARRAY_BUFFER, hasChanged);
+    if(error) return error;
 
-    if(!vertices.empty())
-    {
-        error = vertexBuffer->uploadBufferData(0, vertices.size()*sizeof(ImmediateRendererVertex), &vertices[0]);
-        if(error)
-            return error;
-    }
+    if(hasChanged)
+        frame.vertexBinding->bindVertexBuffers(1, &frame.vertexBuffer.buffer);
 
-    // Upload the indices.
-    if(!indices.empty() && (!indexBuffer || indexBufferCapacity < indices.size()))
-    {
-        indexBufferCapacity = nextPowerOfTwo(indices.size());
-        if(indexBufferCapacity < 32)
-            indexBufferCapacity = 32;
-
-        auto requiredSize = indexBufferCapacity*sizeof(uint32_t);
-        agpu_buffer_description bufferDescription = {};
-        bufferDescription.size = requiredSize;
-        bufferDescription.heap_type = requiredSize >= GpuBufferDataThreshold
-            ? AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL : AGPU_MEMORY_HEAP_TYPE_HOST_TO_DEVICE;
-        bufferDescription.usage_modes = bufferDescription.main_usage_mode = AGPU_ELEMENT_ARRAY_BUFFER;
-        bufferDescription.mapping_flags = AGPU_MAP_DYNAMIC_STORAGE_BIT;
-        bufferDescription.stride = sizeof(uint32_t);
-
-        indexBuffer = agpu::buffer_ref(device->createBuffer(&bufferDescription, nullptr));
-        if(!indexBuffer)
-            return AGPU_OUT_OF_MEMORY;
-    }
+    error = frame.vertexBuffer.write(vertices.data(), vertices.size()*sizeof(ImmediateRendererVertex));
+    if(error) return error;
 
     if(!indices.empty())
     {
-        error = indexBuffer->uploadBufferData(0, indices.size()*sizeof(uint32_t), &indices[0]);
-        if(error)
-            return error;
+        error = frame.indexBuffer.ensureCapacity(device, indices.size(), sizeof(uint32_t), AGPU_ELEMENT_ARRAY_BUFFER, hasChanged);
+        if(error) return error;
+
+        error = frame.indexBuffer.write(indices.data(), indices.size()*sizeof(uint32_t));
+        if(error) return error;
     }
 
     // Upload the immediate state buffers.
@@ -1999,14 +2264,7 @@ agpu_error ImmediateRenderer::beginMeshWithVertices(agpu_size vertexCount, agpu_
         positionsBytes += stride;
     }
 
-    pendingRenderingCommands.push_back([=]{
-        auto error = flushImmediateVertexRenderingState();
-        if(!error)
-        {
-            currentStateTracker->useIndexBuffer(indexBuffer);
-        }
-    });
-
+    recordImmediateVertices();
     return AGPU_OK;
 }
 
@@ -2021,11 +2279,11 @@ agpu_error ImmediateRenderer::beginMeshWithVertexBinding(const agpu::vertex_layo
 	currentImmediateMeshBaseVertex = 0;
     currentImmediateMeshVertexCount = 0;
 
-	pendingRenderingCommands.push_back([=]{
-		currentStateTracker->setVertexLayout(layout);
-		currentStateTracker->useVertexBinding(vertices);
-        currentStateTracker->useIndexBuffer(indexBuffer);
-    });
+	ImmediateRenderingCommand command(ImmediateRenderingCommandType::UseVertexBinding);
+	command.vertexBinding = uint32_t(pendingVertexBindings.size());
+	pendingVertexBindings.push_back(ImmediateRecordedVertexBinding{layout, vertices});
+	pendingRenderingCommands.push_back(command);
+	hasRecordedImmediateVertices = false;
 
 	return AGPU_OK;
 }
@@ -2040,7 +2298,7 @@ agpu_error ImmediateRenderer::useIndexBuffer(const agpu::buffer_ref & index_buff
 	return useIndexBufferAt(index_buffer, 0, description.stride);
 }
 
-agpu_error ImmediateRenderer::useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error ImmediateRenderer::useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size)
 {
 	if(!index_buffer)
         return AGPU_NULL_POINTER;
@@ -2048,9 +2306,13 @@ agpu_error ImmediateRenderer::useIndexBufferAt(const agpu::buffer_ref & index_bu
         return AGPU_INVALID_OPERATION;
 
 	haveExplicitIndexBuffer = true;
-	pendingRenderingCommands.push_back([=]{
-        currentStateTracker->useIndexBufferAt(index_buffer, offset, index_size);
-    });
+	ImmediateRenderingCommand command(ImmediateRenderingCommandType::UseIndexBuffer);
+	command.indexBuffer.index = uint32_t(pendingIndexBuffers.size());
+	command.indexBuffer.indexSize = index_size;
+	command.indexBuffer.offset = offset;
+	pendingIndexBuffers.push_back(index_buffer);
+	pendingRenderingCommands.push_back(command);
+	hasRecordedImmediateVertices = false;
 
 	return AGPU_OK;
 }
@@ -2155,13 +2417,7 @@ agpu_error ImmediateRenderer::drawElementsWithIndices(agpu_primitive_topology mo
         {
             indices.insert(indices.end(), indicesValues, indicesValues + index_count);
             stateToRender.activePrimitiveTopology = mode;
-            pendingRenderingCommands.push_back([=]{
-                auto error = flushRenderingState(stateToRender);
-                if(!error)
-				{
-                    currentStateTracker->drawElements(index_count, instance_count, baseIndex + first_index, actualBaseVertex, base_instance);
-				}
-            });
+            recordDraw(ImmediateRenderingCommandType::DrawElements, recordRenderingState(stateToRender), index_count, instance_count, agpu_uint(baseIndex + first_index), agpu_int(actualBaseVertex), base_instance);
         }
         break;
     case AGPU_IMMEDIATE_POLYGON:
@@ -2180,13 +2436,7 @@ agpu_error ImmediateRenderer::drawElementsWithIndices(agpu_primitive_topology mo
             }
 
             stateToRender.activePrimitiveTopology = AGPU_TRIANGLES;
-            pendingRenderingCommands.push_back([=]{
-                auto error = flushRenderingState(stateToRender);
-                if(!error)
-				{
-                    currentStateTracker->drawElements(convertedIndexCount, instance_count, baseIndex, actualBaseVertex, base_instance);
-				}
-            });
+            recordDraw(ImmediateRenderingCommandType::DrawElements, recordRenderingState(stateToRender), convertedIndexCount, instance_count, agpu_uint(baseIndex), agpu_int(actualBaseVertex), base_instance);
         }
         return AGPU_OK;
     case AGPU_IMMEDIATE_QUADS:
@@ -2216,13 +2466,7 @@ agpu_error ImmediateRenderer::drawElementsWithIndices(agpu_primitive_topology mo
 
 
             stateToRender.activePrimitiveTopology = AGPU_TRIANGLES;
-            pendingRenderingCommands.push_back([=]{
-                auto error = flushRenderingState(stateToRender);
-                if(!error)
-				{
-                    currentStateTracker->drawElements(convertedIndexCount, instance_count, baseIndex, actualBaseVertex, base_instance);
-				}
-            });
+            recordDraw(ImmediateRenderingCommandType::DrawElements, recordRenderingState(stateToRender), convertedIndexCount, instance_count, agpu_uint(baseIndex), agpu_int(actualBaseVertex), base_instance);
         }
         return AGPU_OK;
     default:
@@ -2246,14 +2490,7 @@ agpu_error ImmediateRenderer::drawArrays(agpu_uint vertex_count, agpu_uint insta
 	auto error = validateRenderingStates();
     if(error) return error;
 
-	auto stateToRender = currentRenderingState;
-	pendingRenderingCommands.push_back([=]{
-		auto error = flushRenderingState(stateToRender);
-		if(!error)
-		{
-			currentStateTracker->drawArrays(vertex_count, instance_count, first_vertex, base_instance);
-		}
-	});
+	recordDraw(ImmediateRenderingCommandType::DrawArrays, recordRenderingState(currentRenderingState), vertex_count, instance_count, first_vertex, 0, base_instance);
 
     return AGPU_OK;
 }
@@ -2266,14 +2503,7 @@ agpu_error ImmediateRenderer::drawElements(agpu_uint index_count, agpu_uint inst
 	auto error = validateRenderingStates();
     if(error) return error;
 
-	auto stateToRender = currentRenderingState;
-	pendingRenderingCommands.push_back([=]{
-		auto error = flushRenderingState(stateToRender);
-		if(!error)
-		{
-			currentStateTracker->drawElements(index_count, instance_count, first_index, base_vertex, base_instance);
-		}
-	});
+	recordDraw(ImmediateRenderingCommandType::DrawElements, recordRenderingState(currentRenderingState), index_count, instance_count, first_index, base_vertex, base_instance);
 
     return AGPU_OK;
 }
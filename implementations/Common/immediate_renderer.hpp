@@ -2,9 +2,11 @@
 #define AGPU_IMMEDIATE_RENDERER_HPP
 
 #include "state_tracker_cache.hpp"
+#include "shader_variant_cache.hpp"
 #include "vector_math.hpp"
 #include "utility.hpp"
 #include <assert.h>
+#include <array>
 #include <vector>
 #include <functional>
 #include <string.h>
@@ -101,16 +103,31 @@ struct hash<AgpuCommon::ImmediateRendererSamplerStateDescription>
 
 namespace AgpuCommon
 {
+/**
+ * I hold the compiled variants of the immediate renderer uber shader. A
+ * variant is compiled only once, outside of my lock, and its SPIR-V is kept
+ * in an on-disk cache keyed by the variant options and the uber shader source.
+ */
 class ImmediateShaderLibrary
 {
 public:
+    ImmediateShaderLibrary();
+    ~ImmediateShaderLibrary();
 
     agpu::shader_ref getOrCreateWithCompilationParameters(const agpu::device_ref &device, const ImmediateShaderCompilationParameters &params, agpu_shader_type type);
+    agpu_error precompileVariants(const agpu::device_ref &device, const std::vector<ImmediateShaderCompilationParameters> &variants, size_t workerCount);
+
+    void setCacheDirectory(const std::string &directory);
 
 private:
+    agpu::shader_ref compileVariant(const agpu::device_ref &device, const ImmediateShaderCompilationParameters &params, agpu_shader_type type);
+
     std::mutex shaderCompilationMutex;
-    std::unordered_map<ImmediateShaderCompilationParameters, agpu::shader_ref> vertexShaderCache;
-    std::unordered_map<ImmediateShaderCompilationParameters, agpu::shader_ref> fragmentShaderCache;
+    std::unordered_map<ImmediateShaderCompilationParameters, std::shared_future<agpu::shader_ref>> vertexShaderCache;
+    std::unordered_map<ImmediateShaderCompilationParameters, std::shared_future<agpu::shader_ref>> fragmentShaderCache;
+
+    ShaderVariantDiskCache diskCache;
+    uint64_t uberShaderSourceHash;
 };
 
 class ImmediateRendererSamplerState
@@ -182,6 +199,9 @@ struct ImmediateRenderingState
     agpu::shader_resource_binding_ref transformationStateBinding;
     agpu::shader_resource_binding_ref skinningStateBinding;
     ImmediateTextureBindingSet textureBindingSet;
+
+    bool operator==(const ImmediateRenderingState &other) const;
+    bool operator!=(const ImmediateRenderingState &other) const;
 };
 
 struct TransformationState
@@ -488,11 +508,95 @@ struct hash<AgpuCommon::SkinningState>
 namespace AgpuCommon
 {
 
+/**
+ * I am the number of immediate renderer frames that can be in flight at the
+ * same time. Each one of them streams into its own buffers.
+ */
+static constexpr size_t ImmediateRendererFrameCount = 3;
+
+/**
+ * I am a persistently mapped, host visible buffer that streams the data of one
+ * immediate renderer frame. I only grow, so that the steady state does not
+ * reallocate, and I am written with a single memcpy without staging.
+ */
+class ImmediateStreamingBuffer
+{
+public:
+    ImmediateStreamingBuffer()
+        : capacity(0), mappedPointer(nullptr) {}
+    ImmediateStreamingBuffer(const ImmediateStreamingBuffer &) = delete;
+    ImmediateStreamingBuffer &operator=(const ImmediateStreamingBuffer &) = delete;
+
+    ~ImmediateStreamingBuffer()
+    {
+        release();
+    }
+
+    void release()
+    {
+        if(buffer && mappedPointer)
+            buffer->unmapBuffer();
+
+        buffer.reset();
+        mappedPointer = nullptr;
+        capacity = 0;
+    }
+
+    // I set hasChanged when the buffer is replaced, so that its bindings can be updated.
+    agpu_error ensureCapacity(const agpu::device_ref &device, size_t requiredCapacity, size_t elementSize, agpu_buffer_usage_mask usage, bool &hasChanged)
+    {
+        hasChanged = false;
+        if(buffer && requiredCapacity <= capacity)
+            return AGPU_OK;
+
+        auto newCapacity = nextPowerOfTwo(requiredCapacity);
+        if(newCapacity < 32)
+            newCapacity = 32;
+
+        agpu_buffer_description bufferDescription = {};
+        bufferDescription.size = newCapacity*elementSize;
+        bufferDescription.heap_type = AGPU_MEMORY_HEAP_TYPE_HOST_TO_DEVICE;
+        bufferDescription.usage_modes = bufferDescription.main_usage_mode = usage;
+        bufferDescription.mapping_flags = AGPU_MAP_WRITE_BIT | AGPU_MAP_PERSISTENT_BIT | AGPU_MAP_COHERENT_BIT | AGPU_MAP_DYNAMIC_STORAGE_BIT;
+        bufferDescription.stride = elementSize;
+
+        auto newBuffer = agpu::buffer_ref(device->createBuffer(&bufferDescription, nullptr));
+        if(!newBuffer)
+            return AGPU_OUT_OF_MEMORY;
+
+        release();
+        buffer = newBuffer;
+        capacity = newCapacity;
+
+        // Without a persistent mapping we fall back into uploadBufferData.
+        mappedPointer = reinterpret_cast<uint8_t*> (buffer->mapBuffer(AGPU_WRITE_ONLY));
+        hasChanged = true;
+        return AGPU_OK;
+    }
+
+    agpu_error write(const void *data, size_t size)
+    {
+        if(size == 0)
+            return AGPU_OK;
+
+        if(mappedPointer)
+        {
+            memcpy(mappedPointer, data, size);
+            return AGPU_OK;
+        }
+
+        return buffer->uploadBufferData(0, size, const_cast<void*> (data));
+    }
+
+    agpu::buffer_ref buffer;
+    size_t capacity;
+    uint8_t *mappedPointer;
+};
+
 template<typename ST, agpu_uint DS>
 class ImmediateStateBuffer
 {
 public:
-    static constexpr size_t GpuBufferDataThreshold = 1024*256;
     static constexpr agpu_uint DescriptorSetIndex = DS;
 
     typedef ST StateType;
@@ -500,8 +604,18 @@ public:
 
     static_assert(sizeof(StateType) % 256 == 0, "Uniform constant structures must be aligned to 256 bytes");
 
+    /**
+     * The buffer and the resource bindings of one frame. The resource
+     * bindings are bound only once to their slot in the buffer.
+     */
+    struct FrameStorage
+    {
+        ImmediateStreamingBuffer storage;
+        std::vector<agpu::shader_resource_binding_ref> resourceBindings;
+    };
+
 	ImmediateStateBuffer(const agpu::shader_signature_ref &cshaderSignature)
-		: dirtyFlag(false), bufferCapacity(0), shaderSignature(cshaderSignature)
+		: dirtyFlag(false), currentFrameIndex(0), shaderSignature(cshaderSignature)
     {
 
     }
@@ -509,10 +623,11 @@ public:
     {
     }
 
-    void reset()
+    void reset(size_t frameIndex)
     {
         currentState = StateType();
         dirtyFlag = true;
+        currentFrameIndex = frameIndex;
         currentStateIndex = 0;
         bufferData.clear();
         stateCache.clear();
@@ -548,15 +663,16 @@ public:
             dirtyFlag = false;
         }
 
-        return resourceBindings[currentStateIndex];
+        return frames[currentFrameIndex].resourceBindings[currentStateIndex];
     }
 
     void ensureValidResourceBinding()
     {
+        auto &frame = frames[currentFrameIndex];
         auto requestedIndex = bufferData.size() - 1;
-        if(requestedIndex < resourceBindings.size())
+        if(requestedIndex < frame.resourceBindings.size())
             return;
-        assert(requestedIndex == resourceBindings.size());
+        assert(requestedIndex == frame.resourceBindings.size());
 
         auto newBinding = agpu::shader_resource_binding_ref(shaderSignature->createShaderResourceBinding(DescriptorSetIndex));
         if(!newBinding)
@@ -567,12 +683,12 @@ public:
         }
 
         // Bind the descriptor to the buffer, only if it has the required capacity.
-        if(buffer && requestedIndex < bufferCapacity)
+        if(frame.storage.buffer && requestedIndex < frame.storage.capacity)
         {
-            newBinding->bindUniformBufferRange(0, buffer, sizeof(StateType)*requestedIndex, sizeof(StateType));
+            newBinding->bindUniformBufferRange(0, frame.storage.buffer, sizeof(StateType)*requestedIndex, sizeof(StateType));
         }
 
-        resourceBindings.push_back(newBinding);
+        frame.resourceBindings.push_back(newBinding);
     }
 
     void setState(const StateType &newState)
@@ -586,59 +702,140 @@ public:
 
     agpu_error uploadData(const agpu::device_ref &device)
     {
-        if(!buffer || bufferCapacity < bufferData.size())
-        {
-            bufferCapacity = nextPowerOfTwo(bufferData.size());
-            if(bufferCapacity < 32)
-                bufferCapacity = 32;
-
-            auto requiredSize = bufferCapacity*sizeof(StateType);
-            agpu_buffer_description bufferDescription = {};
-            bufferDescription.size = requiredSize;
-            bufferDescription.heap_type = requiredSize >= GpuBufferDataThreshold
-                ? AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL : AGPU_MEMORY_HEAP_TYPE_HOST_TO_DEVICE;
-            bufferDescription.usage_modes = bufferDescription.main_usage_mode = AGPU_UNIFORM_BUFFER;
-            bufferDescription.mapping_flags = AGPU_MAP_DYNAMIC_STORAGE_BIT;
-            bufferDescription.stride = sizeof(StateType);
-
-            buffer = agpu::buffer_ref(device->createBuffer(&bufferDescription, nullptr));
-            if(!buffer)
-                return AGPU_OUT_OF_MEMORY;
+        auto &frame = frames[currentFrameIndex];
+        bool hasChanged = false;
+        auto error = frame.storage.ensureCapacity(device, bufferData.size(), sizeof(StateType), AGPU_UNIFORM_BUFFER, hasChanged);
+        if(error)
+            return error;
 
+        if(hasChanged)
+        {
             size_t bindingSize = sizeof(StateType);
             size_t bindingOffset = 0;
-            for(size_t i = 0; i < resourceBindings.size(); ++i)
+            for(size_t i = 0; i < frame.resourceBindings.size(); ++i)
             {
-                resourceBindings[i]->bindUniformBufferRange(0, buffer, bindingOffset, bindingSize);
+                frame.resourceBindings[i]->bindUniformBufferRange(0, frame.storage.buffer, bindingOffset, bindingSize);
                 bindingOffset += bindingSize;
             }
         }
 
-        if(!bufferData.empty())
-        {
-            auto error = buffer->uploadBufferData(0, bufferData.size()*sizeof(StateType), &bufferData[0]);
-            if(error)
-                return error;
-        }
-
-        return AGPU_OK;
+        return frame.storage.write(bufferData.data(), bufferData.size()*sizeof(StateType));
     }
 
     StateType currentState;
     bool dirtyFlag;
 
-    size_t bufferCapacity;
+    size_t currentFrameIndex;
     size_t currentStateIndex;
     std::vector<StateType> bufferData;
     std::unordered_map<StateType, size_t> stateCache;
-    std::vector<agpu::shader_resource_binding_ref> resourceBindings;
+    std::array<FrameStorage, ImmediateRendererFrameCount> frames;
     const agpu::shader_signature_ref &shaderSignature;
-    agpu::buffer_ref buffer;
+};
+
+/**
+ * I hold the streaming resources of one immediate renderer frame. The fence
+ * is signaled in the queue that executes the frame when the next frame
+ * begins, and it is waited before the resources are reused.
+ */
+struct ImmediateRendererFrameResources
+{
+    ImmediateRendererFrameResources()
+        : hasPendingFence(false) {}
+
+    ImmediateStreamingBuffer vertexBuffer;
+    ImmediateStreamingBuffer indexBuffer;
+    agpu::vertex_binding_ref vertexBinding;
+
+    agpu::command_queue_ref commandQueue;
+    agpu::fence_ref fence;
+    bool hasPendingFence;
+};
+
+/**
+ * I am the type of a rendering command that is recorded by the immediate
+ * renderer, and replayed into the state tracker when the rendering ends.
+ */
+enum class ImmediateRenderingCommandType : uint8_t
+{
+    SetBlendState = 0,
+    SetBlendFunction,
+    SetColorMask,
+    SetFrontFace,
+    SetCullMode,
+    SetDepthBias,
+    SetDepthState,
+    SetPolygonMode,
+    SetStencilState,
+    SetStencilFrontFace,
+    SetStencilBackFace,
+    SetViewport,
+    SetScissor,
+    SetStencilReference,
+
+    UseImmediateVertices,
+    UseVertexBinding,
+    UseIndexBuffer,
+
+    DrawArrays,
+    DrawElements,
+};
+
+/**
+ * I am a recorded rendering command. I am a plain value, and the objects that
+ * I use are kept alive by the side tables of the renderer, where I keep their
+ * indices. The draws refer to a recorded rendering state, which is flushed
+ * before drawing.
+ */
+struct ImmediateRenderingCommand
+{
+    ImmediateRenderingCommand(ImmediateRenderingCommandType type)
+        : type(type)
+    {
+        memset(integers, 0, sizeof(integers));
+    }
+
+    ImmediateRenderingCommandType type;
+    union
+    {
+        agpu_int integers[7];
+        agpu_float floats[3];
+
+        struct
+        {
+            uint32_t renderingState;
+            agpu_uint count;
+            agpu_uint instanceCount;
+            agpu_uint first;
+            agpu_int baseVertex;
+            agpu_uint baseInstance;
+        } draw;
+
+        struct
+        {
+            uint32_t index;
+            agpu_size indexSize;
+            agpu_device_size offset;
+        } indexBuffer;
+
+        uint32_t vertexBinding;
+    };
+};
+
+/**
+ * I am an explicit vertex binding that is used by a recorded rendering command.
+ */
+struct ImmediateRecordedVertexBinding
+{
+    agpu::vertex_layout_ref layout;
+    agpu::vertex_binding_ref vertices;
 };
 
 /**
  * I am an immediate renderer that emulates a classic OpenGL style
- * glBegin()/glEnd() rendering interface.
+ * glBegin()/glEnd() rendering interface. My vertices, indices and state
+ * buffers are streamed through a ring of frame resources, which requires the
+ * commands of a frame to be submitted before the next frame begins.
  */
 class ImmediateRenderer : public agpu::immediate_renderer
 {
@@ -722,7 +919,7 @@ public:
     virtual agpu_error beginMeshWithVertices(agpu_size vertexCount, agpu_size stride, agpu_size elementCount, agpu_pointer vertices) override;
     virtual agpu_error beginMeshWithVertexBinding(const agpu::vertex_layout_ref & layout, const agpu::vertex_binding_ref & vertices) override;
     virtual agpu_error useIndexBuffer(const agpu::buffer_ref & index_buffer) override;
-    virtual agpu_error useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_size offset, agpu_size index_size) override;
+    virtual agpu_error useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size) override;
 	virtual agpu_error setCurrentMeshColors(agpu_size stride, agpu_size elementCount, agpu_pointer colors) override;
 	virtual agpu_error setCurrentMeshNormals(agpu_size stride, agpu_size elementCount, agpu_pointer normals) override;
 	virtual agpu_error setCurrentMeshTexCoords(agpu_size stride, agpu_size elementCount, agpu_pointer texcoords) override;
@@ -734,8 +931,6 @@ public:
 
 
 private:
-    typedef std::function<void ()> PendingRenderingCommand;
-
     void applyMatrix(const Matrix4F &matrix);
     void invalidateMatrix();
     agpu_error validateTransformationState();
@@ -750,17 +945,36 @@ private:
     agpu_error flushImmediateVertexRenderingState();
     agpu_error flushRenderingData();
 
+    agpu_error beginFrameResources(const agpu::command_queue_ref &commandQueue);
+    agpu_error retireAllFrameResources();
+
+    ImmediateRendererFrameResources &currentFrameResources()
+    {
+        return frameResources[currentFrameIndex];
+    }
+
     agpu::shader_resource_binding_ref getValidTextureBindingFor(const ImmediateTextureBindingSet &bindingSet);
 
-    template<typename FT>
-    agpu_error delegateToStateTracker(const FT &f)
+    template<typename...Args>
+    agpu_error recordStateTrackerCommand(ImmediateRenderingCommandType type, Args... arguments)
     {
+        static_assert(sizeof...(Args) <= 7, "Too many rendering command arguments.");
         if(!currentStateTracker)
             return AGPU_INVALID_OPERATION;
-        pendingRenderingCommands.push_back(f);
+
+        ImmediateRenderingCommand command(type);
+        agpu_int values[] = {agpu_int(arguments)...};
+        for(size_t i = 0; i < sizeof...(Args); ++i)
+            command.integers[i] = values[i];
+        pendingRenderingCommands.push_back(command);
         return AGPU_OK;
     }
 
+    uint32_t recordRenderingState(const ImmediateRenderingState &state);
+    void recordImmediateVertices();
+    void recordDraw(ImmediateRenderingCommandType type, uint32_t renderingState, agpu_uint count, agpu_uint instanceCount, agpu_uint first, agpu_int baseVertex, agpu_uint baseInstance);
+    void executeRenderingCommand(const ImmediateRenderingCommand &command);
+
     bool hasMetallicRoughnessLighting() const
     {
         return currentRenderingState.lightingModel == AGPU_IMMEDIATE_RENDERER_LIGHTING_MODEL_METALLIC_ROUGHNESS;
@@ -780,7 +994,11 @@ private:
     ImmediateShaderLibrary *immediateShaderLibrary;
     ImmediateSharedRenderingStates *immediateSharedRenderingStates;
     agpu::vertex_layout_ref immediateVertexLayout;
-    agpu::vertex_binding_ref vertexBinding;
+
+    // Streaming frame resources.
+    std::array<ImmediateRendererFrameResources, ImmediateRendererFrameCount> frameResources;
+    size_t currentFrameIndex;
+    bool hasBegunFrame;
 
     // The rendering state.
     ImmediateRenderingState currentRenderingState;
@@ -789,16 +1007,19 @@ private:
 
     ImmediateRenderingState lastFlushedRenderingState;
     bool haveFlushedRenderingState;
-    std::vector<PendingRenderingCommand> pendingRenderingCommands;
+
+    // The recorded rendering commands.
+    std::vector<ImmediateRenderingCommand> pendingRenderingCommands;
+    std::vector<ImmediateRenderingState> pendingRenderingStates;
+    std::vector<ImmediateRecordedVertexBinding> pendingVertexBindings;
+    std::vector<agpu::buffer_ref> pendingIndexBuffers;
+    uint32_t currentPrimitivesRenderingState;
+    bool hasRecordedImmediateVertices;
 
     // Vertices
-    agpu::buffer_ref vertexBuffer;
-    size_t vertexBufferCapacity;
     std::vector<ImmediateRendererVertex> vertices;
 
     // Indices
-    agpu::buffer_ref indexBuffer;
-    size_t indexBufferCapacity;
     std::vector<uint32_t> indices;
 
     // Immediate mesh
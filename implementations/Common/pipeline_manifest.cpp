@@ -0,0 +1,444 @@
+#include "pipeline_manifest.hpp"
+#include "disk_cache_utils.hpp"
+#include "utility.hpp"
+#include <stdio.h>
+#include <string.h>
+
+namespace AgpuCommon
+{
+
+static const uint32_t PipelineManifestMagic = 0x4d504741; // AGPM
+static const uint32_t PipelineManifestVersion = 1;
+
+enum PipelineManifestEntryKind
+{
+    PipelineManifestGraphicsEntry = 0,
+    PipelineManifestComputeEntry = 1,
+};
+
+struct PipelineManifestHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t payloadSize;
+    uint64_t payloadChecksum;
+};
+
+class PipelineManifestWriter
+{
+public:
+    template<typename T>
+    void write(const T &value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*> (&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeEnum(uint32_t value)
+    {
+        write(value);
+    }
+
+    void writeBool(bool value)
+    {
+        write(uint8_t(value ? 1 : 0));
+    }
+
+    void writeString(const std::string &string)
+    {
+        write(uint32_t(string.size()));
+        data.insert(data.end(), string.begin(), string.end());
+    }
+
+    std::vector<uint8_t> data;
+};
+
+class PipelineManifestReader
+{
+public:
+    PipelineManifestReader(const uint8_t *data, size_t size)
+        : data(data), size(size), position(0), failed(false) {}
+
+    template<typename T>
+    T read()
+    {
+        T result = T();
+        if(size - position < sizeof(T))
+        {
+            failed = true;
+            position = size;
+            return result;
+        }
+
+        memcpy(&result, data + position, sizeof(T));
+        position += sizeof(T);
+        return result;
+    }
+
+    template<typename T>
+    T readEnum()
+    {
+        return T(read<uint32_t> ());
+    }
+
+    bool readBool()
+    {
+        return read<uint8_t> () != 0;
+    }
+
+    std::string readString()
+    {
+        auto stringSize = read<uint32_t> ();
+        if(size - position < stringSize)
+        {
+            failed = true;
+            position = size;
+            return std::string();
+        }
+
+        std::string result(reinterpret_cast<const char*> (data + position), stringSize);
+        position += stringSize;
+        return result;
+    }
+
+    bool atEnd() const
+    {
+        return position >= size;
+    }
+
+    const uint8_t *data;
+    size_t size;
+    size_t position;
+    bool failed;
+};
+
+static uint64_t keyForName(const char *name)
+{
+    auto result = hashBytes(name, strlen(name));
+    return result ? result : 1;
+}
+
+static bool writeShaderStage(PipelineManifestWriter &writer, const PipelineManifest &manifest, const ShaderStageDescription &stage)
+{
+    uint64_t shaderKey;
+    if(!manifest.shaders.keyOf(stage.shader, shaderKey))
+        return false;
+
+    writer.write(shaderKey);
+    writer.writeString(stage.entryPoint);
+    return true;
+}
+
+static bool readShaderStage(PipelineManifestReader &reader, const PipelineManifest &manifest, ShaderStageDescription &stage)
+{
+    auto shaderKey = reader.read<uint64_t> ();
+    stage.entryPoint = reader.readString();
+    return manifest.shaders.objectFor(shaderKey, stage.shader);
+}
+
+static bool writeGraphicsPipeline(PipelineManifestWriter &writer, const PipelineManifest &manifest, const GraphicsPipelineStateDescription &description)
+{
+    uint64_t shaderSignatureKey;
+    uint64_t vertexLayoutKey;
+    if(!manifest.shaderSignatures.keyOf(description.shaderSignature, shaderSignatureKey) ||
+       !manifest.vertexLayouts.keyOf(description.vertexLayout, vertexLayoutKey))
+        return false;
+
+    writer.write(shaderSignatureKey);
+    if(!writeShaderStage(writer, manifest, description.vertexStage) ||
+       !writeShaderStage(writer, manifest, description.fragmentStage) ||
+       !writeShaderStage(writer, manifest, description.geometryStage) ||
+       !writeShaderStage(writer, manifest, description.tessellationControlStage) ||
+       !writeShaderStage(writer, manifest, description.tessellationEvaluationStage))
+        return false;
+
+    // Color attachments
+    writer.write(uint32_t(description.renderTargetColorAttachmentCount));
+    for(size_t i = 0; i < description.renderTargetColorAttachmentCount; ++i)
+    {
+        auto &attachment = description.renderTargetColorAttachments[i];
+        writer.writeEnum(attachment.textureFormat);
+        writer.writeBool(attachment.blendingEnabled);
+        writer.writeEnum(attachment.sourceColorBlendingFactor);
+        writer.writeEnum(attachment.destColorBlendingFactor);
+        writer.writeEnum(attachment.colorBlendingOperation);
+        writer.writeEnum(attachment.sourceAlphaBlendingFactor);
+        writer.writeEnum(attachment.destAlphaBlendingFactor);
+        writer.writeEnum(attachment.alphaBlendingOperation);
+        writer.writeBool(attachment.redColorMask);
+        writer.writeBool(attachment.greenColorMask);
+        writer.writeBool(attachment.blueColorMask);
+        writer.writeBool(attachment.alphaColorMask);
+    }
+
+    // Depth stencil.
+    writer.writeEnum(description.depthStencilFormat);
+
+    writer.writeBool(description.depthTestingEnabled);
+    writer.writeBool(description.depthWriteMask);
+    writer.writeEnum(description.depthCompareFunction);
+
+    writer.writeBool(description.depthBiasEnabled);
+    writer.write(description.depthBiasConstantFactor);
+    writer.write(description.depthBiasClamp);
+    writer.write(description.depthBiasSlopeFactor);
+
+    writer.write(description.stencilTestingEnabled);
+    writer.write(description.stencilWriteMask);
+    writer.write(description.stencilReadMask);
+
+    writer.writeEnum(description.frontStencilFailOperation);
+    writer.writeEnum(description.frontStencilDepthFailOperation);
+    writer.writeEnum(description.frontStencilDepthPassOperation);
+    writer.writeEnum(description.frontStencilCompareFunction);
+
+    writer.writeEnum(description.backStencilFailOperation);
+    writer.writeEnum(description.backStencilDepthFailOperation);
+    writer.writeEnum(description.backStencilDepthPassOperation);
+    writer.writeEnum(description.backStencilCompareFunction);
+
+    // Face culling
+    writer.writeEnum(description.frontFaceWinding);
+    writer.writeEnum(description.faceCullingMode);
+
+    // Rasterization
+    writer.writeEnum(description.polygonMode);
+    writer.writeEnum(description.primitiveType);
+    writer.write(vertexLayoutKey);
+    writer.write(description.sampleCount);
+    writer.write(description.sampleQuality);
+    return true;
+}
+
+static bool readGraphicsPipeline(PipelineManifestReader &reader, const PipelineManifest &manifest, GraphicsPipelineStateDescription &description)
+{
+    description.reset();
+
+    auto isResolved = manifest.shaderSignatures.objectFor(reader.read<uint64_t> (), description.shaderSignature);
+    isResolved = readShaderStage(reader, manifest, description.vertexStage) && isResolved;
+    isResolved = readShaderStage(reader, manifest, description.fragmentStage) && isResolved;
+    isResolved = readShaderStage(reader, manifest, description.geometryStage) && isResolved;
+    isResolved = readShaderStage(reader, manifest, description.tessellationControlStage) && isResolved;
+    isResolved = readShaderStage(reader, manifest, description.tessellationEvaluationStage) && isResolved;
+
+    // Color attachments
+    description.renderTargetColorAttachmentCount = reader.read<uint32_t> ();
+    if(description.renderTargetColorAttachmentCount > GraphicsPipelineStateDescription::MaxRenderTargetAttachmentCount)
+    {
+        reader.failed = true;
+        return false;
+    }
+
+    for(size_t i = 0; i < description.renderTargetColorAttachmentCount; ++i)
+    {
+        auto &attachment = description.renderTargetColorAttachments[i];
+        attachment.textureFormat = reader.readEnum<agpu_texture_format> ();
+        attachment.blendingEnabled = reader.readBool();
+        attachment.sourceColorBlendingFactor = reader.readEnum<agpu_blending_factor> ();
+        attachment.destColorBlendingFactor = reader.readEnum<agpu_blending_factor> ();
+        attachment.colorBlendingOperation = reader.readEnum<agpu_blending_operation> ();
+        attachment.sourceAlphaBlendingFactor = reader.readEnum<agpu_blending_factor> ();
+        attachment.destAlphaBlendingFactor = reader.readEnum<agpu_blending_factor> ();
+        attachment.alphaBlendingOperation = reader.readEnum<agpu_blending_operation> ();
+        attachment.redColorMask = reader.readBool();
+        attachment.greenColorMask = reader.readBool();
+        attachment.blueColorMask = reader.readBool();
+        attachment.alphaColorMask = reader.readBool();
+    }
+
+    // Depth stencil.
+    description.depthStencilFormat = reader.readEnum<agpu_texture_format> ();
+
+    description.depthTestingEnabled = reader.readBool();
+    description.depthWriteMask = reader.readBool();
+    description.depthCompareFunction = reader.readEnum<agpu_compare_function> ();
+
+    description.depthBiasEnabled = reader.readBool();
+    description.depthBiasConstantFactor = reader.read<agpu_float> ();
+    description.depthBiasClamp = reader.read<agpu_float> ();
+    description.depthBiasSlopeFactor = reader.read<agpu_float> ();
+
+    description.stencilTestingEnabled = reader.read<agpu_bool> ();
+    description.stencilWriteMask = reader.read<agpu_int> ();
+    description.stencilReadMask = reader.read<agpu_int> ();
+
+    description.frontStencilFailOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.frontStencilDepthFailOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.frontStencilDepthPassOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.frontStencilCompareFunction = reader.readEnum<agpu_compare_function> ();
+
+    description.backStencilFailOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.backStencilDepthFailOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.backStencilDepthPassOperation = reader.readEnum<agpu_stencil_operation> ();
+    description.backStencilCompareFunction = reader.readEnum<agpu_compare_function> ();
+
+    // Face culling
+    description.frontFaceWinding = reader.readEnum<agpu_face_winding> ();
+    description.faceCullingMode = reader.readEnum<agpu_cull_mode> ();
+
+    // Rasterization
+    description.polygonMode = reader.readEnum<agpu_polygon_mode> ();
+    description.primitiveType = reader.readEnum<agpu_primitive_topology> ();
+    isResolved = manifest.vertexLayouts.objectFor(reader.read<uint64_t> (), description.vertexLayout) && isResolved;
+    description.sampleCount = reader.read<agpu_uint> ();
+    description.sampleQuality = reader.read<agpu_uint> ();
+    return isResolved;
+}
+
+static bool writeComputePipeline(PipelineManifestWriter &writer, const PipelineManifest &manifest, const ComputePipelineStateDescription &description)
+{
+    uint64_t shaderSignatureKey;
+    if(!manifest.shaderSignatures.keyOf(description.shaderSignature, shaderSignatureKey))
+        return false;
+
+    writer.write(shaderSignatureKey);
+    return writeShaderStage(writer, manifest, description.computeStage);
+}
+
+static bool readComputePipeline(PipelineManifestReader &reader, const PipelineManifest &manifest, ComputePipelineStateDescription &description)
+{
+    description.reset();
+
+    auto isResolved = manifest.shaderSignatures.objectFor(reader.read<uint64_t> (), description.shaderSignature);
+    return readShaderStage(reader, manifest, description.computeStage) && isResolved;
+}
+
+void PipelineManifest::registerShader(const agpu::shader_ref &shader, const void *content, size_t contentSize)
+{
+    auto key = hashBytes(content, contentSize);
+    shaders.set(shader, key ? key : 1);
+}
+
+void PipelineManifest::registerShaderSignature(const agpu::shader_signature_ref &shaderSignature, const char *name)
+{
+    shaderSignatures.set(shaderSignature, keyForName(name));
+}
+
+void PipelineManifest::registerVertexLayout(const agpu::vertex_layout_ref &vertexLayout, const char *name)
+{
+    vertexLayouts.set(vertexLayout, keyForName(name));
+}
+
+bool PipelineManifest::writeToFile(const char *fileName,
+    const std::vector<GraphicsPipelineStateDescription> &graphicsPipelines,
+    const std::vector<ComputePipelineStateDescription> &computePipelines) const
+{
+    PipelineManifestWriter payload;
+    PipelineManifestWriter entry;
+    uint32_t entryCount = 0;
+
+    auto appendEntry = [&](uint8_t kind) {
+        payload.write(kind);
+        payload.write(uint32_t(entry.data.size()));
+        payload.data.insert(payload.data.end(), entry.data.begin(), entry.data.end());
+        ++entryCount;
+    };
+
+    for(auto &description : graphicsPipelines)
+    {
+        entry.data.clear();
+        if(writeGraphicsPipeline(entry, *this, description))
+            appendEntry(PipelineManifestGraphicsEntry);
+    }
+
+    for(auto &description : computePipelines)
+    {
+        entry.data.clear();
+        if(writeComputePipeline(entry, *this, description))
+            appendEntry(PipelineManifestComputeEntry);
+    }
+
+    PipelineManifestHeader header = {};
+    header.magic = PipelineManifestMagic;
+    header.version = PipelineManifestVersion;
+    header.entryCount = entryCount;
+    header.payloadSize = payload.data.size();
+    header.payloadChecksum = hashBytes(payload.data.data(), payload.data.size());
+
+    auto file = fopen(fileName, "wb");
+    if(!file)
+        return false;
+
+    auto success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        (payload.data.empty() || fwrite(payload.data.data(), payload.data.size(), 1, file) == 1);
+    return fclose(file) == 0 && success;
+}
+
+bool PipelineManifest::readFromFile(const char *fileName,
+    std::vector<GraphicsPipelineStateDescription> &graphicsPipelines,
+    std::vector<ComputePipelineStateDescription> &computePipelines,
+    size_t &unresolvedEntryCount) const
+{
+    unresolvedEntryCount = 0;
+
+    auto file = fopen(fileName, "rb");
+    if(!file)
+        return false;
+
+    PipelineManifestHeader header;
+    std::vector<uint8_t> payload;
+    auto success = fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == PipelineManifestMagic &&
+        header.version == PipelineManifestVersion;
+    if(success)
+    {
+        // Do not trust the payload size before allocating for it.
+        auto remainingSize = getRemainingFileSize(file);
+        success = remainingSize >= 0 && header.payloadSize <= uint64_t(remainingSize);
+    }
+    if(success)
+    {
+        payload.resize(size_t(header.payloadSize));
+        success = payload.empty() || fread(payload.data(), payload.size(), 1, file) == 1;
+    }
+    fclose(file);
+
+    if(!success || hashBytes(payload.data(), payload.size()) != header.payloadChecksum)
+        return false;
+
+    PipelineManifestReader reader(payload.data(), payload.size());
+    for(uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        auto kind = reader.read<uint8_t> ();
+        auto entrySize = reader.read<uint32_t> ();
+        if(reader.failed || reader.size - reader.position < entrySize)
+            return false;
+
+        PipelineManifestReader entryReader(reader.data + reader.position, entrySize);
+        reader.position += entrySize;
+
+        bool isResolved = false;
+        switch(kind)
+        {
+        case PipelineManifestGraphicsEntry:
+            {
+                GraphicsPipelineStateDescription description;
+                isResolved = readGraphicsPipeline(entryReader, *this, description);
+                if(isResolved && !entryReader.failed)
+                    graphicsPipelines.push_back(description);
+            }
+            break;
+        case PipelineManifestComputeEntry:
+            {
+                ComputePipelineStateDescription description;
+                isResolved = readComputePipeline(entryReader, *this, description);
+                if(isResolved && !entryReader.failed)
+                    computePipelines.push_back(description);
+            }
+            break;
+        default:
+            break;
+        }
+
+        if(entryReader.failed)
+            return false;
+        if(!isResolved)
+            ++unresolvedEntryCount;
+    }
+
+    return true;
+}
+
+} // End of namespace AgpuCommon
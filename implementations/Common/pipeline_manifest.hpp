@@ -0,0 +1,93 @@
+#ifndef AGPU_COMMON_PIPELINE_MANIFEST_HPP
+#define AGPU_COMMON_PIPELINE_MANIFEST_HPP
+
+#include "state_tracker_cache.hpp"
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace AgpuCommon
+{
+
+/**
+ * I map objects that are referenced by pipeline state descriptions into
+ * stable keys that can be stored in a pipeline manifest. The null object is
+ * always mapped into the key zero.
+ */
+template<typename T>
+class PipelineManifestKeyTable
+{
+public:
+    typedef agpu::ref<T> ObjectRef;
+
+    void set(const ObjectRef &object, uint64_t key)
+    {
+        keys[object] = key;
+        objects[key] = object;
+    }
+
+    bool keyOf(const ObjectRef &object, uint64_t &result) const
+    {
+        result = 0;
+        if(!object)
+            return true;
+
+        auto it = keys.find(object);
+        if(it == keys.end())
+            return false;
+
+        result = it->second;
+        return true;
+    }
+
+    bool objectFor(uint64_t key, ObjectRef &result) const
+    {
+        result.reset();
+        if(key == 0)
+            return true;
+
+        auto it = objects.find(key);
+        if(it == objects.end())
+            return false;
+
+        result = it->second;
+        return true;
+    }
+
+private:
+    std::unordered_map<ObjectRef, uint64_t> keys;
+    std::unordered_map<uint64_t, ObjectRef> objects;
+};
+
+/**
+ * I am a compact binary list of pipeline state descriptions. Shaders are
+ * referenced by the hash of their content, and shader signatures and vertex
+ * layouts by the hash of a name given by the application, so that a
+ * manifest written by one process can be replayed by another one.
+ */
+class PipelineManifest
+{
+public:
+    PipelineManifestKeyTable<agpu::shader> shaders;
+    PipelineManifestKeyTable<agpu::shader_signature> shaderSignatures;
+    PipelineManifestKeyTable<agpu::vertex_layout> vertexLayouts;
+
+    void registerShader(const agpu::shader_ref &shader, const void *content, size_t contentSize);
+    void registerShaderSignature(const agpu::shader_signature_ref &shaderSignature, const char *name);
+    void registerVertexLayout(const agpu::vertex_layout_ref &vertexLayout, const char *name);
+
+    // Writes the descriptions whose referenced objects have all been registered.
+    bool writeToFile(const char *fileName,
+        const std::vector<GraphicsPipelineStateDescription> &graphicsPipelines,
+        const std::vector<ComputePipelineStateDescription> &computePipelines) const;
+
+    // Reads the descriptions whose referenced objects have all been registered.
+    bool readFromFile(const char *fileName,
+        std::vector<GraphicsPipelineStateDescription> &graphicsPipelines,
+        std::vector<ComputePipelineStateDescription> &computePipelines,
+        size_t &unresolvedEntryCount) const;
+};
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_PIPELINE_MANIFEST_HPP
@@ -0,0 +1,121 @@
+#include "shader_variant_cache.hpp"
+#include "disk_cache_utils.hpp"
+#include "utility.hpp"
+#include <string.h>
+
+namespace AgpuCommon
+{
+
+static const uint32_t ShaderVariantFileMagic = 0x56534741; // AGSV
+static const uint32_t ShaderVariantFileVersion = 1;
+static const uint64_t ShaderVariantMaxCodeSize = 64*1024*1024;
+
+/**
+ * Header that precedes the SPIR-V code in a shader variant file.
+ */
+struct ShaderVariantFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t codeSize;
+    uint64_t codeChecksum;
+};
+
+ShaderVariantDiskCache::ShaderVariantDiskCache()
+    : directory(getStringFromEnvironment("AGPU_PIPELINE_CACHE_DIR"))
+{
+}
+
+ShaderVariantDiskCache::~ShaderVariantDiskCache()
+{
+}
+
+void ShaderVariantDiskCache::setDirectory(const std::string &newDirectory)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    directory = newDirectory;
+}
+
+bool ShaderVariantDiskCache::isEnabled()
+{
+    std::unique_lock<std::mutex> l(mutex);
+    return !directory.empty();
+}
+
+std::string ShaderVariantDiskCache::fileNameFor(uint64_t key)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    if(directory.empty())
+        return std::string();
+
+    char baseName[64];
+    snprintf(baseName, sizeof(baseName), "agpu-shader-variant-%016llx.spv", (unsigned long long)key);
+
+    auto result = directory;
+    if(result.back() != '/' && result.back() != '\\')
+        result += '/';
+    result += baseName;
+    return result;
+}
+
+bool ShaderVariantDiskCache::load(uint64_t key, std::vector<uint32_t> &spirv)
+{
+    spirv.clear();
+
+    auto fileName = fileNameFor(key);
+    if(fileName.empty())
+        return false;
+
+    auto file = fopen(fileName.c_str(), "rb");
+    if(!file)
+        return false;
+
+    ShaderVariantFileHeader header;
+    auto isValid = fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == ShaderVariantFileMagic &&
+        header.version == ShaderVariantFileVersion &&
+        header.key == key &&
+        header.codeSize > 0 && header.codeSize % 4 == 0 &&
+        header.codeSize <= ShaderVariantMaxCodeSize;
+    if(isValid)
+    {
+        // Do not trust the code size before allocating for it.
+        auto remainingSize = getRemainingFileSize(file);
+        isValid = remainingSize >= 0 && header.codeSize <= uint64_t(remainingSize);
+    }
+    if(isValid)
+    {
+        spirv.resize(size_t(header.codeSize / 4));
+        isValid = fread(spirv.data(), size_t(header.codeSize), 1, file) == 1 &&
+            hashBytes(spirv.data(), size_t(header.codeSize)) == header.codeChecksum;
+    }
+    fclose(file);
+
+    if(!isValid)
+    {
+        printError("Ignoring stale or corrupted shader variant %s\n", fileName.c_str());
+        spirv.clear();
+    }
+
+    return isValid;
+}
+
+bool ShaderVariantDiskCache::store(uint64_t key, const std::vector<uint32_t> &spirv)
+{
+    auto fileName = fileNameFor(key);
+    if(fileName.empty() || spirv.empty())
+        return false;
+
+    ShaderVariantFileHeader header = {};
+    header.magic = ShaderVariantFileMagic;
+    header.version = ShaderVariantFileVersion;
+    header.key = key;
+    header.codeSize = spirv.size()*4;
+    header.codeChecksum = hashBytes(spirv.data(), spirv.size()*4);
+
+    return writeFileAtomically(fileName, &header, sizeof(header),
+        spirv.data(), spirv.size()*4, "shader variant file", printError);
+}
+
+} // End of namespace AgpuCommon
@@ -0,0 +1,42 @@
+#ifndef AGPU_COMMON_SHADER_VARIANT_CACHE_HPP
+#define AGPU_COMMON_SHADER_VARIANT_CACHE_HPP
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AgpuCommon
+{
+
+/**
+ * I am an on-disk cache of compiled SPIR-V shader variants. Each variant is
+ * stored in its own file, which is named after a key that the client computes
+ * from the complete shader source, so that a change in the source or in the
+ * variant options produces a different file. Files are written into a
+ * temporary file that atomically replaces the old one, so that several
+ * processes can share the same directory.
+ */
+class ShaderVariantDiskCache
+{
+public:
+    ShaderVariantDiskCache();
+    ~ShaderVariantDiskCache();
+
+    // The environment variable AGPU_PIPELINE_CACHE_DIR is used by default.
+    void setDirectory(const std::string &newDirectory);
+    bool isEnabled();
+
+    bool load(uint64_t key, std::vector<uint32_t> &spirv);
+    bool store(uint64_t key, const std::vector<uint32_t> &spirv);
+
+private:
+    std::string fileNameFor(uint64_t key);
+
+    std::mutex mutex;
+    std::string directory;
+};
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_SHADER_VARIANT_CACHE_HPP
@@ -1,4 +1,5 @@
 #include "state_tracker.hpp"
+#include <algorithm>
 
 namespace AgpuCommon
 {
@@ -12,6 +13,9 @@ AbstractStateTracker::AbstractStateTracker(const agpu::state_tracker_cache_ref &
     isRecording = false;
 	isGraphicsPipelineDescriptionChanged = true;
 	isComputePipelineDescriptionChanged = true;
+    isAsynchronousPipelineCompilationEnabled = false;
+    deferredDrawCount = 0;
+    skippedDrawCount = 0;
 }
 
 AbstractStateTracker::~AbstractStateTracker()
@@ -37,6 +41,8 @@ agpu_error AbstractStateTracker::endRecordingAndFlushCommands()
 agpu_error AbstractStateTracker::reset()
 {
     pipelineBuildErrorLog.clear();
+    deferredDrawCount = 0;
+    skippedDrawCount = 0;
 
     auto error = resetGraphicsPipeline();
     if(error) return error;
@@ -75,7 +81,7 @@ agpu_error AbstractStateTracker::validateComputePipelineState()
 agpu_error AbstractStateTracker::resetGraphicsPipeline()
 {
     graphicsPipelineStateDescription.reset();
-    invalidateGraphicsPipelineState();
+    invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -84,10 +90,20 @@ void AbstractStateTracker::invalidateGraphicsPipelineState()
     isGraphicsPipelineDescriptionChanged = true;
 }
 
-agpu_error AbstractStateTracker::validateGraphicsPipelineState()
+void AbstractStateTracker::invalidateGraphicsPipelineStateDescription()
 {
+    graphicsPipelineStateDescription.invalidateHash();
+    invalidateGraphicsPipelineState();
+}
+
+agpu_error AbstractStateTracker::validateGraphicsPipelineState(bool &isDrawSkipped)
+{
+    isDrawSkipped = false;
     if(!isGraphicsPipelineDescriptionChanged) return AGPU_OK;
 
+    if(isAsynchronousPipelineCompilationEnabled)
+        return validateGraphicsPipelineStateAsynchronously(isDrawSkipped);
+
     auto pipelineState = cache.as<StateTrackerCache> ()->getGraphicsPipelineWithDescription(graphicsPipelineStateDescription, pipelineBuildErrorLog);
     if(!pipelineState)
         return AGPU_LINKING_ERROR;
@@ -98,6 +114,58 @@ agpu_error AbstractStateTracker::validateGraphicsPipelineState()
     return AGPU_OK;
 }
 
+agpu_error AbstractStateTracker::validateGraphicsPipelineStateAsynchronously(bool &isDrawSkipped)
+{
+    agpu::pipeline_state_ref pipelineState;
+    auto status = cache.as<StateTrackerCache> ()->requestGraphicsPipelineWithDescription(graphicsPipelineStateDescription, pipelineState, pipelineBuildErrorLog);
+    if(status == PipelineStateRequestStatus::Failed)
+        return AGPU_LINKING_ERROR;
+
+    if(status == PipelineStateRequestStatus::Ready)
+    {
+        currentCommandList->usePipelineState(pipelineState);
+        isGraphicsPipelineDescriptionChanged = false;
+        invalidateComputePipelineState();
+        return AGPU_OK;
+    }
+
+    // The pipeline is still being built. The description is kept as changed,
+    // so that the next draw looks for it again.
+    if(!fallbackGraphicsPipeline)
+    {
+        isDrawSkipped = true;
+        ++skippedDrawCount;
+        return AGPU_OK;
+    }
+
+    currentCommandList->usePipelineState(fallbackGraphicsPipeline);
+    invalidateComputePipelineState();
+    ++deferredDrawCount;
+    return AGPU_OK;
+}
+
+agpu_error AbstractStateTracker::setAsynchronousPipelineCompilation(agpu_bool enabled)
+{
+    isAsynchronousPipelineCompilationEnabled = enabled != 0;
+    return AGPU_OK;
+}
+
+agpu_error AbstractStateTracker::setFallbackGraphicsPipeline(const agpu::pipeline_state_ref & pipeline)
+{
+    fallbackGraphicsPipeline = pipeline;
+    return AGPU_OK;
+}
+
+agpu_ulong AbstractStateTracker::getDeferredDrawCount()
+{
+    return deferredDrawCount;
+}
+
+agpu_ulong AbstractStateTracker::getSkippedDrawCount()
+{
+    return skippedDrawCount;
+}
+
 agpu_error AbstractStateTracker::setComputeStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(computePipelineStateDescription.computeStage.set(shader, entryPoint))
@@ -113,7 +181,7 @@ agpu_error AbstractStateTracker::setComputeStageWithMain(const agpu::shader_ref
 agpu_error AbstractStateTracker::setVertexStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(graphicsPipelineStateDescription.vertexStage.set(shader, entryPoint))
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -125,7 +193,7 @@ agpu_error AbstractStateTracker::setVertexStageWithMain(const agpu::shader_ref &
 agpu_error AbstractStateTracker::setFragmentStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(graphicsPipelineStateDescription.fragmentStage.set(shader, entryPoint))
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -137,7 +205,7 @@ agpu_error AbstractStateTracker::setFragmentStageWithMain(const agpu::shader_ref
 agpu_error AbstractStateTracker::setGeometryStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(graphicsPipelineStateDescription.geometryStage.set(shader, entryPoint))
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -149,7 +217,7 @@ agpu_error AbstractStateTracker::setGeometryStageWithMain(const agpu::shader_ref
 agpu_error AbstractStateTracker::setTessellationControlStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(graphicsPipelineStateDescription.tessellationControlStage.set(shader, entryPoint))
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -161,7 +229,7 @@ agpu_error AbstractStateTracker::setTessellationControlStageWithMain(const agpu:
 agpu_error AbstractStateTracker::setTessellationEvaluationStage(const agpu::shader_ref & shader, agpu_cstring entryPoint)
 {
     if(graphicsPipelineStateDescription.tessellationEvaluationStage.set(shader, entryPoint))
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -178,7 +246,7 @@ agpu_error AbstractStateTracker::setBlendState(agpu_int renderTargetMask, agpu_b
         attachment.blendingEnabled = enabled;
     });
 
-    if(changed) invalidateGraphicsPipelineState();
+    if(changed) invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -203,7 +271,7 @@ agpu_error AbstractStateTracker::setBlendFunction(agpu_int renderTargetMask, agp
         attachment.alphaBlendingOperation = alphaOperation;
     });
 
-    if(changed) invalidateGraphicsPipelineState();
+    if(changed) invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -223,7 +291,7 @@ agpu_error AbstractStateTracker::setColorMask(agpu_int renderTargetMask, agpu_bo
         attachment.alphaColorMask = alphaEnabled;
     });
 
-    if(changed) invalidateGraphicsPipelineState();
+    if(changed) invalidateGraphicsPipelineStateDescription();
     return AGPU_OK;
 }
 
@@ -232,7 +300,7 @@ agpu_error AbstractStateTracker::setFrontFace(agpu_face_winding winding)
     if(graphicsPipelineStateDescription.frontFaceWinding != winding)
     {
         graphicsPipelineStateDescription.frontFaceWinding = winding;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
 
     return AGPU_OK;
@@ -243,7 +311,7 @@ agpu_error AbstractStateTracker::setCullMode(agpu_cull_mode mode)
     if(graphicsPipelineStateDescription.faceCullingMode != mode)
     {
         graphicsPipelineStateDescription.faceCullingMode = mode;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
 
     return AGPU_OK;
@@ -261,7 +329,7 @@ agpu_error AbstractStateTracker::setDepthBias(agpu_float constant_factor, agpu_f
         graphicsPipelineStateDescription.depthBiasConstantFactor = constant_factor;
         graphicsPipelineStateDescription.depthBiasClamp = clamp;
         graphicsPipelineStateDescription.depthBiasSlopeFactor = slope_factor;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
 
     return AGPU_OK;
@@ -276,7 +344,7 @@ agpu_error AbstractStateTracker::setDepthState(agpu_bool enabled, agpu_bool writ
         graphicsPipelineStateDescription.depthTestingEnabled = enabled;
         graphicsPipelineStateDescription.depthWriteMask = writeMask;
         graphicsPipelineStateDescription.depthCompareFunction = function;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -286,7 +354,7 @@ agpu_error AbstractStateTracker::setPolygonMode(agpu_polygon_mode mode)
     if(graphicsPipelineStateDescription.polygonMode != mode)
     {
         graphicsPipelineStateDescription.polygonMode = mode;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -300,7 +368,7 @@ agpu_error AbstractStateTracker::setStencilState(agpu_bool enabled, agpu_int wri
         graphicsPipelineStateDescription.stencilTestingEnabled = enabled;
         graphicsPipelineStateDescription.stencilWriteMask = writeMask;
         graphicsPipelineStateDescription.stencilReadMask = readMask;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -316,7 +384,7 @@ agpu_error AbstractStateTracker::setStencilFrontFace(agpu_stencil_operation sten
         graphicsPipelineStateDescription.frontStencilDepthFailOperation = depthFailOperation;
         graphicsPipelineStateDescription.frontStencilDepthPassOperation = stencilDepthPassOperation;
         graphicsPipelineStateDescription.frontStencilCompareFunction = stencilFunction;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -332,7 +400,7 @@ agpu_error AbstractStateTracker::setStencilBackFace(agpu_stencil_operation stenc
         graphicsPipelineStateDescription.backStencilDepthFailOperation = depthFailOperation;
         graphicsPipelineStateDescription.backStencilDepthPassOperation = stencilDepthPassOperation;
         graphicsPipelineStateDescription.backStencilCompareFunction = stencilFunction;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -342,7 +410,7 @@ agpu_error AbstractStateTracker::setPrimitiveType(agpu_primitive_topology type)
     if(graphicsPipelineStateDescription.primitiveType != type)
     {
         graphicsPipelineStateDescription.primitiveType = type;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -352,7 +420,7 @@ agpu_error AbstractStateTracker::setVertexLayout(const agpu::vertex_layout_ref &
     if(graphicsPipelineStateDescription.vertexLayout != layout)
     {
         graphicsPipelineStateDescription.vertexLayout = layout;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
 
     return AGPU_OK;
@@ -365,7 +433,7 @@ agpu_error AbstractStateTracker::setShaderSignature(const agpu::shader_signature
     graphicsPipelineStateDescription.shaderSignature = signature;
     computePipelineStateDescription.shaderSignature = signature;
     invalidateComputePipelineState();
-    invalidateGraphicsPipelineState();
+    invalidateGraphicsPipelineStateDescription();
     return currentCommandList->setShaderSignature(signature);
 }
 
@@ -376,7 +444,7 @@ agpu_error AbstractStateTracker::setSampleDescription(agpu_uint sample_count, ag
     {
         graphicsPipelineStateDescription.sampleCount = sample_count;
         graphicsPipelineStateDescription.sampleQuality = sample_quality;
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
     }
     return AGPU_OK;
 }
@@ -406,7 +474,7 @@ agpu_error AbstractStateTracker::useIndexBuffer(const agpu::buffer_ref & index_b
     return currentCommandList->useIndexBuffer(index_buffer);
 }
 
-agpu_error AbstractStateTracker::useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error AbstractStateTracker::useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
     return currentCommandList->useIndexBufferAt(index_buffer, offset, index_size);
@@ -452,18 +520,20 @@ agpu_error AbstractStateTracker::drawArrays(agpu_uint vertex_count, agpu_uint in
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
 
-    auto error = validateGraphicsPipelineState();
-    if(error) return error;
+    bool isDrawSkipped = false;
+    auto error = validateGraphicsPipelineState(isDrawSkipped);
+    if(error || isDrawSkipped) return error;
 
     return currentCommandList->drawArrays(vertex_count, instance_count, first_vertex, base_instance);
 }
 
-agpu_error AbstractStateTracker::drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error AbstractStateTracker::drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
 
-    auto error = validateGraphicsPipelineState();
-    if(error) return error;
+    bool isDrawSkipped = false;
+    auto error = validateGraphicsPipelineState(isDrawSkipped);
+    if(error || isDrawSkipped) return error;
 
     return currentCommandList->drawArraysIndirect(offset, drawcount);
 }
@@ -472,18 +542,20 @@ agpu_error AbstractStateTracker::drawElements(agpu_uint index_count, agpu_uint i
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
 
-    auto error = validateGraphicsPipelineState();
-    if(error) return error;
+    bool isDrawSkipped = false;
+    auto error = validateGraphicsPipelineState(isDrawSkipped);
+    if(error || isDrawSkipped) return error;
 
     return currentCommandList->drawElements(index_count, instance_count, first_index, base_vertex, base_instance);
 }
 
-agpu_error AbstractStateTracker::drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error AbstractStateTracker::drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
 
-    auto error = validateGraphicsPipelineState();
-    if(error) return error;
+    bool isDrawSkipped = false;
+    auto error = validateGraphicsPipelineState(isDrawSkipped);
+    if(error || isDrawSkipped) return error;
 
     return currentCommandList->drawElementsIndirect(offset, drawcount);
 }
@@ -498,7 +570,7 @@ agpu_error AbstractStateTracker::dispatchCompute(agpu_uint group_count_x, agpu_u
     return currentCommandList->dispatchCompute(group_count_x, group_count_y, group_count_z);
 }
 
-agpu_error AbstractStateTracker::dispatchComputeIndirect(agpu_size offset)
+agpu_error AbstractStateTracker::dispatchComputeIndirect(agpu_device_size offset)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
 
@@ -572,7 +644,7 @@ agpu_error AbstractStateTracker::beginRenderPass(const agpu::renderpass_ref & re
     }
 
     if(changed)
-        invalidateGraphicsPipelineState();
+        invalidateGraphicsPipelineStateDescription();
 
     return currentCommandList->beginRenderPass(renderpass, framebuffer, bundle_content);
 }
@@ -607,7 +679,7 @@ agpu_error AbstractStateTracker::memoryBarrier(agpu_pipeline_stage_flags source_
     return currentCommandList->memoryBarrier(source_stage, dest_stage, source_accesses, dest_accesses);
 }
 
-agpu_error AbstractStateTracker::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+agpu_error AbstractStateTracker::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
     return currentCommandList->bufferMemoryBarrier(buffer, source_stage, dest_stage, source_accesses, dest_accesses, offset, size);
@@ -643,7 +715,7 @@ agpu_error AbstractStateTracker::popTextureTransitionBarrier()
     return currentCommandList->popTextureTransitionBarrier();
 }
 
-agpu_error AbstractStateTracker::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+agpu_error AbstractStateTracker::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 {
     if(!currentCommandList) return AGPU_INVALID_OPERATION;
     return currentCommandList->copyBuffer(source_buffer, source_offset, dest_buffer, dest_offset, copy_size);
@@ -667,6 +739,39 @@ agpu_error AbstractStateTracker::copyTexture(const agpu::texture_ref & source_te
     return currentCommandList->copyTexture(source_texture, dest_texture, copy_region);
 }
 
+agpu_error AbstractStateTracker::generateMipmaps(const agpu::texture_ref & texture)
+{
+    if(!currentCommandList) return AGPU_INVALID_OPERATION;
+
+    // The generation may use a compute pipeline of its own.
+    invalidateComputePipelineState();
+    return currentCommandList->generateMipmaps(texture);
+}
+
+agpu_error AbstractStateTracker::resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count)
+{
+    if(!currentCommandList) return AGPU_INVALID_OPERATION;
+    return currentCommandList->resetQueryPool(query_pool, first_query, query_count);
+}
+
+agpu_error AbstractStateTracker::writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    if(!currentCommandList) return AGPU_INVALID_OPERATION;
+    return currentCommandList->writeTimestamp(query_pool, query_index);
+}
+
+agpu_error AbstractStateTracker::beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    if(!currentCommandList) return AGPU_INVALID_OPERATION;
+    return currentCommandList->beginQuery(query_pool, query_index);
+}
+
+agpu_error AbstractStateTracker::endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    if(!currentCommandList) return AGPU_INVALID_OPERATION;
+    return currentCommandList->endQuery(query_pool, query_index);
+}
+
 //==============================================================================
 // DirectStateTracker
 //==============================================================================
@@ -746,12 +851,20 @@ FrameBufferredStateTracker::FrameBufferredStateTracker(const agpu::state_tracker
         const agpu::command_queue_ref &commandQueue,
         agpu_uint frameBufferingCount)
     : AbstractStateTracker(cache, device, type, commandQueue),
-      frameBufferingCount(frameBufferingCount)
+      frameBufferingCount(std::max(frameBufferingCount, 1u)),
+      currentFrameIndex(0),
+      hasUnsignaledFrame(false)
 {
 }
 
 FrameBufferredStateTracker::~FrameBufferredStateTracker()
 {
+    // The command lists cannot be destroyed while they are still in flight.
+    if(hasUnsignaledFrame)
+        signalFrameSlotFence(currentFrameIndex);
+
+    for(agpu_uint i = 0; i < frameBufferingCount; ++i)
+        waitForFrameSlot(i);
 }
 
 agpu::state_tracker_ref FrameBufferredStateTracker::create(const agpu::state_tracker_cache_ref &cache,
@@ -770,6 +883,8 @@ bool FrameBufferredStateTracker::createCommandAllocatorsAndCommandLists()
 {
     commandAllocators.reserve(frameBufferingCount);
     commandLists.reserve(frameBufferingCount);
+    fences.resize(frameBufferingCount);
+    hasPendingFences.resize(frameBufferingCount, false);
     for(size_t i = 0; i < frameBufferingCount; ++i)
     {
         auto allocator = agpu::command_allocator_ref(device->createCommandAllocator(commandListType, commandQueue));
@@ -791,14 +906,80 @@ bool FrameBufferredStateTracker::createCommandAllocatorsAndCommandLists()
     return true;
 }
 
+agpu_error FrameBufferredStateTracker::signalFrameSlotFence(agpu_uint slotIndex)
+{
+    hasUnsignaledFrame = false;
+
+    auto &fence = fences[slotIndex];
+    if(!fence)
+    {
+        fence = agpu::fence_ref(device->createFence());
+        if(!fence)
+            return AGPU_ERROR;
+    }
+
+    auto error = commandQueue->signalFence(fence);
+    if(error) return error;
+
+    hasPendingFences[slotIndex] = true;
+    return AGPU_OK;
+}
+
+agpu_error FrameBufferredStateTracker::waitForFrameSlot(agpu_uint slotIndex)
+{
+    if(!hasPendingFences[slotIndex])
+        return AGPU_OK;
+
+    hasPendingFences[slotIndex] = false;
+    return fences[slotIndex]->waitOnClient();
+}
+
 agpu_error FrameBufferredStateTracker::setupCommandListForRecordingCommands()
 {
-    return AGPU_UNIMPLEMENTED;
+    // The previous frame has been submitted by the client at this point.
+    if(hasUnsignaledFrame)
+    {
+        auto error = signalFrameSlotFence(currentFrameIndex);
+        if(error) return error;
+    }
+
+    // Rotate into the next slot, and wait for it only if it is in flight.
+    currentFrameIndex = (currentFrameIndex + 1) % frameBufferingCount;
+    auto error = waitForFrameSlot(currentFrameIndex);
+    if(error) return error;
+
+    // The whole memory of the frame is released at once with the allocator.
+    auto &commandAllocator = commandAllocators[currentFrameIndex];
+    error = commandAllocator->reset();
+    if(error) return error;
+
+    auto &commandList = commandLists[currentFrameIndex];
+    error = commandList->reset(commandAllocator, agpu::pipeline_state_ref());
+    if(error) return error;
+
+    currentCommandList = commandList;
+    return AGPU_OK;
+}
+
+agpu_error FrameBufferredStateTracker::endRecordingAndFlushCommands()
+{
+    auto error = AbstractStateTracker::endRecordingAndFlushCommands();
+    if(error) return error;
+
+    return signalFrameSlotFence(currentFrameIndex);
 }
 
 agpu::command_list_ptr FrameBufferredStateTracker::endRecordingCommands()
 {
-    return nullptr;
+    if(!currentCommandList)
+        return nullptr;
+
+    auto error = currentCommandList->close();
+    auto result = currentCommandList.disown();
+    if(error) return nullptr;
+
+    hasUnsignaledFrame = true;
+    return result;
 }
 
 } // End of namespace AgpuCommon
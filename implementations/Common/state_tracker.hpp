@@ -65,7 +65,7 @@ public:
 	virtual agpu_error setScissor(agpu_int x, agpu_int y, agpu_int w, agpu_int h) override;
 	virtual agpu_error useVertexBinding(const agpu::vertex_binding_ref & vertex_binding) override;
 	virtual agpu_error useIndexBuffer(const agpu::buffer_ref & index_buffer) override;
-	virtual agpu_error useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_size offset, agpu_size index_size) override;
+	virtual agpu_error useIndexBufferAt(const agpu::buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size) override;
 	virtual agpu_error useDrawIndirectBuffer(const agpu::buffer_ref & draw_buffer) override;
 	virtual agpu_error useComputeDispatchIndirectBuffer(const agpu::buffer_ref & buffer) override;
 	virtual agpu_error useShaderResources(const agpu::shader_resource_binding_ref & binding) override;
@@ -73,11 +73,11 @@ public:
 	virtual agpu_error useComputeShaderResources(const agpu::shader_resource_binding_ref & binding) override;
 	virtual agpu_error useComputeShaderResourcesInSlot(const agpu::shader_resource_binding_ref & binding, agpu_uint slot) override;
 	virtual agpu_error drawArrays(agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance) override;
-	virtual agpu_error drawArraysIndirect(agpu_size offset, agpu_size drawcount) override;
+	virtual agpu_error drawArraysIndirect(agpu_device_size offset, agpu_size drawcount) override;
 	virtual agpu_error drawElements(agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance) override;
-	virtual agpu_error drawElementsIndirect(agpu_size offset, agpu_size drawcount) override;
+	virtual agpu_error drawElementsIndirect(agpu_device_size offset, agpu_size drawcount) override;
 	virtual agpu_error dispatchCompute(agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z) override;
-	virtual agpu_error dispatchComputeIndirect(agpu_size offset) override;
+	virtual agpu_error dispatchComputeIndirect(agpu_device_size offset) override;
 	virtual agpu_error setStencilReference(agpu_uint reference) override;
 	virtual agpu_error executeBundle(const agpu::command_list_ref & bundle) override;
 	virtual agpu_error beginRenderPass(const agpu::renderpass_ref & renderpass, const agpu::framebuffer_ref & framebuffer, agpu_bool bundle_content) override;
@@ -86,20 +86,43 @@ public:
 	virtual agpu_error resolveTexture(const agpu::texture_ref & sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, const agpu::texture_ref & destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect) override;
 	virtual agpu_error pushConstants(agpu_uint offset, agpu_uint size, agpu_pointer values) override;
     virtual agpu_error memoryBarrier(agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses) override;
-    virtual agpu_error bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size) override;
     virtual agpu_error textureMemoryBarrier(const agpu::texture_ref & texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) override;
     virtual agpu_error pushBufferTransitionBarrier(const agpu::buffer_ref & buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage) override;
 	virtual agpu_error pushTextureTransitionBarrier(const agpu::texture_ref & texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) override;
     virtual agpu_error popBufferTransitionBarrier() override;
     virtual agpu_error popTextureTransitionBarrier() override;
-    virtual agpu_error copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size) override;
+    virtual agpu_error copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size) override;
     virtual agpu_error copyBufferToTexture(const agpu::buffer_ref & buffer, const agpu::texture_ref & texture, agpu_buffer_image_copy_region* copy_region) override;
     virtual agpu_error copyTextureToBuffer(const agpu::texture_ref & texture, const agpu::buffer_ref & buffer, agpu_buffer_image_copy_region* copy_region) override;
 	virtual agpu_error copyTexture(const agpu::texture_ref & source_texture, const agpu::texture_ref & dest_texture, agpu_image_copy_region* copy_region) override;
+    virtual agpu_error generateMipmaps(const agpu::texture_ref & texture) override;
+
+    // Queries
+    virtual agpu_error resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count) override;
+    virtual agpu_error writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
+    virtual agpu_error beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
+    virtual agpu_error endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
+
+    // Asynchronous pipeline compilation.
+    virtual agpu_error setAsynchronousPipelineCompilation(agpu_bool enabled) override;
+    virtual agpu_error setFallbackGraphicsPipeline(const agpu::pipeline_state_ref & pipeline) override;
+    virtual agpu_ulong getDeferredDrawCount() override;
+    virtual agpu_ulong getSkippedDrawCount() override;
+
+    const agpu::command_queue_ref &getCommandQueue() const
+    {
+        return commandQueue;
+    }
 
 protected:
+    // The first method only forces the pipeline to be bound again. The
+    // changes of the description use the second one, which also drops the
+    // cached hash of the description.
     void invalidateGraphicsPipelineState();
-    agpu_error validateGraphicsPipelineState();
+    void invalidateGraphicsPipelineStateDescription();
+    agpu_error validateGraphicsPipelineState(bool &isDrawSkipped);
+    agpu_error validateGraphicsPipelineStateAsynchronously(bool &isDrawSkipped);
 
     void invalidateComputePipelineState();
     agpu_error validateComputePipelineState();
@@ -122,6 +145,15 @@ protected:
     bool isRecording;
 
     std::string pipelineBuildErrorLog;
+
+    // When the asynchronous pipeline compilation is enabled, a draw whose
+    // pipeline is still being built uses the fallback pipeline instead, or
+    // it is skipped when there is no fallback. The fallback pipeline must be
+    // compatible with the bound shader signature and vertex layout.
+    bool isAsynchronousPipelineCompilationEnabled;
+    agpu::pipeline_state_ref fallbackGraphicsPipeline;
+    agpu_ulong deferredDrawCount;
+    agpu_ulong skippedDrawCount;
 };
 
 /**
@@ -158,7 +190,11 @@ protected:
 };
 
 /**
- * I am an state tracker with support for implicit frame buffering.
+ * I am an state tracker with support for implicit frame buffering. I rotate
+ * through my frame slots, each one with its own command allocator, command
+ * list and fence, so that the next frame can be recorded while the previous
+ * ones are still being executed by the GPU. I only wait for a slot when I
+ * wrap around into it and its frame is still in flight.
  */
 class FrameBufferredStateTracker : public AbstractStateTracker
 {
@@ -176,16 +212,27 @@ public:
             const agpu::command_queue_ref &commandQueue,
             agpu_uint frameBufferingCount);
 
+    virtual agpu_error endRecordingAndFlushCommands() override;
     virtual agpu::command_list_ptr endRecordingCommands() override;
 
 protected:
     virtual agpu_error setupCommandListForRecordingCommands() override;
 
     bool createCommandAllocatorsAndCommandLists();
+    agpu_error signalFrameSlotFence(agpu_uint slotIndex);
+    agpu_error waitForFrameSlot(agpu_uint slotIndex);
 
     agpu_uint frameBufferingCount;
     std::vector<agpu::command_allocator_ref> commandAllocators;
     std::vector<agpu::command_list_ref> commandLists;
+    std::vector<agpu::fence_ref> fences;
+    std::vector<bool> hasPendingFences;
+
+    agpu_uint currentFrameIndex;
+
+    // A command list returned by endRecordingCommands is submitted by the
+    // client, so the fence of its slot is signaled when the next frame begins.
+    bool hasUnsignaledFrame;
 };
 
 
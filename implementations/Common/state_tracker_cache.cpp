@@ -1,6 +1,10 @@
 #include "state_tracker_cache.hpp"
 #include "state_tracker.hpp"
 #include "immediate_renderer.hpp"
+#include "pipeline_manifest.hpp"
+#include "worker_pool.hpp"
+#include "utility.hpp"
+#include <string.h>
 
 #define CHECK_ERROR() if(error) return error
 
@@ -18,6 +22,11 @@ size_t hashOfEnum(uint32_t v)
     return hashOf(v);
 }
 
+static_assert(sizeof(RenderTargetColorAttachmentDescription) == 7*4 + 8, "Render target color attachment descriptions must not have implicit padding.");
+static_assert(sizeof(GraphicsPipelineStateKey) ==
+    22*4 + 4 + 4 + GraphicsPipelineStateKey::MaxRenderTargetAttachmentCount*sizeof(RenderTargetColorAttachmentDescription),
+    "Graphics pipeline state keys must not have implicit padding.");
+
 // ShaderStageDescription
 ShaderStageDescription::ShaderStageDescription()
 {
@@ -73,6 +82,8 @@ void RenderTargetColorAttachmentDescription::reset()
     greenColorMask = true;
     blueColorMask = true;
     alphaColorMask = true;
+
+    memset(padding, 0, sizeof(padding));
 }
 
 agpu_error RenderTargetColorAttachmentDescription::applyToBuilder(agpu_int index, const agpu::pipeline_builder_ref &builder) const
@@ -89,23 +100,7 @@ agpu_error RenderTargetColorAttachmentDescription::applyToBuilder(agpu_int index
 
 bool RenderTargetColorAttachmentDescription::operator==(const RenderTargetColorAttachmentDescription &o) const
 {
-    return
-        textureFormat == o.textureFormat &&
-
-        // Blending
-        blendingEnabled == o.blendingEnabled &&
-        sourceColorBlendingFactor == o.sourceColorBlendingFactor &&
-        destColorBlendingFactor == o.destColorBlendingFactor &&
-        colorBlendingOperation == o.colorBlendingOperation &&
-        sourceAlphaBlendingFactor == o.sourceAlphaBlendingFactor &&
-        destAlphaBlendingFactor == o.destAlphaBlendingFactor &&
-        alphaBlendingOperation == o.alphaBlendingOperation &&
-
-        // Color mask.
-        redColorMask == o.redColorMask &&
-        greenColorMask == o.greenColorMask &&
-        blueColorMask == o.blueColorMask &&
-        alphaColorMask == o.alphaColorMask;
+    return memcmp(this, &o, sizeof(RenderTargetColorAttachmentDescription)) == 0;
 }
 
 size_t RenderTargetColorAttachmentDescription::hash() const
@@ -132,6 +127,7 @@ size_t RenderTargetColorAttachmentDescription::hash() const
 // GraphicsPipelineStateDescription
 GraphicsPipelineStateDescription::GraphicsPipelineStateDescription()
 {
+    reset();
 }
 
 GraphicsPipelineStateDescription::~GraphicsPipelineStateDescription()
@@ -140,6 +136,8 @@ GraphicsPipelineStateDescription::~GraphicsPipelineStateDescription()
 
 void GraphicsPipelineStateDescription::reset()
 {
+    invalidateHash();
+
     shaderSignature.reset();
     vertexStage.reset();
     fragmentStage.reset();
@@ -188,6 +186,8 @@ void GraphicsPipelineStateDescription::reset()
     vertexLayout.reset();
     sampleCount = 1;
     sampleQuality = 0;
+
+    memset(padding, 0, sizeof(padding));
 }
 
 agpu_error GraphicsPipelineStateDescription::applyToBuilder(const agpu::pipeline_builder_ref &builder) const
@@ -239,117 +239,33 @@ agpu_error GraphicsPipelineStateDescription::applyToBuilder(const agpu::pipeline
 
 bool GraphicsPipelineStateDescription::operator==(const GraphicsPipelineStateDescription &o) const
 {
-    auto result =
+    // The key size includes the attachment count, so the memcmp fails
+    // before reading past the attachments that are in use by both sides.
+    return
+        hash() == o.hash() &&
+        memcmp(static_cast<const GraphicsPipelineStateKey*> (this), static_cast<const GraphicsPipelineStateKey*> (&o), keySize()) == 0 &&
+
         shaderSignature == o.shaderSignature &&
         vertexStage == o.vertexStage &&
         fragmentStage == o.fragmentStage &&
         geometryStage == o.geometryStage &&
         tessellationControlStage == o.tessellationControlStage &&
         tessellationEvaluationStage == o.tessellationEvaluationStage &&
-
-        depthStencilFormat == o.depthStencilFormat &&
-
-        // Depth stencil.
-        depthTestingEnabled == o.depthTestingEnabled &&
-        depthWriteMask == o.depthWriteMask &&
-        depthCompareFunction == o.depthCompareFunction &&
-
-        depthBiasEnabled == o.depthBiasEnabled &&
-        depthBiasConstantFactor == o.depthBiasConstantFactor &&
-        depthBiasClamp == o.depthBiasClamp &&
-        depthBiasSlopeFactor == o.depthBiasSlopeFactor &&
-
-        stencilTestingEnabled == o.stencilTestingEnabled &&
-        stencilWriteMask == o.stencilWriteMask &&
-        stencilReadMask == o.stencilReadMask &&
-
-        frontStencilFailOperation == o.frontStencilFailOperation &&
-        frontStencilDepthFailOperation == o.frontStencilDepthFailOperation &&
-        frontStencilDepthPassOperation == o.frontStencilDepthPassOperation &&
-        frontStencilCompareFunction == o.frontStencilCompareFunction &&
-
-        backStencilFailOperation == o.backStencilFailOperation &&
-        backStencilDepthFailOperation == o.backStencilDepthFailOperation &&
-        backStencilDepthPassOperation == o.backStencilDepthPassOperation &&
-        backStencilCompareFunction == o.backStencilCompareFunction &&
-
-        // Face culling
-        frontFaceWinding == o.frontFaceWinding &&
-        faceCullingMode == o.faceCullingMode &&
-
-        // Rasterization
-        polygonMode == o.polygonMode &&
-        primitiveType == o.primitiveType &&
-        vertexLayout == o.vertexLayout &&
-        sampleCount == o.sampleCount &&
-        sampleQuality == o.sampleQuality &&
-
-        renderTargetColorAttachmentCount == o.renderTargetColorAttachmentCount;
-
-    if(!result) return false;
-
-    for(size_t i = 0; i < renderTargetColorAttachmentCount; ++i)
-    {
-        if(!(renderTargetColorAttachments[i] == o.renderTargetColorAttachments[i]))
-            return false;
-    }
-
-    return true;
+        vertexLayout == o.vertexLayout;
 }
 
-size_t GraphicsPipelineStateDescription::hash() const
+size_t GraphicsPipelineStateDescription::computeHash() const
 {
-    auto result =
+    return
+        size_t(hashBytes(static_cast<const GraphicsPipelineStateKey*> (this), keySize())) ^
+
         shaderSignature.hash() ^
         vertexStage.hash() ^
         fragmentStage.hash() ^
         geometryStage.hash() ^
         tessellationControlStage.hash() ^
         tessellationEvaluationStage.hash() ^
-
-        // Depth stencil
-        hashOfEnum(depthStencilFormat) ^
-
-        hashOf(depthTestingEnabled) ^
-        hashOf(depthWriteMask) ^
-        hashOfEnum(depthCompareFunction) ^
-
-        hashOf(depthBiasEnabled) ^
-        hashOf(depthBiasConstantFactor) ^
-        hashOf(depthBiasClamp) ^
-        hashOf(depthBiasSlopeFactor) ^
-
-        hashOf(stencilTestingEnabled) ^
-        hashOf(stencilWriteMask) ^
-        hashOf(stencilReadMask) ^
-
-        hashOfEnum(frontStencilFailOperation) ^
-        hashOfEnum(frontStencilDepthFailOperation) ^
-        hashOfEnum(frontStencilDepthPassOperation) ^
-        hashOfEnum(frontStencilCompareFunction) ^
-
-        hashOfEnum(backStencilFailOperation) ^
-        hashOfEnum(backStencilDepthFailOperation) ^
-        hashOfEnum(backStencilDepthPassOperation) ^
-        hashOfEnum(backStencilCompareFunction) ^
-
-        // Face culling
-        hashOfEnum(frontFaceWinding) ^
-        hashOfEnum(faceCullingMode) ^
-
-        // Rasterization
-        hashOfEnum(polygonMode) ^
-        hashOfEnum(primitiveType) ^
-        vertexLayout.hash() ^
-        hashOf(sampleCount) ^
-        hashOf(sampleQuality) ^
-
-        hashOf(renderTargetColorAttachmentCount);
-
-    for(size_t i = 0; i < renderTargetColorAttachmentCount; ++i)
-        result ^= renderTargetColorAttachments[i].hash();
-
-    return result;
+        vertexLayout.hash();
 }
 
 // ComputePipelineStateDescription
@@ -387,13 +303,16 @@ size_t ComputePipelineStateDescription::hash() const
 
 // StateTrackerCache
 StateTrackerCache::StateTrackerCache(const agpu::device_ref &device, uint32_t queueFamilyType)
-    : device(device), queueFamilyType(queueFamilyType)
+    : device(device), queueFamilyType(queueFamilyType),
+      pipelineManifest(new PipelineManifest())
 {
     immediateRendererObjectsInitialized = false;
+    hasShaderCacheDirectory = false;
 }
 
 StateTrackerCache::~StateTrackerCache()
 {
+    pipelineBuildPool.reset();
 }
 
 agpu::state_tracker_cache_ref StateTrackerCache::create(const agpu::device_ref &device, uint32_t queueFamilyType)
@@ -424,17 +343,16 @@ agpu::immediate_renderer_ptr StateTrackerCache::createImmediateRenderer()
     return ImmediateRenderer::create(refFromThis<agpu::state_tracker_cache> ()).disown();
 }
 
-agpu::pipeline_state_ref StateTrackerCache::getComputePipelineWithDescription(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog)
+agpu::pipeline_state_ref StateTrackerCache::getComputePipelineWithDescription(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog, bool isManifestReplay)
 {
-    std::unique_lock<std::mutex> l(computePipelineStateCacheMutex);
-
-    // Find an existent
-    {
-        auto it = computePipelineStateCache.find(description);
-        if(it != computePipelineStateCache.end())
-            return it->second;
-    }
+    return computePipelineStateCache.getOrBuild(description, pipelineBuildErrorLog, isManifestReplay,
+        [this](const ComputePipelineStateDescription &description, std::string &buildErrorLog) {
+            return buildComputePipeline(description, buildErrorLog);
+        });
+}
 
+agpu::pipeline_state_ref StateTrackerCache::buildComputePipeline(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog)
+{
     // Create the pipeline builder.
     auto builder = agpu::compute_pipeline_builder_ref(device->createComputePipelineBuilder());
     if(!builder)
@@ -465,24 +383,31 @@ agpu::pipeline_state_ref StateTrackerCache::getComputePipelineWithDescription(co
         return agpu::pipeline_state_ref();
     }
 
-    // Store a copy of the PSO.
-    computePipelineStateCache.insert(std::make_pair(description, pso));
-
-    // Return the PSO.
     return pso;
 }
 
-agpu::pipeline_state_ref StateTrackerCache::getGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog)
+agpu::pipeline_state_ref StateTrackerCache::getGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog, bool isManifestReplay)
 {
-    std::unique_lock<std::mutex> l(graphicsPipelineStateCacheMutex);
+    return graphicsPipelineStateCache.getOrBuild(description, pipelineBuildErrorLog, isManifestReplay,
+        [this](const GraphicsPipelineStateDescription &description, std::string &buildErrorLog) {
+            return buildGraphicsPipeline(description, buildErrorLog);
+        });
+}
 
-    // Find an existent
-    {
-        auto it = graphicsPipelineStateCache.find(description);
-        if(it != graphicsPipelineStateCache.end())
-            return it->second;
-    }
+PipelineStateRequestStatus StateTrackerCache::requestGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, agpu::pipeline_state_ref &pipeline, std::string &pipelineBuildErrorLog)
+{
+    auto &buildPool = getPipelineBuildPool();
+    return graphicsPipelineStateCache.getOrScheduleBuild(description, pipeline, pipelineBuildErrorLog,
+        [this](const GraphicsPipelineStateDescription &description, std::string &buildErrorLog) {
+            return buildGraphicsPipeline(description, buildErrorLog);
+        },
+        [&buildPool](const std::function<void ()> &job) {
+            buildPool.addJob(job);
+        });
+}
 
+agpu::pipeline_state_ref StateTrackerCache::buildGraphicsPipeline(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog)
+{
     // Create the pipeline builder.
     auto builder = agpu::pipeline_builder_ref(device->createPipelineBuilder());
     if(!builder)
@@ -513,11 +438,152 @@ agpu::pipeline_state_ref StateTrackerCache::getGraphicsPipelineWithDescription(c
         return agpu::pipeline_state_ref();
     }
 
-    // Store a copy of the PSO.
-    graphicsPipelineStateCache.insert(std::make_pair(description, pso));
-
-    // Return the PSO.
     return pso;
 }
 
+agpu_error StateTrackerCache::registerManifestShader(const agpu::shader_ref &shader, agpu_pointer content, agpu_size content_size)
+{
+    if(!shader || !content) return AGPU_NULL_POINTER;
+
+    std::unique_lock<std::mutex> l(pipelineManifestMutex);
+    pipelineManifest->registerShader(shader, content, content_size);
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::registerManifestShaderSignature(const agpu::shader_signature_ref &shader_signature, agpu_cstring key)
+{
+    if(!shader_signature || !key) return AGPU_NULL_POINTER;
+
+    std::unique_lock<std::mutex> l(pipelineManifestMutex);
+    pipelineManifest->registerShaderSignature(shader_signature, key);
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::registerManifestVertexLayout(const agpu::vertex_layout_ref &vertex_layout, agpu_cstring key)
+{
+    if(!vertex_layout || !key) return AGPU_NULL_POINTER;
+
+    std::unique_lock<std::mutex> l(pipelineManifestMutex);
+    pipelineManifest->registerVertexLayout(vertex_layout, key);
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::savePipelineManifest(agpu_cstring file_name)
+{
+    if(!file_name) return AGPU_NULL_POINTER;
+
+    std::vector<GraphicsPipelineStateDescription> graphicsPipelines;
+    graphicsPipelineStateCache.collectBuiltDescriptions(graphicsPipelines);
+
+    std::vector<ComputePipelineStateDescription> computePipelines;
+    computePipelineStateCache.collectBuiltDescriptions(computePipelines);
+
+    std::unique_lock<std::mutex> l(pipelineManifestMutex);
+    if(!pipelineManifest->writeToFile(file_name, graphicsPipelines, computePipelines))
+        return AGPU_ERROR;
+
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::loadPipelineManifest(agpu_cstring file_name, agpu_uint worker_count)
+{
+    if(!file_name) return AGPU_NULL_POINTER;
+
+    std::vector<GraphicsPipelineStateDescription> graphicsPipelines;
+    std::vector<ComputePipelineStateDescription> computePipelines;
+    size_t unresolvedEntryCount = 0;
+    {
+        std::unique_lock<std::mutex> l(pipelineManifestMutex);
+        if(!pipelineManifest->readFromFile(file_name, graphicsPipelines, computePipelines, unresolvedEntryCount))
+            return AGPU_ERROR;
+    }
+
+    auto &buildPool = getPipelineBuildPool(worker_count);
+
+    // Entries with unregistered objects cannot be replayed. They are
+    // reported as misses when the application requests them.
+    for(auto &description : graphicsPipelines)
+    {
+        buildPool.addJob([this, description] {
+            std::string buildLog;
+            getGraphicsPipelineWithDescription(description, buildLog, true);
+        });
+    }
+
+    for(auto &description : computePipelines)
+    {
+        buildPool.addJob([this, description] {
+            std::string buildLog;
+            getComputePipelineWithDescription(description, buildLog, true);
+        });
+    }
+
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::waitForPipelineManifestReplay()
+{
+    WorkerPool *buildPool = nullptr;
+    {
+        std::unique_lock<std::mutex> l(pipelineBuildPoolMutex);
+        buildPool = pipelineBuildPool.get();
+    }
+
+    if(buildPool)
+        buildPool->waitForPendingJobs();
+    return AGPU_OK;
+}
+
+WorkerPool &StateTrackerCache::getPipelineBuildPool(size_t workerCount)
+{
+    // The worker count is only honoured by the first request that creates the pool.
+    std::unique_lock<std::mutex> l(pipelineBuildPoolMutex);
+    if(!pipelineBuildPool)
+        pipelineBuildPool.reset(new WorkerPool(workerCount));
+    return *pipelineBuildPool;
+}
+
+agpu_ulong StateTrackerCache::getPipelineManifestHitCount()
+{
+    return graphicsPipelineStateCache.getManifestHitCount() + computePipelineStateCache.getManifestHitCount();
+}
+
+agpu_ulong StateTrackerCache::getPipelineManifestMissCount()
+{
+    return graphicsPipelineStateCache.getManifestMissCount() + computePipelineStateCache.getManifestMissCount();
+}
+
+agpu_error StateTrackerCache::setShaderCacheDirectory(agpu_cstring directory)
+{
+    if(!directory) return AGPU_NULL_POINTER;
+
+    std::unique_lock<std::mutex> l(immediateRendererObjectsMutex);
+    shaderCacheDirectory = directory;
+    hasShaderCacheDirectory = true;
+    if(immediateShaderLibrary)
+        immediateShaderLibrary->setCacheDirectory(shaderCacheDirectory);
+    return AGPU_OK;
+}
+
+agpu_error StateTrackerCache::precompileImmediateRendererShaderVariants(agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count)
+{
+    if(variant_count > 0 && !variants) return AGPU_NULL_POINTER;
+    if(!ensureImmediateRendererObjectsExists()) return AGPU_ERROR;
+
+    std::vector<ImmediateShaderCompilationParameters> parameters(variant_count);
+    for(agpu_uint i = 0; i < variant_count; ++i)
+    {
+        auto &variant = variants[i];
+        auto &params = parameters[i];
+        params.flatShading = variant.flat_shading != 0;
+        params.texturingEnabled = variant.texturing_enabled != 0;
+        params.tangentSpaceEnabled = variant.tangent_space_enabled != 0;
+        params.skinningEnabled = variant.skinning_enabled != 0;
+        params.lightingEnabled = variant.lighting_enabled != 0;
+        params.lightingModel = variant.lighting_model;
+    }
+
+    return immediateShaderLibrary->precompileVariants(device, parameters, worker_count);
+}
+
 } // End of namespace AgpuCommon
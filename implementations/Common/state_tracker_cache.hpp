@@ -2,10 +2,17 @@
 #define AGPU_STATE_TRACKER_CACHE_HPP
 
 #include <AGPU/agpu_impl.hpp>
+#include <stddef.h>
+#include <stdint.h>
 #include <unordered_map>
 #include <array>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace AgpuCommon
 {
@@ -46,7 +53,8 @@ struct ShaderStageDescription
 };
 
 /**
- * I am a description for a render target color attachment
+ * I am a description for a render target color attachment. My fields are
+ * laid out without implicit padding, so that I can be compared as raw bytes.
  */
 struct RenderTargetColorAttachmentDescription
 {
@@ -64,13 +72,13 @@ struct RenderTargetColorAttachmentDescription
     agpu_texture_format textureFormat;
 
     // Blending
-    bool blendingEnabled;
     agpu_blending_factor sourceColorBlendingFactor;
     agpu_blending_factor destColorBlendingFactor;
     agpu_blending_operation colorBlendingOperation;
     agpu_blending_factor sourceAlphaBlendingFactor;
     agpu_blending_factor destAlphaBlendingFactor;
     agpu_blending_operation alphaBlendingOperation;
+    bool blendingEnabled;
 
     // Color mask.
     bool redColorMask;
@@ -78,42 +86,27 @@ struct RenderTargetColorAttachmentDescription
     bool blueColorMask;
     bool alphaColorMask;
 
+    uint8_t padding[3];
 };
 
 /**
- * I am a description for a graphics pipeline state.
+ * I am the part of a graphics pipeline state description that is made only
+ * of plain values. My fields are laid out without implicit padding, so that I
+ * can be hashed and compared as raw bytes. The render target color attachments
+ * are the last field, so that the unused ones can be left out.
  */
-struct GraphicsPipelineStateDescription
+struct GraphicsPipelineStateKey
 {
-    GraphicsPipelineStateDescription();
-    ~GraphicsPipelineStateDescription();
-
-    void reset();
-    agpu_error applyToBuilder(const agpu::pipeline_builder_ref &builder) const;
-
-    bool operator==(const GraphicsPipelineStateDescription &o) const;
-    size_t hash() const;
-
-    agpu::shader_signature_ref shaderSignature;
-    ShaderStageDescription vertexStage;
-    ShaderStageDescription fragmentStage;
-    ShaderStageDescription geometryStage;
-    ShaderStageDescription tessellationControlStage;
-    ShaderStageDescription tessellationEvaluationStage;
-
-    // Color attachments
-    static constexpr size_t MaxRenderTargetAttachmentCount = 16;
-    size_t renderTargetColorAttachmentCount;
-    std::array<RenderTargetColorAttachmentDescription, MaxRenderTargetAttachmentCount> renderTargetColorAttachments;
+    size_t keySize() const
+    {
+        return offsetof(GraphicsPipelineStateKey, renderTargetColorAttachments) +
+            renderTargetColorAttachmentCount*sizeof(RenderTargetColorAttachmentDescription);
+    }
 
     // Depth stencil.
     agpu_texture_format depthStencilFormat;
-
-    bool depthTestingEnabled;
-    bool depthWriteMask;
     agpu_compare_function depthCompareFunction;
 
-    bool depthBiasEnabled;
     agpu_float depthBiasConstantFactor;
     agpu_float depthBiasClamp;
     agpu_float depthBiasSlopeFactor;
@@ -139,10 +132,60 @@ struct GraphicsPipelineStateDescription
     // Rasterization
     agpu_polygon_mode polygonMode;
     agpu_primitive_topology primitiveType;
-    agpu::vertex_layout_ref vertexLayout;
     agpu_uint sampleCount;
     agpu_uint sampleQuality;
 
+    bool depthTestingEnabled;
+    bool depthWriteMask;
+    bool depthBiasEnabled;
+    uint8_t padding[1];
+
+    // Color attachments
+    static constexpr size_t MaxRenderTargetAttachmentCount = 16;
+    uint32_t renderTargetColorAttachmentCount;
+    std::array<RenderTargetColorAttachmentDescription, MaxRenderTargetAttachmentCount> renderTargetColorAttachments;
+};
+
+/**
+ * I am a description for a graphics pipeline state. My hash is cached, and it
+ * must be invalidated after changing any of my fields. A lookup compares the
+ * hashes first, then the packed key with a single memcmp, and finally the
+ * referenced objects.
+ */
+struct GraphicsPipelineStateDescription : GraphicsPipelineStateKey
+{
+    GraphicsPipelineStateDescription();
+    ~GraphicsPipelineStateDescription();
+
+    void reset();
+    agpu_error applyToBuilder(const agpu::pipeline_builder_ref &builder) const;
+
+    bool operator==(const GraphicsPipelineStateDescription &o) const;
+
+    size_t hash() const
+    {
+        if(!isHashValid)
+        {
+            cachedHash = computeHash();
+            isHashValid = true;
+        }
+
+        return cachedHash;
+    }
+
+    void invalidateHash()
+    {
+        isHashValid = false;
+    }
+
+    agpu::shader_signature_ref shaderSignature;
+    ShaderStageDescription vertexStage;
+    ShaderStageDescription fragmentStage;
+    ShaderStageDescription geometryStage;
+    ShaderStageDescription tessellationControlStage;
+    ShaderStageDescription tessellationEvaluationStage;
+    agpu::vertex_layout_ref vertexLayout;
+
     template<typename F>
     void renderTargetsMatchingMaskDo(uint32_t renderTargetMask, const F &f)
     {
@@ -155,6 +198,12 @@ struct GraphicsPipelineStateDescription
             f(renderTargetColorAttachments[i]);
         }
     }
+
+private:
+    size_t computeHash() const;
+
+    mutable size_t cachedHash;
+    mutable bool isHashValid;
 };
 
 /**
@@ -203,6 +252,220 @@ namespace AgpuCommon
 {
 class ImmediateShaderLibrary;
 class ImmediateSharedRenderingStates;
+class PipelineManifest;
+class WorkerPool;
+
+/**
+ * I am the result of building a pipeline state object.
+ */
+struct PipelineStateBuildResult
+{
+    agpu::pipeline_state_ref pipeline;
+    std::string buildErrorLog;
+};
+
+/**
+ * I am an entry in the pipeline state cache. My result is shared by every
+ * request that arrives while the pipeline is still being built.
+ */
+struct PipelineStateCacheEntry
+{
+    std::shared_future<PipelineStateBuildResult> result;
+    bool isFromManifest;
+    bool hasBeenRequested;
+};
+
+/**
+ * I am the state of a pipeline that is requested without waiting for it.
+ */
+enum class PipelineStateRequestStatus
+{
+    Ready,
+    Pending,
+    Failed
+};
+
+/**
+ * I am a sharded map from pipeline state descriptions into pipeline state
+ * objects. A shard lock is only held while looking up or inserting an entry,
+ * and the pipeline is built outside of it. Concurrent requests for a pipeline
+ * that is being built wait on the result of the first request. A failed build
+ * keeps its entry, and the next request for it builds the pipeline again.
+ */
+template<typename DT>
+class PipelineStateCache
+{
+public:
+    typedef std::function<agpu::pipeline_state_ref (const DT &, std::string &)> BuildFunction;
+    typedef std::function<void (const std::function<void ()> &)> ScheduleFunction;
+
+    static constexpr size_t ShardCount = 16;
+
+    PipelineStateCache()
+        : manifestHitCount(0), manifestMissCount(0) {}
+
+    agpu::pipeline_state_ref getOrBuild(const DT &description, std::string &pipelineBuildErrorLog, bool isManifestReplay, const BuildFunction &buildFunction)
+    {
+        auto &shard = shardFor(description);
+        std::promise<PipelineStateBuildResult> buildPromise;
+        std::shared_future<PipelineStateBuildResult> result;
+        bool mustBuild = false;
+
+        {
+            std::unique_lock<std::mutex> l(shard.mutex);
+            auto it = shard.entries.find(description);
+            if(it == shard.entries.end())
+            {
+                it = shard.entries.insert(std::make_pair(description, makeEntry(buildPromise, isManifestReplay))).first;
+                mustBuild = true;
+            }
+            else if(isFailedBuild(it->second))
+            {
+                // Try again the builds that have failed before.
+                it->second.result = buildPromise.get_future().share();
+                mustBuild = true;
+            }
+
+            if(!isManifestReplay)
+                countRequest(it->second);
+            result = it->second.result;
+        }
+
+        if(mustBuild)
+            build(description, buildPromise, buildFunction);
+        else if(isManifestReplay)
+        {
+            // The replay only warms the cache. Waiting here for a build that
+            // is queued behind this job in the same pool could deadlock it.
+            return agpu::pipeline_state_ref();
+        }
+
+        auto &buildResult = result.get();
+        if(!buildResult.pipeline)
+            pipelineBuildErrorLog += buildResult.buildErrorLog;
+        return buildResult.pipeline;
+    }
+
+    /**
+     * I return the pipeline if it has already been built. Otherwise, I
+     * schedule its build, if it is not being built yet, and I return
+     * immediately without waiting for it.
+     */
+    PipelineStateRequestStatus getOrScheduleBuild(const DT &description, agpu::pipeline_state_ref &pipeline, std::string &pipelineBuildErrorLog, const BuildFunction &buildFunction, const ScheduleFunction &scheduleFunction)
+    {
+        pipeline.reset();
+
+        auto &shard = shardFor(description);
+        std::shared_future<PipelineStateBuildResult> result;
+        {
+            std::unique_lock<std::mutex> l(shard.mutex);
+            auto it = shard.entries.find(description);
+            if(it == shard.entries.end())
+            {
+                // The promise is shared with the build job, which may outlive this call.
+                auto buildPromise = std::make_shared<std::promise<PipelineStateBuildResult>> ();
+                it = shard.entries.insert(std::make_pair(description, makeEntry(*buildPromise, false))).first;
+                countRequest(it->second);
+                l.unlock();
+
+                scheduleFunction([description, buildPromise, buildFunction] {
+                    build(description, *buildPromise, buildFunction);
+                });
+                return PipelineStateRequestStatus::Pending;
+            }
+
+            countRequest(it->second);
+            result = it->second.result;
+        }
+
+        if(result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return PipelineStateRequestStatus::Pending;
+
+        auto &buildResult = result.get();
+        if(!buildResult.pipeline)
+        {
+            pipelineBuildErrorLog += buildResult.buildErrorLog;
+            return PipelineStateRequestStatus::Failed;
+        }
+
+        pipeline = buildResult.pipeline;
+        return PipelineStateRequestStatus::Ready;
+    }
+
+    void collectBuiltDescriptions(std::vector<DT> &descriptions)
+    {
+        for(auto &shard : shards)
+        {
+            std::unique_lock<std::mutex> l(shard.mutex);
+            for(auto &entry : shard.entries)
+            {
+                auto &result = entry.second.result;
+                if(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready && result.get().pipeline)
+                    descriptions.push_back(entry.first);
+            }
+        }
+    }
+
+    uint64_t getManifestHitCount() const
+    {
+        return manifestHitCount.load();
+    }
+
+    uint64_t getManifestMissCount() const
+    {
+        return manifestMissCount.load();
+    }
+
+private:
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<DT, PipelineStateCacheEntry> entries;
+    };
+
+    Shard &shardFor(const DT &description)
+    {
+        return shards[description.hash() % ShardCount];
+    }
+
+    static PipelineStateCacheEntry makeEntry(std::promise<PipelineStateBuildResult> &buildPromise, bool isFromManifest)
+    {
+        PipelineStateCacheEntry entry;
+        entry.result = buildPromise.get_future().share();
+        entry.isFromManifest = isFromManifest;
+        entry.hasBeenRequested = false;
+        return entry;
+    }
+
+    static bool isFailedBuild(const PipelineStateCacheEntry &entry)
+    {
+        return entry.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+            !entry.result.get().pipeline;
+    }
+
+    static void build(const DT &description, std::promise<PipelineStateBuildResult> &buildPromise, const BuildFunction &buildFunction)
+    {
+        PipelineStateBuildResult buildResult;
+        buildResult.pipeline = buildFunction(description, buildResult.buildErrorLog);
+        buildPromise.set_value(buildResult);
+    }
+
+    void countRequest(PipelineStateCacheEntry &entry)
+    {
+        if(entry.hasBeenRequested)
+            return;
+
+        entry.hasBeenRequested = true;
+        if(entry.isFromManifest)
+            ++manifestHitCount;
+        else
+            ++manifestMissCount;
+    }
+
+    std::array<Shard, ShardCount> shards;
+    std::atomic<uint64_t> manifestHitCount;
+    std::atomic<uint64_t> manifestMissCount;
+};
 
 /**
  * I am a cache for the on the fly generated pipeline state objects that are
@@ -221,8 +484,23 @@ public:
 	virtual agpu::state_tracker_ptr createStateTrackerWithFrameBuffering(agpu_command_list_type type, const agpu::command_queue_ref & command_queue, agpu_uint framebuffering_count) override;
     virtual agpu::immediate_renderer_ptr createImmediateRenderer() override;
 
-    agpu::pipeline_state_ref getComputePipelineWithDescription(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog);
-    agpu::pipeline_state_ref getGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog);
+    // Pipeline warm-up manifest.
+    virtual agpu_error registerManifestShader(const agpu::shader_ref & shader, agpu_pointer content, agpu_size content_size) override;
+    virtual agpu_error registerManifestShaderSignature(const agpu::shader_signature_ref & shader_signature, agpu_cstring key) override;
+    virtual agpu_error registerManifestVertexLayout(const agpu::vertex_layout_ref & vertex_layout, agpu_cstring key) override;
+    virtual agpu_error savePipelineManifest(agpu_cstring file_name) override;
+    virtual agpu_error loadPipelineManifest(agpu_cstring file_name, agpu_uint worker_count) override;
+    virtual agpu_error waitForPipelineManifestReplay() override;
+    virtual agpu_ulong getPipelineManifestHitCount() override;
+    virtual agpu_ulong getPipelineManifestMissCount() override;
+
+    // Immediate renderer shader variants.
+    virtual agpu_error setShaderCacheDirectory(agpu_cstring directory) override;
+    virtual agpu_error precompileImmediateRendererShaderVariants(agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count) override;
+
+    agpu::pipeline_state_ref getComputePipelineWithDescription(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog, bool isManifestReplay = false);
+    agpu::pipeline_state_ref getGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog, bool isManifestReplay = false);
+    PipelineStateRequestStatus requestGraphicsPipelineWithDescription(const GraphicsPipelineStateDescription &description, agpu::pipeline_state_ref &pipeline, std::string &pipelineBuildErrorLog);
 
     agpu::device_ref device;
     uint32_t queueFamilyType;
@@ -235,15 +513,25 @@ public:
     agpu::vertex_layout_ref immediateVertexLayout;
 
 private:
-    std::mutex computePipelineStateCacheMutex;
-    std::unordered_map<ComputePipelineStateDescription, agpu::pipeline_state_ref> computePipelineStateCache;
+    agpu::pipeline_state_ref buildComputePipeline(const ComputePipelineStateDescription &description, std::string &pipelineBuildErrorLog);
+    agpu::pipeline_state_ref buildGraphicsPipeline(const GraphicsPipelineStateDescription &description, std::string &pipelineBuildErrorLog);
+    WorkerPool &getPipelineBuildPool(size_t workerCount = 0);
 
-    std::mutex graphicsPipelineStateCacheMutex;
-    std::unordered_map<GraphicsPipelineStateDescription, agpu::pipeline_state_ref> graphicsPipelineStateCache;
+    PipelineStateCache<ComputePipelineStateDescription> computePipelineStateCache;
+    PipelineStateCache<GraphicsPipelineStateDescription> graphicsPipelineStateCache;
 
     std::mutex immediateRendererObjectsMutex;
     bool immediateRendererObjectsInitialized;
+    std::string shaderCacheDirectory;
+    bool hasShaderCacheDirectory;
+
+    std::mutex pipelineManifestMutex;
+    std::unique_ptr<PipelineManifest> pipelineManifest;
 
+    // The pool runs the manifest replay and the asynchronous pipeline builds.
+    // This is the last member, so that its jobs finish before anything else is destroyed.
+    std::mutex pipelineBuildPoolMutex;
+    std::unique_ptr<WorkerPool> pipelineBuildPool;
 };
 
 } // End of namespace AgpuCommon
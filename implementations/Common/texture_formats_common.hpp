@@ -396,4 +396,26 @@ inline size_t blockHeightOfCompressedTextureFormat(agpu_texture_format format)
     }
 }
 
+inline size_t tightlyPackedPitchOfTextureFormat(agpu_texture_format format, size_t width)
+{
+    if(isCompressedTextureFormat(format))
+    {
+        auto blockWidth = blockWidthOfCompressedTextureFormat(format);
+        return (width + blockWidth - 1) / blockWidth * blockSizeOfCompressedTextureFormat(format);
+    }
+
+    return width * pixelSizeOfTextureFormat(format);
+}
+
+inline size_t tightlyPackedRowCountOfTextureFormat(agpu_texture_format format, size_t height)
+{
+    if(isCompressedTextureFormat(format))
+    {
+        auto blockHeight = blockHeightOfCompressedTextureFormat(format);
+        return (height + blockHeight - 1) / blockHeight;
+    }
+
+    return height;
+}
+
 #endif //AGPU_TEXTURE_FORMATS_COMMON_HPP
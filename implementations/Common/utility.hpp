@@ -1,7 +1,10 @@
 #ifndef AGPU_COMMON_UTILITY_HPP
 #define AGPU_COMMON_UTILITY_HPP
 
+#include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 namespace AgpuCommon
 {
@@ -22,6 +25,28 @@ inline size_t alignedTo(size_t value, size_t alignment)
 {
     return (value + alignment - 1) & size_t(-intptr_t(alignment));
 }
+
+inline uint64_t hashBytes(const void *data, size_t size, uint64_t seed = 0xcbf29ce484222325ull)
+{
+    // FNV-1a
+    auto bytes = reinterpret_cast<const uint8_t*> (data);
+    uint64_t result = seed;
+    for(size_t i = 0; i < size; ++i)
+    {
+        result ^= bytes[i];
+        result *= 0x100000001b3ull;
+    }
+
+    return result;
+}
+
+inline void printError(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
 } // End of namespace AgpuCommon
 
 #endif // AGPU_COMMON_UTILITY_HPP
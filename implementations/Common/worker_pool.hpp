@@ -0,0 +1,108 @@
+#ifndef AGPU_COMMON_WORKER_POOL_HPP
+#define AGPU_COMMON_WORKER_POOL_HPP
+
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+
+namespace AgpuCommon
+{
+
+/**
+ * I am a fixed size pool of threads that process jobs from a shared queue.
+ * Jobs that are still pending when I am destroyed are discarded.
+ */
+class WorkerPool
+{
+public:
+    typedef std::function<void ()> Job;
+
+    explicit WorkerPool(size_t workerCount = 0)
+        : activeJobCount(0), isShuttingDown(false)
+    {
+        if(workerCount == 0)
+            workerCount = defaultWorkerCount();
+
+        workers.reserve(workerCount);
+        for(size_t i = 0; i < workerCount; ++i)
+            workers.push_back(std::thread([this] { workerThreadEntry(); }));
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            isShuttingDown = true;
+            pendingJobs.clear();
+            moreWorkCondition.notify_all();
+        }
+
+        for(auto &worker : workers)
+            worker.join();
+    }
+
+    static size_t defaultWorkerCount()
+    {
+        auto count = std::thread::hardware_concurrency();
+        return count > 1 ? count - 1 : 1;
+    }
+
+    size_t getWorkerCount() const
+    {
+        return workers.size();
+    }
+
+    void addJob(const Job &job)
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        pendingJobs.push_back(job);
+        moreWorkCondition.notify_one();
+    }
+
+    void waitForPendingJobs()
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        while(!pendingJobs.empty() || activeJobCount != 0)
+            idleCondition.wait(l);
+    }
+
+private:
+    void workerThreadEntry()
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        for(;;)
+        {
+            while(!isShuttingDown && pendingJobs.empty())
+                moreWorkCondition.wait(l);
+            if(isShuttingDown)
+                return;
+
+            auto job = std::move(pendingJobs.front());
+            pendingJobs.pop_front();
+            ++activeJobCount;
+
+            l.unlock();
+            job();
+            l.lock();
+
+            --activeJobCount;
+            if(pendingJobs.empty() && activeJobCount == 0)
+                idleCondition.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable moreWorkCondition;
+    std::condition_variable idleCondition;
+    std::deque<Job> pendingJobs;
+    size_t activeJobCount;
+    bool isShuttingDown;
+    std::vector<std::thread> workers;
+};
+
+} // End of namespace AgpuCommon
+
+#endif //AGPU_COMMON_WORKER_POOL_HPP
@@ -112,7 +112,7 @@ agpu_error ADXBuffer::getDescription(agpu_buffer_description* description)
 	return AGPU_OK;
 }
 
-agpu_error ADXBuffer::createVertexBufferView(D3D12_VERTEX_BUFFER_VIEW *outView, agpu_size offset, agpu_size stride)
+agpu_error ADXBuffer::createVertexBufferView(D3D12_VERTEX_BUFFER_VIEW *outView, agpu_device_size offset, agpu_size stride)
 {
     if(offset > description.size)
         return AGPU_OUT_OF_BOUNDS;
@@ -123,7 +123,7 @@ agpu_error ADXBuffer::createVertexBufferView(D3D12_VERTEX_BUFFER_VIEW *outView,
     return AGPU_OK;
 }
 
-agpu_error ADXBuffer::createIndexBufferView(D3D12_INDEX_BUFFER_VIEW *outView, agpu_size offset, agpu_size index_size)
+agpu_error ADXBuffer::createIndexBufferView(D3D12_INDEX_BUFFER_VIEW *outView, agpu_device_size offset, agpu_size index_size)
 {
     if(offset > description.size)
         return AGPU_OUT_OF_BOUNDS;
@@ -135,9 +135,9 @@ agpu_error ADXBuffer::createIndexBufferView(D3D12_INDEX_BUFFER_VIEW *outView, ag
 }
 
 
-agpu_error ADXBuffer::createConstantBufferViewDescription(D3D12_CONSTANT_BUFFER_VIEW_DESC *outView, agpu_size offset, agpu_size size)
+agpu_error ADXBuffer::createConstantBufferViewDescription(D3D12_CONSTANT_BUFFER_VIEW_DESC *outView, agpu_device_size offset, agpu_device_size size)
 {
-    if(offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_OUT_OF_BOUNDS;
 
     outView->BufferLocation = gpuVirtualAddress + offset;
@@ -145,9 +145,9 @@ agpu_error ADXBuffer::createConstantBufferViewDescription(D3D12_CONSTANT_BUFFER_
     return AGPU_OK;
 }
 
-agpu_error ADXBuffer::createUAVDescription(D3D12_UNORDERED_ACCESS_VIEW_DESC *outView, agpu_size offset, agpu_size size)
+agpu_error ADXBuffer::createUAVDescription(D3D12_UNORDERED_ACCESS_VIEW_DESC *outView, agpu_device_size offset, agpu_device_size size)
 {
-    if(offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_OUT_OF_BOUNDS;
 
     memset(outView, 0, sizeof(D3D12_UNORDERED_ACCESS_VIEW_DESC));
@@ -187,14 +187,14 @@ agpu_error ADXBuffer::unmapBuffer()
     return AGPU_OK;
 }
 
-agpu_error ADXBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu_error ADXBuffer::uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     bool canBeSubUpdated = (description.mapping_flags & AGPU_MAP_DYNAMIC_STORAGE_BIT) != 0;
     if (!canBeSubUpdated)
         return AGPU_UNSUPPORTED;
 
     // Check the limits
-    if (offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_ERROR;
 
     // Check the data.
@@ -238,14 +238,34 @@ agpu_error ADXBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_po
     return uploadResult ? AGPU_OK : AGPU_ERROR;
 }
 
-agpu_error ADXBuffer::readBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu::fence_ptr ADXBuffer::uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
+{
+    // The upload is synchronous in this backend, so the fence is signaled right away.
+    auto error = uploadBufferData(offset, size, data);
+    if(error)
+        return nullptr;
+
+    auto device = weakDevice.lock();
+    if(!device)
+        return nullptr;
+
+    auto fence = agpu::fence_ref(device->createFence());
+    if(!fence)
+        return nullptr;
+
+    auto commandQueue = agpu::command_queue_ref(device->getDefaultCommandQueue());
+    commandQueue->signalFence(fence);
+    return fence.disown();
+}
+
+agpu_error ADXBuffer::readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     bool canBeSubReaded = (description.mapping_flags & (AGPU_MAP_DYNAMIC_STORAGE_BIT | AGPU_MAP_READ_BIT)) != 0;
     if (!canBeSubReaded)
         return AGPU_UNSUPPORTED;
 
     // Check the limits
-    if (offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_ERROR;
 
     // Do we have data to upload?
@@ -20,8 +20,9 @@ public:
     virtual agpu_error unmapBuffer() override;
     virtual agpu_error getDescription(agpu_buffer_description* description) override;
 
-    virtual agpu_error uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data) override;
-    virtual agpu_error readBufferData(agpu_size offset, agpu_size size, agpu_pointer data) override;
+    virtual agpu_error uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
+    virtual agpu::fence_ptr uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
+    virtual agpu_error readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
 
     virtual agpu_error flushWholeBuffer() override;
 	virtual agpu_error invalidateWholeBuffer() override;
@@ -34,10 +35,10 @@ public:
     ComPtr<D3D12MA::Allocation> allocation;
 
     D3D12_GPU_VIRTUAL_ADDRESS gpuVirtualAddress;
-    agpu_error createIndexBufferView(D3D12_INDEX_BUFFER_VIEW *outView, agpu_size offset, agpu_size index_size);
-    agpu_error createVertexBufferView(D3D12_VERTEX_BUFFER_VIEW *outView, agpu_size offset, agpu_size stride);
-    agpu_error createConstantBufferViewDescription(D3D12_CONSTANT_BUFFER_VIEW_DESC *outView, agpu_size offset, agpu_size size);
-    agpu_error createUAVDescription(D3D12_UNORDERED_ACCESS_VIEW_DESC *outView, agpu_size offset, agpu_size size);
+    agpu_error createIndexBufferView(D3D12_INDEX_BUFFER_VIEW *outView, agpu_device_size offset, agpu_size index_size);
+    agpu_error createVertexBufferView(D3D12_VERTEX_BUFFER_VIEW *outView, agpu_device_size offset, agpu_size stride);
+    agpu_error createConstantBufferViewDescription(D3D12_CONSTANT_BUFFER_VIEW_DESC *outView, agpu_device_size offset, agpu_device_size size);
+    agpu_error createUAVDescription(D3D12_UNORDERED_ACCESS_VIEW_DESC *outView, agpu_device_size offset, agpu_device_size size);
 
 private:
     agpu_error createView();
@@ -30,4 +30,11 @@ agpu_error ADXCommandAllocator::reset()
     return AGPU_OK;
 }
 
+AgpuCommon::ComputeMipmapGenerator &ADXCommandAllocator::getMipmapGenerator()
+{
+    if(!mipmapGenerator)
+        mipmapGenerator.reset(new AgpuCommon::ComputeMipmapGenerator(device));
+    return *mipmapGenerator;
+}
+
 } // End of namespace AgpuD3D12
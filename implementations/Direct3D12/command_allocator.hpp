@@ -3,6 +3,7 @@
 
 #include "device.hpp"
 #include "command_list.hpp"
+#include <memory>
 
 namespace AgpuD3D12
 {
@@ -17,11 +18,18 @@ public:
 
     agpu_error reset();
 
+    AgpuCommon::ComputeMipmapGenerator &getMipmapGenerator();
+
 public:
 
     agpu::device_ref device;
     agpu_command_list_type type;
     ComPtr<ID3D12CommandAllocator> allocator;
+
+private:
+    // The compute pipelines of the mipmap generation hold a reference to the
+    // device, so they are kept here instead of in the device.
+    std::unique_ptr<AgpuCommon::ComputeMipmapGenerator> mipmapGenerator;
 };
 
 } // End of namespace AgpuD3D12
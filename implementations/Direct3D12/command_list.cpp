@@ -43,6 +43,7 @@ agpu::command_list_ref ADXCommandList::create(const agpu::device_ref &device, ag
     auto adxList = result.as<ADXCommandList> ();
     adxList->type = type;
     adxList->commandList = commandList;
+    adxList->allocator = allocator;
     if (adxList->setCommonState() < 0)
     {
         return agpu::command_list_ref();
@@ -213,7 +214,7 @@ agpu_error ADXCommandList::useIndexBuffer(const agpu::buffer_ref &index_buffer)
     return useIndexBufferAt(index_buffer, 0, adxIndexBuffer->description.stride);
 }
 
-agpu_error ADXCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error ADXCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_device_size offset, agpu_size index_size)
 {
     CHECK_POINTER(index_buffer);
     auto adxIndexBuffer = index_buffer.as<ADXBuffer> ();
@@ -274,7 +275,7 @@ agpu_error ADXCommandList::drawArrays(agpu_uint vertex_count, agpu_uint instance
     return AGPU_OK;
 }
 
-agpu_error ADXCommandList::drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error ADXCommandList::drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     return AGPU_OK;
 }
@@ -285,7 +286,7 @@ agpu_error ADXCommandList::drawElements(agpu_uint index_count, agpu_uint instanc
     return AGPU_OK;
 }
 
-agpu_error ADXCommandList::drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error ADXCommandList::drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     return AGPU_UNIMPLEMENTED;
 }
@@ -296,7 +297,7 @@ agpu_error ADXCommandList::dispatchCompute(agpu_uint group_count_x, agpu_uint gr
     return AGPU_OK;
 }
 
-agpu_error ADXCommandList::dispatchComputeIndirect(agpu_size offset)
+agpu_error ADXCommandList::dispatchComputeIndirect(agpu_device_size offset)
 {
     return AGPU_UNIMPLEMENTED;
 }
@@ -343,6 +344,8 @@ agpu_error ADXCommandList::reset(const agpu::command_allocator_ref &allocator, c
     if (initial_pipeline_state)
 		initial_pipeline_state.as<ADXPipelineState> ()->activatedOnCommandList(commandList);
 
+    this->allocator = allocator;
+    mipmapGenerationResources.clear();
     return setCommonState();
 }
 
@@ -578,7 +581,7 @@ agpu_error ADXCommandList::memoryBarrier(agpu_pipeline_stage_flags source_stage,
 	return AGPU_OK;
 }
 
-agpu_error ADXCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+agpu_error ADXCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 {
 	CHECK_POINTER(buffer);
 	auto adxBuffer = buffer.as<ADXBuffer>();
@@ -666,7 +669,7 @@ agpu_error ADXCommandList::popTextureTransitionBarrier()
     return AGPU_OK;
 }
 
-agpu_error ADXCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+agpu_error ADXCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 {
 	CHECK_POINTER(source_buffer);
 	CHECK_POINTER(dest_buffer);
@@ -801,4 +804,41 @@ agpu_error ADXCommandList::copyTexture(const agpu::texture_ref& source_texture,
     return AGPU_OK;
 }
 
+agpu_error ADXCommandList::generateMipmaps(const agpu::texture_ref& texture)
+{
+    CHECK_POINTER(texture);
+
+    // Direct3D 12 does not have a fixed function mipmap generation, so the
+    // levels are always produced by the compute fallback.
+    agpu::shader_signature_ref oldShaderSignature;
+    if (currentShaderSignature)
+        oldShaderSignature = currentShaderSignature->refFromThis<agpu::shader_signature> ();
+
+    auto &generator = allocator.as<ADXCommandAllocator> ()->getMipmapGenerator();
+    auto error = generator.generate(refFromThis<agpu::command_list> (), texture, mipmapGenerationResources);
+    if (oldShaderSignature)
+        setShaderSignature(oldShaderSignature);
+    return error;
+}
+
+agpu_error ADXCommandList::resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error ADXCommandList::writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error ADXCommandList::beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error ADXCommandList::endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
 } // End of namespace AgpuD3D12
@@ -6,7 +6,7 @@ namespace AgpuD3D12
 {
 
 ADXCommandQueue::ADXCommandQueue(const agpu::device_ref &cdevice)
-    : device(cdevice), finishFenceEvent(NULL)
+    : device(cdevice), finishFenceEvent(NULL), lastSignaledTimelineValue(0)
 {
 
 }
@@ -31,6 +31,8 @@ agpu::command_queue_ref ADXCommandQueue::createDefault(const agpu::device_ref &d
     queueObject->queue = d3dQueue;
     if (!queueObject->createFinishFence())
         return agpu::command_queue_ref();
+    if (FAILED(deviceForDX->d3dDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&queueObject->timelineFence))))
+        return agpu::command_queue_ref();
 
     return queue;
 }
@@ -114,4 +116,66 @@ agpu_error ADXCommandQueue::waitFence(const agpu::fence_ref &fence)
     return AGPU_OK;
 }
 
+agpu_error ADXCommandQueue::signalTimelineValue(agpu_ulong value)
+{
+    std::unique_lock<std::mutex> l(timelineLock);
+    if (value <= lastSignaledTimelineValue)
+        return AGPU_INVALID_PARAMETER;
+
+    ERROR_IF_FAILED(queue->Signal(timelineFence.Get(), value));
+    lastSignaledTimelineValue = value;
+    return AGPU_OK;
+}
+
+agpu_error ADXCommandQueue::waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value)
+{
+    CHECK_POINTER(source_queue);
+    auto sourceQueue = source_queue.as<ADXCommandQueue> ();
+    if (sourceQueue == this)
+    {
+        // Waiting for a value that is signaled later in the same queue never completes.
+        std::unique_lock<std::mutex> l(timelineLock);
+        if (value > lastSignaledTimelineValue)
+            return AGPU_INVALID_OPERATION;
+    }
+
+    ERROR_IF_FAILED(queue->Wait(sourceQueue->timelineFence.Get(), value));
+    return AGPU_OK;
+}
+
+agpu_ulong ADXCommandQueue::getCompletedTimelineValue()
+{
+    return timelineFence->GetCompletedValue();
+}
+
+agpu_error ADXCommandQueue::waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns)
+{
+    if (timelineFence->GetCompletedValue() >= value)
+        return AGPU_OK;
+
+    // The timeout is rounded up to milliseconds.
+    DWORD timeoutMilliseconds = INFINITE;
+    if (timeout_ns < agpu_ulong(INFINITE - 1) * 1000000)
+        timeoutMilliseconds = DWORD((timeout_ns + 999999) / 1000000);
+
+    // Each wait has its own event, so that concurrent waits do not steal the signal of each other.
+    auto event = CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
+    if (event == nullptr)
+        return AGPU_ERROR;
+
+    if (FAILED(timelineFence->SetEventOnCompletion(value, event)))
+    {
+        CloseHandle(event);
+        return AGPU_ERROR;
+    }
+
+    auto waitResult = WaitForSingleObject(event, timeoutMilliseconds);
+    CloseHandle(event);
+    if (waitResult == WAIT_TIMEOUT)
+        return AGPU_TIMEOUT;
+    else if (waitResult != WAIT_OBJECT_0)
+        return AGPU_ERROR;
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuD3D12
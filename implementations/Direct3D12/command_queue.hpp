@@ -20,6 +20,11 @@ public:
     virtual agpu_error signalFence(const agpu::fence_ref &fence) override;
     virtual agpu_error waitFence(const agpu::fence_ref &fence) override;
 
+    virtual agpu_error signalTimelineValue(agpu_ulong value) override;
+    virtual agpu_error waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value) override;
+    virtual agpu_ulong getCompletedTimelineValue() override;
+    virtual agpu_error waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns) override;
+
 public:
 
     agpu::device_ref device;
@@ -32,6 +37,11 @@ private:
     HANDLE finishFenceEvent;
     ComPtr<ID3D12Fence> finishFence;
     UINT64 finishFenceValue;
+
+    // The timeline of the queue is only signaled by this queue.
+    std::mutex timelineLock;
+    ComPtr<ID3D12Fence> timelineFence;
+    UINT64 lastSignaledTimelineValue;
 };
 
 } // End of namespace AgpuD3D12
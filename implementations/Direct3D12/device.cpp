@@ -18,8 +18,10 @@
 #include "fence.hpp"
 #include "platform.hpp"
 #include "sampler.hpp"
+#include "../Common/fence_wait.hpp"
 #include "../Common/offline_shader_compiler.hpp"
 #include "../Common/state_tracker_cache.hpp"
+#include "../Common/buffer_pool.hpp"
 #include "../Common/window_scraper.hpp"
 
 namespace AgpuD3D12
@@ -165,6 +167,15 @@ agpu::command_queue_ptr ADXDevice::getDefaultCommandQueue()
     return defaultCommandQueue.disownedNewRef();
 }
 
+agpu::command_queue_ptr ADXDevice::getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index)
+{
+    // The default queue executes every type of work.
+    if(queue_type > AGPU_COMMAND_QUEUE_TYPE_TRANSFER || index != 0)
+        return nullptr;
+
+    return defaultCommandQueue.disownedNewRef();
+}
+
 agpu::swap_chain_ptr ADXDevice::createSwapChain(const agpu::command_queue_ref & commandQueue, agpu_swap_chain_create_info* swapChainInfo)
 {
     return ADXSwapChain::create(refFromThis<agpu::device> (), commandQueue, swapChainInfo).disown();
@@ -255,6 +266,16 @@ agpu::fence_ptr ADXDevice::createFence()
     return ADXFence::create(refFromThis<agpu::device> ()).disown();
 }
 
+agpu_error ADXDevice::waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+{
+    return AgpuCommon::waitForFencesByPolling(count, fences, wait_all, timeout_ns);
+}
+
+agpu::query_pool_ptr ADXDevice::createQueryPool(agpu_query_pool_description* description)
+{
+    return nullptr;
+}
+
 agpu_int ADXDevice::getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count)
 {
 	if (sample_count == 1)
@@ -295,6 +316,7 @@ agpu_bool ADXDevice::isFeatureSupported(agpu_feature feature)
 	{
     //case AGPU_FEATURE_VRDISPLAY: return isVRDisplaySupported;
     //case AGPU_FEATURE_VRINPUT_DEVICES: return isVRInputDevicesSupported;
+    case AGPU_FEATURE_COMMAND_QUEUE_TIMELINE: return true;
 	default: return adapterDesc->isFeatureSupported(feature);
 	}
 }
@@ -325,10 +347,21 @@ agpu::state_tracker_cache_ptr ADXDevice::createStateTrackerCache(const agpu::com
 	return AgpuCommon::StateTrackerCache::create(refFromThis<agpu::device> (), 0).disown();
 }
 
+agpu::buffer_pool_ptr ADXDevice::createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment)
+{
+	return AgpuCommon::BufferPool::create(refFromThis<agpu::device> (), block_description, alignment).disown();
+}
+
 agpu_error ADXDevice::finishExecution()
 {
 	// TODO: Finish the execution of all of the command queues.
 	return defaultCommandQueue->finishExecution();
 }
 
+agpu_error ADXDevice::flushPipelineCache()
+{
+	// There is no persistent pipeline cache in this backend.
+	return AGPU_OK;
+}
+
 } // End of namespace AgpuD3D12
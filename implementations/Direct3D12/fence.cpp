@@ -18,7 +18,7 @@ ADXFence::~ADXFence()
 
 agpu::fence_ref ADXFence::create(const agpu::device_ref &device)
 {
-    auto result = agpu::makeObject<ADXFence> (device);
+    auto result = agpu::makePooledObject<ADXFence> (device);
     auto dxFence = result.as<ADXFence> ();
 
     // Create transfer synchronization fence.
@@ -34,6 +34,22 @@ agpu::fence_ref ADXFence::create(const agpu::device_ref &device)
 }
 
 agpu_error ADXFence::waitOnClient()
+{
+    return waitWithTimeout(UINT64_MAX);
+}
+
+agpu_bool ADXFence::isSignaled()
+{
+    UINT64 waitValue = 0;
+    {
+        std::unique_lock<std::mutex> l(fenceMutex);
+        waitValue = fenceValue - 1;
+    }
+
+    return waitValue > 0 && fence->GetCompletedValue() >= waitValue;
+}
+
+agpu_error ADXFence::waitWithTimeout(agpu_ulong timeout_ns)
 {
     UINT64 waitValue = 0;
 
@@ -45,8 +61,17 @@ agpu_error ADXFence::waitOnClient()
 
     if (fence->GetCompletedValue() < waitValue)
     {
+        // The timeout is rounded up to milliseconds.
+        DWORD timeoutMilliseconds = INFINITE;
+        if(timeout_ns < agpu_ulong(INFINITE - 1)*1000000)
+            timeoutMilliseconds = DWORD((timeout_ns + 999999) / 1000000);
+
         ERROR_IF_FAILED(fence->SetEventOnCompletion(waitValue, event));
-        WaitForSingleObject(event, INFINITE);
+        auto waitResult = WaitForSingleObject(event, timeoutMilliseconds);
+        if(waitResult == WAIT_TIMEOUT)
+            return AGPU_TIMEOUT;
+        else if(waitResult != WAIT_OBJECT_0)
+            return AGPU_ERROR;
     }
 
     return AGPU_OK;
@@ -15,6 +15,8 @@ public:
     static agpu::fence_ref create(const agpu::device_ref &device);
 
     virtual agpu_error waitOnClient() override;
+    virtual agpu_bool isSignaled() override;
+    virtual agpu_error waitWithTimeout(agpu_ulong timeout_ns) override;
 
 public:
     std::mutex fenceMutex;
@@ -19,7 +19,7 @@ ADXShaderResourceBinding::~ADXShaderResourceBinding()
 
 agpu::shader_resource_binding_ref ADXShaderResourceBinding::create(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint bankIndex, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle)
 {
-    auto resourceBinding = agpu::makeObject<ADXShaderResourceBinding> (device, signature);
+    auto resourceBinding = agpu::makePooledObject<ADXShaderResourceBinding> (device, signature);
     auto adxResourceBinding = resourceBinding.as<ADXShaderResourceBinding> ();
     adxResourceBinding->bankIndex = bankIndex;
 	adxResourceBinding->cpuDescriptorTableHandle = cpuHandle;
@@ -35,7 +35,7 @@ agpu_error ADXShaderResourceBinding::bindUniformBuffer(agpu_int location, const
     return bindUniformBufferRange(location, uniform_buffer, 0, adxBuffer->description.size);
 }
 
-agpu_error ADXShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref & uniform_buffer, agpu_size offset, agpu_size size)
+agpu_error ADXShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref & uniform_buffer, agpu_device_size offset, agpu_device_size size)
 {
 	CHECK_POINTER(uniform_buffer);
 	if (location < 0)
@@ -66,7 +66,7 @@ agpu_error ADXShaderResourceBinding::bindStorageBuffer(agpu_int location, const
 	return bindStorageBufferRange(location, storage_buffer, 0, adxBuffer->description.size);
 }
 
-agpu_error ADXShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref & storage_buffer, agpu_size offset, agpu_size size)
+agpu_error ADXShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref & storage_buffer, agpu_device_size offset, agpu_device_size size)
 {
 	CHECK_POINTER(storage_buffer);
 	if (location < 0)
@@ -228,4 +228,10 @@ agpu::shader_resource_binding_ptr ADXShaderSignature::createShaderResourceBindin
 	return ADXShaderResourceBinding::create(device, refFromThis<agpu::shader_signature> (), bankIndex, cpuHandle, gpuHandle).disown();
 }
 
+agpu::shader_resource_binding_ptr ADXShaderSignature::createTransientShaderResourceBinding(agpu_uint element)
+{
+    // There is no cheaper allocation path for short lived bindings.
+    return createShaderResourceBinding(element);
+}
+
 } // End of namespace AgpuD3D12
@@ -60,6 +60,7 @@ public:
     static agpu::shader_signature_ref create(const agpu::device_ref &device, const ComPtr<ID3D12RootSignature> &rootSignature, ADXShaderSignatureBuilder *builder);
 
     virtual agpu::shader_resource_binding_ptr createShaderResourceBinding(agpu_uint element) override;
+    virtual agpu::shader_resource_binding_ptr createTransientShaderResourceBinding(agpu_uint element) override;
 
 public:
     agpu::device_ref device;
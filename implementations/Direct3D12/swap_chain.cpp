@@ -291,4 +291,9 @@ agpu_error ADXSwapChain::setOverlayPosition(agpu_int x, agpu_int y)
 	return overlayWindow->setPosition(x, y);
 }
 
+agpu_error ADXSwapChain::readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+{
+	return AGPU_UNSUPPORTED;
+}
+
 } // End of namespace AgpuD3D12
@@ -28,6 +28,7 @@ public:
     virtual agpu_uint getLayerCount() override;
 
     virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) override;
+    virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
 
 public:
     void disconnect();
@@ -37,7 +37,7 @@ agpu::texture_view_ref ADXTextureView::create(const agpu::device_ref &device, co
 		mapSwizzleComponent(description.components.a, D3D12_SHADER_COMPONENT_MAPPING_FROM_MEMORY_COMPONENT_3)
 	);
 
-    return agpu::makeObject<ADXTextureView> (device, texture, description, shader4ComponentMapping);
+    return agpu::makePooledObject<ADXTextureView> (device, texture, description, shader4ComponentMapping);
 }
 
 agpu::texture_ptr ADXTextureView::getTexture()
@@ -22,7 +22,7 @@ agpu::vertex_binding_ref ADXVertexBinding::create(const agpu::device_ref &device
     if (!layout)
         return agpu::vertex_binding_ref();
 
-    return agpu::makeObject<ADXVertexBinding> (device, layout);
+    return agpu::makePooledObject<ADXVertexBinding> (device, layout);
 }
 
 agpu_error ADXVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_ref* vertex_buffers)
@@ -30,7 +30,7 @@ agpu_error ADXVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_ref
     return bindVertexBuffersWithOffsets(count, vertex_buffers, nullptr);
 }
 
-agpu_error ADXVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_size* offsets)
+agpu_error ADXVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_device_size* offsets)
 {
     CHECK_POINTER(vertex_buffers);
     if (count != vertexBuffers.size())
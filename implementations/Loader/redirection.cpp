@@ -129,6 +129,14 @@ AGPU_EXPORT agpu_command_queue* agpuGetDefaultCommandQueue ( agpu_device* device
 	return (*dispatchTable)->agpuGetDefaultCommandQueue ( device );
 }
 
+AGPU_EXPORT agpu_command_queue* agpuGetCommandQueue ( agpu_device* device, agpu_command_queue_type queue_type, agpu_uint index )
+{
+	if (device == nullptr)
+		return (agpu_command_queue*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (device);
+	return (*dispatchTable)->agpuGetCommandQueue ( device, queue_type, index );
+}
+
 AGPU_EXPORT agpu_swap_chain* agpuCreateSwapChain ( agpu_device* device, agpu_command_queue* commandQueue, agpu_swap_chain_create_info* swapChainInfo )
 {
 	if (device == nullptr)
@@ -273,6 +281,22 @@ AGPU_EXPORT agpu_fence* agpuCreateFence ( agpu_device* device )
 	return (*dispatchTable)->agpuCreateFence ( device );
 }
 
+AGPU_EXPORT agpu_error agpuWaitForFences ( agpu_device* device, agpu_uint count, agpu_fence** fences, agpu_bool wait_all, agpu_ulong timeout_ns )
+{
+	if (device == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (device);
+	return (*dispatchTable)->agpuWaitForFences ( device, count, fences, wait_all, timeout_ns );
+}
+
+AGPU_EXPORT agpu_query_pool* agpuCreateQueryPool ( agpu_device* device, agpu_query_pool_description* description )
+{
+	if (device == nullptr)
+		return (agpu_query_pool*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (device);
+	return (*dispatchTable)->agpuCreateQueryPool ( device, description );
+}
+
 AGPU_EXPORT agpu_int agpuGetMultiSampleQualityLevels ( agpu_device* device, agpu_texture_format format, agpu_uint sample_count )
 {
 	if (device == nullptr)
@@ -361,6 +385,14 @@ AGPU_EXPORT agpu_state_tracker_cache* agpuCreateStateTrackerCache ( agpu_device*
 	return (*dispatchTable)->agpuCreateStateTrackerCache ( device, command_queue_family );
 }
 
+AGPU_EXPORT agpu_buffer_pool* agpuCreateBufferPool ( agpu_device* device, agpu_buffer_description* block_description, agpu_device_size alignment )
+{
+	if (device == nullptr)
+		return (agpu_buffer_pool*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (device);
+	return (*dispatchTable)->agpuCreateBufferPool ( device, block_description, alignment );
+}
+
 AGPU_EXPORT agpu_error agpuFinishDeviceExecution ( agpu_device* device )
 {
 	if (device == nullptr)
@@ -369,6 +401,14 @@ AGPU_EXPORT agpu_error agpuFinishDeviceExecution ( agpu_device* device )
 	return (*dispatchTable)->agpuFinishDeviceExecution ( device );
 }
 
+AGPU_EXPORT agpu_error agpuFlushDevicePipelineCache ( agpu_device* device )
+{
+	if (device == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (device);
+	return (*dispatchTable)->agpuFlushDevicePipelineCache ( device );
+}
+
 AGPU_EXPORT agpu_error agpuAddVRSystemReference ( agpu_vr_system* vr_system )
 {
 	if (vr_system == nullptr)
@@ -705,6 +745,14 @@ AGPU_EXPORT agpu_error agpuSetSwapChainOverlayPosition ( agpu_swap_chain* swap_c
 	return (*dispatchTable)->agpuSetSwapChainOverlayPosition ( swap_chain, x, y );
 }
 
+AGPU_EXPORT agpu_error agpuReadSwapChainPresentedFrame ( agpu_swap_chain* swap_chain, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer )
+{
+	if (swap_chain == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (swap_chain);
+	return (*dispatchTable)->agpuReadSwapChainPresentedFrame ( swap_chain, pitch, slicePitch, buffer );
+}
+
 AGPU_EXPORT agpu_error agpuAddComputePipelineBuilderReference ( agpu_compute_pipeline_builder* compute_pipeline_builder )
 {
 	if (compute_pipeline_builder == nullptr)
@@ -1041,6 +1089,38 @@ AGPU_EXPORT agpu_error agpuWaitFence ( agpu_command_queue* command_queue, agpu_f
 	return (*dispatchTable)->agpuWaitFence ( command_queue, fence );
 }
 
+AGPU_EXPORT agpu_error agpuSignalQueueTimelineValue ( agpu_command_queue* command_queue, agpu_ulong value )
+{
+	if (command_queue == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_queue);
+	return (*dispatchTable)->agpuSignalQueueTimelineValue ( command_queue, value );
+}
+
+AGPU_EXPORT agpu_error agpuWaitQueueTimelineValue ( agpu_command_queue* command_queue, agpu_command_queue* source_queue, agpu_ulong value )
+{
+	if (command_queue == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_queue);
+	return (*dispatchTable)->agpuWaitQueueTimelineValue ( command_queue, source_queue, value );
+}
+
+AGPU_EXPORT agpu_ulong agpuGetQueueCompletedTimelineValue ( agpu_command_queue* command_queue )
+{
+	if (command_queue == nullptr)
+		return (agpu_ulong)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_queue);
+	return (*dispatchTable)->agpuGetQueueCompletedTimelineValue ( command_queue );
+}
+
+AGPU_EXPORT agpu_error agpuWaitQueueTimelineValueOnClient ( agpu_command_queue* command_queue, agpu_ulong value, agpu_ulong timeout_ns )
+{
+	if (command_queue == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_queue);
+	return (*dispatchTable)->agpuWaitQueueTimelineValueOnClient ( command_queue, value, timeout_ns );
+}
+
 AGPU_EXPORT agpu_error agpuAddCommandAllocatorReference ( agpu_command_allocator* command_allocator )
 {
 	if (command_allocator == nullptr)
@@ -1129,7 +1209,7 @@ AGPU_EXPORT agpu_error agpuUseIndexBuffer ( agpu_command_list* command_list, agp
 	return (*dispatchTable)->agpuUseIndexBuffer ( command_list, index_buffer );
 }
 
-AGPU_EXPORT agpu_error agpuUseIndexBufferAt ( agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size )
+AGPU_EXPORT agpu_error agpuUseIndexBufferAt ( agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1193,7 +1273,7 @@ AGPU_EXPORT agpu_error agpuDrawArrays ( agpu_command_list* command_list, agpu_ui
 	return (*dispatchTable)->agpuDrawArrays ( command_list, vertex_count, instance_count, first_vertex, base_instance );
 }
 
-AGPU_EXPORT agpu_error agpuDrawArraysIndirect ( agpu_command_list* command_list, agpu_size offset, agpu_size drawcount )
+AGPU_EXPORT agpu_error agpuDrawArraysIndirect ( agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1209,7 +1289,7 @@ AGPU_EXPORT agpu_error agpuDrawElements ( agpu_command_list* command_list, agpu_
 	return (*dispatchTable)->agpuDrawElements ( command_list, index_count, instance_count, first_index, base_vertex, base_instance );
 }
 
-AGPU_EXPORT agpu_error agpuDrawElementsIndirect ( agpu_command_list* command_list, agpu_size offset, agpu_size drawcount )
+AGPU_EXPORT agpu_error agpuDrawElementsIndirect ( agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1225,7 +1305,7 @@ AGPU_EXPORT agpu_error agpuDispatchCompute ( agpu_command_list* command_list, ag
 	return (*dispatchTable)->agpuDispatchCompute ( command_list, group_count_x, group_count_y, group_count_z );
 }
 
-AGPU_EXPORT agpu_error agpuDispatchComputeIndirect ( agpu_command_list* command_list, agpu_size offset )
+AGPU_EXPORT agpu_error agpuDispatchComputeIndirect ( agpu_command_list* command_list, agpu_device_size offset )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1321,7 +1401,7 @@ AGPU_EXPORT agpu_error agpuMemoryBarrier ( agpu_command_list* command_list, agpu
 	return (*dispatchTable)->agpuMemoryBarrier ( command_list, source_stage, dest_stage, source_accesses, dest_accesses );
 }
 
-AGPU_EXPORT agpu_error agpuBufferMemoryBarrier ( agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size )
+AGPU_EXPORT agpu_error agpuBufferMemoryBarrier ( agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1369,7 +1449,7 @@ AGPU_EXPORT agpu_error agpuPopTextureTransitionBarrier ( agpu_command_list* comm
 	return (*dispatchTable)->agpuPopTextureTransitionBarrier ( command_list );
 }
 
-AGPU_EXPORT agpu_error agpuCopyBuffer ( agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size )
+AGPU_EXPORT agpu_error agpuCopyBuffer ( agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size )
 {
 	if (command_list == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1401,6 +1481,46 @@ AGPU_EXPORT agpu_error agpuCopyTexture ( agpu_command_list* command_list, agpu_t
 	return (*dispatchTable)->agpuCopyTexture ( command_list, source_texture, dest_texture, copy_region );
 }
 
+AGPU_EXPORT agpu_error agpuGenerateMipmaps ( agpu_command_list* command_list, agpu_texture* texture )
+{
+	if (command_list == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_list);
+	return (*dispatchTable)->agpuGenerateMipmaps ( command_list, texture );
+}
+
+AGPU_EXPORT agpu_error agpuResetQueryPool ( agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count )
+{
+	if (command_list == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_list);
+	return (*dispatchTable)->agpuResetQueryPool ( command_list, query_pool, first_query, query_count );
+}
+
+AGPU_EXPORT agpu_error agpuWriteTimestamp ( agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (command_list == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_list);
+	return (*dispatchTable)->agpuWriteTimestamp ( command_list, query_pool, query_index );
+}
+
+AGPU_EXPORT agpu_error agpuBeginQuery ( agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (command_list == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_list);
+	return (*dispatchTable)->agpuBeginQuery ( command_list, query_pool, query_index );
+}
+
+AGPU_EXPORT agpu_error agpuEndQuery ( agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (command_list == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (command_list);
+	return (*dispatchTable)->agpuEndQuery ( command_list, query_pool, query_index );
+}
+
 AGPU_EXPORT agpu_error agpuAddTextureReference ( agpu_texture* texture )
 {
 	if (texture == nullptr)
@@ -1465,6 +1585,14 @@ AGPU_EXPORT agpu_error agpuUploadTextureData ( agpu_texture* texture, agpu_int l
 	return (*dispatchTable)->agpuUploadTextureData ( texture, level, arrayIndex, pitch, slicePitch, data );
 }
 
+AGPU_EXPORT agpu_fence* agpuUploadTextureDataAsynchronously ( agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data )
+{
+	if (texture == nullptr)
+		return (agpu_fence*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (texture);
+	return (*dispatchTable)->agpuUploadTextureDataAsynchronously ( texture, level, arrayIndex, pitch, slicePitch, data );
+}
+
 AGPU_EXPORT agpu_error agpuUploadTextureSubData ( agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data )
 {
 	if (texture == nullptr)
@@ -1473,6 +1601,14 @@ AGPU_EXPORT agpu_error agpuUploadTextureSubData ( agpu_texture* texture, agpu_in
 	return (*dispatchTable)->agpuUploadTextureSubData ( texture, level, arrayIndex, pitch, slicePitch, sourceSize, destRegion, data );
 }
 
+AGPU_EXPORT agpu_error agpuUploadTextureSubresources ( agpu_texture* texture, agpu_uint count, agpu_texture_subresource_data* subresources )
+{
+	if (texture == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (texture);
+	return (*dispatchTable)->agpuUploadTextureSubresources ( texture, count, subresources );
+}
+
 AGPU_EXPORT agpu_error agpuGetTextureFullViewDescription ( agpu_texture* texture, agpu_texture_view_description* result )
 {
 	if (texture == nullptr)
@@ -1577,7 +1713,7 @@ AGPU_EXPORT agpu_error agpuGetBufferDescription ( agpu_buffer* buffer, agpu_buff
 	return (*dispatchTable)->agpuGetBufferDescription ( buffer, description );
 }
 
-AGPU_EXPORT agpu_error agpuUploadBufferData ( agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data )
+AGPU_EXPORT agpu_error agpuUploadBufferData ( agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data )
 {
 	if (buffer == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1585,7 +1721,15 @@ AGPU_EXPORT agpu_error agpuUploadBufferData ( agpu_buffer* buffer, agpu_size off
 	return (*dispatchTable)->agpuUploadBufferData ( buffer, offset, size, data );
 }
 
-AGPU_EXPORT agpu_error agpuReadBufferData ( agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data )
+AGPU_EXPORT agpu_fence* agpuUploadBufferDataAsynchronously ( agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data )
+{
+	if (buffer == nullptr)
+		return (agpu_fence*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer);
+	return (*dispatchTable)->agpuUploadBufferDataAsynchronously ( buffer, offset, size, data );
+}
+
+AGPU_EXPORT agpu_error agpuReadBufferData ( agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data )
 {
 	if (buffer == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1633,7 +1777,7 @@ AGPU_EXPORT agpu_error agpuBindVertexBuffers ( agpu_vertex_binding* vertex_bindi
 	return (*dispatchTable)->agpuBindVertexBuffers ( vertex_binding, count, vertex_buffers );
 }
 
-AGPU_EXPORT agpu_error agpuBindVertexBuffersWithOffsets ( agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_size* offsets )
+AGPU_EXPORT agpu_error agpuBindVertexBuffersWithOffsets ( agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_device_size* offsets )
 {
 	if (vertex_binding == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1905,6 +2049,14 @@ AGPU_EXPORT agpu_shader_resource_binding* agpuCreateShaderResourceBinding ( agpu
 	return (*dispatchTable)->agpuCreateShaderResourceBinding ( shader_signature, element );
 }
 
+AGPU_EXPORT agpu_shader_resource_binding* agpuCreateTransientShaderResourceBinding ( agpu_shader_signature* shader_signature, agpu_uint element )
+{
+	if (shader_signature == nullptr)
+		return (agpu_shader_resource_binding*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (shader_signature);
+	return (*dispatchTable)->agpuCreateTransientShaderResourceBinding ( shader_signature, element );
+}
+
 AGPU_EXPORT agpu_error agpuAddShaderResourceBindingReference ( agpu_shader_resource_binding* shader_resource_binding )
 {
 	if (shader_resource_binding == nullptr)
@@ -1929,7 +2081,7 @@ AGPU_EXPORT agpu_error agpuBindUniformBuffer ( agpu_shader_resource_binding* sha
 	return (*dispatchTable)->agpuBindUniformBuffer ( shader_resource_binding, location, uniform_buffer );
 }
 
-AGPU_EXPORT agpu_error agpuBindUniformBufferRange ( agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_size offset, agpu_size size )
+AGPU_EXPORT agpu_error agpuBindUniformBufferRange ( agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_device_size offset, agpu_device_size size )
 {
 	if (shader_resource_binding == nullptr)
 		return AGPU_NULL_POINTER;
@@ -1945,7 +2097,7 @@ AGPU_EXPORT agpu_error agpuBindStorageBuffer ( agpu_shader_resource_binding* sha
 	return (*dispatchTable)->agpuBindStorageBuffer ( shader_resource_binding, location, storage_buffer );
 }
 
-AGPU_EXPORT agpu_error agpuBindStorageBufferRange ( agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_size offset, agpu_size size )
+AGPU_EXPORT agpu_error agpuBindStorageBufferRange ( agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_device_size offset, agpu_device_size size )
 {
 	if (shader_resource_binding == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2009,6 +2161,70 @@ AGPU_EXPORT agpu_error agpuWaitOnClient ( agpu_fence* fence )
 	return (*dispatchTable)->agpuWaitOnClient ( fence );
 }
 
+AGPU_EXPORT agpu_bool agpuIsFenceSignaled ( agpu_fence* fence )
+{
+	if (fence == nullptr)
+		return (agpu_bool)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (fence);
+	return (*dispatchTable)->agpuIsFenceSignaled ( fence );
+}
+
+AGPU_EXPORT agpu_error agpuWaitFenceWithTimeout ( agpu_fence* fence, agpu_ulong timeout_ns )
+{
+	if (fence == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (fence);
+	return (*dispatchTable)->agpuWaitFenceWithTimeout ( fence, timeout_ns );
+}
+
+AGPU_EXPORT agpu_error agpuAddQueryPoolReference ( agpu_query_pool* query_pool )
+{
+	if (query_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuAddQueryPoolReference ( query_pool );
+}
+
+AGPU_EXPORT agpu_error agpuReleaseQueryPool ( agpu_query_pool* query_pool )
+{
+	if (query_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuReleaseQueryPool ( query_pool );
+}
+
+AGPU_EXPORT agpu_error agpuGetQueryPoolDescription ( agpu_query_pool* query_pool, agpu_query_pool_description* description )
+{
+	if (query_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuGetQueryPoolDescription ( query_pool, description );
+}
+
+AGPU_EXPORT agpu_uint agpuGetQueryPoolResultValueCount ( agpu_query_pool* query_pool )
+{
+	if (query_pool == nullptr)
+		return (agpu_uint)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuGetQueryPoolResultValueCount ( query_pool );
+}
+
+AGPU_EXPORT agpu_float agpuGetQueryPoolTimestampPeriod ( agpu_query_pool* query_pool )
+{
+	if (query_pool == nullptr)
+		return (agpu_float)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuGetQueryPoolTimestampPeriod ( query_pool );
+}
+
+AGPU_EXPORT agpu_error agpuGetQueryPoolResults ( agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags )
+{
+	if (query_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (query_pool);
+	return (*dispatchTable)->agpuGetQueryPoolResults ( query_pool, first_query, query_count, results, flags );
+}
+
 AGPU_EXPORT agpu_error agpuAddOfflineShaderCompilerReference ( agpu_offline_shader_compiler* offline_shader_compiler )
 {
 	if (offline_shader_compiler == nullptr)
@@ -2097,6 +2313,46 @@ AGPU_EXPORT agpu_shader* agpuGetOfflineShaderCompilerResultAsShader ( agpu_offli
 	return (*dispatchTable)->agpuGetOfflineShaderCompilerResultAsShader ( offline_shader_compiler );
 }
 
+AGPU_EXPORT agpu_error agpuAddBufferPoolReference ( agpu_buffer_pool* buffer_pool )
+{
+	if (buffer_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer_pool);
+	return (*dispatchTable)->agpuAddBufferPoolReference ( buffer_pool );
+}
+
+AGPU_EXPORT agpu_error agpuReleaseBufferPool ( agpu_buffer_pool* buffer_pool )
+{
+	if (buffer_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer_pool);
+	return (*dispatchTable)->agpuReleaseBufferPool ( buffer_pool );
+}
+
+AGPU_EXPORT agpu_buffer* agpuAllocateBufferPoolRange ( agpu_buffer_pool* buffer_pool, agpu_device_size size, agpu_device_size* offset )
+{
+	if (buffer_pool == nullptr)
+		return (agpu_buffer*)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer_pool);
+	return (*dispatchTable)->agpuAllocateBufferPoolRange ( buffer_pool, size, offset );
+}
+
+AGPU_EXPORT agpu_error agpuFreeBufferPoolRange ( agpu_buffer_pool* buffer_pool, agpu_buffer* buffer, agpu_device_size offset )
+{
+	if (buffer_pool == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer_pool);
+	return (*dispatchTable)->agpuFreeBufferPoolRange ( buffer_pool, buffer, offset );
+}
+
+AGPU_EXPORT agpu_device_size agpuGetBufferPoolAlignment ( agpu_buffer_pool* buffer_pool )
+{
+	if (buffer_pool == nullptr)
+		return (agpu_device_size)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (buffer_pool);
+	return (*dispatchTable)->agpuGetBufferPoolAlignment ( buffer_pool );
+}
+
 AGPU_EXPORT agpu_error agpuAddStateTrackerCacheReference ( agpu_state_tracker_cache* state_tracker_cache )
 {
 	if (state_tracker_cache == nullptr)
@@ -2145,6 +2401,86 @@ AGPU_EXPORT agpu_immediate_renderer* agpuCreateImmediateRenderer ( agpu_state_tr
 	return (*dispatchTable)->agpuCreateImmediateRenderer ( state_tracker_cache );
 }
 
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestShader ( agpu_state_tracker_cache* state_tracker_cache, agpu_shader* shader, agpu_pointer content, agpu_size content_size )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheRegisterManifestShader ( state_tracker_cache, shader, content, content_size );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestShaderSignature ( agpu_state_tracker_cache* state_tracker_cache, agpu_shader_signature* shader_signature, agpu_cstring key )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheRegisterManifestShaderSignature ( state_tracker_cache, shader_signature, key );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestVertexLayout ( agpu_state_tracker_cache* state_tracker_cache, agpu_vertex_layout* vertex_layout, agpu_cstring key )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheRegisterManifestVertexLayout ( state_tracker_cache, vertex_layout, key );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheSavePipelineManifest ( agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheSavePipelineManifest ( state_tracker_cache, file_name );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheLoadPipelineManifest ( agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name, agpu_uint worker_count )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheLoadPipelineManifest ( state_tracker_cache, file_name, worker_count );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheWaitForPipelineManifestReplay ( agpu_state_tracker_cache* state_tracker_cache )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheWaitForPipelineManifestReplay ( state_tracker_cache );
+}
+
+AGPU_EXPORT agpu_ulong agpuStateTrackerCacheGetPipelineManifestHitCount ( agpu_state_tracker_cache* state_tracker_cache )
+{
+	if (state_tracker_cache == nullptr)
+		return (agpu_ulong)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheGetPipelineManifestHitCount ( state_tracker_cache );
+}
+
+AGPU_EXPORT agpu_ulong agpuStateTrackerCacheGetPipelineManifestMissCount ( agpu_state_tracker_cache* state_tracker_cache )
+{
+	if (state_tracker_cache == nullptr)
+		return (agpu_ulong)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheGetPipelineManifestMissCount ( state_tracker_cache );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCacheSetShaderCacheDirectory ( agpu_state_tracker_cache* state_tracker_cache, agpu_cstring directory )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCacheSetShaderCacheDirectory ( state_tracker_cache, directory );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerCachePrecompileImmediateRendererShaderVariants ( agpu_state_tracker_cache* state_tracker_cache, agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count )
+{
+	if (state_tracker_cache == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker_cache);
+	return (*dispatchTable)->agpuStateTrackerCachePrecompileImmediateRendererShaderVariants ( state_tracker_cache, variant_count, variants, worker_count );
+}
+
 AGPU_EXPORT agpu_error agpuAddStateTrackerReference ( agpu_state_tracker* state_tracker )
 {
 	if (state_tracker == nullptr)
@@ -2457,7 +2793,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBuffer ( agpu_state_tracker* stat
 	return (*dispatchTable)->agpuStateTrackerUseIndexBuffer ( state_tracker, index_buffer );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBufferAt ( agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size )
+AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBufferAt ( agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2521,7 +2857,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerDrawArrays ( agpu_state_tracker* state_tr
 	return (*dispatchTable)->agpuStateTrackerDrawArrays ( state_tracker, vertex_count, instance_count, first_vertex, base_instance );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerDrawArraysIndirect ( agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount )
+AGPU_EXPORT agpu_error agpuStateTrackerDrawArraysIndirect ( agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2537,7 +2873,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerDrawElements ( agpu_state_tracker* state_
 	return (*dispatchTable)->agpuStateTrackerDrawElements ( state_tracker, index_count, instance_count, first_index, base_vertex, base_instance );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerDrawElementsIndirect ( agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount )
+AGPU_EXPORT agpu_error agpuStateTrackerDrawElementsIndirect ( agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2553,7 +2889,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerDispatchCompute ( agpu_state_tracker* sta
 	return (*dispatchTable)->agpuStateTrackerDispatchCompute ( state_tracker, group_count_x, group_count_y, group_count_z );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerDispatchComputeIndirect ( agpu_state_tracker* state_tracker, agpu_size offset )
+AGPU_EXPORT agpu_error agpuStateTrackerDispatchComputeIndirect ( agpu_state_tracker* state_tracker, agpu_device_size offset )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2625,7 +2961,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerMemoryBarrier ( agpu_state_tracker* state
 	return (*dispatchTable)->agpuStateTrackerMemoryBarrier ( state_tracker, source_stage, dest_stage, source_accesses, dest_accesses );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerBufferMemoryBarrier ( agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size )
+AGPU_EXPORT agpu_error agpuStateTrackerBufferMemoryBarrier ( agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2673,7 +3009,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerPopTextureTransitionBarrier ( agpu_state_
 	return (*dispatchTable)->agpuStateTrackerPopTextureTransitionBarrier ( state_tracker );
 }
 
-AGPU_EXPORT agpu_error agpuStateTrackerCopyBuffer ( agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size )
+AGPU_EXPORT agpu_error agpuStateTrackerCopyBuffer ( agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size )
 {
 	if (state_tracker == nullptr)
 		return AGPU_NULL_POINTER;
@@ -2705,6 +3041,78 @@ AGPU_EXPORT agpu_error agpuStateTrackerCopyTexture ( agpu_state_tracker* state_t
 	return (*dispatchTable)->agpuStateTrackerCopyTexture ( state_tracker, source_texture, dest_texture, copy_region );
 }
 
+AGPU_EXPORT agpu_error agpuStateTrackerGenerateMipmaps ( agpu_state_tracker* state_tracker, agpu_texture* texture )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerGenerateMipmaps ( state_tracker, texture );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerSetAsynchronousPipelineCompilation ( agpu_state_tracker* state_tracker, agpu_bool enabled )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerSetAsynchronousPipelineCompilation ( state_tracker, enabled );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerSetFallbackGraphicsPipeline ( agpu_state_tracker* state_tracker, agpu_pipeline_state* pipeline )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerSetFallbackGraphicsPipeline ( state_tracker, pipeline );
+}
+
+AGPU_EXPORT agpu_ulong agpuStateTrackerGetDeferredDrawCount ( agpu_state_tracker* state_tracker )
+{
+	if (state_tracker == nullptr)
+		return (agpu_ulong)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerGetDeferredDrawCount ( state_tracker );
+}
+
+AGPU_EXPORT agpu_ulong agpuStateTrackerGetSkippedDrawCount ( agpu_state_tracker* state_tracker )
+{
+	if (state_tracker == nullptr)
+		return (agpu_ulong)0;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerGetSkippedDrawCount ( state_tracker );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerResetQueryPool ( agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerResetQueryPool ( state_tracker, query_pool, first_query, query_count );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerWriteTimestamp ( agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerWriteTimestamp ( state_tracker, query_pool, query_index );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerBeginQuery ( agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerBeginQuery ( state_tracker, query_pool, query_index );
+}
+
+AGPU_EXPORT agpu_error agpuStateTrackerEndQuery ( agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index )
+{
+	if (state_tracker == nullptr)
+		return AGPU_NULL_POINTER;
+	agpu_icd_dispatch **dispatchTable = reinterpret_cast<agpu_icd_dispatch**> (state_tracker);
+	return (*dispatchTable)->agpuStateTrackerEndQuery ( state_tracker, query_pool, query_index );
+}
+
 AGPU_EXPORT agpu_error agpuAddImmediateRendererReference ( agpu_immediate_renderer* immediate_renderer )
 {
 	if (immediate_renderer == nullptr)
@@ -3201,7 +3609,7 @@ AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBuffer ( agpu_immediate_rend
 	return (*dispatchTable)->agpuImmediateRendererUseIndexBuffer ( immediate_renderer, index_buffer );
 }
 
-AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBufferAt ( agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size )
+AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBufferAt ( agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size )
 {
 	if (immediate_renderer == nullptr)
 		return AGPU_NULL_POINTER;
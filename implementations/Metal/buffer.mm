@@ -57,10 +57,10 @@ agpu_error AMtlBuffer::getDescription(agpu_buffer_description* description)
     return AGPU_OK;
 }
 
-agpu_error AMtlBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu_error AMtlBuffer::uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     CHECK_POINTER(data)
-    if(offset + size > handle.length)
+    if(offset > handle.length || size > handle.length - offset)
         return AGPU_OUT_OF_BOUNDS;
         
     if(description.heap_type != AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL)
@@ -92,10 +92,26 @@ agpu_error AMtlBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_p
     return uploadResult ? AGPU_OK : AGPU_ERROR;
 }
 
-agpu_error AMtlBuffer::readBufferData(agpu_size offset, agpu_size size, agpu_pointer buffer)
+agpu::fence_ptr AMtlBuffer::uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
+{
+    // The upload is synchronous in this backend, so the fence is signaled right away.
+    auto error = uploadBufferData(offset, size, data);
+    if(error)
+        return nullptr;
+
+    auto fence = agpu::fence_ref(device->createFence());
+    if(!fence)
+        return nullptr;
+
+    auto commandQueue = agpu::command_queue_ref(device->getDefaultCommandQueue());
+    commandQueue->signalFence(fence);
+    return fence.disown();
+}
+
+agpu_error AMtlBuffer::readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer buffer)
 {
     CHECK_POINTER(buffer)
-    if(offset + size > handle.length)
+    if(offset > handle.length || size > handle.length - offset)
         return AGPU_OUT_OF_BOUNDS;
 
     if(description.heap_type != AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL)
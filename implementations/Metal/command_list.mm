@@ -152,7 +152,7 @@ agpu_error AMtlCommandList::useIndexBuffer(const agpu::buffer_ref &index_buffer)
 }
 
 
-agpu_error AMtlCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error AMtlCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_device_size offset, agpu_size index_size)
 {
     CHECK_POINTER(index_buffer);
 
@@ -330,7 +330,7 @@ agpu_error AMtlCommandList::drawArrays ( agpu_uint vertex_count, agpu_uint insta
     return AGPU_OK;
 }
 
-agpu_error AMtlCommandList::drawArraysIndirect ( agpu_size offset, agpu_size drawcount )
+agpu_error AMtlCommandList::drawArraysIndirect ( agpu_device_size offset, agpu_size drawcount )
 {
     if(!currentIndexBuffer || !currentIndirectBuffer || !currentPipeline)
         return AGPU_INVALID_OPERATION;
@@ -357,7 +357,7 @@ agpu_error AMtlCommandList::drawElements ( agpu_uint index_count, agpu_uint inst
     return AGPU_OK;
 }
 
-agpu_error AMtlCommandList::drawElementsIndirect ( agpu_size offset, agpu_size drawcount )
+agpu_error AMtlCommandList::drawElementsIndirect ( agpu_device_size offset, agpu_size drawcount )
 {
     if(!currentIndexBuffer || !currentIndirectBuffer || !currentPipeline)
         return AGPU_INVALID_OPERATION;
@@ -384,7 +384,7 @@ agpu_error AMtlCommandList::dispatchCompute ( agpu_uint group_count_x, agpu_uint
     return AGPU_OK;
 }
 
-agpu_error AMtlCommandList::dispatchComputeIndirect ( agpu_size offset )
+agpu_error AMtlCommandList::dispatchComputeIndirect ( agpu_device_size offset )
 {
     if(!currentPipeline)
         return AGPU_INVALID_OPERATION;
@@ -705,7 +705,7 @@ agpu_error AMtlCommandList::memoryBarrier(agpu_pipeline_stage_flags source_stage
     return AGPU_OK;
 }
 
-agpu_error AMtlCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+agpu_error AMtlCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 {
     return memoryBarrier(source_stage, dest_stage, source_accesses, dest_accesses);
 }
@@ -754,7 +754,7 @@ void AMtlCommandList::endBlitting()
     blitEncoder = nil;
 }
 
-agpu_error AMtlCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+agpu_error AMtlCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 {
     CHECK_POINTER(source_buffer);
     CHECK_POINTER(dest_buffer);
@@ -864,4 +864,39 @@ agpu_error AMtlCommandList::copyTexture(const agpu::texture_ref & source_texture
     return AGPU_OK;
 }
 
+agpu_error AMtlCommandList::generateMipmaps(const agpu::texture_ref & texture)
+{
+    CHECK_POINTER(texture);
+    if(texture.as<AMtlTexture> ()->description.miplevels <= 1)
+        return AGPU_OK;
+
+    // The sRGB handle is used, so that the levels are filtered in linear space.
+    recordCommand([=] {
+        beginBlitting();
+        [blitEncoder generateMipmapsForTexture: texture.as<AMtlTexture> ()->handle];
+        endBlitting();
+    });
+    return AGPU_OK;
+}
+
+agpu_error AMtlCommandList::resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error AMtlCommandList::writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error AMtlCommandList::beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error AMtlCommandList::endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    return AGPU_UNSUPPORTED;
+}
+
 } // End of namespace AgpuMetal
@@ -3,6 +3,8 @@
 
 #include "device.hpp"
 #include <mutex>
+#include <condition_variable>
+#include <memory>
 
 namespace AgpuMetal
 {
@@ -21,12 +23,25 @@ public:
     virtual agpu_error signalFence(const agpu::fence_ref &fence) override;
     virtual agpu_error waitFence(const agpu::fence_ref &fence) override;
 
+    virtual agpu_error signalTimelineValue(agpu_ulong value) override;
+    virtual agpu_error waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value) override;
+    virtual agpu_ulong getCompletedTimelineValue() override;
+    virtual agpu_error waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns) override;
+
     agpu::device_weakref weakDevice;
     id<MTLCommandQueue> handle;
 
+    // The timeline of the queue is a shared event, that is only signaled by
+    // this queue. It is nil when shared events are not available.
+    id<MTLSharedEvent> timelineEvent;
+    MTLSharedEventListener *timelineListener;
+
 private:
     agpu::fence_ref finishFence;
     std::mutex finishFenceMutex;
+
+    std::mutex timelineMutex;
+    uint64_t lastSignaledTimelineValue;
 };
 
 } // End of namespace AgpuMetal
@@ -2,12 +2,13 @@
 #include "command_list.hpp"
 #include "fence.hpp"
 #include "../Common/memory_profiler.hpp"
+#include <chrono>
 
 namespace AgpuMetal
 {
     
 AMtlCommandQueue::AMtlCommandQueue(const agpu::device_ref &device)
-    : weakDevice(device)
+    : weakDevice(device), timelineEvent(nil), timelineListener(nil), lastSignaledTimelineValue(0)
 {
     AgpuProfileConstructor(AMtlCommandQueue);
 }
@@ -27,6 +28,11 @@ agpu::command_queue_ref AMtlCommandQueue::create(const agpu::device_ref &device,
     auto queue = result.as<AMtlCommandQueue> ();
     queue->handle = handle;
     queue->finishFence = finishFence;
+    if (@available(macos 10.14, *))
+    {
+        queue->timelineEvent = [handle.device newSharedEvent];
+        queue->timelineListener = [[MTLSharedEventListener alloc] init];
+    }
     return result;
 }
 
@@ -75,4 +81,98 @@ agpu_error AMtlCommandQueue::waitFence(const agpu::fence_ref &fence)
     return AGPU_UNIMPLEMENTED;
 }
 
+agpu_error AMtlCommandQueue::signalTimelineValue(agpu_ulong value)
+{
+    if(!timelineEvent)
+        return AGPU_UNSUPPORTED;
+
+    std::unique_lock<std::mutex> l(timelineMutex);
+    if(value <= lastSignaledTimelineValue)
+        return AGPU_INVALID_PARAMETER;
+
+    @autoreleasepool {
+        auto commandBuffer = [handle commandBuffer];
+        [commandBuffer encodeSignalEvent: timelineEvent value: value];
+        [commandBuffer commit];
+    }
+
+    lastSignaledTimelineValue = value;
+    return AGPU_OK;
+}
+
+agpu_error AMtlCommandQueue::waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value)
+{
+    CHECK_POINTER(source_queue);
+    auto sourceQueue = source_queue.as<AMtlCommandQueue> ();
+    if(!timelineEvent || !sourceQueue->timelineEvent)
+        return AGPU_UNSUPPORTED;
+
+    std::unique_lock<std::mutex> l(timelineMutex);
+
+    // Waiting for a value that is signaled later in the same queue never completes.
+    if(sourceQueue == this && value > lastSignaledTimelineValue)
+        return AGPU_INVALID_OPERATION;
+
+    @autoreleasepool {
+        auto commandBuffer = [handle commandBuffer];
+        [commandBuffer encodeWaitForEvent: sourceQueue->timelineEvent value: value];
+        [commandBuffer commit];
+    }
+
+    return AGPU_OK;
+}
+
+agpu_ulong AMtlCommandQueue::getCompletedTimelineValue()
+{
+    if(!timelineEvent)
+        return 0;
+    return timelineEvent.signaledValue;
+}
+
+namespace
+{
+struct TimelineClientWait
+{
+    TimelineClientWait()
+        : isCompleted(false) {}
+
+    std::mutex mutex;
+    std::condition_variable completedCondition;
+    bool isCompleted;
+};
+}
+
+agpu_error AMtlCommandQueue::waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns)
+{
+    if(!timelineEvent)
+        return AGPU_UNSUPPORTED;
+    if(timelineEvent.signaledValue >= value)
+        return AGPU_OK;
+
+    // The notification may arrive after a timeout, so its state is shared.
+    auto wait = std::make_shared<TimelineClientWait> ();
+    [timelineEvent notifyListener: timelineListener atValue: value block: ^(id<MTLSharedEvent> event, uint64_t signaledValue) {
+        std::unique_lock<std::mutex> l(wait->mutex);
+        wait->isCompleted = true;
+        wait->completedCondition.notify_all();
+    }];
+
+    std::unique_lock<std::mutex> l(wait->mutex);
+    if(timeout_ns >= agpu_ulong(INT64_MAX/2))
+    {
+        while(!wait->isCompleted)
+            wait->completedCondition.wait(l);
+        return AGPU_OK;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+    while(!wait->isCompleted)
+    {
+        if(wait->completedCondition.wait_until(l, deadline) == std::cv_status::timeout)
+            return wait->isCompleted ? AGPU_OK : AGPU_TIMEOUT;
+    }
+
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuMetal
@@ -20,6 +20,7 @@ public:
     static agpu::device_ref open(id<MTLDevice> selectedDevice, agpu_device_open_info *openInfo);
 
     virtual agpu::command_queue_ptr getDefaultCommandQueue() override;
+    virtual agpu::command_queue_ptr getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index) override;
     id<MTLCommandQueue> getDefaultCommandQueueHandle();
 
     virtual agpu::swap_chain_ptr createSwapChain(const agpu::command_queue_ref &commandQueue, agpu_swap_chain_create_info* swapChainInfo) override;
@@ -40,6 +41,8 @@ public:
 	virtual agpu::texture_ptr createTexture(agpu_texture_description* description) override;
     virtual agpu::sampler_ptr createSampler(agpu_sampler_description* description) override;
 	virtual agpu::fence_ptr createFence() override;
+	virtual agpu_error waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns) override;
+	virtual agpu::query_pool_ptr createQueryPool(agpu_query_pool_description* description) override;
 	virtual agpu_int getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count) override;
 	virtual agpu_bool hasTopLeftNdcOrigin() override;
 	virtual agpu_bool hasBottomLeftTextureCoordinates() override;
@@ -51,7 +54,9 @@ public:
 	virtual agpu::window_scraper_ptr createWindowScraper() override;
     virtual agpu::offline_shader_compiler_ptr createOfflineShaderCompiler() override;
     virtual agpu::state_tracker_cache_ptr createStateTrackerCache(const agpu::command_queue_ref & command_queue_family) override;
+    virtual agpu::buffer_pool_ptr createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment) override;
     virtual agpu_error finishExecution() override;
+    virtual agpu_error flushPipelineCache() override;
 
     id<MTLDevice> device;
 
@@ -16,8 +16,10 @@
 #include "texture.hpp"
 #include "sampler.hpp"
 #include "platform.hpp"
+#include "../Common/fence_wait.hpp"
 #include "../Common/offline_shader_compiler.hpp"
 #include "../Common/state_tracker_cache.hpp"
+#include "../Common/buffer_pool.hpp"
 #include "../Common/memory_profiler.hpp"
 #include "../Common/window_scraper.hpp"
 
@@ -91,6 +93,15 @@ agpu::command_queue_ptr AMtlDevice::getDefaultCommandQueue()
     return mainCommandQueue.disownedNewRef();
 }
 
+agpu::command_queue_ptr AMtlDevice::getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index)
+{
+    // The default queue executes every type of work.
+    if(queue_type > AGPU_COMMAND_QUEUE_TYPE_TRANSFER || index != 0)
+        return nullptr;
+
+    return mainCommandQueue.disownedNewRef();
+}
+
 id<MTLCommandQueue> AMtlDevice::getDefaultCommandQueueHandle()
 {
     return mainCommandQueue.as<AMtlCommandQueue> ()->handle;
@@ -187,6 +198,16 @@ agpu::fence_ptr AMtlDevice::createFence()
     return AMtlFence::create(refFromThis<agpu::device> ()).disown();
 }
 
+agpu_error AMtlDevice::waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+{
+    return AgpuCommon::waitForFencesByPolling(count, fences, wait_all, timeout_ns);
+}
+
+agpu::query_pool_ptr AMtlDevice::createQueryPool(agpu_query_pool_description* description)
+{
+    return nullptr;
+}
+
 agpu_int AMtlDevice::getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count)
 {
     return 1;
@@ -222,9 +243,20 @@ agpu::state_tracker_cache_ptr AMtlDevice::createStateTrackerCache(const agpu::co
 	return AgpuCommon::StateTrackerCache::create(refFromThis<agpu::device> (), 0).disown();
 }
 
+agpu::buffer_pool_ptr AMtlDevice::createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment)
+{
+	return AgpuCommon::BufferPool::create(refFromThis<agpu::device> (), block_description, alignment).disown();
+}
+
 agpu_error AMtlDevice::finishExecution()
 {
     return mainCommandQueue->finishExecution();
 }
 
+agpu_error AMtlDevice::flushPipelineCache()
+{
+    // There is no persistent pipeline cache in this backend.
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuMetal
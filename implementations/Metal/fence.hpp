@@ -3,6 +3,7 @@
 
 #include "device.hpp"
 #include <mutex>
+#include <chrono>
 
 namespace AgpuMetal
 {
@@ -16,13 +17,15 @@ public:
     static agpu::fence_ref create(const agpu::device_ref &device);
 
     virtual agpu_error waitOnClient() override;
+    virtual agpu_bool isSignaled() override;
+    virtual agpu_error waitWithTimeout(agpu_ulong timeout_ns) override;
     agpu_error signalOnQueue(id<MTLCommandQueue> queue);
 
     agpu::device_weakref weakDevice;
     id<MTLCommandBuffer> fenceCommand;
     std::mutex mutex;
     std::condition_variable signaledCondition;
-    bool isSignaled;
+    bool hasCompleted;
 };
 
 } // End of namespace AgpuMetal
@@ -8,7 +8,7 @@ AMtlFence::AMtlFence(const agpu::device_ref &device)
     : weakDevice(device)
 {
     AgpuProfileConstructor(AMtlFence);
-    isSignaled = false;
+    hasCompleted = false;
 }
 
 AMtlFence::~AMtlFence()
@@ -20,7 +20,7 @@ AMtlFence::~AMtlFence()
 
 agpu::fence_ref AMtlFence::create(const agpu::device_ref &device)
 {
-    return agpu::makeObject<AMtlFence> (device);
+    return agpu::makePooledObject<AMtlFence> (device);
 }
 
 agpu_error AMtlFence::waitOnClient()
@@ -28,7 +28,7 @@ agpu_error AMtlFence::waitOnClient()
     std::unique_lock<std::mutex> l(mutex);
     if(fenceCommand)
     {
-        while(!isSignaled)
+        while(!hasCompleted)
             signaledCondition.wait(l);
         if(fenceCommand)
         {
@@ -40,17 +40,43 @@ agpu_error AMtlFence::waitOnClient()
     return AGPU_OK;
 }
 
+agpu_bool AMtlFence::isSignaled()
+{
+    std::unique_lock<std::mutex> l(mutex);
+    return hasCompleted;
+}
+
+agpu_error AMtlFence::waitWithTimeout(agpu_ulong timeout_ns)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    if(timeout_ns >= agpu_ulong(INT64_MAX/2))
+    {
+        while(!hasCompleted)
+            signaledCondition.wait(l);
+        return AGPU_OK;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+    while(!hasCompleted)
+    {
+        if(signaledCondition.wait_until(l, deadline) == std::cv_status::timeout)
+            return hasCompleted ? AGPU_OK : AGPU_TIMEOUT;
+    }
+
+    return AGPU_OK;
+}
+
 agpu_error AMtlFence::signalOnQueue(id<MTLCommandQueue> queue)
 {
     @autoreleasepool {
         std::unique_lock<std::mutex> l(mutex);
-        isSignaled = false;
+        hasCompleted = false;
         if(fenceCommand)
             [fenceCommand waitUntilCompleted];
         fenceCommand = [queue commandBuffer];
         [fenceCommand addCompletedHandler:^(id<MTLCommandBuffer> cb) {
             std::unique_lock<std::mutex> l(mutex);
-            isSignaled = true;
+            hasCompleted = true;
             signaledCondition.notify_all();
         }];
         [fenceCommand commit];
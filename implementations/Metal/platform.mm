@@ -31,6 +31,11 @@ agpu_bool isFeatureSupportedInDevice(id<MTLDevice> device, agpu_feature feature)
     case AGPU_FEATURE_SHADER_INT_16:
         return true;
 
+    case AGPU_FEATURE_COMMAND_QUEUE_TIMELINE:
+        if (@available(macos 10.14, *))
+            return true;
+        return false;
+
     case AGPU_FEATURE_GEOMETRY_SHADER:
 	case AGPU_FEATURE_TESSELLATION_SHADER:
 	case AGPU_FEATURE_MULTI_DRAW_INDIRECT:
@@ -30,9 +30,9 @@ public:
     static agpu::shader_resource_binding_ref create(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex);
 
     virtual agpu_error bindUniformBuffer(agpu_int location, const agpu::buffer_ref &uniform_buffer) override;
-    virtual agpu_error bindUniformBufferRange( agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bindUniformBufferRange( agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size) override;
     virtual agpu_error bindStorageBuffer(agpu_int location, const agpu::buffer_ref &uniform_buffer) override;
-    virtual agpu_error bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size) override;
     virtual agpu_error bindSampledTextureView(agpu_int location, const agpu::texture_view_ref & view) override;
     virtual agpu_error bindArrayOfSampledTextureView(agpu_int location, agpu_int first_index, agpu_uint count, agpu::texture_view_ref* views) override;
 	virtual agpu_error bindStorageImageView(agpu_int location, const agpu::texture_view_ref & view) override;
@@ -33,7 +33,7 @@ AMtlShaderResourceBinding::~AMtlShaderResourceBinding()
 
 agpu::shader_resource_binding_ref AMtlShaderResourceBinding::create(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex)
 {
-    auto result = agpu::makeObject<AMtlShaderResourceBinding> (device);
+    auto result = agpu::makePooledObject<AMtlShaderResourceBinding> (device);
     auto binding = result.as<AMtlShaderResourceBinding> ();
     binding->signature = signature;
     binding->elementIndex = elementIndex;
@@ -64,7 +64,7 @@ agpu_error AMtlShaderResourceBinding::bindUniformBuffer(agpu_int location, const
     return bindUniformBufferRange(location, uniform_buffer, 0, uniform_buffer.as<AMtlBuffer> ()->description.size);
 }
 
-agpu_error AMtlShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size)
+agpu_error AMtlShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size)
 {
     CHECK_POINTER(uniform_buffer);
     if(location < 0)
@@ -91,7 +91,7 @@ agpu_error AMtlShaderResourceBinding::bindStorageBuffer(agpu_int location, const
     return bindStorageBufferRange(location, storage_buffer, 0, storage_buffer.as<AMtlBuffer> ()->description.size);
 }
 
-agpu_error AMtlShaderResourceBinding::bindStorageBufferRange ( agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_size offset, agpu_size size )
+agpu_error AMtlShaderResourceBinding::bindStorageBufferRange ( agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_device_size offset, agpu_device_size size )
 {
     CHECK_POINTER(storage_buffer);
     if(location < 0)
@@ -84,6 +84,12 @@ agpu::shader_resource_binding_ptr AMtlShaderSignature::createShaderResourceBindi
     return AMtlShaderResourceBinding::create(device, refFromThis<agpu::shader_signature> (), element).disown();
 }
 
+agpu::shader_resource_binding_ptr AMtlShaderSignature::createTransientShaderResourceBinding(agpu_uint element)
+{
+    // There is no cheaper allocation path for short lived bindings.
+    return createShaderResourceBinding(element);
+}
+
 int AMtlShaderSignature::mapDescriptorSetAndBinding(agpu_shader_binding_type type, unsigned int set, unsigned int binding)
 {
     if(set >= elements.size())
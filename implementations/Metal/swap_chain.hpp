@@ -41,6 +41,7 @@ public:
     virtual agpu_size getFramebufferCount() override;
     
     virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) override;
+    virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
 
     agpu::device_ref device;
     NSWindow *window;
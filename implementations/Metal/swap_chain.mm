@@ -268,4 +268,9 @@ agpu_error AMtlSwapChain::setOverlayPosition(agpu_int x, agpu_int y)
     return AGPU_OK;
 }
 
+agpu_error AMtlSwapChain::readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+{
+    return AGPU_UNSUPPORTED;
+}
+
 } // End of namespace AgpuMetal
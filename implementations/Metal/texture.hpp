@@ -20,7 +20,9 @@ public:
     virtual agpu_error readTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
     virtual agpu_error readTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer) override;
     virtual agpu_error uploadTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
+    virtual agpu::fence_ptr uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
     virtual agpu_error uploadTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data) override;
+    virtual agpu_error uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources) override;
     virtual agpu_error getFullViewDescription(agpu_texture_view_description* result) override;
     virtual agpu::texture_view_ptr createView(agpu_texture_view_description* description) override;
 	virtual agpu::texture_view_ptr getOrCreateFullView() override;
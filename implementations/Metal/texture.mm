@@ -4,6 +4,7 @@
 #include "command_queue.hpp"
 #include "constants.hpp"
 #include "../Common/memory_profiler.hpp"
+#include <algorithm>
 
 namespace AgpuMetal
 {
@@ -212,6 +213,22 @@ agpu_error AMtlTexture::uploadTextureData ( agpu_int level, agpu_int arrayIndex,
     return uploadTextureSubData(level, arrayIndex, pitch, slicePitch, nullptr, nullptr, data);
 }
 
+agpu::fence_ptr AMtlTexture::uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data)
+{
+    // The upload is synchronous in this backend, so the fence is signaled right away.
+    auto error = uploadTextureData(level, arrayIndex, pitch, slicePitch, data);
+    if(error)
+        return nullptr;
+
+    auto fence = agpu::fence_ref(device->createFence());
+    if(!fence)
+        return nullptr;
+
+    auto commandQueue = agpu::command_queue_ref(device->getDefaultCommandQueue());
+    commandQueue->signalFence(fence);
+    return fence.disown();
+}
+
 agpu_error AMtlTexture::uploadTextureSubData ( agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data )
 {
     CHECK_POINTER(data);
@@ -251,6 +268,40 @@ agpu_error AMtlTexture::uploadTextureSubData ( agpu_int level, agpu_int arrayInd
     return resultCode;
 }
 
+agpu_error AMtlTexture::uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources)
+{
+    CHECK_POINTER(subresources);
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        CHECK_POINTER(subresources[i].data);
+        if(subresources[i].level >= description.miplevels || subresources[i].array_index >= description.layers)
+            return AGPU_OUT_OF_BOUNDS;
+    }
+
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        auto &subresource = subresources[i];
+
+        // A zero pitch selects tightly packed rows and slices.
+        auto pitch = subresource.pitch;
+        auto slicePitch = subresource.slice_pitch;
+        if(pitch == 0)
+        {
+            auto levelWidth = std::max(description.width >> subresource.level, 1u);
+            auto levelHeight = std::max(description.height >> subresource.level, 1u);
+            pitch = agpu_int(tightlyPackedPitchOfTextureFormat(description.format, levelWidth));
+            if(slicePitch == 0)
+                slicePitch = agpu_int(pitch * tightlyPackedRowCountOfTextureFormat(description.format, levelHeight));
+        }
+
+        auto error = uploadTextureData(subresource.level, subresource.array_index, pitch, slicePitch, subresource.data);
+        if(error)
+            return error;
+    }
+
+    return AGPU_OK;
+}
+
 agpu_error AMtlTexture::getFullViewDescription ( agpu_texture_view_description* viewDescription )
 {
     CHECK_POINTER(viewDescription);
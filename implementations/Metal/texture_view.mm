@@ -74,7 +74,7 @@ agpu::texture_view_ref AMtlTextureView::create(const agpu::device_ref &device, c
             return agpu::texture_view_ref();
     }
 
-    return agpu::makeObject<AMtlTextureView> (device, texture, *description, handle);
+    return agpu::makePooledObject<AMtlTextureView> (device, texture, *description, handle);
 }
 
 agpu::texture_ptr AMtlTextureView::getTexture()
@@ -23,7 +23,7 @@ agpu::vertex_binding_ref AMtlVertexBinding::create(const agpu::device_ref &devic
         return agpu::vertex_binding_ref();
     auto amtlLayout = layout.as<AMtlVertexLayout> ();
     
-    auto result = agpu::makeObject<AMtlVertexBinding> (device);
+    auto result = agpu::makePooledObject<AMtlVertexBinding> (device);
     auto bindings = result.as<AMtlVertexBinding> ();
     bindings->buffers.resize(amtlLayout->vertexStrides.size());
     bindings->offsets.resize(amtlLayout->vertexStrides.size());
@@ -35,7 +35,7 @@ agpu_error AMtlVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_re
     return bindVertexBuffersWithOffsets(count, vertex_buffers, nullptr);
 }
 
-agpu_error AMtlVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_size *offsets)
+agpu_error AMtlVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_device_size *offsets)
 {
     CHECK_POINTER(vertex_buffers);
     if(count != buffers.size())
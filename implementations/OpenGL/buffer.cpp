@@ -40,14 +40,16 @@ agpu::buffer_ref GLBuffer::createBuffer(const agpu::device_ref &device, const ag
     auto binding = mapBinding(description.main_usage_mode);
     auto mappingFlags = mapMappingFlags(description.mapping_flags);
 
-    deviceForGL->onMainContextBlocking([&]{
+    // Buffers are shared between the contexts, so the initial data is uploaded in a worker.
+    deviceForGL->onWorkerContextBlocking([&]{
         // Generate the buffer
         deviceForGL->glGenBuffers(1, &handle);
-        deviceForGL->glBindBuffer(binding, handle);
+        deviceForGL->glBindBuffer(GL_COPY_WRITE_BUFFER, handle);
 
         // Initialize the buffer storage
         //printf("createBuffer %d %p\n", int(description.size), initialData);
-        deviceForGL->glBufferStorage(binding, description.size, initialData, mappingFlags);
+        deviceForGL->glBufferStorage(GL_COPY_WRITE_BUFFER, description.size, initialData, mappingFlags);
+        deviceForGL->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
     });
 
     // Create the buffer object.
@@ -121,21 +123,40 @@ void GLBuffer::dumpToFile(const char *fileName)
     fclose(f);
 }
 
-agpu_error GLBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu_error GLBuffer::uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     //printf("uploadBufferData %d %d %p\n", int(offset), int(size), data);
-    deviceForGL->onMainContextBlocking([&]{
-        bind();
-        deviceForGL->glBufferSubData(target, offset, size, data);
+    deviceForGL->onWorkerContextBlocking([&]{
+        // The copy targets do not disturb the vertex array bindings of the context.
+        deviceForGL->glBindBuffer(GL_COPY_WRITE_BUFFER, handle);
+        deviceForGL->glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        deviceForGL->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
     });
     return AGPU_OK;
 }
 
-agpu_error GLBuffer::readBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu::fence_ptr GLBuffer::uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
-    deviceForGL->onMainContextBlocking([&]{
-        bind();
-        deviceForGL->glGetBufferSubData(target, offset, size, data);
+    // The upload is synchronous in this backend, so the fence is signaled right away.
+    auto error = uploadBufferData(offset, size, data);
+    if(error)
+        return nullptr;
+
+    auto fence = agpu::fence_ref(device->createFence());
+    if(!fence)
+        return nullptr;
+
+    auto commandQueue = agpu::command_queue_ref(device->getDefaultCommandQueue());
+    commandQueue->signalFence(fence);
+    return fence.disown();
+}
+
+agpu_error GLBuffer::readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
+{
+    deviceForGL->onWorkerContextBlocking([&]{
+        deviceForGL->glBindBuffer(GL_COPY_READ_BUFFER, handle);
+        deviceForGL->glGetBufferSubData(GL_COPY_READ_BUFFER, offset, size, data);
+        deviceForGL->glBindBuffer(GL_COPY_READ_BUFFER, 0);
     });
     return AGPU_OK;
 }
@@ -62,8 +62,9 @@ public:
     virtual agpu_pointer mapBuffer(agpu_mapping_access access) override;
     virtual agpu_error unmapBuffer() override;
 	virtual agpu_error getDescription(agpu_buffer_description* description) override;
-    virtual agpu_error uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data) override;
-    virtual agpu_error readBufferData(agpu_size offset, agpu_size size, agpu_pointer data) override;
+    virtual agpu_error uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
+    virtual agpu::fence_ptr uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
+    virtual agpu_error readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) override;
     virtual agpu_error flushWholeBuffer () override;
     virtual agpu_error invalidateWholeBuffer () override;
 
@@ -5,6 +5,9 @@
 #include "framebuffer.hpp"
 #include "renderpass.hpp"
 #include "shader_resource_binding.hpp"
+#include "query_pool.hpp"
+#include "texture.hpp"
+#include "texture_formats.hpp"
 #include <string.h>
 
 namespace AgpuGL
@@ -216,40 +219,56 @@ agpu_error GLCommandList::setShaderSignature(const agpu::shader_signature_ref &s
 
 agpu_error GLCommandList::setViewport(agpu_int x, agpu_int y, agpu_int w, agpu_int h)
 {
-    return addCommand([=] {
-        glViewport(x, y, w, h);
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLSetViewportCommand> ();
+    command->x = x;
+    command->y = y;
+    command->w = w;
+    command->h = h;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::setScissor(agpu_int x, agpu_int y, agpu_int w, agpu_int h)
 {
-    return addCommand([=] {
-        glScissor(x, y, w, h);
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLSetScissorCommand> ();
+    command->x = x;
+    command->y = y;
+    command->w = w;
+    command->h = h;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::usePipelineState(const agpu::pipeline_state_ref &pipeline)
 {
-	switch (pipeline.as<GLPipelineState>()->type)
-	{
-	case AgpuPipelineStateType::Graphics:
-		return addCommand([=] {
-			executionContext.usePipelineState(pipeline);
-		});
-	case AgpuPipelineStateType::Compute:
-		return addCommand([=] {
-			executionContext.useComputePipelineState(pipeline);
-		});
-	default:
-		return AGPU_UNSUPPORTED;
-	}
+    CHECK_POINTER(pipeline);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    switch (pipeline.as<GLPipelineState>()->type)
+    {
+    case AgpuPipelineStateType::Graphics:
+        commandStream.append<GLUsePipelineStateCommand> ()->pipeline = referenceObject(pipelineStates, pipeline);
+        return AGPU_OK;
+    case AgpuPipelineStateType::Compute:
+        commandStream.append<GLUseComputePipelineStateCommand> ()->pipeline = referenceObject(pipelineStates, pipeline);
+        return AGPU_OK;
+    default:
+        return AGPU_UNSUPPORTED;
+    }
 }
 
 agpu_error GLCommandList::useVertexBinding(const agpu::vertex_binding_ref &vertex_binding)
 {
-    return addCommand([=] {
-        this->currentVertexBinding = vertex_binding;
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLUseVertexBindingCommand> ()->vertexBinding = referenceObject(vertexBindings, vertex_binding);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::useIndexBuffer(const agpu::buffer_ref &index_buffer)
@@ -258,155 +277,150 @@ agpu_error GLCommandList::useIndexBuffer(const agpu::buffer_ref &index_buffer)
 }
 
 
-agpu_error GLCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error GLCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_device_size offset, agpu_size index_size)
 {
-    return addCommand([=] {
-        this->currentIndexBuffer = index_buffer;
-        this->currentIndexBufferOffset = offset;
-        this->currentIndexBufferIndexSize = index_size;
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLUseIndexBufferCommand> ();
+    command->buffer = referenceObject(buffers, index_buffer);
+    command->indexSize = uint32_t(index_size);
+    command->offset = offset;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::useDrawIndirectBuffer(const agpu::buffer_ref &draw_buffer)
 {
-    return addCommand([=] {
-        this->currentDrawBuffer = draw_buffer;
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLUseDrawIndirectBufferCommand> ()->buffer = referenceObject(buffers, draw_buffer);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::useComputeDispatchIndirectBuffer(const agpu::buffer_ref &buffer)
 {
-    return addCommand([=] {
-        this->currentComputeDispatchBuffer = buffer;
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLUseComputeDispatchIndirectBufferCommand> ()->buffer = referenceObject(buffers, buffer);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::useShaderResources(const agpu::shader_resource_binding_ref &binding)
 {
     CHECK_POINTER(binding);
-    return addCommand([=] {
-        executionContext.useShaderResources(binding);
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLUseShaderResourcesCommand> ()->binding = referenceObject(shaderResourceBindings, binding);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::useComputeShaderResources(const agpu::shader_resource_binding_ref &binding)
 {
     CHECK_POINTER(binding);
-    return addCommand([=] {
-        executionContext.useComputeShaderResources(binding);
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLUseComputeShaderResourcesCommand> ()->binding = referenceObject(shaderResourceBindings, binding);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::pushConstants(agpu_uint offset, agpu_uint size, agpu_pointer values)
 {
     CHECK_POINTER(values);
+    if (offset > sizeof(executionContext.pushConstantBuffer) ||
+        size > sizeof(executionContext.pushConstantBuffer) - offset)
+        return AGPU_OUT_OF_BOUNDS;
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-    auto rawSource = reinterpret_cast<const uint8_t*> (values);
-    std::vector<uint8_t> dataCopy(rawSource, rawSource + size);
-    return addCommand([=] {
-        memcpy(executionContext.pushConstantBuffer + offset, &dataCopy[0], size);
-        executionContext.hasValidGraphicsPushConstants = false;
-        executionContext.hasValidComputePushConstants = false;
-    });
+    // The values are copied inline, right after the packet.
+    auto command = commandStream.append<GLPushConstantsCommand> (size);
+    command->offset = offset;
+    command->size = size;
+    memcpy(GLCommandStream::payloadOf(command), values, size);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::drawArrays(agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance)
 {
-    return addCommand([=] {
-        if (!currentVertexBinding)
-            return;
-
-        currentVertexBinding.as<GLVertexBinding> ()->bind();
-        executionContext.validateBeforeDrawCall();
-        executionContext.setBaseInstance(base_instance);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        deviceForGL->glDrawArraysInstancedBaseInstance(executionContext.primitiveMode, first_vertex, vertex_count, instance_count, base_instance);
-    });
+    auto command = commandStream.append<GLDrawArraysCommand> ();
+    command->vertexCount = vertex_count;
+    command->instanceCount = instance_count;
+    command->firstVertex = first_vertex;
+    command->baseInstance = base_instance;
+    return AGPU_OK;
 }
 
-agpu_error GLCommandList::drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error GLCommandList::drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 {
-    return addCommand([=] {
-        if (!currentVertexBinding || !currentDrawBuffer)
-            return;
-
-        currentVertexBinding.as<GLVertexBinding> ()->bind();
-        currentDrawBuffer.as<GLBuffer> ()->bind();
-        executionContext.validateBeforeDrawCall();
-        executionContext.setBaseInstance(0);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        if(drawcount > 1)
-            deviceForGL->glMultiDrawArraysIndirect(executionContext.primitiveMode, reinterpret_cast<void*> ((size_t)offset), (GLsizei)drawcount, currentDrawBuffer.as<GLBuffer> ()->description.stride);
-        else
-            deviceForGL->glDrawArraysIndirect(executionContext.primitiveMode, reinterpret_cast<void*> ((size_t)offset));
-    });
+    auto command = commandStream.append<GLDrawArraysIndirectCommand> ();
+    command->offset = offset;
+    command->drawCount = drawcount;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::drawElements(agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance)
 {
-    return addCommand([=] {
-        if (!currentVertexBinding || !currentIndexBuffer)
-            return;
-
-        currentVertexBinding.as<GLVertexBinding> ()->bind();
-        currentIndexBuffer.as<GLBuffer> ()->bind();
-        executionContext.validateBeforeDrawCall();
-        executionContext.setBaseInstance(base_instance);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        size_t stride = currentIndexBufferIndexSize;
-        size_t offset = currentIndexBufferOffset + stride*first_index;
-        deviceForGL->glDrawElementsInstancedBaseVertexBaseInstance(executionContext.primitiveMode, index_count,
-            mapIndexType(stride), reinterpret_cast<void*> (offset),
-            instance_count, base_vertex, base_instance);
-    });
+    auto command = commandStream.append<GLDrawElementsCommand> ();
+    command->indexCount = index_count;
+    command->instanceCount = instance_count;
+    command->firstIndex = first_index;
+    command->baseVertex = base_vertex;
+    command->baseInstance = base_instance;
+    return AGPU_OK;
 }
 
-agpu_error GLCommandList::drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error GLCommandList::drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 {
-    return addCommand([=] {
-        if (!currentVertexBinding || !currentIndexBuffer || !currentDrawBuffer)
-            return;
-
-        currentVertexBinding.as<GLVertexBinding> ()->bind();
-        currentIndexBuffer.as<GLBuffer> ()->bind();
-        currentDrawBuffer.as<GLBuffer> ()->bind();
-        executionContext.validateBeforeDrawCall();
-        executionContext.setBaseInstance(0);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        if(drawcount > 1)
-            deviceForGL->glMultiDrawElementsIndirect(executionContext.primitiveMode, mapIndexType(currentIndexBuffer.as<GLBuffer> ()->description.stride), reinterpret_cast<void*> ((size_t)offset), (GLsizei)drawcount, currentDrawBuffer.as<GLBuffer> ()->description.stride);
-        else
-            deviceForGL->glDrawElementsIndirect(executionContext.primitiveMode, mapIndexType(currentIndexBuffer.as<GLBuffer> ()->description.stride), reinterpret_cast<void*> ((size_t)offset));
-    });
+    auto command = commandStream.append<GLDrawElementsIndirectCommand> ();
+    command->offset = offset;
+    command->drawCount = drawcount;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::dispatchCompute(agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z)
 {
-    return addCommand([=] {
-        executionContext.validateBeforeComputeDispatch();
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        deviceForGL->glDispatchCompute(group_count_x, group_count_y, group_count_z);
-    });
+    auto command = commandStream.append<GLDispatchComputeCommand> ();
+    command->groupCountX = group_count_x;
+    command->groupCountY = group_count_y;
+    command->groupCountZ = group_count_z;
+    return AGPU_OK;
 }
 
-agpu_error GLCommandList::dispatchComputeIndirect(agpu_size offset)
+agpu_error GLCommandList::dispatchComputeIndirect(agpu_device_size offset)
 {
-    return addCommand([=] {
-        if(!currentComputeDispatchBuffer)
-            return;
-
-        currentComputeDispatchBuffer.as<GLBuffer> ()->bind();
-        executionContext.validateBeforeComputeDispatch();
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-        deviceForGL->glDispatchComputeIndirect(offset);
-    });
+    commandStream.append<GLDispatchComputeIndirectCommand> ()->offset = offset;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::setStencilReference(agpu_uint reference)
 {
-    return addCommand([=] {
-        executionContext.setStencilReference(reference);
-    });
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    commandStream.append<GLSetStencilReferenceCommand> ()->reference = reference;
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::executeBundle(const agpu::command_list_ref &bundle)
@@ -414,10 +428,11 @@ agpu_error GLCommandList::executeBundle(const agpu::command_list_ref &bundle)
     CHECK_POINTER(bundle)
     if(bundle.as<GLCommandList> ()->type != AGPU_COMMAND_LIST_TYPE_BUNDLE)
         return AGPU_INVALID_PARAMETER;
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-    return addCommand([=] {
-        bundle.as<GLCommandList> ()->execute();
-    });
+    commandStream.append<GLExecuteBundleCommand> ()->bundle = referenceObject(bundles, bundle);
+    return AGPU_OK;
 }
 
 agpu_error GLCommandList::close()
@@ -426,10 +441,24 @@ agpu_error GLCommandList::close()
     return AGPU_OK;
 }
 
+void GLCommandList::clearCommands()
+{
+    commandStream.clear();
+    pipelineStates.clear();
+    vertexBindings.clear();
+    buffers.clear();
+    shaderResourceBindings.clear();
+    bundles.clear();
+    renderpasses.clear();
+    framebuffers.clear();
+    queryPools.clear();
+    textures.clear();
+}
+
 agpu_error GLCommandList::reset(const agpu::command_allocator_ref &allocator, const agpu::pipeline_state_ref &initial_pipeline_state)
 {
     closed = false;
-    commands.clear();
+    clearCommands();
     if (initial_pipeline_state)
         usePipelineState(initial_pipeline_state);
     return AGPU_OK;
@@ -439,7 +468,7 @@ agpu_error GLCommandList::reset(const agpu::command_allocator_ref &allocator, co
 agpu_error GLCommandList::resetBundle(const agpu::command_allocator_ref & allocator, const agpu::pipeline_state_ref & initial_pipeline_state, agpu_inheritance_info* inheritance_info)
 {
     closed = false;
-    commands.clear();
+    clearCommands();
     if (initial_pipeline_state)
         usePipelineState(initial_pipeline_state);
     return AGPU_OK;
@@ -448,29 +477,21 @@ agpu_error GLCommandList::resetBundle(const agpu::command_allocator_ref & alloca
 agpu_error GLCommandList::beginRenderPass(const agpu::renderpass_ref &renderpass, const agpu::framebuffer_ref &framebuffer, agpu_bool bundle_content)
 {
     CHECK_POINTER(framebuffer)
-    return addCommand([=] {
-        auto glFramebuffer = framebuffer.as<GLFramebuffer>();
-        glFramebuffer->bind();
-        glViewport(0, 0, glFramebuffer->width, glFramebuffer->height);
-        glScissor(0, 0, glFramebuffer->width, glFramebuffer->height);
-        renderpass.as<GLRenderPass>()->started();
-    });
-}
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-agpu_error GLCommandList::endRenderPass()
-{
-    return addCommand([=] {
-        deviceForGL->glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    });
+    auto command = commandStream.append<GLBeginRenderPassCommand> ();
+    command->renderpass = referenceObject(renderpasses, renderpass);
+    command->framebuffer = referenceObject(framebuffers, framebuffer);
     return AGPU_OK;
 }
 
-agpu_error GLCommandList::addCommand(const AgpuGLCommand &command)
+agpu_error GLCommandList::endRenderPass()
 {
     if (closed)
         return AGPU_COMMAND_LIST_CLOSED;
 
-    commands.push_back(command);
+    commandStream.append<GLEndRenderPassCommand> ();
     return AGPU_OK;
 }
 
@@ -480,26 +501,245 @@ void GLCommandList::execute()
     currentIndexBuffer.reset();
     currentDrawBuffer.reset();
     currentComputeDispatchBuffer.reset();
-    for (auto &command : commands)
-        command();
+
+    auto position = commandStream.begin();
+    auto end = commandStream.end();
+    while(position < end)
+    {
+        auto header = reinterpret_cast<const GLCommandHeader*> (position);
+        switch(header->opcode)
+        {
+        case GLCommandOpcode::SetViewport:
+            {
+                auto command = reinterpret_cast<const GLSetViewportCommand*> (header);
+                glViewport(command->x, command->y, command->w, command->h);
+            }
+            break;
+        case GLCommandOpcode::SetScissor:
+            {
+                auto command = reinterpret_cast<const GLSetScissorCommand*> (header);
+                glScissor(command->x, command->y, command->w, command->h);
+            }
+            break;
+        case GLCommandOpcode::UsePipelineState:
+            executionContext.usePipelineState(pipelineStates[reinterpret_cast<const GLUsePipelineStateCommand*> (header)->pipeline]);
+            break;
+        case GLCommandOpcode::UseComputePipelineState:
+            executionContext.useComputePipelineState(pipelineStates[reinterpret_cast<const GLUseComputePipelineStateCommand*> (header)->pipeline]);
+            break;
+        case GLCommandOpcode::UseVertexBinding:
+            currentVertexBinding = vertexBindings[reinterpret_cast<const GLUseVertexBindingCommand*> (header)->vertexBinding];
+            break;
+        case GLCommandOpcode::UseIndexBuffer:
+            {
+                auto command = reinterpret_cast<const GLUseIndexBufferCommand*> (header);
+                currentIndexBuffer = buffers[command->buffer];
+                currentIndexBufferOffset = command->offset;
+                currentIndexBufferIndexSize = command->indexSize;
+            }
+            break;
+        case GLCommandOpcode::UseDrawIndirectBuffer:
+            currentDrawBuffer = buffers[reinterpret_cast<const GLUseDrawIndirectBufferCommand*> (header)->buffer];
+            break;
+        case GLCommandOpcode::UseComputeDispatchIndirectBuffer:
+            currentComputeDispatchBuffer = buffers[reinterpret_cast<const GLUseComputeDispatchIndirectBufferCommand*> (header)->buffer];
+            break;
+        case GLCommandOpcode::UseShaderResources:
+            executionContext.useShaderResources(shaderResourceBindings[reinterpret_cast<const GLUseShaderResourcesCommand*> (header)->binding]);
+            break;
+        case GLCommandOpcode::UseComputeShaderResources:
+            executionContext.useComputeShaderResources(shaderResourceBindings[reinterpret_cast<const GLUseComputeShaderResourcesCommand*> (header)->binding]);
+            break;
+        case GLCommandOpcode::PushConstants:
+            {
+                auto command = reinterpret_cast<const GLPushConstantsCommand*> (header);
+                memcpy(executionContext.pushConstantBuffer + command->offset, command + 1, command->size);
+                executionContext.hasValidGraphicsPushConstants = false;
+                executionContext.hasValidComputePushConstants = false;
+            }
+            break;
+        case GLCommandOpcode::DrawArrays:
+            executeDrawArrays(reinterpret_cast<const GLDrawArraysCommand*> (header));
+            break;
+        case GLCommandOpcode::DrawArraysIndirect:
+            executeDrawArraysIndirect(reinterpret_cast<const GLDrawArraysIndirectCommand*> (header));
+            break;
+        case GLCommandOpcode::DrawElements:
+            executeDrawElements(reinterpret_cast<const GLDrawElementsCommand*> (header));
+            break;
+        case GLCommandOpcode::DrawElementsIndirect:
+            executeDrawElementsIndirect(reinterpret_cast<const GLDrawElementsIndirectCommand*> (header));
+            break;
+        case GLCommandOpcode::DispatchCompute:
+            {
+                auto command = reinterpret_cast<const GLDispatchComputeCommand*> (header);
+                executionContext.validateBeforeComputeDispatch();
+                deviceForGL->glDispatchCompute(command->groupCountX, command->groupCountY, command->groupCountZ);
+            }
+            break;
+        case GLCommandOpcode::DispatchComputeIndirect:
+            if(currentComputeDispatchBuffer)
+            {
+                currentComputeDispatchBuffer.as<GLBuffer> ()->bind();
+                executionContext.validateBeforeComputeDispatch();
+                deviceForGL->glDispatchComputeIndirect(reinterpret_cast<const GLDispatchComputeIndirectCommand*> (header)->offset);
+            }
+            break;
+        case GLCommandOpcode::SetStencilReference:
+            executionContext.setStencilReference(reinterpret_cast<const GLSetStencilReferenceCommand*> (header)->reference);
+            break;
+        case GLCommandOpcode::ExecuteBundle:
+            bundles[reinterpret_cast<const GLExecuteBundleCommand*> (header)->bundle].as<GLCommandList> ()->execute();
+            break;
+        case GLCommandOpcode::BeginRenderPass:
+            executeBeginRenderPass(reinterpret_cast<const GLBeginRenderPassCommand*> (header));
+            break;
+        case GLCommandOpcode::EndRenderPass:
+            deviceForGL->glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            break;
+        case GLCommandOpcode::ResolveFramebuffer:
+            executeResolveFramebuffer(reinterpret_cast<const GLResolveFramebufferCommand*> (header));
+            break;
+        case GLCommandOpcode::ResetQueryPool:
+            {
+                auto command = reinterpret_cast<const GLResetQueryPoolCommand*> (header);
+                queryPools[command->queryPool].as<GLQueryPool> ()->resetQueries(command->firstQuery, command->queryCount);
+            }
+            break;
+        case GLCommandOpcode::WriteTimestamp:
+            {
+                auto command = reinterpret_cast<const GLWriteTimestampCommand*> (header);
+                queryPools[command->queryPool].as<GLQueryPool> ()->writeTimestamp(command->queryIndex);
+            }
+            break;
+        case GLCommandOpcode::BeginQuery:
+            {
+                auto command = reinterpret_cast<const GLBeginQueryCommand*> (header);
+                queryPools[command->queryPool].as<GLQueryPool> ()->beginQuery(command->queryIndex);
+            }
+            break;
+        case GLCommandOpcode::EndQuery:
+            {
+                auto command = reinterpret_cast<const GLEndQueryCommand*> (header);
+                queryPools[command->queryPool].as<GLQueryPool> ()->endQuery(command->queryIndex);
+            }
+            break;
+        case GLCommandOpcode::GenerateMipmaps:
+            executeGenerateMipmaps(reinterpret_cast<const GLGenerateMipmapsCommand*> (header));
+            break;
+        }
+
+        position += header->size;
+    }
 
     executionContext.reset();
 }
 
+void GLCommandList::executeDrawArrays(const GLDrawArraysCommand *command)
+{
+    if (!currentVertexBinding)
+        return;
+
+    currentVertexBinding.as<GLVertexBinding> ()->bind();
+    executionContext.validateBeforeDrawCall();
+    executionContext.setBaseInstance(command->baseInstance);
+
+    deviceForGL->glDrawArraysInstancedBaseInstance(executionContext.primitiveMode, command->firstVertex, command->vertexCount, command->instanceCount, command->baseInstance);
+}
+
+void GLCommandList::executeDrawArraysIndirect(const GLDrawArraysIndirectCommand *command)
+{
+    if (!currentVertexBinding || !currentDrawBuffer)
+        return;
+
+    currentVertexBinding.as<GLVertexBinding> ()->bind();
+    currentDrawBuffer.as<GLBuffer> ()->bind();
+    executionContext.validateBeforeDrawCall();
+    executionContext.setBaseInstance(0);
+
+    if(command->drawCount > 1)
+        deviceForGL->glMultiDrawArraysIndirect(executionContext.primitiveMode, reinterpret_cast<void*> ((size_t)command->offset), (GLsizei)command->drawCount, currentDrawBuffer.as<GLBuffer> ()->description.stride);
+    else
+        deviceForGL->glDrawArraysIndirect(executionContext.primitiveMode, reinterpret_cast<void*> ((size_t)command->offset));
+}
+
+void GLCommandList::executeDrawElements(const GLDrawElementsCommand *command)
+{
+    if (!currentVertexBinding || !currentIndexBuffer)
+        return;
+
+    currentVertexBinding.as<GLVertexBinding> ()->bind();
+    currentIndexBuffer.as<GLBuffer> ()->bind();
+    executionContext.validateBeforeDrawCall();
+    executionContext.setBaseInstance(command->baseInstance);
+
+    size_t stride = currentIndexBufferIndexSize;
+    size_t offset = currentIndexBufferOffset + stride*command->firstIndex;
+    deviceForGL->glDrawElementsInstancedBaseVertexBaseInstance(executionContext.primitiveMode, command->indexCount,
+        mapIndexType(stride), reinterpret_cast<void*> (offset),
+        command->instanceCount, command->baseVertex, command->baseInstance);
+}
+
+void GLCommandList::executeDrawElementsIndirect(const GLDrawElementsIndirectCommand *command)
+{
+    if (!currentVertexBinding || !currentIndexBuffer || !currentDrawBuffer)
+        return;
+
+    currentVertexBinding.as<GLVertexBinding> ()->bind();
+    currentIndexBuffer.as<GLBuffer> ()->bind();
+    currentDrawBuffer.as<GLBuffer> ()->bind();
+    executionContext.validateBeforeDrawCall();
+    executionContext.setBaseInstance(0);
+
+    if(command->drawCount > 1)
+        deviceForGL->glMultiDrawElementsIndirect(executionContext.primitiveMode, mapIndexType(currentIndexBuffer.as<GLBuffer> ()->description.stride), reinterpret_cast<void*> ((size_t)command->offset), (GLsizei)command->drawCount, currentDrawBuffer.as<GLBuffer> ()->description.stride);
+    else
+        deviceForGL->glDrawElementsIndirect(executionContext.primitiveMode, mapIndexType(currentIndexBuffer.as<GLBuffer> ()->description.stride), reinterpret_cast<void*> ((size_t)command->offset));
+}
+
+void GLCommandList::executeBeginRenderPass(const GLBeginRenderPassCommand *command)
+{
+    auto glFramebuffer = framebuffers[command->framebuffer].as<GLFramebuffer>();
+    glFramebuffer->bind();
+    glViewport(0, 0, glFramebuffer->width, glFramebuffer->height);
+    glScissor(0, 0, glFramebuffer->width, glFramebuffer->height);
+    renderpasses[command->renderpass].as<GLRenderPass>()->started();
+}
+
+void GLCommandList::executeResolveFramebuffer(const GLResolveFramebufferCommand *command)
+{
+    auto destFramebuffer = framebuffers[command->destFramebuffer].as<GLFramebuffer> ();
+    auto sourceFramebuffer = framebuffers[command->sourceFramebuffer].as<GLFramebuffer> ();
+    destFramebuffer->bind(GL_DRAW_FRAMEBUFFER);
+    sourceFramebuffer->bind(GL_READ_FRAMEBUFFER);
+    deviceForGL->glBlitFramebuffer(
+        0, 0, sourceFramebuffer->width, sourceFramebuffer->height,
+        0, 0, destFramebuffer->width, destFramebuffer->height,
+        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+}
+
+void GLCommandList::executeGenerateMipmaps(const GLGenerateMipmapsCommand *command)
+{
+    // The levels of sRGB textures are filtered in linear space by the driver.
+    auto texture = textures[command->texture].as<GLTexture> ();
+    glBindTexture(texture->target, texture->handle);
+    deviceForGL->glGenerateMipmap(texture->target);
+
+    // The texture unit that was used may hold a texture of the bound resources.
+    executionContext.hasValidShaderResources = false;
+    executionContext.hasValidComputeShaderResources = false;
+}
+
 agpu_error GLCommandList::resolveFramebuffer(const agpu::framebuffer_ref &destFramebuffer, const agpu::framebuffer_ref &sourceFramebuffer)
 {
     CHECK_POINTER(destFramebuffer);
     CHECK_POINTER(sourceFramebuffer);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
 
-    return addCommand([=] {
-        destFramebuffer.as<GLFramebuffer>()->bind(GL_DRAW_FRAMEBUFFER);
-        sourceFramebuffer.as<GLFramebuffer>()->bind(GL_READ_FRAMEBUFFER);
-        deviceForGL->glBlitFramebuffer(
-            0, 0, sourceFramebuffer.as<GLFramebuffer>()->width, sourceFramebuffer.as<GLFramebuffer>()->height,
-            0, 0, destFramebuffer.as<GLFramebuffer>()->width, destFramebuffer.as<GLFramebuffer>()->height,
-            GL_COLOR_BUFFER_BIT, GL_NEAREST);
-    });
-
+    auto command = commandStream.append<GLResolveFramebufferCommand> ();
+    command->destFramebuffer = referenceObject(framebuffers, destFramebuffer);
+    command->sourceFramebuffer = referenceObject(framebuffers, sourceFramebuffer);
     return AGPU_OK;
 }
 
@@ -515,7 +755,7 @@ agpu_error GLCommandList::memoryBarrier(agpu_pipeline_stage_flags source_stage,
     return AGPU_UNIMPLEMENTED;
 }
 
-agpu_error GLCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+agpu_error GLCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 {
     return memoryBarrier(source_stage, dest_stage, source_accesses, dest_accesses);
 }
@@ -545,7 +785,7 @@ agpu_error GLCommandList::popTextureTransitionBarrier()
     return AGPU_UNIMPLEMENTED;
 }
 
-agpu_error GLCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+agpu_error GLCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 {
     return AGPU_UNIMPLEMENTED;
 }
@@ -559,4 +799,93 @@ agpu_error GLCommandList::copyTextureToBuffer(const agpu::texture_ref & texture,
 {
     return AGPU_UNIMPLEMENTED;
 }
+
+agpu_error GLCommandList::resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count)
+{
+    CHECK_POINTER(query_pool);
+    auto glQueryPool = query_pool.as<GLQueryPool> ();
+    if(first_query > glQueryPool->description.query_count || query_count > glQueryPool->description.query_count - first_query)
+        return AGPU_OUT_OF_BOUNDS;
+
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLResetQueryPoolCommand> ();
+    command->queryPool = referenceObject(queryPools, query_pool);
+    command->firstQuery = first_query;
+    command->queryCount = query_count;
+    return AGPU_OK;
+}
+
+agpu_error GLCommandList::writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto glQueryPool = query_pool.as<GLQueryPool> ();
+    if(glQueryPool->description.type != AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= glQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLWriteTimestampCommand> ();
+    command->queryPool = referenceObject(queryPools, query_pool);
+    command->queryIndex = query_index;
+    return AGPU_OK;
+}
+
+agpu_error GLCommandList::beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto glQueryPool = query_pool.as<GLQueryPool> ();
+    if(glQueryPool->description.type == AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= glQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLBeginQueryCommand> ();
+    command->queryPool = referenceObject(queryPools, query_pool);
+    command->queryIndex = query_index;
+    return AGPU_OK;
+}
+
+agpu_error GLCommandList::endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto glQueryPool = query_pool.as<GLQueryPool> ();
+    if(glQueryPool->description.type == AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= glQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto command = commandStream.append<GLEndQueryCommand> ();
+    command->queryPool = referenceObject(queryPools, query_pool);
+    command->queryIndex = query_index;
+    return AGPU_OK;
+}
+
+agpu_error GLCommandList::generateMipmaps(const agpu::texture_ref & texture)
+{
+    CHECK_POINTER(texture);
+    if (closed)
+        return AGPU_COMMAND_LIST_CLOSED;
+
+    auto &description = texture.as<GLTexture> ()->description;
+    if(description.miplevels <= 1)
+        return AGPU_OK;
+    if(description.sample_count > 1 || isCompressedTextureFormat(description.format))
+        return AGPU_UNSUPPORTED;
+
+    auto command = commandStream.append<GLGenerateMipmapsCommand> ();
+    command->texture = referenceObject(textures, texture);
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuGL
@@ -2,14 +2,12 @@
 #define AGPU_COMMAND_LIST_HPP_
 
 #include <vector>
-#include <functional>
 #include "device.hpp"
+#include "command_stream.hpp"
 
 namespace AgpuGL
 {
 
-typedef std::function<void()> AgpuGLCommand;
-
 struct CommandListExecutionContext
 {
     static constexpr unsigned int MaxNumberOfShaderResourceBindings = 16;
@@ -60,18 +58,18 @@ public:
     virtual agpu_error usePipelineState(const agpu::pipeline_state_ref &pipeline) override;
     virtual agpu_error useVertexBinding(const agpu::vertex_binding_ref &vertex_binding) override;
     virtual agpu_error useIndexBuffer(const agpu::buffer_ref &index_buffer) override;
-    virtual agpu_error useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_size offset, agpu_size index_size) override;
+    virtual agpu_error useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_device_size offset, agpu_size index_size) override;
     virtual agpu_error useDrawIndirectBuffer(const agpu::buffer_ref &draw_buffer) override;
     virtual agpu_error useComputeDispatchIndirectBuffer(const agpu::buffer_ref &draw_buffer) override;
     virtual agpu_error useShaderResources (const agpu::shader_resource_binding_ref &binding) override;
     virtual agpu_error useComputeShaderResources(const agpu::shader_resource_binding_ref &binding) override;
     virtual agpu_error pushConstants(agpu_uint offset, agpu_uint size, agpu_pointer values) override;
     virtual agpu_error drawArrays(agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance) override;
-    virtual agpu_error drawArraysIndirect(agpu_size offset, agpu_size drawcount) override;
+    virtual agpu_error drawArraysIndirect(agpu_device_size offset, agpu_size drawcount) override;
     virtual agpu_error drawElements(agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance) override;
-    virtual agpu_error drawElementsIndirect(agpu_size offset, agpu_size drawcount) override;
+    virtual agpu_error drawElementsIndirect(agpu_device_size offset, agpu_size drawcount) override;
     virtual agpu_error dispatchCompute(agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z) override;
-    virtual agpu_error dispatchComputeIndirect(agpu_size offset) override;
+    virtual agpu_error dispatchComputeIndirect(agpu_device_size offset) override;
     virtual agpu_error setStencilReference(agpu_uint reference) override;
     virtual agpu_error executeBundle(const agpu::command_list_ref &bundle) override;
     virtual agpu_error close() override;
@@ -83,15 +81,21 @@ public:
     virtual agpu_error resolveTexture(const agpu::texture_ref & sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, const agpu::texture_ref & destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect) override;
 
     virtual agpu_error memoryBarrier(agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses) override;
-    virtual agpu_error bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size) override;
     virtual agpu_error textureMemoryBarrier(const agpu::texture_ref & texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_subresource_range* subresource_range) override;
     virtual agpu_error pushBufferTransitionBarrier(const agpu::buffer_ref & buffer, agpu_buffer_usage_mask new_usage) override;
     virtual agpu_error pushTextureTransitionBarrier(const agpu::texture_ref & texture, agpu_texture_usage_mode_mask new_usage, agpu_subresource_range* subresource_range) override;
     virtual agpu_error popBufferTransitionBarrier() override;
     virtual agpu_error popTextureTransitionBarrier() override;
-    virtual agpu_error copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size) override;
+    virtual agpu_error copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size) override;
     virtual agpu_error copyBufferToTexture(const agpu::buffer_ref & buffer, const agpu::texture_ref & texture, agpu_buffer_image_copy_region* copy_region) override;
     virtual agpu_error copyTextureToBuffer(const agpu::texture_ref & texture, const agpu::buffer_ref & buffer, agpu_buffer_image_copy_region* copy_region) override;
+    virtual agpu_error generateMipmaps(const agpu::texture_ref & texture) override;
+
+    virtual agpu_error resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count) override;
+    virtual agpu_error writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
+    virtual agpu_error beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
+    virtual agpu_error endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index) override;
 
 public:
     agpu::device_ref device;
@@ -110,9 +114,35 @@ public:
     void execute();
 
 private:
-    agpu_error addCommand(const AgpuGLCommand &command);
+    template<typename T>
+    static uint32_t referenceObject(std::vector<T> &objects, const T &object)
+    {
+        // Consecutive commands usually reference the same object.
+        if(objects.empty() || objects.back() != object)
+            objects.push_back(object);
+        return uint32_t(objects.size() - 1);
+    }
+
+    void clearCommands();
+    void executeDrawArrays(const GLDrawArraysCommand *command);
+    void executeDrawArraysIndirect(const GLDrawArraysIndirectCommand *command);
+    void executeDrawElements(const GLDrawElementsCommand *command);
+    void executeDrawElementsIndirect(const GLDrawElementsIndirectCommand *command);
+    void executeBeginRenderPass(const GLBeginRenderPassCommand *command);
+    void executeResolveFramebuffer(const GLResolveFramebufferCommand *command);
+    void executeGenerateMipmaps(const GLGenerateMipmapsCommand *command);
+
+    GLCommandStream commandStream;
+    std::vector<agpu::pipeline_state_ref> pipelineStates;
+    std::vector<agpu::vertex_binding_ref> vertexBindings;
+    std::vector<agpu::buffer_ref> buffers;
+    std::vector<agpu::shader_resource_binding_ref> shaderResourceBindings;
+    std::vector<agpu::command_list_ref> bundles;
+    std::vector<agpu::renderpass_ref> renderpasses;
+    std::vector<agpu::framebuffer_ref> framebuffers;
+    std::vector<agpu::query_pool_ref> queryPools;
+    std::vector<agpu::texture_ref> textures;
 
-    std::vector<AgpuGLCommand> commands;
     bool closed;
     CommandListExecutionContext executionContext;
 };
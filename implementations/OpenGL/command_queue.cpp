@@ -51,50 +51,6 @@ public:
     std::condition_variable finishedCondition;
 };
 
-class GpuSignalFenceCommand: public GpuCommand
-{
-public:
-    GpuSignalFenceCommand(const agpu::fence_ref &fence)
-        : fence(fence), signaled(false)
-    {
-
-    }
-
-    virtual void execute()
-    {
-        auto glFence = fence.as<GLFence> ();
-        std::unique_lock<std::mutex> l(glFence->mutex);
-
-        auto device = OpenGLContext::getCurrent()->weakDevice.lock();
-        if(glFence->fenceObject)
-            deviceForGL->glDeleteSync(glFence->fenceObject);
-
-        glFence->fenceObject = deviceForGL->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-        glFlush();
-    }
-
-    virtual void destroy()
-    {
-        auto glFence = fence.as<GLFence> ();
-        std::unique_lock<std::mutex> l(glFence->mutex);
-        signaled = true;
-        glFence->sendCommandCondition.notify_all();
-    }
-
-    void wait()
-    {
-        auto glFence = fence.as<GLFence> ();
-        {
-            std::unique_lock<std::mutex> l(glFence->mutex);
-            while(!signaled)
-                glFence->sendCommandCondition.wait(l);
-        }
-    }
-
-    agpu::fence_ref fence;
-    bool signaled;
-};
-
 class GpuExecuteCommandList: public GpuCommand
 {
 public:
@@ -109,7 +65,9 @@ public:
 
     virtual void execute()
     {
-        command_list.as<GLCommandList> ()->execute();
+        auto glCommandList = command_list.as<GLCommandList> ();
+        glCommandList->execute();
+        glCommandList->device.as<GLDevice> ()->signalMainContextSubmission();
     }
 
     virtual void destroy()
@@ -157,6 +115,7 @@ agpu::command_queue_ref GLCommandQueue::create(const agpu::device_ref &device)
 {
 	auto result = agpu::makeObject<GLCommandQueue> ();
     result.as<GLCommandQueue> ()->weakDevice = device;
+    result.as<GLCommandQueue> ()->timelineState = std::make_shared<GLFenceSignalState> ();
 	return result;
 }
 
@@ -191,26 +150,67 @@ agpu_error GLCommandQueue::finishExecution()
 
 agpu_error GLCommandQueue::signalFence(const agpu::fence_ref &fence )
 {
-    GpuSignalFenceCommand signalCommand(fence);
-    addCommand(&signalCommand);
-    signalCommand.wait();
-    return AGPU_OK;
+    CHECK_POINTER(fence);
+
+    // The signal is only queued, its completion is tracked by the fence.
+    auto signalNumber = fence.as<GLFence> ()->requestSignal();
+    return addCustomCommand([=]() {
+        fence.as<GLFence> ()->executeSignal(signalNumber);
+    });
 }
 
 agpu_error GLCommandQueue::waitFence(const agpu::fence_ref &fence )
 {
-    GLsync fenceObject = nullptr;
+    CHECK_POINTER(fence);
+    return addCustomCommand([=]() {
+        fence.as<GLFence> ()->executeGPUWait();
+    });
+}
+
+agpu_error GLCommandQueue::signalTimelineValue(agpu_ulong value)
+{
+    auto device = weakDevice.lock();
     {
-        auto glFence = fence.as<GLFence> ();
-        std::unique_lock<std::mutex> l(glFence->mutex);
-        fenceObject = glFence->fenceObject;
+        std::unique_lock<std::mutex> l(deviceForGL->fenceCompletionMutex);
+        if(value <= timelineState->requestedSignalCount)
+            return AGPU_INVALID_PARAMETER;
+        timelineState->requestedSignalCount = value;
     }
-    if(fenceObject)
-        addCustomCommand([=]() {
-            glFlush();
-            lockWeakDeviceForGL->glWaitSync(fenceObject, 0, -1);
-        });
+
+    auto glDevice = deviceForGL;
+    auto state = timelineState;
+    return addCustomCommand([=]() {
+        GLFence::executeSignalOf(glDevice, state, value);
+    });
+}
+
+agpu_error GLCommandQueue::waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value)
+{
+    CHECK_POINTER(source_queue);
+
+    // The main context executes the commands in submission order, so the
+    // wait is satisfied once the signal has been submitted before it.
+    auto device = weakDevice.lock();
+    std::unique_lock<std::mutex> l(deviceForGL->fenceCompletionMutex);
+    if(value > source_queue.as<GLCommandQueue> ()->timelineState->requestedSignalCount)
+        return AGPU_INVALID_OPERATION;
     return AGPU_OK;
 }
 
+agpu_ulong GLCommandQueue::getCompletedTimelineValue()
+{
+    auto device = weakDevice.lock();
+    std::unique_lock<std::mutex> l(deviceForGL->fenceCompletionMutex);
+    return timelineState->completedSignalCount;
+}
+
+agpu_error GLCommandQueue::waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns)
+{
+    auto device = weakDevice.lock();
+    auto state = timelineState;
+    return deviceForGL->waitForFenceCompletion(timeout_ns, [&]() {
+        return state->completedSignalCount >= value;
+    });
+}
+
 } // End of namespace AgpuGL
@@ -12,6 +12,7 @@ namespace AgpuGL
 {
 
 class GpuCommand;
+struct GLFenceSignalState;
 
 struct GLCommandQueue: public agpu::command_queue
 {
@@ -28,11 +29,19 @@ public:
     virtual agpu_error signalFence(const agpu::fence_ref &fence) override;
     virtual agpu_error waitFence(const agpu::fence_ref &fence) override;
 
+    virtual agpu_error signalTimelineValue(agpu_ulong value) override;
+    virtual agpu_error waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value) override;
+    virtual agpu_ulong getCompletedTimelineValue() override;
+    virtual agpu_error waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns) override;
 
 public:
     void addCommand(GpuCommand *command);
 
     agpu::device_weakref weakDevice;
+
+    // All of the queues are executed in the main context, so the timeline is
+    // signaled with the same mechanism as the fences.
+    std::shared_ptr<GLFenceSignalState> timelineState;
 };
 
 } // End of namespace AgpuGL
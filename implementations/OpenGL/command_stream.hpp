@@ -0,0 +1,343 @@
+#ifndef AGPU_OPENGL_COMMAND_STREAM_HPP
+#define AGPU_OPENGL_COMMAND_STREAM_HPP
+
+#include <AGPU/agpu_impl.hpp>
+#include <stdint.h>
+#include <vector>
+
+namespace AgpuGL
+{
+
+enum class GLCommandOpcode : uint16_t
+{
+    SetViewport = 0,
+    SetScissor,
+    UsePipelineState,
+    UseComputePipelineState,
+    UseVertexBinding,
+    UseIndexBuffer,
+    UseDrawIndirectBuffer,
+    UseComputeDispatchIndirectBuffer,
+    UseShaderResources,
+    UseComputeShaderResources,
+    PushConstants,
+    DrawArrays,
+    DrawArraysIndirect,
+    DrawElements,
+    DrawElementsIndirect,
+    DispatchCompute,
+    DispatchComputeIndirect,
+    SetStencilReference,
+    ExecuteBundle,
+    BeginRenderPass,
+    EndRenderPass,
+    ResolveFramebuffer,
+    ResetQueryPool,
+    WriteTimestamp,
+    BeginQuery,
+    EndQuery,
+    GenerateMipmaps,
+};
+
+/**
+ * I am the header of every packet in a command stream. The size includes
+ * the header itself, the packet fields and its inline payload.
+ */
+struct GLCommandHeader
+{
+    GLCommandOpcode opcode;
+    uint16_t reserved;
+    uint32_t size;
+};
+
+// The referenced objects are stored as indices into the typed object tables
+// of the command list, which keep them alive until the list is reset.
+
+struct GLSetViewportCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::SetViewport;
+
+    GLCommandHeader header;
+    agpu_int x, y, w, h;
+};
+
+struct GLSetScissorCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::SetScissor;
+
+    GLCommandHeader header;
+    agpu_int x, y, w, h;
+};
+
+struct GLUsePipelineStateCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UsePipelineState;
+
+    GLCommandHeader header;
+    uint32_t pipeline;
+};
+
+struct GLUseComputePipelineStateCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseComputePipelineState;
+
+    GLCommandHeader header;
+    uint32_t pipeline;
+};
+
+struct GLUseVertexBindingCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseVertexBinding;
+
+    GLCommandHeader header;
+    uint32_t vertexBinding;
+};
+
+struct GLUseIndexBufferCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseIndexBuffer;
+
+    GLCommandHeader header;
+    uint32_t buffer;
+    uint32_t indexSize;
+    agpu_device_size offset;
+};
+
+struct GLUseDrawIndirectBufferCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseDrawIndirectBuffer;
+
+    GLCommandHeader header;
+    uint32_t buffer;
+};
+
+struct GLUseComputeDispatchIndirectBufferCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseComputeDispatchIndirectBuffer;
+
+    GLCommandHeader header;
+    uint32_t buffer;
+};
+
+struct GLUseShaderResourcesCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseShaderResources;
+
+    GLCommandHeader header;
+    uint32_t binding;
+};
+
+struct GLUseComputeShaderResourcesCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::UseComputeShaderResources;
+
+    GLCommandHeader header;
+    uint32_t binding;
+};
+
+// The push constant values follow the packet.
+struct GLPushConstantsCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::PushConstants;
+
+    GLCommandHeader header;
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct GLDrawArraysCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DrawArrays;
+
+    GLCommandHeader header;
+    agpu_uint vertexCount;
+    agpu_uint instanceCount;
+    agpu_uint firstVertex;
+    agpu_uint baseInstance;
+};
+
+struct GLDrawArraysIndirectCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DrawArraysIndirect;
+
+    GLCommandHeader header;
+    agpu_device_size offset;
+    agpu_size drawCount;
+};
+
+struct GLDrawElementsCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DrawElements;
+
+    GLCommandHeader header;
+    agpu_uint indexCount;
+    agpu_uint instanceCount;
+    agpu_uint firstIndex;
+    agpu_int baseVertex;
+    agpu_uint baseInstance;
+};
+
+struct GLDrawElementsIndirectCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DrawElementsIndirect;
+
+    GLCommandHeader header;
+    agpu_device_size offset;
+    agpu_size drawCount;
+};
+
+struct GLDispatchComputeCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DispatchCompute;
+
+    GLCommandHeader header;
+    agpu_uint groupCountX;
+    agpu_uint groupCountY;
+    agpu_uint groupCountZ;
+};
+
+struct GLDispatchComputeIndirectCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::DispatchComputeIndirect;
+
+    GLCommandHeader header;
+    agpu_device_size offset;
+};
+
+struct GLSetStencilReferenceCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::SetStencilReference;
+
+    GLCommandHeader header;
+    agpu_uint reference;
+};
+
+struct GLExecuteBundleCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::ExecuteBundle;
+
+    GLCommandHeader header;
+    uint32_t bundle;
+};
+
+struct GLBeginRenderPassCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::BeginRenderPass;
+
+    GLCommandHeader header;
+    uint32_t renderpass;
+    uint32_t framebuffer;
+};
+
+struct GLEndRenderPassCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::EndRenderPass;
+
+    GLCommandHeader header;
+};
+
+struct GLResolveFramebufferCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::ResolveFramebuffer;
+
+    GLCommandHeader header;
+    uint32_t destFramebuffer;
+    uint32_t sourceFramebuffer;
+};
+
+struct GLResetQueryPoolCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::ResetQueryPool;
+
+    GLCommandHeader header;
+    uint32_t queryPool;
+    agpu_uint firstQuery;
+    agpu_uint queryCount;
+};
+
+struct GLWriteTimestampCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::WriteTimestamp;
+
+    GLCommandHeader header;
+    uint32_t queryPool;
+    agpu_uint queryIndex;
+};
+
+struct GLBeginQueryCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::BeginQuery;
+
+    GLCommandHeader header;
+    uint32_t queryPool;
+    agpu_uint queryIndex;
+};
+
+struct GLEndQueryCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::EndQuery;
+
+    GLCommandHeader header;
+    uint32_t queryPool;
+    agpu_uint queryIndex;
+};
+
+struct GLGenerateMipmapsCommand
+{
+    static constexpr GLCommandOpcode Opcode = GLCommandOpcode::GenerateMipmaps;
+
+    GLCommandHeader header;
+    uint32_t texture;
+};
+
+/**
+ * I am a linear stream of tagged command packets. My storage keeps its
+ * capacity when I am cleared, so a command list that is recorded again does
+ * not allocate once it has reached its steady size.
+ */
+class GLCommandStream
+{
+public:
+    static constexpr size_t PacketAlignment = 8;
+
+    template<typename T>
+    T *append(size_t payloadSize = 0)
+    {
+        auto packetSize = (sizeof(T) + payloadSize + PacketAlignment - 1) & (~(PacketAlignment - 1));
+        auto offset = data.size();
+        data.resize(offset + packetSize);
+
+        auto packet = reinterpret_cast<T*> (&data[offset]);
+        packet->header.opcode = T::Opcode;
+        packet->header.size = uint32_t(packetSize);
+        return packet;
+    }
+
+    template<typename T>
+    static uint8_t *payloadOf(T *packet)
+    {
+        return reinterpret_cast<uint8_t*> (packet + 1);
+    }
+
+    void clear()
+    {
+        data.clear();
+    }
+
+    const uint8_t *begin() const
+    {
+        return data.data();
+    }
+
+    const uint8_t *end() const
+    {
+        return data.data() + data.size();
+    }
+
+private:
+    std::vector<uint8_t> data;
+};
+
+} // End of namespace AgpuGL
+
+#endif //AGPU_OPENGL_COMMAND_STREAM_HPP
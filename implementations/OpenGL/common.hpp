@@ -4,6 +4,7 @@
 #include <AGPU/agpu_impl.hpp>
 #include <stdarg.h>
 #include <stdio.h>
+#include <string>
 
 #define CHECK_POINTER(pointer) if (!(pointer)) return AGPU_NULL_POINTER;
 #define MAKE_CURRENT() if (!makeCurrent) return AGPU_NOT_CURRENT_CONTEXT;
@@ -15,6 +16,7 @@ namespace AgpuGL
 #define lockWeakDeviceForGL weakDevice.lock().as<GLDevice> ()
 
 void printError(const char *format, ...);
+std::string getStringFromEnvironment(const char *varname);
 } // End of namespace
 
 
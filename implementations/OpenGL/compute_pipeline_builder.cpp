@@ -3,6 +3,7 @@
 #include "pipeline_builder.hpp" // For processTextureWithSamplerCombinations
 #include "shader.hpp"
 #include "shader_signature.hpp"
+#include "program_binary_cache.hpp"
 #include <algorithm>
 
 namespace AgpuGL
@@ -41,47 +42,78 @@ agpu::pipeline_state_ptr GLComputePipelineBuilder::build ()
 	std::vector<MappedTextureWithSamplerCombination> mappedTextureWithSamplerCombinations;
 	TextureWithSamplerCombinationMap textureWithSamplerCombinationMap;
 
-	buildTextureWithSampleCombinationMapInto(textureWithSamplerCombinationMap, mappedTextureWithSamplerCombinations);
-
-	// Instantiate the shaders
-	GLShaderForSignatureRef shaderInstance;
-	std::string errorMessage;
-
-	// Create the shader instance.
-	auto error = shader.as<GLShader> ()->instanceForSignature(shaderSignature, textureWithSamplerCombinationMap, shaderEntryPointName, &shaderInstance, &errorMessage);
-	errorMessages += errorMessage;
-	if (error != AGPU_OK)
+	// Look for the program in the binary cache, which skips the shader cross compilation.
+	auto programBinaryCache = deviceForGL->programBinaryCache.get();
+	uint64_t programCacheKey = 0;
+	if (programBinaryCache)
 	{
-		printError("Instance error: %d:%s\n", error, errorMessage.c_str());
-		return nullptr;
+		GLProgramCacheKeyHasher keyHasher;
+		keyHasher.add(deviceForGL->glslVersionNumber);
+		keyHasher.addSignature(shaderSignature);
+		keyHasher.addShader(shader, shaderEntryPointName);
+		programCacheKey = keyHasher.hash;
+
+		GLProgramBinaryCacheEntry cacheEntry;
+		if (programBinaryCache->load(programCacheKey, cacheEntry))
+		{
+			deviceForGL->onWorkerContextBlocking([&] {
+				program = programBinaryCache->createProgramFromBinary(cacheEntry);
+			});
+
+			if (program)
+				mappedTextureWithSamplerCombinations = cacheEntry.mappedTextureWithSamplerCombinations;
+		}
 	}
 
-	bool succeded = false;
-	deviceForGL->onMainContextBlocking([&] {
-		// Create the progrma
-		program = deviceForGL->glCreateProgram();
+	bool succeded = program != 0;
+	if (!succeded)
+	{
+		buildTextureWithSampleCombinationMapInto(textureWithSamplerCombinationMap, mappedTextureWithSamplerCombinations);
 
-		// Attach the shader instance to the program.
+		// Instantiate the shaders
+		GLShaderForSignatureRef shaderInstance;
 		std::string errorMessage;
-		auto error = shaderInstance->attachToProgram(program, &errorMessage);
+
+		// Create the shader instance.
+		auto error = shader.as<GLShader> ()->instanceForSignature(shaderSignature, textureWithSamplerCombinationMap, shaderEntryPointName, &shaderInstance, &errorMessage);
 		errorMessages += errorMessage;
 		if (error != AGPU_OK)
-			return;
-
-		// Link the program.
-		deviceForGL->glLinkProgram(program);
-
-		// Check the link status
-		GLint status;
-		deviceForGL->glGetProgramiv(program, GL_LINK_STATUS, &status);
-		if (status != GL_TRUE)
 		{
-			// TODO: Get the info log
-			return;
+			printError("Instance error: %d:%s\n", error, errorMessage.c_str());
+			return nullptr;
 		}
 
-		succeded = true;
-	});
+		deviceForGL->onWorkerContextBlocking([&] {
+			// Create the progrma
+			program = deviceForGL->glCreateProgram();
+			if (programBinaryCache)
+				programBinaryCache->prepareProgramForLinking(program);
+
+			// Attach the shader instance to the program.
+			std::string errorMessage;
+			auto error = shaderInstance->attachToProgram(program, &errorMessage);
+			errorMessages += errorMessage;
+			if (error != AGPU_OK)
+				return;
+
+			// Link the program.
+			deviceForGL->glLinkProgram(program);
+
+			// Check the link status
+			GLint status;
+			deviceForGL->glGetProgramiv(program, GL_LINK_STATUS, &status);
+			if (status != GL_TRUE)
+			{
+				// TODO: Get the info log
+				return;
+			}
+
+			if (programBinaryCache)
+				programBinaryCache->storeLinkedProgram(programCacheKey, program, mappedTextureWithSamplerCombinations);
+
+			succeded = true;
+		});
+	}
 
 	if (!succeded)
 		return nullptr;
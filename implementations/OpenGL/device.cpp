@@ -18,8 +18,11 @@
 #include "texture.hpp"
 #include "sampler.hpp"
 #include "fence.hpp"
+#include "query_pool.hpp"
+#include "program_binary_cache.hpp"
 #include "../Common/offline_shader_compiler.hpp"
 #include "../Common/state_tracker_cache.hpp"
+#include "../Common/buffer_pool.hpp"
 
 #define LOAD_FUNCTION(functionName) loadExtensionFunction(functionName, #functionName)
 
@@ -113,14 +116,25 @@ void OpenGLContext::finish()
 }
 
 GLDevice::GLDevice()
+    : isHeadless(false), workerContextCount(0), nextWorkerContextIndex(0), lastMainContextSubmissionFence(nullptr)
 {
 }
 
 GLDevice::~GLDevice()
 {
+    destroyWorkerContexts();
+
     if(mainContext)
     {
+        // The pending fence signals queue their waits from the main context.
+        onMainContextBlocking([]() {});
+        destroyFenceWaitContext();
+
         onMainContextBlocking([&]() {
+            if(lastMainContextSubmissionFence)
+                glDeleteSync(lastMainContextSubmissionFence);
+            lastMainContextSubmissionFence = nullptr;
+
             mainContext->destroy();
             delete mainContext;
             mainContext = nullptr;
@@ -194,6 +208,11 @@ void GLDevice::readVersionInformation()
     }
 
 	name = reinterpret_cast<const char*> (glGetString(GL_RENDERER));
+
+    // The program binaries are only valid for the driver that produced them.
+    driverString = reinterpret_cast<const char*> (glGetString(GL_VENDOR));
+    driverString += "|" + name + "|";
+    driverString += reinterpret_cast<const char*> (glGetString(GL_VERSION));
     printMessage("OpenGL version %s\n", glGetString(GL_VERSION));
     printMessage("OpenGL vendor %s\n", glGetString(GL_VENDOR));
     printMessage("GLSL version %s\n", glGetString(GL_SHADING_LANGUAGE_VERSION));
@@ -220,6 +239,14 @@ void GLDevice::checkEnvironmentVariables()
 {
 	dumpShaders = getBooleanEnvironment("DUMP_SHADERS", false);
 	dumpShadersOnError = getBooleanEnvironment("DUMP_SHADERS_ON_ERROR", false);
+
+    workerContextCount = 2;
+    auto workerContextCountString = getStringFromEnvironment("AGPU_GL_WORKER_CONTEXTS");
+    if(!workerContextCountString.empty())
+    {
+        auto count = atoi(workerContextCountString.c_str());
+        workerContextCount = count > 0 ? size_t(count) : 0;
+    }
 }
 
 void GLDevice::loadExtensions()
@@ -287,6 +314,20 @@ void GLDevice::loadExtensions()
     LOAD_FUNCTION(glGetProgramiv);
     LOAD_FUNCTION(glGetProgramInfoLog);
 
+    // Program binary
+    if(versionNumber >= OpenGLVersion::Version41 || hasOpenGLExtension("GL_ARB_get_program_binary"))
+    {
+        LOAD_FUNCTION(glGetProgramBinary);
+        LOAD_FUNCTION(glProgramBinary);
+        LOAD_FUNCTION(glProgramParameteri);
+    }
+    else
+    {
+        glGetProgramBinary = nullptr;
+        glProgramBinary = nullptr;
+        glProgramParameteri = nullptr;
+    }
+
     LOAD_FUNCTION(glGetActiveAttrib);
     LOAD_FUNCTION(glGetActiveUniform);
 
@@ -322,6 +363,7 @@ void GLDevice::loadExtensions()
     LOAD_FUNCTION(glCompressedTexSubImage1D);
     LOAD_FUNCTION(glCompressedTexSubImage2D);
     LOAD_FUNCTION(glCompressedTexSubImage3D);
+    LOAD_FUNCTION(glGenerateMipmap);
 
     // Samplers
     LOAD_FUNCTION(glGenSamplers);
@@ -354,9 +396,22 @@ void GLDevice::loadExtensions()
 	LOAD_FUNCTION(glMemoryBarrier);
 	LOAD_FUNCTION(glFlushMappedBufferRange);
 
+    // Queries
+    LOAD_FUNCTION(glGenQueries);
+    LOAD_FUNCTION(glDeleteQueries);
+    LOAD_FUNCTION(glBeginQuery);
+    LOAD_FUNCTION(glEndQuery);
+    LOAD_FUNCTION(glQueryCounter);
+    LOAD_FUNCTION(glGetQueryObjectuiv);
+    LOAD_FUNCTION(glGetQueryObjectui64v);
+
     isPersistentMemoryMappingSupported_ = isCoherentMemoryMappingSupported_ = glBufferStorage != nullptr && hasOpenGLExtension("GL_ARB_buffer_storage");
     hasExtension_GL_NV_depth_buffer_float = glDepthRangedNV != nullptr && hasOpenGLExtension("GL_NV_depth_buffer_float");
     hasExtension_GL_ARB_clip_control = glClipControl != nullptr && hasOpenGLExtension("GL_ARB_clip_control");
+    hasExtension_GL_ARB_timer_query = glQueryCounter != nullptr && glGetQueryObjectui64v != nullptr &&
+        (versionNumber >= OpenGLVersion::Version33 || hasOpenGLExtension("GL_ARB_timer_query"));
+    hasExtension_GL_ARB_pipeline_statistics_query = glGetQueryObjectui64v != nullptr &&
+        hasOpenGLExtension("GL_ARB_pipeline_statistics_query");
 
 }
 
@@ -365,6 +420,15 @@ agpu::command_queue_ptr GLDevice::getDefaultCommandQueue()
 	return defaultCommandQueue.disownedNewRef();
 }
 
+agpu::command_queue_ptr GLDevice::getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index)
+{
+    // The default queue executes every type of work.
+    if(queue_type > AGPU_COMMAND_QUEUE_TYPE_TRANSFER || index != 0)
+        return nullptr;
+
+    return defaultCommandQueue.disownedNewRef();
+}
+
 agpu::swap_chain_ptr GLDevice::createSwapChain(const agpu::command_queue_ref & commandQueue, agpu_swap_chain_create_info* swapChainInfo)
 {
 	return GLSwapChain::create(refFromThis<agpu::device> (), commandQueue, swapChainInfo).disown();
@@ -457,6 +521,33 @@ agpu::fence_ptr GLDevice::createFence()
 	return GLFence::create(refFromThis<agpu::device> ()).disown();
 }
 
+agpu_error GLDevice::waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+{
+    if(count == 0)
+        return AGPU_OK;
+    CHECK_POINTER(fences);
+    for(agpu_uint i = 0; i < count; ++i)
+        CHECK_POINTER(fences[i]);
+
+    return waitForFenceCompletion(timeout_ns, [&]() {
+        for(agpu_uint i = 0; i < count; ++i)
+        {
+            auto isSignaled = fences[i].as<GLFence> ()->isSignaledWithCompletionMutex();
+            if(isSignaled && !wait_all)
+                return true;
+            else if(!isSignaled && wait_all)
+                return false;
+        }
+
+        return bool(wait_all);
+    });
+}
+
+agpu::query_pool_ptr GLDevice::createQueryPool(agpu_query_pool_description* description)
+{
+	return GLQueryPool::create(refFromThis<agpu::device> (), description).disown();
+}
+
 agpu_bool GLDevice::hasBottomLeftTextureCoordinates()
 {
     return true;
@@ -473,6 +564,124 @@ void GLDevice::initializeObjects()
 	checkEnvironmentVariables();
     loadExtensions();
     createDefaultCommandQueue();
+    createProgramBinaryCache();
+    createWorkerContexts();
+    createFenceWaitContext();
+}
+
+void GLDevice::createProgramBinaryCache()
+{
+    if(pipelineCacheDirectory.empty() || !GLProgramBinaryCache::isSupportedBy(*this))
+        return;
+
+    programBinaryCache.reset(new GLProgramBinaryCache(*this, pipelineCacheDirectory, driverString));
+}
+
+void GLDevice::createWorkerContexts()
+{
+    // The worker contexts are created here in the main context thread, but
+    // they are only made current in their own threads.
+    for(size_t i = 0; i < workerContextCount; ++i)
+    {
+        auto worker = createWorkerContext();
+        if(!worker)
+            break;
+
+        workerContexts.push_back(std::move(worker));
+    }
+}
+
+void GLDevice::createFenceWaitContext()
+{
+    // Waiting for a fence blocks its thread, so it is done in a dedicated
+    // context instead of the main context.
+    fenceWaitContext = createWorkerContext();
+}
+
+std::unique_ptr<GLWorkerContext> GLDevice::createWorkerContext()
+{
+    auto context = mainContext->createSharedContext();
+    if(!context)
+    {
+        printError("Failed to create an OpenGL worker context.\n");
+        return nullptr;
+    }
+
+    context->weakDevice = mainContext->weakDevice;
+
+    std::unique_ptr<GLWorkerContext> worker(new GLWorkerContext());
+    worker->context = context;
+    worker->jobQueue.start();
+
+    bool madeCurrent = false;
+    AsyncJob makeCurrentJob([&] {
+        madeCurrent = context->makeCurrent();
+    });
+    worker->jobQueue.addJob(&makeCurrentJob);
+    makeCurrentJob.wait();
+
+    if(!madeCurrent)
+    {
+        printError("Failed to make current an OpenGL worker context.\n");
+        destroyWorkerContext(*worker);
+        return nullptr;
+    }
+
+    return worker;
+}
+
+void GLDevice::destroyWorkerContext(GLWorkerContext &worker)
+{
+    AsyncJob destroyJob([&] {
+        worker.context->destroy();
+        delete worker.context;
+        worker.context = nullptr;
+    });
+    worker.jobQueue.addJob(&destroyJob);
+    destroyJob.wait();
+    worker.jobQueue.shutdown();
+}
+
+void GLDevice::destroyWorkerContexts()
+{
+    for(auto &worker : workerContexts)
+        destroyWorkerContext(*worker);
+
+    workerContexts.clear();
+}
+
+void GLDevice::destroyFenceWaitContext()
+{
+    if(!fenceWaitContext)
+        return;
+
+    // The destruction job runs after the pending waits.
+    destroyWorkerContext(*fenceWaitContext);
+    fenceWaitContext.reset();
+}
+
+void GLDevice::signalMainContextSubmission()
+{
+    if(workerContexts.empty())
+        return;
+
+    // The fence has to be flushed, so that the workers do not wait for a fence
+    // that is never sent to the GPU.
+    auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    std::unique_lock<std::mutex> l(mainContextSubmissionMutex);
+    if(lastMainContextSubmissionFence)
+        glDeleteSync(lastMainContextSubmissionFence);
+    lastMainContextSubmissionFence = fence;
+}
+
+void GLDevice::waitForMainContextSubmissions()
+{
+    // The wait happens in the GPU, so the mutex is only held while the wait is queued.
+    std::unique_lock<std::mutex> l(mainContextSubmissionMutex);
+    if(lastMainContextSubmissionFence)
+        glWaitSync(lastMainContextSubmissionFence, 0, GL_TIMEOUT_IGNORED);
 }
 
 void GLDevice::createDefaultCommandQueue()
@@ -499,6 +708,9 @@ agpu_bool GLDevice::isFeatureSupported (agpu_feature feature)
     case AGPU_FEATURE_PERSISTENT_COHERENT_MEMORY_MAPPING: return isPersistentMemoryMappingSupported_ && isCoherentMemoryMappingSupported_;
     case AGPU_FEATURE_COMMAND_LIST_REUSE: return true;
     case AGPU_FEATURE_NON_EMULATED_COMMAND_LIST_REUSE: return false;
+    case AGPU_FEATURE_TIMESTAMP_QUERY: return hasExtension_GL_ARB_timer_query;
+    case AGPU_FEATURE_PIPELINE_STATISTICS_QUERY: return hasExtension_GL_ARB_pipeline_statistics_query;
+    case AGPU_FEATURE_COMMAND_QUEUE_TIMELINE: return true;
     default: return false;
     }
 }
@@ -532,6 +744,11 @@ agpu::state_tracker_cache_ptr GLDevice::createStateTrackerCache(const agpu::comm
 	return AgpuCommon::StateTrackerCache::create(refFromThis<agpu::device> (), 0).disown();
 }
 
+agpu::buffer_pool_ptr GLDevice::createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment)
+{
+	return AgpuCommon::BufferPool::create(refFromThis<agpu::device> (), block_description, alignment).disown();
+}
+
 agpu_error GLDevice::finishExecution()
 {
 	onMainContextBlocking([&]{
@@ -540,4 +757,10 @@ agpu_error GLDevice::finishExecution()
 	return AGPU_OK;
 }
 
+agpu_error GLDevice::flushPipelineCache()
+{
+	// The program binaries are stored as soon as they are linked.
+	return AGPU_OK;
+}
+
 } // End of namespace AgpuGL
@@ -17,6 +17,8 @@ typedef BOOL(WINAPI * wglChoosePixelFormatARBProc) (HDC hdc, const int *piAttrib
 #include <GL/gl.h>
 #include <GL/glx.h>
 #include <GL/glext.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
 
 typedef GLXContext (*glXCreateContextAttribsARBProc)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
 
@@ -27,6 +29,10 @@ typedef GLXContext (*glXCreateContextAttribsARBProc)(Display*, GLXFBConfig, GLXC
 #include <string>
 #include <map>
 #include <list>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
 
 #include "common.hpp"
 #include "job_queue.hpp"
@@ -35,6 +41,7 @@ namespace AgpuGL
 {
 
 class AgpuGLImmediateContext;
+class GLProgramBinaryCache;
 
 /**
  * OpenGL version number
@@ -69,6 +76,9 @@ struct OpenGLContext
     void destroy();
     void finish();
 
+    // I create a context that shares its objects with me, without making it current.
+    OpenGLContext *createSharedContext();
+
     static OpenGLContext *getCurrent();
 
     agpu::device_weakref weakDevice;
@@ -91,12 +101,33 @@ struct OpenGLContext
 
     Display *display;
     Window window;
+    GLXPbuffer pbuffer;
     GLXContext context;
+
+    // Headless contexts are created with EGL, without any window system.
+    OpenGLContext *createSharedEGLContext();
+
+    bool isEGL;
+    EGLDisplay eglDisplay;
+    EGLConfig eglConfig;
+    EGLSurface eglSurface;
+    EGLContext eglContext;
 #endif
 
     bool isCurrent() const;
 };
 
+/**
+ * I am a worker thread with its own OpenGL context, which shares its objects
+ * with the main context. I am used for uploads, readbacks and shader
+ * compilation, so that they do not have to queue behind the main context.
+ */
+struct GLWorkerContext
+{
+    OpenGLContext *context;
+    JobQueue jobQueue;
+};
+
 /**
  * Agpu OpenGL device
  */
@@ -118,6 +149,13 @@ public:
     void *getProcAddress(const char *symbolName);
     void initializeObjects();
     void createDefaultCommandQueue();
+    void createWorkerContexts();
+    void createFenceWaitContext();
+    void createProgramBinaryCache();
+    void destroyWorkerContexts();
+    void destroyFenceWaitContext();
+    std::unique_ptr<GLWorkerContext> createWorkerContext();
+    void destroyWorkerContext(GLWorkerContext &worker);
 
     template<typename FT>
     void loadExtensionFunction(FT &functionPointer, const char *functionName)
@@ -133,8 +171,79 @@ public:
         job.wait();
     }
 
+    /**
+     * I run a job on one of the worker contexts. Before the job, the worker
+     * waits on the GPU for the command lists submitted to the main context,
+     * and after it the worker waits for a fence, so the objects modified by
+     * the job are complete when I return. I fall back to the main context when
+     * there are no workers, or when I am called from a thread that already
+     * has a context.
+     */
+    template<typename FT>
+    void onWorkerContextBlocking(const FT &f)
+    {
+        if(OpenGLContext::getCurrent())
+        {
+            f();
+            return;
+        }
+
+        if(workerContexts.empty())
+        {
+            onMainContextBlocking(f);
+            return;
+        }
+
+        auto &worker = workerContexts[nextWorkerContextIndex++ % workerContexts.size()];
+        AsyncJob job([&] {
+            waitForMainContextSubmissions();
+            f();
+            worker->context->finish();
+        });
+        worker->jobQueue.addJob(&job);
+        job.wait();
+    }
+
+    /**
+     * I run a job on the fence wait context, which waits for the fence signals
+     * in the order in which they are submitted. The main context is used when
+     * the fence wait context could not be created.
+     */
+    template<typename FT>
+    void onFenceWaitContext(const FT &f)
+    {
+        auto job = new AsyncJob(f, true);
+        if(fenceWaitContext)
+            fenceWaitContext->jobQueue.addJob(job);
+        else
+            mainContextJobQueue.addJob(job);
+    }
+
+    /**
+     * I wait until the predicate is true, or until the timeout expires. The
+     * predicate is evaluated with the fence completion mutex held.
+     */
+    template<typename PT>
+    agpu_error waitForFenceCompletion(agpu_ulong timeout_ns, const PT &predicate)
+    {
+        std::unique_lock<std::mutex> l(fenceCompletionMutex);
+        if(timeout_ns >= agpu_ulong(INT64_MAX/2))
+        {
+            fenceCompletionCondition.wait(l, predicate);
+            return AGPU_OK;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+        return fenceCompletionCondition.wait_until(l, deadline, predicate) ? AGPU_OK : AGPU_TIMEOUT;
+    }
+
+    // I am called in the main context after executing a command list.
+    void signalMainContextSubmission();
+    void waitForMainContextSubmissions();
+
 public:
     virtual agpu::command_queue_ptr getDefaultCommandQueue() override;
+    virtual agpu::command_queue_ptr getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index) override;
 	virtual agpu::swap_chain_ptr createSwapChain(const agpu::command_queue_ref & commandQueue, agpu_swap_chain_create_info* swapChainInfo) override;
 	virtual agpu::buffer_ptr createBuffer(agpu_buffer_description* description, agpu_pointer initial_data) override;
 	virtual agpu::vertex_layout_ptr createVertexLayout() override;
@@ -153,6 +262,8 @@ public:
 	virtual agpu::texture_ptr createTexture(agpu_texture_description* description) override;
 	virtual agpu::sampler_ptr createSampler(agpu_sampler_description* description) override;
 	virtual agpu::fence_ptr createFence() override;
+    virtual agpu_error waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns) override;
+	virtual agpu::query_pool_ptr createQueryPool(agpu_query_pool_description* description) override;
 
 	virtual agpu_int getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count) override;
 	virtual agpu_bool hasTopLeftNdcOrigin() override;
@@ -165,13 +276,16 @@ public:
 	virtual agpu::vr_system_ptr getVRSystem() override;
     virtual agpu::offline_shader_compiler_ptr createOfflineShaderCompiler() override;
     virtual agpu::state_tracker_cache_ptr createStateTrackerCache(const agpu::command_queue_ref & command_queue_family) override;
+    virtual agpu::buffer_pool_ptr createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment) override;
 
 	virtual agpu_error finishExecution() override;
+	virtual agpu_error flushPipelineCache() override;
 
 public:
     OpenGLVersion versionNumber;
     int glslVersionNumber;
     std::string rendererString, shaderString;
+    std::string driverString;
     std::string extensions;
 
     agpu::command_queue_ref defaultCommandQueue;
@@ -185,10 +299,29 @@ public:
     bool isCoherentMemoryMappingSupported_;
     bool hasExtension_GL_NV_depth_buffer_float;
     bool hasExtension_GL_ARB_clip_control;
+    bool hasExtension_GL_ARB_timer_query;
+    bool hasExtension_GL_ARB_pipeline_statistics_query;
 
     // OpenGL API
     OpenGLContext *mainContext;
     JobQueue mainContextJobQueue;
+    bool isHeadless;
+
+    // Program binary cache
+    std::string pipelineCacheDirectory;
+    std::unique_ptr<GLProgramBinaryCache> programBinaryCache;
+
+    // Worker contexts
+    size_t workerContextCount;
+    std::vector<std::unique_ptr<GLWorkerContext>> workerContexts;
+    std::atomic_uint nextWorkerContextIndex;
+    std::mutex mainContextSubmissionMutex;
+    GLsync lastMainContextSubmissionFence;
+
+    // Fence signals
+    std::unique_ptr<GLWorkerContext> fenceWaitContext;
+    std::mutex fenceCompletionMutex;
+    std::condition_variable fenceCompletionCondition;
 
     // Device information
     std::string name;
@@ -256,6 +389,11 @@ public:
     PFNGLGETPROGRAMIVPROC glGetProgramiv;
     PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 
+    // Program binary
+    PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+    PFNGLPROGRAMBINARYPROC glProgramBinary;
+    PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+
     PFNGLGETACTIVEATTRIBPROC glGetActiveAttrib;
     PFNGLGETACTIVEUNIFORMPROC glGetActiveUniform;
 
@@ -291,6 +429,7 @@ public:
     PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC glCompressedTexSubImage1D;
     PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glCompressedTexSubImage2D;
     PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC glCompressedTexSubImage3D;
+    PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 
     // Sampler
     PFNGLGENSAMPLERSPROC glGenSamplers;
@@ -322,6 +461,15 @@ public:
     // Memory barrier
     PFNGLFLUSHMAPPEDBUFFERRANGEPROC glFlushMappedBufferRange;
     PFNGLMEMORYBARRIERPROC glMemoryBarrier;
+
+    // Queries
+    PFNGLGENQUERIESPROC glGenQueries;
+    PFNGLDELETEQUERIESPROC glDeleteQueries;
+    PFNGLBEGINQUERYPROC glBeginQuery;
+    PFNGLENDQUERYPROC glEndQuery;
+    PFNGLQUERYCOUNTERPROC glQueryCounter;
+    PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv;
+    PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
 };
 
 } // End of namespace AgpuGL
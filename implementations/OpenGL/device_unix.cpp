@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "device.hpp"
+#include "program_binary_cache.hpp"
 
 #if defined(__linux__)
 
@@ -46,7 +47,8 @@ private:
 
 
 OpenGLContext::OpenGLContext()
-    : ownsWindow(false), ownsDisplay(false), display(nullptr), window(0), context(0)
+    : ownsWindow(false), ownsDisplay(false), display(nullptr), window(0), pbuffer(0), context(0),
+      isEGL(false), eglDisplay(EGL_NO_DISPLAY), eglConfig(nullptr), eglSurface(EGL_NO_SURFACE), eglContext(EGL_NO_CONTEXT)
 {
 }
 
@@ -61,6 +63,10 @@ OpenGLContext *OpenGLContext::getCurrent()
 
 bool OpenGLContext::makeCurrentWithWindow(agpu_pointer window)
 {
+    // Headless contexts can only render into offscreen framebuffers.
+    if(isEGL)
+        return false;
+
     WithX11Display wd(display);
     auto res = glXMakeCurrent(display, (Window)window, context) == True;
     if(res)
@@ -70,8 +76,16 @@ bool OpenGLContext::makeCurrentWithWindow(agpu_pointer window)
 
 bool OpenGLContext::makeCurrent()
 {
+    if(isEGL)
+    {
+        auto res = eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext) == EGL_TRUE;
+        if(res)
+            currentGLContext = this;
+        return res;
+    }
+
     WithX11Display wd(display);
-    auto res = glXMakeCurrent(display, window, context) == True;
+    auto res = glXMakeCurrent(display, pbuffer ? pbuffer : window, context) == True;
     if(res)
         currentGLContext = this;
     return res;
@@ -79,6 +93,12 @@ bool OpenGLContext::makeCurrent()
 
 void OpenGLContext::swapBuffers()
 {
+    if(isEGL)
+    {
+        glFlush();
+        return;
+    }
+
     WithX11Display wd(display);
     glFlush();
     glXSwapBuffers(display, window);
@@ -86,6 +106,12 @@ void OpenGLContext::swapBuffers()
 
 void OpenGLContext::swapBuffersOfWindow(agpu_pointer window)
 {
+    if(isEGL)
+    {
+        glFlush();
+        return;
+    }
+
     WithX11Display wd(display);
     glFlush();
     glXSwapBuffers(display, (Window)window);
@@ -93,7 +119,7 @@ void OpenGLContext::swapBuffersOfWindow(agpu_pointer window)
 
 void OpenGLContext::destroy()
 {
-    if(!context)
+    if(!context && !eglContext)
         return;
 
     auto device = weakDevice.lock();
@@ -107,14 +133,264 @@ void OpenGLContext::destroy()
         glDevice->glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
+    if(isEGL)
+    {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(eglDisplay, eglContext);
+        eglContext = EGL_NO_CONTEXT;
+
+        if(eglSurface != EGL_NO_SURFACE)
+        {
+            eglDestroySurface(eglDisplay, eglSurface);
+            eglSurface = EGL_NO_SURFACE;
+        }
+
+        // The display is shared, see createHeadlessContext.
+        return;
+    }
+
     glXMakeCurrent(display, None, 0);
     glXDestroyContext(display, context);
     context = 0;
 
+    if(pbuffer)
+    {
+        glXDestroyPbuffer(display, pbuffer);
+        pbuffer = 0;
+    }
+
     if(ownsDisplay)
         XCloseDisplay(display);
 }
 
+OpenGLContext *OpenGLContext::createSharedContext()
+{
+    if(isEGL)
+        return createSharedEGLContext();
+
+    if(!glXCreateContextAttribsARB)
+        return nullptr;
+
+    WithX11Display wd(display);
+
+    // The shared context is only used for transfers and compilation, so a
+    // tiny pbuffer is enough for making it current.
+    int pbufferAttributes[] = {
+        GLX_PBUFFER_WIDTH, 1,
+        GLX_PBUFFER_HEIGHT, 1,
+        None
+    };
+
+    int contextAttributes[] =
+    {
+        GLX_CONTEXT_MAJOR_VERSION_ARB, (int)version / 10,
+        GLX_CONTEXT_MINOR_VERSION_ARB, (int)version % 10,
+        GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+        None
+    };
+    if(contextAttributes[1] < 3)
+        contextAttributes[4] = None;
+
+    std::unique_lock<std::mutex> l(contextErrorMutex);
+    ctxErrorOccurred = false;
+    auto oldHandler = XSetErrorHandler(&ctxErrorHandler);
+
+    // The framebuffer config may not support pbuffers. OpenGL 3.0 contexts
+    // can also be made current without a drawable.
+    GLXPbuffer sharedPbuffer = glXCreatePbuffer(display, framebufferConfig, pbufferAttributes);
+    XSync(display, False);
+    if(ctxErrorOccurred)
+    {
+        sharedPbuffer = 0;
+        ctxErrorOccurred = false;
+    }
+
+    auto sharedContext = glXCreateContextAttribsARB(display, framebufferConfig, context, True, contextAttributes);
+
+    // Sync to ensure any errors generated are processed.
+    XSync(display, False);
+    XSetErrorHandler(oldHandler);
+
+    if(ctxErrorOccurred || !sharedContext || (!sharedPbuffer && version < OpenGLVersion::Version30))
+    {
+        if(sharedContext)
+            glXDestroyContext(display, sharedContext);
+        if(sharedPbuffer)
+            glXDestroyPbuffer(display, sharedPbuffer);
+        return nullptr;
+    }
+
+    auto result = new OpenGLContext();
+    result->display = display;
+    result->framebufferConfig = framebufferConfig;
+    result->glXCreateContextAttribsARB = glXCreateContextAttribsARB;
+    result->pbuffer = sharedPbuffer;
+    result->context = sharedContext;
+    result->version = version;
+    return result;
+}
+
+static EGLContext createEGLContextWithVersion(EGLDisplay display, EGLConfig config, EGLContext shareContext, OpenGLVersion version)
+{
+    EGLint contextAttributes[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, (EGLint)version / 10,
+        EGL_CONTEXT_MINOR_VERSION_KHR, (EGLint)version % 10,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    if(contextAttributes[1] < 3)
+        contextAttributes[4] = EGL_NONE;
+
+    return eglCreateContext(display, config, shareContext, contextAttributes);
+}
+
+static bool isSurfacelessContextSupported(EGLDisplay display)
+{
+    auto extensions = eglQueryString(display, EGL_EXTENSIONS);
+    return extensions && GLDevice::isExtensionSupported(extensions, "EGL_KHR_surfaceless_context");
+}
+
+static EGLSurface createEGLPbufferFor(EGLDisplay display, EGLConfig config)
+{
+    // We only render into framebuffer objects, so a tiny pbuffer is enough
+    // for making the context current.
+    EGLint pbufferAttributes[] = {
+        EGL_WIDTH, 1,
+        EGL_HEIGHT, 1,
+        EGL_NONE
+    };
+
+    return eglCreatePbufferSurface(display, config, pbufferAttributes);
+}
+
+OpenGLContext *OpenGLContext::createSharedEGLContext()
+{
+    auto sharedContext = createEGLContextWithVersion(eglDisplay, eglConfig, eglContext, version);
+    if(sharedContext == EGL_NO_CONTEXT)
+        return nullptr;
+
+    auto sharedSurface = EGL_NO_SURFACE;
+    if(eglSurface != EGL_NO_SURFACE)
+    {
+        sharedSurface = createEGLPbufferFor(eglDisplay, eglConfig);
+        if(sharedSurface == EGL_NO_SURFACE)
+        {
+            eglDestroyContext(eglDisplay, sharedContext);
+            return nullptr;
+        }
+    }
+
+    auto result = new OpenGLContext();
+    result->isEGL = true;
+    result->eglDisplay = eglDisplay;
+    result->eglConfig = eglConfig;
+    result->eglSurface = sharedSurface;
+    result->eglContext = sharedContext;
+    result->version = version;
+    return result;
+}
+
+static EGLDisplay getHeadlessEGLDisplay()
+{
+    // Prefer the Mesa surfaceless platform, which does not require any
+    // window system or render node permission beyond the GPU itself.
+    auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(clientExtensions && GLDevice::isExtensionSupported(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        auto eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if(eglGetPlatformDisplayEXT)
+        {
+            auto display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if(display != EGL_NO_DISPLAY)
+                return display;
+        }
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+static bool createHeadlessContext(OpenGLContext &contextWrapper)
+{
+    auto display = getHeadlessEGLDisplay();
+    if(display == EGL_NO_DISPLAY)
+    {
+        printError("Failed to get an EGL display for the headless device.\n");
+        return false;
+    }
+
+    EGLint major, minor;
+    if(!eglInitialize(display, &major, &minor))
+    {
+        printError("Failed to initialize the EGL display.\n");
+        return false;
+    }
+
+    // The display is the same one for every headless device in the process,
+    // and eglTerminate would pull it from under the other devices. Initializing
+    // it again is harmless, so it is left initialized until the process exits.
+    contextWrapper.isEGL = true;
+    contextWrapper.eglDisplay = display;
+
+    if(!eglBindAPI(EGL_OPENGL_API))
+    {
+        printError("EGL does not support the desktop OpenGL API.\n");
+        return false;
+    }
+
+    EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+
+    // Surfaceless displays may not expose any pbuffer config.
+    EGLint configCount = 0;
+    if(!eglChooseConfig(display, configAttributes, &contextWrapper.eglConfig, 1, &configCount) || configCount == 0)
+    {
+        configAttributes[1] = 0;
+        if(!eglChooseConfig(display, configAttributes, &contextWrapper.eglConfig, 1, &configCount) || configCount == 0)
+        {
+            printError("Failed to find an EGL config for the headless device.\n");
+            return false;
+        }
+    }
+
+    for(int versionIndex = 0; GLContextVersionPriorities[versionIndex] != OpenGLVersion::Invalid; ++versionIndex)
+    {
+        auto version = GLContextVersionPriorities[versionIndex];
+        contextWrapper.eglContext = createEGLContextWithVersion(display, contextWrapper.eglConfig, EGL_NO_CONTEXT, version);
+        if(contextWrapper.eglContext != EGL_NO_CONTEXT)
+        {
+            contextWrapper.version = version;
+            break;
+        }
+    }
+
+    if(contextWrapper.eglContext == EGL_NO_CONTEXT)
+    {
+        printError("Failed to create a headless OpenGL context.\n");
+        return false;
+    }
+
+    // Surfaceless contexts are made current without any drawable.
+    if(isSurfacelessContextSupported(display))
+        return true;
+
+    contextWrapper.eglSurface = createEGLPbufferFor(display, contextWrapper.eglConfig);
+    if(contextWrapper.eglSurface == EGL_NO_SURFACE)
+    {
+        printError("Failed to create the headless EGL pbuffer.\n");
+        return false;
+    }
+
+    return true;
+}
+
 /*static void deviceOpenInfoToVisualAttributes(agpu_device_open_info* openInfo, std::vector<int> &visualInfo)
 {
     visualInfo.clear();
@@ -236,11 +512,38 @@ agpu::device_ref GLDevice::open(agpu_device_open_info* openInfo)
     auto device = result.as<GLDevice> ();
 
     bool failure = false;
+    bool headless = (openInfo->open_flags & AGPU_DEVICE_OPEN_FLAG_HEADLESS) != 0;
 
     // Perform the main context creation in
     device->mainContextJobQueue.start();
     AsyncJob contextCreationJob([&] {
         std::unique_ptr<OpenGLContext> contextWrapper(new OpenGLContext());
+        if(headless)
+        {
+            if(!createHeadlessContext(*contextWrapper))
+            {
+                if(contextWrapper->eglContext != EGL_NO_CONTEXT)
+                    contextWrapper->destroy();
+                failure = true;
+                return;
+            }
+
+            if(!contextWrapper->makeCurrent())
+            {
+                printError("Failed to make current the headless OpenGL context.\n");
+                contextWrapper->destroy();
+                failure = true;
+                return;
+            }
+
+            device->isHeadless = true;
+            device->mainContext = contextWrapper.release();
+            device->mainContext->weakDevice = result;
+            device->pipelineCacheDirectory = GLProgramBinaryCache::getDirectoryFor(openInfo);
+            device->initializeObjects();
+            return;
+        }
+
         const char *displayName = nullptr;
         if(openInfo->display)
             displayName = ((Display*)openInfo->display)->display_name;
@@ -414,6 +717,7 @@ agpu::device_ref GLDevice::open(agpu_device_open_info* openInfo)
         // Initialize the device objects.
         device->mainContext = contextWrapper.release();
         device->mainContext->weakDevice = result;
+        device->pipelineCacheDirectory = GLProgramBinaryCache::getDirectoryFor(openInfo);
         device->initializeObjects();
 
     });
@@ -427,6 +731,8 @@ agpu::device_ref GLDevice::open(agpu_device_open_info* openInfo)
 
 void *GLDevice::getProcAddress(const char *symbolName)
 {
+    if(isHeadless)
+        return (void*)eglGetProcAddress(symbolName);
     return (void*)glXGetProcAddress((const GLubyte*)symbolName);
 }
 
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "device.hpp"
+#include "program_binary_cache.hpp"
 
 #if defined(_WIN32)
 #include <GL/wglext.h>
@@ -224,6 +225,53 @@ void GLDevice::setWindowPixelFormat(agpu_pointer window)
     }
 }
 
+OpenGLContext *OpenGLContext::createSharedContext()
+{
+    if (!wglCreateContextAttribsARB)
+        return nullptr;
+
+    // The shared context needs a window with the same pixel format.
+    HINSTANCE hInstance = GetModuleHandle(nullptr);
+    HWND sharedWindow = CreateWindowW(L"agpuDummyOGLWindow", L"agpuOGLWorkerWindow", WS_OVERLAPPEDWINDOW, 0, 0, 16, 16, 0, 0, hInstance, 0);
+    if (!sharedWindow)
+        return nullptr;
+
+    auto sharedDC = GetDC(sharedWindow);
+    PIXELFORMATDESCRIPTOR pixelFormatDescriptor;
+    auto pixelFormat = GetPixelFormat(hDC);
+    DescribePixelFormat(hDC, pixelFormat, sizeof(pixelFormatDescriptor), &pixelFormatDescriptor);
+    if (SetPixelFormat(sharedDC, pixelFormat, &pixelFormatDescriptor) == FALSE)
+    {
+        if (!printLastError())
+            printError("Failed to set the worker window pixel format.\n");
+        DestroyWindow(sharedWindow);
+        return nullptr;
+    }
+
+    int contextAttributes[] =
+    {
+        WGL_CONTEXT_MAJOR_VERSION_ARB, (int)version / 10,
+        WGL_CONTEXT_MINOR_VERSION_ARB, (int)version % 10,
+        0
+    };
+
+    auto sharedContext = wglCreateContextAttribsARB(sharedDC, context, contextAttributes);
+    if (!sharedContext)
+    {
+        DestroyWindow(sharedWindow);
+        return nullptr;
+    }
+
+    auto result = new OpenGLContext();
+    result->wglCreateContextAttribsARB = wglCreateContextAttribsARB;
+    result->wglChoosePixelFormatARB = wglChoosePixelFormatARB;
+    result->window = sharedWindow;
+    result->hDC = sharedDC;
+    result->context = sharedContext;
+    result->version = version;
+    return result;
+}
+
 agpu::device_ref GLDevice::open(agpu_device_open_info* openInfo)
 {
     // Create the device.
@@ -394,6 +442,7 @@ agpu::device_ref GLDevice::open(agpu_device_open_info* openInfo)
         contextWrapper->makeCurrent();
         device->mainContext = contextWrapper.release();
         device->mainContext->weakDevice = result;
+        device->pipelineCacheDirectory = GLProgramBinaryCache::getDirectoryFor(openInfo);
         device->initializeObjects();
     });
 
@@ -1,43 +1,94 @@
 #include "fence.hpp"
+#include <algorithm>
 
 namespace AgpuGL
 {
 
+// The time that the fence wait context blocks on a sync in a single call.
+static const GLuint64 FenceWaitTimeSlice = 100000000;
+
 GLFence::GLFence()
+    : signalState(std::make_shared<GLFenceSignalState> ())
 {
-    fenceObject = nullptr;
 }
 
 GLFence::~GLFence()
 {
-    if(fenceObject)
-    {
-        deviceForGL->onMainContextBlocking([&]() {
-            deviceForGL->glDeleteSync(fenceObject);
-        });
-    }
 }
 
 agpu::fence_ref GLFence::create(const agpu::device_ref &device)
 {
-    auto result = agpu::makeObject<GLFence> ();
+    auto result = agpu::makePooledObject<GLFence> ();
     result.as<GLFence> ()->device = device;
     return result;
 }
 
 agpu_error GLFence::waitOnClient()
 {
-    deviceForGL->onMainContextBlocking([&]() {
-        if(fenceObject)
-        {
-            GLenum waitReturn = GL_UNSIGNALED;
-            while (waitReturn != GL_ALREADY_SIGNALED && waitReturn != GL_CONDITION_SATISFIED)
-                waitReturn = deviceForGL->glClientWaitSync(fenceObject, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
-        	deviceForGL->glDeleteSync(fenceObject);
-        	fenceObject = nullptr;
-        }
+    // A fence that was never signaled does not block.
+    auto state = signalState;
+    return deviceForGL->waitForFenceCompletion(UINT64_MAX, [&]() {
+        return state->completedSignalCount >= state->requestedSignalCount;
+    });
+}
+
+agpu_bool GLFence::isSignaled()
+{
+    std::unique_lock<std::mutex> l(deviceForGL->fenceCompletionMutex);
+    return isSignaledWithCompletionMutex();
+}
+
+agpu_error GLFence::waitWithTimeout(agpu_ulong timeout_ns)
+{
+    return deviceForGL->waitForFenceCompletion(timeout_ns, [&]() {
+        return isSignaledWithCompletionMutex();
+    });
+}
+
+uint64_t GLFence::requestSignal()
+{
+    std::unique_lock<std::mutex> l(deviceForGL->fenceCompletionMutex);
+    return ++signalState->requestedSignalCount;
+}
+
+void GLFence::executeSignal(uint64_t signalNumber)
+{
+    executeSignalOf(deviceForGL, signalState, signalNumber);
+}
+
+void GLFence::executeSignalOf(GLDevice *glDevice, const std::shared_ptr<GLFenceSignalState> &state, uint64_t signalNumber)
+{
+    // The fence has to be flushed, so that it can be waited from another context.
+    auto sync = glDevice->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    {
+        std::unique_lock<std::mutex> l(glDevice->fenceCompletionMutex);
+        state->lastSync = sync;
+    }
+
+    glDevice->onFenceWaitContext([=]() {
+        GLenum waitReturn = GL_TIMEOUT_EXPIRED;
+        while(waitReturn == GL_TIMEOUT_EXPIRED)
+            waitReturn = glDevice->glClientWaitSync(sync, 0, FenceWaitTimeSlice);
+
+        std::unique_lock<std::mutex> l(glDevice->fenceCompletionMutex);
+        glDevice->glDeleteSync(sync);
+        if(state->lastSync == sync)
+            state->lastSync = nullptr;
+        state->completedSignalCount = std::max(state->completedSignalCount, signalNumber);
+        glDevice->fenceCompletionCondition.notify_all();
     });
-    return AGPU_OK;
+}
+
+void GLFence::executeGPUWait()
+{
+    // The sync is only deleted with the mutex held, and the deletion of a
+    // sync that is being waited is deferred by OpenGL.
+    auto glDevice = deviceForGL;
+    std::unique_lock<std::mutex> l(glDevice->fenceCompletionMutex);
+    if(signalState->lastSync)
+        glDevice->glWaitSync(signalState->lastSync, 0, GL_TIMEOUT_IGNORED);
 }
 
 } // End of namespace AgpuGL
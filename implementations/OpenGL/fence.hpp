@@ -6,6 +6,21 @@
 namespace AgpuGL
 {
 
+/**
+ * I am the signal state of a fence. I am shared with the pending waits in the
+ * fence wait context, which own the sync objects and may outlive the fence.
+ * I am protected by the fence completion mutex of the device.
+ */
+struct GLFenceSignalState
+{
+    GLFenceSignalState()
+        : requestedSignalCount(0), completedSignalCount(0), lastSync(nullptr) {}
+
+    uint64_t requestedSignalCount;
+    uint64_t completedSignalCount;
+    GLsync lastSync;
+};
+
 struct GLFence : public agpu::fence
 {
 public:
@@ -14,14 +29,32 @@ public:
 
     static agpu::fence_ref create(const agpu::device_ref &device);
 
-    agpu_error waitOnClient();
+    virtual agpu_error waitOnClient() override;
+    virtual agpu_bool isSignaled() override;
+    virtual agpu_error waitWithTimeout(agpu_ulong timeout_ns) override;
+
+    // I am called when a signal of the fence is queued, and I return its number.
+    uint64_t requestSignal();
+
+    // I am called in the main context, when the signal is executed.
+    void executeSignal(uint64_t signalNumber);
+
+    // I signal a signal state in the main context. I am shared with the
+    // timelines of the command queues.
+    static void executeSignalOf(GLDevice *glDevice, const std::shared_ptr<GLFenceSignalState> &state, uint64_t signalNumber);
+
+    // I am called in the main context, to make it wait on the GPU for the last signal.
+    void executeGPUWait();
+
+    bool isSignaledWithCompletionMutex() const
+    {
+        return signalState->requestedSignalCount > 0 &&
+            signalState->completedSignalCount >= signalState->requestedSignalCount;
+    }
 
 public:
     agpu::device_ref device;
-    GLsync fenceObject;
-
-    std::mutex mutex;
-    std::condition_variable sendCommandCondition;
+    std::shared_ptr<GLFenceSignalState> signalState;
 };
 
 } // End of namespace AgpuGL
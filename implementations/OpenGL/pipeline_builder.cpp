@@ -2,6 +2,7 @@
 #include "pipeline_state.hpp"
 #include "shader.hpp"
 #include "shader_signature.hpp"
+#include "program_binary_cache.hpp"
 #include "constants.hpp"
 #include "../Common/texture_formats_common.hpp"
 #include <set>
@@ -167,71 +168,108 @@ agpu::pipeline_state_ptr GLGraphicsPipelineBuilder::build ()
 
     if(!shaders.empty())
     {
-        buildTextureWithSampleCombinationMapInto(textureWithSamplerCombinationMap, mappedTextureWithSamplerCombinations);
+        if(!shaderSignature)
+        {
+            errorMessages += "Missing shader signature.";
+            return nullptr;
+        }
 
-        // Instantiate the shaders
-        for(auto &shaderWithEntryPoint : shaders)
+        // Look for the program in the binary cache, which skips the shader cross compilation.
+        auto programBinaryCache = deviceForGL->programBinaryCache.get();
+        uint64_t programCacheKey = 0;
+        if(programBinaryCache)
         {
-            const auto &shader = shaderWithEntryPoint.first;
-            if(!shaderSignature)
+            GLProgramCacheKeyHasher keyHasher;
+            keyHasher.add(deviceForGL->glslVersionNumber);
+            keyHasher.addSignature(shaderSignature);
+            for(auto &shaderWithEntryPoint : shaders)
             {
-                errorMessages += "Missing shader signature.";
-                succeded = false;
-                break;
+                if(shaderWithEntryPoint.first)
+                    keyHasher.addShader(shaderWithEntryPoint.first, shaderWithEntryPoint.second);
             }
-            GLShaderForSignatureRef shaderForSignature;
-            std::string errorMessage;
+            programCacheKey = keyHasher.hash;
 
-            // Create the shader instance.
-            auto error = shader.as<GLShader> ()->instanceForSignature(shaderSignature, textureWithSamplerCombinationMap, shaderWithEntryPoint.second, &shaderForSignature, &errorMessage);
-            errorMessages += errorMessage;
-            if(error != AGPU_OK)
+            GLProgramBinaryCacheEntry cacheEntry;
+            if(programBinaryCache->load(programCacheKey, cacheEntry))
             {
-                printError("Instance error: %d:%s\n", error, errorMessage.c_str());
-                succeded = false;
-                break;
+                deviceForGL->onWorkerContextBlocking([&]{
+                    program = programBinaryCache->createProgramFromBinary(cacheEntry);
+                    if(program)
+                        baseInstanceUniformIndex = deviceForGL->glGetUniformLocation(program, "SPIRV_Cross_BaseInstance");
+                });
+
+                if(program)
+                    mappedTextureWithSamplerCombinations = cacheEntry.mappedTextureWithSamplerCombinations;
             }
-
-            shaderInstances.push_back(shaderForSignature);
         }
 
-        if(!succeded)
-            return nullptr;
-
-        succeded = false;
-        deviceForGL->onMainContextBlocking([&]{
-            // Create the progrma
-            program = deviceForGL->glCreateProgram();
+        if(!program)
+        {
+            buildTextureWithSampleCombinationMapInto(textureWithSamplerCombinationMap, mappedTextureWithSamplerCombinations);
 
-            // Attach the shaders.
-            for(auto shaderInstance : shaderInstances)
+            // Instantiate the shaders
+            for(auto &shaderWithEntryPoint : shaders)
             {
-                // Attach the shader instance to the program.
+                const auto &shader = shaderWithEntryPoint.first;
+                GLShaderForSignatureRef shaderForSignature;
                 std::string errorMessage;
-                auto error = shaderInstance->attachToProgram(program, &errorMessage);
 
+                // Create the shader instance.
+                auto error = shader.as<GLShader> ()->instanceForSignature(shaderSignature, textureWithSamplerCombinationMap, shaderWithEntryPoint.second, &shaderForSignature, &errorMessage);
                 errorMessages += errorMessage;
                 if(error != AGPU_OK)
-                    return;
+                {
+                    printError("Instance error: %d:%s\n", error, errorMessage.c_str());
+                    succeded = false;
+                    break;
+                }
+
+                shaderInstances.push_back(shaderForSignature);
             }
 
-        	// Link the program.
-        	deviceForGL->glLinkProgram(program);
+            if(!succeded)
+                return nullptr;
+
+            succeded = false;
+            deviceForGL->onWorkerContextBlocking([&]{
+                // Create the progrma
+                program = deviceForGL->glCreateProgram();
+                if(programBinaryCache)
+                    programBinaryCache->prepareProgramForLinking(program);
+
+                // Attach the shaders.
+                for(auto shaderInstance : shaderInstances)
+                {
+                    // Attach the shader instance to the program.
+                    std::string errorMessage;
+                    auto error = shaderInstance->attachToProgram(program, &errorMessage);
+
+                    errorMessages += errorMessage;
+                    if(error != AGPU_OK)
+                        return;
+                }
+
+                // Link the program.
+                deviceForGL->glLinkProgram(program);
+
+                // Check the link status
+                GLint status;
+                deviceForGL->glGetProgramiv(program, GL_LINK_STATUS, &status);
+                if(status != GL_TRUE)
+                {
+                    // TODO: Get the info log
+                    return;
+                }
 
-        	// Check the link status
-        	GLint status;
-        	deviceForGL->glGetProgramiv(program, GL_LINK_STATUS, &status);
-            if(status != GL_TRUE)
-            {
-				// TODO: Get the info log
-                return;
-            }
+                // Get some special uniforms
+                baseInstanceUniformIndex = deviceForGL->glGetUniformLocation(program, "SPIRV_Cross_BaseInstance");
 
-			// Get some special uniforms
-			baseInstanceUniformIndex = deviceForGL->glGetUniformLocation(program, "SPIRV_Cross_BaseInstance");
+                if(programBinaryCache)
+                    programBinaryCache->storeLinkedProgram(programCacheKey, program, mappedTextureWithSamplerCombinations);
 
-            succeded = true;
-        });
+                succeded = true;
+            });
+        }
     }
 
 	if(!succeded)
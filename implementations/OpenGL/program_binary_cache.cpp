@@ -0,0 +1,276 @@
+#include "program_binary_cache.hpp"
+#include "shader_signature.hpp"
+#include "../Common/disk_cache_utils.hpp"
+#include "../Common/utility.hpp"
+#include <stddef.h>
+#include <string.h>
+
+namespace AgpuGL
+{
+
+static const uint32_t ProgramBinaryCacheFileMagic = 0x42504741; // AGPB
+static const uint32_t ProgramBinaryCacheFileVersion = 1;
+
+/**
+ * Header that precedes the serialized combinations and the program binary in
+ * a cache file.
+ */
+struct GLProgramBinaryCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t binaryFormat;
+    uint64_t key;
+    uint64_t driverHash;
+    uint64_t dataSize;
+    uint64_t dataChecksum;
+    uint64_t headerChecksum;
+};
+
+static uint64_t computeHeaderChecksum(const GLProgramBinaryCacheFileHeader &header)
+{
+    return AgpuCommon::hashBytes(&header, offsetof(GLProgramBinaryCacheFileHeader, headerChecksum));
+}
+
+template<typename T>
+static void writeValue(std::vector<uint8_t> &out, const T &value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*> (&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool readValue(const std::vector<uint8_t> &in, size_t &position, T &value)
+{
+    if(position + sizeof(T) > in.size())
+        return false;
+
+    memcpy(&value, &in[position], sizeof(T));
+    position += sizeof(T);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+GLProgramCacheKeyHasher::GLProgramCacheKeyHasher()
+    : hash(0xcbf29ce484222325ull)
+{
+}
+
+void GLProgramCacheKeyHasher::addBytes(const void *data, size_t size)
+{
+    hash = AgpuCommon::hashBytes(data, size, hash);
+}
+
+void GLProgramCacheKeyHasher::addString(const std::string &string)
+{
+    add(uint64_t(string.size()));
+    addBytes(string.data(), string.size());
+}
+
+void GLProgramCacheKeyHasher::addShader(const agpu::shader_ref &shader, const std::string &entryPoint)
+{
+    auto glShader = shader.as<GLShader> ();
+    add(uint32_t(glShader->type));
+    add(uint32_t(glShader->rawSourceLanguage));
+    add(uint64_t(glShader->rawShaderSource.size()));
+    addBytes(glShader->rawShaderSource.data(), glShader->rawShaderSource.size());
+    addString(entryPoint);
+}
+
+void GLProgramCacheKeyHasher::addSignature(const agpu::shader_signature_ref &signature)
+{
+    // The bindings are what the shaders are remapped into.
+    auto glSignature = signature.as<GLShaderSignature> ();
+    add(uint64_t(glSignature->elements.size()));
+    for(auto &element : glSignature->elements)
+    {
+        add(uint32_t(element.type));
+        add(element.maxBindings);
+        add(uint64_t(element.elements.size()));
+        for(auto &bankElement : element.elements)
+        {
+            add(uint32_t(bankElement.type));
+            add(bankElement.bindingCount);
+            add(bankElement.startIndex);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+GLProgramBinaryCache::GLProgramBinaryCache(GLDevice &device, const std::string &directory, const std::string &driverString)
+    : device(device), directory(directory)
+{
+    driverHash = AgpuCommon::hashBytes(driverString.data(), driverString.size());
+    if(!this->directory.empty() && this->directory.back() != '/' && this->directory.back() != '\\')
+        this->directory += '/';
+}
+
+GLProgramBinaryCache::~GLProgramBinaryCache()
+{
+}
+
+std::string GLProgramBinaryCache::getDirectoryFor(agpu_device_open_info *openInfo)
+{
+    if(openInfo->pipeline_cache_directory && *openInfo->pipeline_cache_directory)
+        return openInfo->pipeline_cache_directory;
+
+    return getStringFromEnvironment("AGPU_PIPELINE_CACHE_DIR");
+}
+
+bool GLProgramBinaryCache::isSupportedBy(GLDevice &device)
+{
+    if(!device.glGetProgramBinary || !device.glProgramBinary || !device.glProgramParameteri)
+        return false;
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+std::string GLProgramBinaryCache::fileNameForKey(uint64_t key)
+{
+    // The driver is part of the name, so that the binaries of different
+    // drivers sharing a directory do not evict each other.
+    char baseName[64];
+    snprintf(baseName, sizeof(baseName), "agpu-gl-program-%016llx-%016llx.bin", (unsigned long long)driverHash, (unsigned long long)key);
+    return directory + baseName;
+}
+
+bool GLProgramBinaryCache::load(uint64_t key, GLProgramBinaryCacheEntry &entry)
+{
+    std::unique_lock<std::mutex> l(mutex);
+
+    auto fileName = fileNameForKey(key);
+    auto file = fopen(fileName.c_str(), "rb");
+    if(!file)
+        return false;
+
+    GLProgramBinaryCacheFileHeader header = {};
+    std::vector<uint8_t> data;
+    auto hasHeader = fread(&header, sizeof(header), 1, file) == 1;
+    auto isValid = hasHeader &&
+        header.magic == ProgramBinaryCacheFileMagic &&
+        header.version == ProgramBinaryCacheFileVersion &&
+        header.headerSize == sizeof(GLProgramBinaryCacheFileHeader) &&
+        header.headerChecksum == computeHeaderChecksum(header) &&
+        header.key == key &&
+        header.driverHash == driverHash;
+    if(isValid)
+    {
+        data.resize(size_t(header.dataSize));
+        isValid = !data.empty() && fread(data.data(), data.size(), 1, file) == 1 &&
+            AgpuCommon::hashBytes(data.data(), data.size()) == header.dataChecksum;
+    }
+    fclose(file);
+
+    // Parse the combinations, which precede the binary.
+    size_t position = 0;
+    uint32_t combinationCount = 0;
+    isValid = isValid && readValue(data, position, combinationCount);
+    entry.mappedTextureWithSamplerCombinations.clear();
+    for(uint32_t i = 0; isValid && i < combinationCount; ++i)
+    {
+        MappedTextureWithSamplerCombination mapped;
+        uint32_t nameSize = 0;
+        isValid = readValue(data, position, mapped.combination.textureDescriptorSet) &&
+            readValue(data, position, mapped.combination.textureDescriptorBinding) &&
+            readValue(data, position, mapped.combination.samplerDescriptorSet) &&
+            readValue(data, position, mapped.combination.samplerDescriptorBinding) &&
+            readValue(data, position, mapped.sourceTextureUnit) &&
+            readValue(data, position, mapped.sourceSamplerUnit) &&
+            readValue(data, position, mapped.mappedTextureUnit) &&
+            readValue(data, position, mapped.mappedSamplerUnit) &&
+            readValue(data, position, nameSize) &&
+            position + nameSize <= data.size();
+        if(!isValid)
+            break;
+
+        mapped.name.assign(reinterpret_cast<const char*> (data.data() + position), nameSize);
+        position += nameSize;
+        entry.mappedTextureWithSamplerCombinations.push_back(mapped);
+    }
+
+    if(!isValid || position >= data.size())
+    {
+        printError("Ignoring stale or corrupted program binary %s\n", fileName.c_str());
+        return false;
+    }
+
+    entry.binaryFormat = header.binaryFormat;
+    entry.binary.assign(data.begin() + position, data.end());
+    return true;
+}
+
+GLuint GLProgramBinaryCache::createProgramFromBinary(const GLProgramBinaryCacheEntry &entry)
+{
+    auto program = device.glCreateProgram();
+    device.glProgramBinary(program, entry.binaryFormat, entry.binary.data(), GLsizei(entry.binary.size()));
+
+    // The driver may reject a binary, even when it comes from the same driver.
+    GLint status = GL_FALSE;
+    device.glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if(status != GL_TRUE)
+    {
+        device.glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void GLProgramBinaryCache::prepareProgramForLinking(GLuint program)
+{
+    device.glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLProgramBinaryCache::storeLinkedProgram(uint64_t key, GLuint program, const std::vector<MappedTextureWithSamplerCombination> &mappedTextureWithSamplerCombinations)
+{
+    GLint binaryLength = 0;
+    device.glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if(binaryLength <= 0)
+        return;
+
+    std::vector<uint8_t> binary(binaryLength);
+    GLenum binaryFormat = 0;
+    GLsizei writtenLength = 0;
+    device.glGetProgramBinary(program, binaryLength, &writtenLength, &binaryFormat, binary.data());
+    if(writtenLength <= 0)
+        return;
+    binary.resize(writtenLength);
+
+    // Serialize the combinations, followed by the binary.
+    std::vector<uint8_t> data;
+    writeValue(data, uint32_t(mappedTextureWithSamplerCombinations.size()));
+    for(auto &mapped : mappedTextureWithSamplerCombinations)
+    {
+        writeValue(data, mapped.combination.textureDescriptorSet);
+        writeValue(data, mapped.combination.textureDescriptorBinding);
+        writeValue(data, mapped.combination.samplerDescriptorSet);
+        writeValue(data, mapped.combination.samplerDescriptorBinding);
+        writeValue(data, mapped.sourceTextureUnit);
+        writeValue(data, mapped.sourceSamplerUnit);
+        writeValue(data, mapped.mappedTextureUnit);
+        writeValue(data, mapped.mappedSamplerUnit);
+        writeValue(data, uint32_t(mapped.name.size()));
+        data.insert(data.end(), mapped.name.begin(), mapped.name.end());
+    }
+    data.insert(data.end(), binary.begin(), binary.end());
+
+    GLProgramBinaryCacheFileHeader header = {};
+    header.magic = ProgramBinaryCacheFileMagic;
+    header.version = ProgramBinaryCacheFileVersion;
+    header.headerSize = sizeof(GLProgramBinaryCacheFileHeader);
+    header.binaryFormat = binaryFormat;
+    header.key = key;
+    header.driverHash = driverHash;
+    header.dataSize = data.size();
+    header.dataChecksum = AgpuCommon::hashBytes(data.data(), data.size());
+    header.headerChecksum = computeHeaderChecksum(header);
+
+    std::unique_lock<std::mutex> l(mutex);
+    AgpuCommon::writeFileAtomically(fileNameForKey(key), &header, sizeof(header),
+        data.data(), data.size(), "program binary file", printError);
+}
+
+} // End of namespace AgpuGL
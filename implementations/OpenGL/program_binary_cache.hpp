@@ -0,0 +1,83 @@
+#ifndef AGPU_GL_PROGRAM_BINARY_CACHE_HPP
+#define AGPU_GL_PROGRAM_BINARY_CACHE_HPP
+
+#include "device.hpp"
+#include "shader.hpp"
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AgpuGL
+{
+
+/**
+ * I compute the key of a program in the binary cache, from everything that
+ * is used for producing it: the shader sources and entry points, the bindings
+ * of the shader signature and the GLSL version of the device.
+ */
+class GLProgramCacheKeyHasher
+{
+public:
+    GLProgramCacheKeyHasher();
+
+    void addBytes(const void *data, size_t size);
+    void addString(const std::string &string);
+    void addShader(const agpu::shader_ref &shader, const std::string &entryPoint);
+    void addSignature(const agpu::shader_signature_ref &signature);
+
+    template<typename T>
+    void add(const T &value)
+    {
+        addBytes(&value, sizeof(value));
+    }
+
+    uint64_t hash;
+};
+
+/**
+ * I am a program binary that is stored in the cache, together with the
+ * texture with sampler combinations that were extracted from its shaders.
+ */
+struct GLProgramBinaryCacheEntry
+{
+    GLenum binaryFormat;
+    std::vector<uint8_t> binary;
+    std::vector<MappedTextureWithSamplerCombination> mappedTextureWithSamplerCombinations;
+};
+
+/**
+ * Persistent on-disk cache of linked program binaries. Each program is stored
+ * in its own file, named after its key. The entries are only accepted when
+ * they were produced by the same driver, and when their checksums match. A
+ * binary that is rejected by the driver is ignored, and replaced after the
+ * program is linked again.
+ */
+class GLProgramBinaryCache
+{
+public:
+    GLProgramBinaryCache(GLDevice &device, const std::string &directory, const std::string &driverString);
+    ~GLProgramBinaryCache();
+
+    static std::string getDirectoryFor(agpu_device_open_info *openInfo);
+    static bool isSupportedBy(GLDevice &device);
+
+    bool load(uint64_t key, GLProgramBinaryCacheEntry &entry);
+
+    // These methods must be called with a current context.
+    GLuint createProgramFromBinary(const GLProgramBinaryCacheEntry &entry);
+    void prepareProgramForLinking(GLuint program);
+    void storeLinkedProgram(uint64_t key, GLuint program, const std::vector<MappedTextureWithSamplerCombination> &mappedTextureWithSamplerCombinations);
+
+private:
+    std::string fileNameForKey(uint64_t key);
+
+    GLDevice &device;
+    std::string directory;
+    uint64_t driverHash;
+    std::mutex mutex;
+};
+
+} // End of namespace AgpuGL
+
+#endif //AGPU_GL_PROGRAM_BINARY_CACHE_HPP
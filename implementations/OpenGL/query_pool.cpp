@@ -0,0 +1,212 @@
+#include "query_pool.hpp"
+
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+// GL_ARB_pipeline_statistics_query
+#ifndef GL_VERTICES_SUBMITTED
+#define GL_VERTICES_SUBMITTED 0x82EE
+#define GL_PRIMITIVES_SUBMITTED 0x82EF
+#define GL_VERTEX_SHADER_INVOCATIONS 0x82F0
+#define GL_TESS_CONTROL_SHADER_PATCHES 0x82F1
+#define GL_TESS_EVALUATION_SHADER_INVOCATIONS 0x82F2
+#define GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED 0x82F3
+#define GL_FRAGMENT_SHADER_INVOCATIONS 0x82F4
+#define GL_COMPUTE_SHADER_INVOCATIONS 0x82F5
+#define GL_CLIPPING_INPUT_PRIMITIVES 0x82F6
+#define GL_CLIPPING_OUTPUT_PRIMITIVES 0x82F7
+#endif
+
+#ifndef GL_GEOMETRY_SHADER_INVOCATIONS
+#define GL_GEOMETRY_SHADER_INVOCATIONS 0x887F
+#endif
+
+namespace AgpuGL
+{
+
+/**
+ * The statistics in the same order than their bits, which is also the order
+ * of their values in the results.
+ */
+static const struct
+{
+    agpu_pipeline_statistic_flags flag;
+    GLenum target;
+} PipelineStatisticTargets[] = {
+    {AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES, GL_VERTICES_SUBMITTED},
+    {AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES, GL_PRIMITIVES_SUBMITTED},
+    {AGPU_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS, GL_VERTEX_SHADER_INVOCATIONS},
+    {AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS, GL_GEOMETRY_SHADER_INVOCATIONS},
+    {AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES, GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED},
+    {AGPU_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS, GL_CLIPPING_INPUT_PRIMITIVES},
+    {AGPU_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES, GL_CLIPPING_OUTPUT_PRIMITIVES},
+    {AGPU_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS, GL_FRAGMENT_SHADER_INVOCATIONS},
+    {AGPU_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES, GL_TESS_CONTROL_SHADER_PATCHES},
+    {AGPU_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS, GL_TESS_EVALUATION_SHADER_INVOCATIONS},
+    {AGPU_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS, GL_COMPUTE_SHADER_INVOCATIONS},
+};
+
+GLQueryPool::GLQueryPool(const agpu::device_ref &device)
+    : device(device)
+{
+    resultValueCount = 1;
+}
+
+GLQueryPool::~GLQueryPool()
+{
+    if(!handles.empty())
+    {
+        deviceForGL->onMainContextBlocking([&]() {
+            deviceForGL->glDeleteQueries(GLsizei(handles.size()), handles.data());
+        });
+    }
+}
+
+agpu::query_pool_ref GLQueryPool::create(const agpu::device_ref &device, agpu_query_pool_description *description)
+{
+    if(!description || description->query_count == 0 || !deviceForGL->glGenQueries)
+        return agpu::query_pool_ref();
+
+    std::vector<GLenum> targets;
+    switch(description->type)
+    {
+    case AGPU_QUERY_TYPE_TIMESTAMP:
+        if(!deviceForGL->hasExtension_GL_ARB_timer_query)
+            return agpu::query_pool_ref();
+        targets.push_back(GL_TIMESTAMP);
+        break;
+    case AGPU_QUERY_TYPE_OCCLUSION:
+        targets.push_back(GL_SAMPLES_PASSED);
+        break;
+    case AGPU_QUERY_TYPE_PIPELINE_STATISTICS:
+        if(!deviceForGL->hasExtension_GL_ARB_pipeline_statistics_query || description->pipeline_statistics == 0)
+            return agpu::query_pool_ref();
+        for(auto &statistic : PipelineStatisticTargets)
+        {
+            if(description->pipeline_statistics & statistic.flag)
+                targets.push_back(statistic.target);
+        }
+        break;
+    default:
+        return agpu::query_pool_ref();
+    }
+
+    auto result = agpu::makeObject<GLQueryPool> (device);
+    auto queryPool = result.as<GLQueryPool> ();
+    queryPool->description = *description;
+    queryPool->resultValueCount = agpu_uint(targets.size());
+    queryPool->targets = targets;
+    queryPool->handles.resize(description->query_count*targets.size());
+    queryPool->issuedQueries.resize(description->query_count, false);
+
+    deviceForGL->onMainContextBlocking([&]() {
+        deviceForGL->glGenQueries(GLsizei(queryPool->handles.size()), queryPool->handles.data());
+    });
+
+    return result;
+}
+
+agpu_error GLQueryPool::getDescription(agpu_query_pool_description* description)
+{
+    CHECK_POINTER(description);
+    *description = this->description;
+    return AGPU_OK;
+}
+
+agpu_uint GLQueryPool::getResultValueCount()
+{
+    return resultValueCount;
+}
+
+agpu_float GLQueryPool::getTimestampPeriod()
+{
+    // OpenGL timestamps are always in nanoseconds.
+    return 1.0f;
+}
+
+agpu_error GLQueryPool::getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags)
+{
+    CHECK_POINTER(results);
+    if(first_query > description.query_count || query_count > description.query_count - first_query)
+        return AGPU_OUT_OF_BOUNDS;
+    if(query_count == 0)
+        return AGPU_OK;
+
+    auto waitForResults = (flags & AGPU_QUERY_RESULT_WAIT) != 0;
+    auto withAvailability = (flags & AGPU_QUERY_RESULT_WITH_AVAILABILITY) != 0;
+    auto stride = resultValueCount + (withAvailability ? 1 : 0);
+
+    agpu_error error = AGPU_OK;
+    deviceForGL->onMainContextBlocking([&]() {
+        for(agpu_uint i = 0; i < query_count; ++i)
+        {
+            auto queryIndex = first_query + i;
+            auto destination = results + i*stride;
+            auto baseHandle = handles.data() + queryIndex*resultValueCount;
+
+            bool isAvailable = issuedQueries[queryIndex];
+            for(agpu_uint j = 0; isAvailable && j < resultValueCount; ++j)
+            {
+                GLuint available = GL_FALSE;
+                if(waitForResults)
+                {
+                    // Reading the result waits for it.
+                    available = GL_TRUE;
+                }
+                else
+                {
+                    deviceForGL->glGetQueryObjectuiv(baseHandle[j], GL_QUERY_RESULT_AVAILABLE, &available);
+                }
+                isAvailable = available == GL_TRUE;
+            }
+
+            if(isAvailable)
+            {
+                for(agpu_uint j = 0; j < resultValueCount; ++j)
+                {
+                    GLuint64 value = 0;
+                    deviceForGL->glGetQueryObjectui64v(baseHandle[j], GL_QUERY_RESULT, &value);
+                    destination[j] = agpu_ulong(value);
+                }
+            }
+            else
+            {
+                error = AGPU_NOT_READY;
+            }
+
+            if(withAvailability)
+                destination[resultValueCount] = isAvailable ? 1 : 0;
+        }
+    });
+
+    return error;
+}
+
+void GLQueryPool::resetQueries(agpu_uint first_query, agpu_uint query_count)
+{
+    for(agpu_uint i = 0; i < query_count; ++i)
+        issuedQueries[first_query + i] = false;
+}
+
+void GLQueryPool::writeTimestamp(agpu_uint query_index)
+{
+    deviceForGL->glQueryCounter(handles[query_index], GL_TIMESTAMP);
+    issuedQueries[query_index] = true;
+}
+
+void GLQueryPool::beginQuery(agpu_uint query_index)
+{
+    auto baseHandle = handles.data() + query_index*resultValueCount;
+    for(agpu_uint i = 0; i < resultValueCount; ++i)
+        deviceForGL->glBeginQuery(targets[i], baseHandle[i]);
+}
+
+void GLQueryPool::endQuery(agpu_uint query_index)
+{
+    for(agpu_uint i = 0; i < resultValueCount; ++i)
+        deviceForGL->glEndQuery(targets[i]);
+    issuedQueries[query_index] = true;
+}
+
+} // End of namespace AgpuGL
@@ -0,0 +1,46 @@
+#ifndef AGPU_OPENGL_QUERY_POOL_HPP
+#define AGPU_OPENGL_QUERY_POOL_HPP
+
+#include "device.hpp"
+#include <vector>
+
+namespace AgpuGL
+{
+
+/**
+ * I am a pool of timestamp, occlusion or pipeline statistics queries. Each
+ * one of my pipeline statistics queries is made of one OpenGL query object per
+ * requested statistic. My query objects are only touched in the main context.
+ */
+class GLQueryPool : public agpu::query_pool
+{
+public:
+    GLQueryPool(const agpu::device_ref &device);
+    ~GLQueryPool();
+
+    static agpu::query_pool_ref create(const agpu::device_ref &device, agpu_query_pool_description *description);
+
+    virtual agpu_error getDescription(agpu_query_pool_description* description) override;
+    virtual agpu_uint getResultValueCount() override;
+    virtual agpu_float getTimestampPeriod() override;
+    virtual agpu_error getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags) override;
+
+    // These methods must be called in the main context.
+    void resetQueries(agpu_uint first_query, agpu_uint query_count);
+    void writeTimestamp(agpu_uint query_index);
+    void beginQuery(agpu_uint query_index);
+    void endQuery(agpu_uint query_index);
+
+    agpu::device_ref device;
+    agpu_query_pool_description description;
+    agpu_uint resultValueCount;
+    std::vector<GLenum> targets;
+    std::vector<GLuint> handles;
+
+    // A query object that was never begun cannot be read back.
+    std::vector<bool> issuedQueries;
+};
+
+} // End of namespace AgpuGL
+
+#endif //AGPU_OPENGL_QUERY_POOL_HPP
@@ -56,7 +56,7 @@ agpu_error GLShaderForSignature::compile(std::string *errorMessage)
 	CHECK_POINTER(errorMessage);
 
 	agpu_error result = AGPU_OK;
-    deviceForGL->onMainContextBlocking([&]() {
+    deviceForGL->onWorkerContextBlocking([&]() {
 		// Create the shader
 		handle = deviceForGL->glCreateShader(mapShaderType(type));
 		if(!handle)
@@ -19,7 +19,7 @@ GLShaderResourceBinding::~GLShaderResourceBinding()
 
 agpu::shader_resource_binding_ref GLShaderResourceBinding::create(const agpu::shader_signature_ref &signature, int elementIndex)
 {
-    auto result = agpu::makeObject<GLShaderResourceBinding> ();
+    auto result = agpu::makePooledObject<GLShaderResourceBinding> ();
 	auto binding = result.as<GLShaderResourceBinding> ();
     auto glSignature = signature.as<GLShaderSignature>();
 	binding->device = glSignature->device;
@@ -53,7 +53,7 @@ agpu_error GLShaderResourceBinding::bindUniformBuffer(agpu_int location, const a
     return bindUniformBufferRange(location, uniform_buffer, 0, uniform_buffer.as<GLBuffer>()->description.size);
 }
 
-agpu_error GLShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size)
+agpu_error GLShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size)
 {
 	if(location < 0)
 		return AGPU_OK;
@@ -81,7 +81,7 @@ agpu_error GLShaderResourceBinding::bindStorageBuffer(agpu_int location, const a
     return bindStorageBufferRange(location, storage_buffer, 0, storage_buffer.as<GLBuffer>()->description.size);
 }
 
-agpu_error GLShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_size offset, agpu_size size)
+agpu_error GLShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_device_size offset, agpu_device_size size)
 {
 	if(location < 0)
 		return AGPU_OK;
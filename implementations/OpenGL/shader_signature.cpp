@@ -33,6 +33,12 @@ agpu::shader_resource_binding_ptr GLShaderSignature::createShaderResourceBinding
     return GLShaderResourceBinding::create(refFromThis<agpu::shader_signature> (), element).disown();
 }
 
+agpu::shader_resource_binding_ptr GLShaderSignature::createTransientShaderResourceBinding(agpu_uint element)
+{
+    // There is no cheaper allocation path for short lived bindings.
+    return createShaderResourceBinding(element);
+}
+
 int GLShaderSignature::mapDescriptorSetAndBinding(agpu_shader_binding_type type, unsigned int set, unsigned int binding)
 {
     if(set >= elements.size())
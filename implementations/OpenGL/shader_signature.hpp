@@ -16,6 +16,7 @@ public:
     static agpu::shader_signature_ref create(const agpu::device_ref &device, const GLShaderSignatureBuilder *builder);
 
     virtual agpu::shader_resource_binding_ptr createShaderResourceBinding(agpu_uint element) override;
+    virtual agpu::shader_resource_binding_ptr createTransientShaderResourceBinding(agpu_uint element) override;
 
     int mapDescriptorSetAndBinding(agpu_shader_binding_type type, unsigned int set, unsigned int binding);
 
@@ -9,16 +9,51 @@ namespace AgpuGL
 {
 
 GLSwapChain::GLSwapChain()
-    : window(nullptr), width(0), height(0), backBufferIndex(0)
+    : window(nullptr), width(0), height(0), backBufferIndex(0),
+      headless(false), readbackFormat(GL_NONE), readbackType(GL_NONE), readbackPitch(0), pendingFrameCount(0)
 {
 }
 
 GLSwapChain::~GLSwapChain()
 {
+    if(readbackBuffers.empty())
+        return;
+
+    deviceForGL->onMainContextBlocking([&]() {
+        for(auto fence : readbackFences)
+        {
+            if(fence)
+                deviceForGL->glDeleteSync(fence);
+        }
+
+        for(size_t i = 0; i < readbackBuffers.size(); ++i)
+        {
+            if(readbackPointers[i])
+            {
+                deviceForGL->glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[i]);
+                deviceForGL->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+        }
+        deviceForGL->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        deviceForGL->glDeleteBuffers(GLsizei(readbackBuffers.size()), readbackBuffers.data());
+    });
 }
 
 agpu::swap_chain_ref GLSwapChain::create(const agpu::device_ref &device, const agpu::command_queue_ref &commandQueue, agpu_swap_chain_create_info *create_info)
 {
+    // Headless devices do not have any window where the frames can be presented.
+    bool headless = (create_info->flags & AGPU_SWAP_CHAIN_FLAG_HEADLESS) != 0 || deviceForGL->isHeadless;
+    if(headless)
+    {
+        if(create_info->colorbuffer_format == AGPU_TEXTURE_FORMAT_UNKNOWN)
+            create_info->colorbuffer_format = AGPU_TEXTURE_FORMAT_B8G8R8A8_UNORM;
+        if(!pixelSizeOfTextureFormat(create_info->colorbuffer_format) || isCompressedTextureFormat(create_info->colorbuffer_format))
+        {
+            printError("Unsupported offscreen swap chain color buffer format.\n");
+            return agpu::swap_chain_ref();
+        }
+    }
+
     // Create the framebuffer objects.
     std::vector<agpu::framebuffer_ref> framebuffers(create_info->buffer_count);
     bool hasDepth = hasDepthComponent(create_info->depth_stencil_format);
@@ -101,17 +136,102 @@ agpu::swap_chain_ref GLSwapChain::create(const agpu::device_ref &device, const a
     chain->height = create_info->height;
     chain->commandQueue = commandQueue;
 
-    // Set the window pixel format.
-    deviceForGL->setWindowPixelFormat(chain->window);
-
     // Store the framebuffers.
 	chain->framebuffers = framebuffers;
+
+    if(headless)
+    {
+        chain->headless = true;
+        chain->readbackFormat = mapExternalFormat(create_info->colorbuffer_format);
+        chain->readbackType = mapExternalFormatType(create_info->colorbuffer_format);
+        chain->readbackPitch = pixelSizeOfTextureFormat(create_info->colorbuffer_format) * create_info->width;
+        if(!chain->createReadbackBuffers())
+            return agpu::swap_chain_ref();
+        return result;
+    }
+
+    // Set the window pixel format.
+    deviceForGL->setWindowPixelFormat(chain->window);
     return result;
 }
 
+bool GLSwapChain::createReadbackBuffers()
+{
+    auto glDevice = device.as<GLDevice> ();
+    auto count = framebuffers.size();
+    auto bufferSize = GLsizeiptr(readbackPitch * height);
+    bool success = true;
+
+    readbackBuffers.resize(count);
+    readbackPointers.resize(count, nullptr);
+    readbackFences.resize(count, nullptr);
+    glDevice->onMainContextBlocking([&]() {
+        glDevice->glGenBuffers(GLsizei(count), readbackBuffers.data());
+        for(size_t i = 0; i < count; ++i)
+        {
+            glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[i]);
+
+            // Keep the buffers mapped when possible, so that reading a frame is only a copy.
+            if(glDevice->isPersistentMemoryMappingSupported_)
+            {
+                auto flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glDevice->glBufferStorage(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, flags);
+                readbackPointers[i] = reinterpret_cast<uint8_t*> (glDevice->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, flags));
+                success = success && readbackPointers[i] != nullptr;
+            }
+            else
+            {
+                glDevice->glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
+            }
+        }
+        glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    });
+
+    return success;
+}
+
+// This must be called in the main context, with the readback mutex held.
+void GLSwapChain::readBackFramebuffer()
+{
+    auto glDevice = device.as<GLDevice> ();
+
+    // The oldest unread frame is stored in this buffer. Drop it. The new
+    // read is ordered after the previous one, so there is no need to wait.
+    auto &fence = readbackFences[backBufferIndex];
+    if(pendingFrameCount == readbackBuffers.size())
+    {
+        glDevice->glDeleteSync(fence);
+        fence = nullptr;
+        --pendingFrameCount;
+    }
+
+    auto backBuffer = framebuffers[backBufferIndex].as<GLFramebuffer> ();
+    backBuffer->bind(GL_READ_FRAMEBUFFER);
+    glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[backBufferIndex]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, readbackFormat, readbackType, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    fence = glDevice->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    ++pendingFrameCount;
+}
+
 agpu_error GLSwapChain::swapBuffers()
 {
     auto glDevice = device.as<GLDevice> ();
+    if(headless)
+    {
+        std::unique_lock<std::mutex> l(readbackMutex);
+        glDevice->onMainContextBlocking([&](){
+            readBackFramebuffer();
+        });
+
+        backBufferIndex = (backBufferIndex + 1) % framebuffers.size();
+        return AGPU_OK;
+    }
+
     glDevice->onMainContextBlocking([&](){
         auto currentContext = OpenGLContext::getCurrent();
         auto res = currentContext->makeCurrentWithWindow(window);
@@ -159,6 +279,69 @@ agpu_error GLSwapChain::setOverlayPosition(agpu_int x, agpu_int y)
     return AGPU_OK;
 }
 
+agpu_error GLSwapChain::readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+{
+    CHECK_POINTER(buffer);
+    if(!headless)
+        return AGPU_UNSUPPORTED;
+    if(pitch < 0 || slicePitch < 0 || size_t(pitch) < readbackPitch || size_t(slicePitch) < size_t(pitch) * height)
+        return AGPU_INVALID_PARAMETER;
+
+    std::unique_lock<std::mutex> l(readbackMutex);
+    if(pendingFrameCount == 0)
+        return AGPU_NOT_READY;
+
+    // Poll the fence of the oldest presented frame, without waiting for it.
+    auto glDevice = device.as<GLDevice> ();
+    auto index = (backBufferIndex + readbackBuffers.size() - pendingFrameCount) % readbackBuffers.size();
+    agpu_error result = AGPU_OK;
+    glDevice->onMainContextBlocking([&]() {
+        auto &fence = readbackFences[index];
+        auto status = glDevice->glClientWaitSync(fence, 0, 0);
+        if(status == GL_TIMEOUT_EXPIRED)
+        {
+            result = AGPU_NOT_READY;
+            return;
+        }
+
+        glDevice->glDeleteSync(fence);
+        fence = nullptr;
+        --pendingFrameCount;
+        if(status == GL_WAIT_FAILED)
+        {
+            result = AGPU_ERROR;
+            return;
+        }
+
+        auto source = readbackPointers[index];
+        if(!source)
+        {
+            glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[index]);
+            source = reinterpret_cast<uint8_t*> (glDevice->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(readbackPitch * height), GL_MAP_READ_BIT));
+            if(!source)
+            {
+                glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                result = AGPU_ERROR;
+                return;
+            }
+        }
+
+        // The rows read by OpenGL go from the bottom to the top, so they are
+        // flipped like in the texture readbacks.
+        auto destination = reinterpret_cast<uint8_t*> (buffer);
+        for(agpu_uint y = 0; y < height; ++y)
+            memcpy(destination + pitch*y, source + readbackPitch*(height - 1 - y), readbackPitch);
+
+        if(!readbackPointers[index])
+        {
+            glDevice->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glDevice->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+    });
+
+    return result;
+}
+
 agpu_size GLSwapChain::getWidth()
 {
     return width;
@@ -3,6 +3,7 @@
 
 #include "device.hpp"
 #include "framebuffer.hpp"
+#include <mutex>
 
 namespace AgpuGL
 {
@@ -23,6 +24,7 @@ public:
     virtual agpu_error swapBuffers() override;
 
 	virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) override;
+    virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
 
     virtual agpu_size getWidth() override;
 	virtual agpu_size getHeight() override;
@@ -36,6 +38,21 @@ public:
     agpu_uint backBufferIndex;
     std::vector<agpu::framebuffer_ref> framebuffers;
     agpu::command_queue_ref commandQueue;
+
+    // Headless swap chains read back each presented frame into a pixel buffer.
+    bool headless;
+    GLenum readbackFormat;
+    GLenum readbackType;
+    size_t readbackPitch;
+    std::vector<GLuint> readbackBuffers;
+    std::vector<uint8_t*> readbackPointers;
+    std::vector<GLsync> readbackFences;
+    std::mutex readbackMutex;
+    agpu_uint pendingFrameCount;
+
+private:
+    bool createReadbackBuffers();
+    void readBackFramebuffer();
 };
 
 } // End of namespace AgpuGL
@@ -270,81 +270,102 @@ agpu_pointer GLTexture::mapLevel ( agpu_int level, agpu_int arrayIndex, agpu_map
     if(mappedPointer)
         return mappedPointer;
 
+    deviceForGL->onMainContextBlocking([&]() {
+        mapTransferBuffer(level, arrayIndex, flags);
+    });
+
+    return mappedPointer;
+}
+
+agpu_error GLTexture::unmapLevel ( )
+{
+    if(!mappedPointer)
+        return AGPU_INVALID_OPERATION;
+
+    deviceForGL->onMainContextBlocking([&]() {
+        unmapTransferBuffer();
+    });
+
+    return AGPU_OK;
+}
+
+void GLTexture::mapTransferBuffer(agpu_int level, agpu_int arrayIndex, agpu_mapping_access flags)
+{
     this->mappingAccess = flags;
     this->mappedLevel = level;
+    this->mappedArrayIndex = arrayIndex;
     bool isRead = mappingAccess == AGPU_READ_ONLY || mappingAccess == AGPU_READ_WRITE;
     bool isWrite = mappingAccess == AGPU_WRITE_ONLY || mappingAccess == AGPU_READ_WRITE;
 
     GLenum target = isWrite ? GL_PIXEL_UNPACK_BUFFER : GL_PIXEL_PACK_BUFFER;
     GLenum access = mapMappingAccess(mappingAccess);
 
-    deviceForGL->onMainContextBlocking([&]() {
-        if(!transferBuffer)
-            createTransferBuffer(GL_PIXEL_PACK_BUFFER);
-
-        if(isRead)
-            performTransferToCpu(level);
-
-        deviceForGL->glBindBuffer(target, transferBuffer);
-        mappedPointer = deviceForGL->glMapBuffer(target, access);
-        deviceForGL->glBindBuffer(target, 0);
-    });
+    if(!transferBuffer)
+        createTransferBuffer(GL_PIXEL_PACK_BUFFER);
 
-    mappedArrayIndex = arrayIndex;
+    if(isRead)
+        performTransferToCpu(level);
 
-    return mappedPointer;
+    deviceForGL->glBindBuffer(target, transferBuffer);
+    mappedPointer = deviceForGL->glMapBuffer(target, access);
+    deviceForGL->glBindBuffer(target, 0);
 }
 
-agpu_error GLTexture::unmapLevel ( )
+void GLTexture::unmapTransferBuffer()
 {
-    if(!mappedPointer)
-        return AGPU_INVALID_OPERATION;
-
     //bool isRead = mappingAccess == AGPU_READ_ONLY || mappingAccess == AGPU_READ_WRITE;
     bool isWrite = mappingAccess == AGPU_WRITE_ONLY || mappingAccess == AGPU_READ_WRITE;
     GLenum target = isWrite ? GL_PIXEL_UNPACK_BUFFER : GL_PIXEL_PACK_BUFFER;
 
-    deviceForGL->onMainContextBlocking([&]() {
-        deviceForGL->glBindBuffer(target, transferBuffer);
-        deviceForGL->glUnmapBuffer(target);
-        deviceForGL->glBindBuffer(target, 0);
+    deviceForGL->glBindBuffer(target, transferBuffer);
+    deviceForGL->glUnmapBuffer(target);
+    deviceForGL->glBindBuffer(target, 0);
 
-        if(isWrite)
-            performTransferToGpu(mappedLevel, mappedArrayIndex);
-    });
+    if(isWrite)
+        performTransferToGpu(mappedLevel, mappedArrayIndex);
 
     mappedPointer = nullptr;
-    return AGPU_OK;
 }
 
 agpu_error GLTexture::readTextureData ( agpu_int level, agpu_int arrayIndex, agpu_int dstPitch, agpu_int slicePitch, agpu_pointer data )
 {
     CHECK_POINTER(data);
-    auto src = reinterpret_cast<uint8_t*> (mapLevel(level, arrayIndex, AGPU_READ_ONLY, nullptr));
-    if(!src)
-        return AGPU_ERROR;
+    if(mappedPointer)
+        return AGPU_INVALID_OPERATION;
 
-    auto transferLayout = BufferTextureTransferLayout::fromDescriptionAndLevel(description, level);
-    auto srcPitch = transferLayout.pitch;
-    auto dst = reinterpret_cast<uint8_t*> (data);
+    // The whole readback is done in a worker context, through the transfer pixel buffer.
+    agpu_error result = AGPU_OK;
+    deviceForGL->onWorkerContextBlocking([&]() {
+        mapTransferBuffer(level, arrayIndex, AGPU_READ_ONLY);
+        auto src = reinterpret_cast<uint8_t*> (mappedPointer);
+        if(!src)
+        {
+            result = AGPU_ERROR;
+            return;
+        }
 
-    if (dstPitch >= transferLayout.pitch && slicePitch == transferLayout.slicePitch)
-    {
-        memcpy(dst, src, slicePitch);
-    }
-    else
-    {
-        auto height = transferLayout.height;
-        auto fsrc = src + (height - 1) *srcPitch;
-        ptrdiff_t fsrcPitch = -ptrdiff_t(srcPitch);
-        for(size_t y = 0; y < height; ++y)
+        auto transferLayout = BufferTextureTransferLayout::fromDescriptionAndLevel(description, level);
+        auto srcPitch = transferLayout.pitch;
+        auto dst = reinterpret_cast<uint8_t*> (data);
+        if (dstPitch >= transferLayout.pitch && slicePitch == transferLayout.slicePitch)
         {
-            memcpy(dst + dstPitch*y, fsrc + fsrcPitch*y, srcPitch);
+            memcpy(dst, src, slicePitch);
+        }
+        else
+        {
+            auto height = transferLayout.height;
+            auto fsrc = src + (height - 1) *srcPitch;
+            ptrdiff_t fsrcPitch = -ptrdiff_t(srcPitch);
+            for(size_t y = 0; y < height; ++y)
+            {
+                memcpy(dst + dstPitch*y, fsrc + fsrcPitch*y, srcPitch);
+            }
         }
-    }
 
-    unmapLevel();
-    return AGPU_OK;
+        unmapTransferBuffer();
+    });
+
+    return result;
 }
 
 agpu_error GLTexture::readTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer)
@@ -357,9 +378,81 @@ agpu_error GLTexture::uploadTextureData ( agpu_int level, agpu_int arrayIndex, a
     return uploadTextureSubData(level, arrayIndex, pitch, slicePitch, nullptr, nullptr, data);
 }
 
+agpu::fence_ptr GLTexture::uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data)
+{
+    // The upload is synchronous in this backend, so the fence is signaled right away.
+    auto error = uploadTextureData(level, arrayIndex, pitch, slicePitch, data);
+    if(error)
+        return nullptr;
+
+    auto fence = agpu::fence_ref(device->createFence());
+    if(!fence)
+        return nullptr;
+
+    auto commandQueue = agpu::command_queue_ref(device->getDefaultCommandQueue());
+    commandQueue->signalFence(fence);
+    return fence.disown();
+}
+
 agpu_error GLTexture::uploadTextureSubData ( agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data )
 {
-    auto dst = reinterpret_cast<uint8_t*> (mapLevel(level, arrayIndex, AGPU_WRITE_ONLY, destRegion));
+    if(mappedPointer)
+        return AGPU_INVALID_OPERATION;
+
+    // The whole upload is done in a worker context, through the transfer pixel buffer.
+    agpu_error result = AGPU_OK;
+    deviceForGL->onWorkerContextBlocking([&]() {
+        result = uploadThroughTransferBuffer(level, arrayIndex, pitch, slicePitch, sourceSize, destRegion, data);
+    });
+
+    return result;
+}
+
+agpu_error GLTexture::uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources)
+{
+    CHECK_POINTER(subresources);
+    if(mappedPointer)
+        return AGPU_INVALID_OPERATION;
+
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        CHECK_POINTER(subresources[i].data);
+        if(subresources[i].level >= description.miplevels || subresources[i].array_index >= description.layers)
+            return AGPU_OUT_OF_BOUNDS;
+    }
+
+    // All of the subresources are uploaded in a single worker job, which
+    // synchronizes with the main context only once.
+    agpu_error result = AGPU_OK;
+    deviceForGL->onWorkerContextBlocking([&]() {
+        for(agpu_uint i = 0; i < count && result == AGPU_OK; ++i)
+        {
+            auto &subresource = subresources[i];
+
+            // A zero pitch selects tightly packed rows and slices.
+            auto pitch = subresource.pitch;
+            auto slicePitch = subresource.slice_pitch;
+            if(pitch == 0)
+            {
+                auto transferLayout = BufferTextureTransferLayout::fromDescriptionAndLevel(description, subresource.level);
+                pitch = transferLayout.pitch;
+                if(!isCompressedTextureFormat(description.format))
+                    pitch = agpu_int(transferLayout.width * pixelSizeOfTextureFormat(description.format));
+                if(slicePitch == 0)
+                    slicePitch = agpu_int(pitch * (transferLayout.slicePitch / transferLayout.pitch));
+            }
+
+            result = uploadThroughTransferBuffer(subresource.level, subresource.array_index, pitch, slicePitch, nullptr, nullptr, subresource.data);
+        }
+    });
+
+    return result;
+}
+
+agpu_error GLTexture::uploadThroughTransferBuffer(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data)
+{
+    mapTransferBuffer(level, arrayIndex, AGPU_WRITE_ONLY);
+    auto dst = reinterpret_cast<uint8_t*> (mappedPointer);
     if(!dst)
         return AGPU_ERROR;
 
@@ -389,7 +482,7 @@ agpu_error GLTexture::uploadTextureSubData ( agpu_int level, agpu_int arrayIndex
         }
     }
 
-    unmapLevel();
+    unmapTransferBuffer();
     return AGPU_OK;
 }
 
@@ -423,7 +516,7 @@ agpu::texture_view_ptr GLTexture::getOrCreateFullView()
     {
         agpu_texture_view_description descripton;
         getFullViewDescription(&descripton);
-        fullTextureView = agpu::makeObject<GLFullTextureView> (device, refFromThis<agpu::texture> (), descripton);
+        fullTextureView = agpu::makePooledObject<GLFullTextureView> (device, refFromThis<agpu::texture> (), descripton);
     }
 
     return fullTextureView.disownedNewRef();
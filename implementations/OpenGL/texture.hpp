@@ -41,7 +41,9 @@ public:
     virtual agpu_error readTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
 	virtual agpu_error readTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer) override;
 	virtual agpu_error uploadTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
+	virtual agpu::fence_ptr uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
     virtual agpu_error uploadTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data) override;
+    virtual agpu_error uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources) override;
 
     virtual agpu_error getDescription(agpu_texture_description* description) override;
 
@@ -68,6 +70,11 @@ private:
     static void allocateTextureCube(const agpu::device_ref &device, GLuint handle, GLenum target, agpu_texture_description *description);
     static void allocateTextureBuffer(const agpu::device_ref &device, GLuint handle, GLenum target, agpu_texture_description *description);
 
+    // I must be called with a current context.
+    void mapTransferBuffer(agpu_int level, agpu_int arrayIndex, agpu_mapping_access flags);
+    void unmapTransferBuffer();
+    agpu_error uploadThroughTransferBuffer(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data);
+
     void createTransferBuffer(GLenum target);
     void performTransferToCpu(int level);
     void performTransferToGpu(int level, int arrayIndex);
@@ -27,7 +27,7 @@ agpu::vertex_binding_ref GLVertexBinding::createVertexBinding(const agpu::device
         deviceForGL->glGenVertexArrays(1, &handle);
     });
 
-    auto result = agpu::makeObject<GLVertexBinding> ();
+    auto result = agpu::makePooledObject<GLVertexBinding> ();
 	auto binding = result.as<GLVertexBinding> ();
     binding->handle = handle;
 	binding->device = device;
@@ -47,7 +47,7 @@ agpu_error GLVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_ref*
     return bindVertexBuffersWithOffsets(count, vertex_buffers, nullptr);
 }
 
-agpu_error GLVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_size *offsets)
+agpu_error GLVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_device_size *offsets)
 {
     if (count != vertexLayout.as<GLVertexLayout> ()->vertexBufferCount)
         return AGPU_ERROR;
@@ -19,7 +19,7 @@ public:
     static agpu::vertex_binding_ref createVertexBinding(const agpu::device_ref &device, const agpu::vertex_layout_ref &layout);
 
     agpu_error bindVertexBuffers(agpu_uint count, agpu::buffer_ref* vertex_buffers);
-	agpu_error bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_size *offsets);
+	agpu_error bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_device_size *offsets);
 
 	agpu_error activateVertexAttribute ( agpu_size stride, agpu_vertex_attrib_description &attribute, agpu_size bufferOffset );
 
@@ -0,0 +1,520 @@
+#include "async_transfer_engine.hpp"
+#include "implicit_resource_command_list.hpp"
+#include "device.hpp"
+#include "command_queue.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace AgpuVulkan
+{
+
+static size_t leastCommonMultipleWithFour(size_t value)
+{
+    if(value == 0)
+        return 4;
+    if(value % 4 == 0)
+        return value;
+    if(value % 2 == 0)
+        return value * 2;
+    return value * 4;
+}
+
+AVkAsyncTransferEngine::AVkAsyncTransferEngine(AVkDevice &cdevice)
+    : device(cdevice),
+    isWaitingForFence(false),
+    queueFamilyIndex(0),
+    nextSerial(1),
+    completedSerial(0)
+{
+}
+
+AVkAsyncTransferEngine::~AVkAsyncTransferEngine()
+{
+}
+
+bool AVkAsyncTransferEngine::initialize(const agpu::command_queue_ref &queue)
+{
+    commandQueue = queue;
+    queueFamilyIndex = queue.as<AVkCommandQueue> ()->queueFamilyIndex;
+    return true;
+}
+
+void AVkAsyncTransferEngine::destroy()
+{
+    if(!commandQueue)
+        return;
+
+    flush();
+    waitFor(nextSerial - 1);
+
+    std::unique_lock<std::mutex> l(mutex);
+    for(auto &batch : freeBatches)
+        destroyBatch(*batch);
+    freeBatches.clear();
+
+    for(auto &chunk : freeChunks)
+        destroyChunk(chunk);
+    freeChunks.clear();
+
+    commandQueue.reset();
+}
+
+bool AVkAsyncTransferEngine::createBatch(std::unique_ptr<AVkTransferBatch> &result)
+{
+    std::unique_ptr<AVkTransferBatch> batch(new AVkTransferBatch());
+    batch->serial = 0;
+    batch->commandPool = VK_NULL_HANDLE;
+    batch->commandBuffer = VK_NULL_HANDLE;
+    batch->fence = VK_NULL_HANDLE;
+
+    VkCommandPoolCreateInfo poolCreate = {};
+    poolCreate.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolCreate.queueFamilyIndex = queueFamilyIndex;
+    poolCreate.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    auto error = vkCreateCommandPool(device.device, &poolCreate, nullptr, &batch->commandPool);
+    if(error)
+        return false;
+
+    VkCommandBufferAllocateInfo commandInfo = {};
+    commandInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandInfo.commandPool = batch->commandPool;
+    commandInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandInfo.commandBufferCount = 1;
+    error = vkAllocateCommandBuffers(device.device, &commandInfo, &batch->commandBuffer);
+    if(error)
+    {
+        destroyBatch(*batch);
+        return false;
+    }
+
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    error = vkCreateFence(device.device, &fenceInfo, nullptr, &batch->fence);
+    if(error)
+    {
+        destroyBatch(*batch);
+        return false;
+    }
+
+    result = std::move(batch);
+    return true;
+}
+
+void AVkAsyncTransferEngine::destroyBatch(AVkTransferBatch &batch)
+{
+    for(auto &chunk : batch.chunks)
+        destroyChunk(chunk);
+    batch.chunks.clear();
+
+    if(batch.fence)
+        vkDestroyFence(device.device, batch.fence, nullptr);
+    if(batch.commandPool)
+        vkDestroyCommandPool(device.device, batch.commandPool, nullptr);
+    batch.fence = VK_NULL_HANDLE;
+    batch.commandPool = VK_NULL_HANDLE;
+    batch.commandBuffer = VK_NULL_HANDLE;
+}
+
+bool AVkAsyncTransferEngine::acquireChunk(size_t minimumSize, AVkStagingChunk &chunk)
+{
+    if(minimumSize <= StagingChunkSize && !freeChunks.empty())
+    {
+        chunk = freeChunks.back();
+        freeChunks.pop_back();
+        chunk.usedSize = 0;
+        return true;
+    }
+
+    auto capacity = std::max(StagingChunkSize, alignedTo(minimumSize, StagingChunkSize));
+
+    VkBufferCreateInfo bufferDescription = {};
+    bufferDescription.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferDescription.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    bufferDescription.size = capacity;
+    bufferDescription.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo allocationInfo = {};
+    allocationInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    allocationInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocationInfo.requiredFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VmaAllocationInfo createdAllocationInfo = {};
+    auto error = vmaCreateBuffer(device.sharedContext->memoryAllocator, &bufferDescription, &allocationInfo, &chunk.buffer, &chunk.allocation, &createdAllocationInfo);
+    if(error)
+        return false;
+
+    chunk.mappedPointer = reinterpret_cast<uint8_t*> (createdAllocationInfo.pMappedData);
+    chunk.capacity = capacity;
+    chunk.usedSize = 0;
+    return true;
+}
+
+void AVkAsyncTransferEngine::releaseChunk(const AVkStagingChunk &chunk)
+{
+    if(chunk.capacity == StagingChunkSize && freeChunks.size() < MaxPooledChunks)
+        freeChunks.push_back(chunk);
+    else
+        destroyChunk(chunk);
+}
+
+void AVkAsyncTransferEngine::destroyChunk(const AVkStagingChunk &chunk)
+{
+    vmaDestroyBuffer(device.sharedContext->memoryAllocator, chunk.buffer, chunk.allocation);
+}
+
+bool AVkAsyncTransferEngine::ensureRecordingBatch()
+{
+    if(recordingBatch)
+        return true;
+
+    retireCompletedBatches();
+
+    std::unique_ptr<AVkTransferBatch> batch;
+    if(!freeBatches.empty())
+    {
+        batch = std::move(freeBatches.back());
+        freeBatches.pop_back();
+    }
+    else if(!createBatch(batch))
+    {
+        return false;
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    auto error = vkBeginCommandBuffer(batch->commandBuffer, &beginInfo);
+    if(error)
+    {
+        destroyBatch(*batch);
+        return false;
+    }
+
+    batch->serial = nextSerial++;
+    recordingBatch = std::move(batch);
+    return true;
+}
+
+bool AVkAsyncTransferEngine::submitRecordingBatch()
+{
+    if(!recordingBatch)
+        return true;
+
+    // Make the transfers visible to the commands that are submitted later.
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(recordingBatch->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    auto error = vkEndCommandBuffer(recordingBatch->commandBuffer);
+    if(error)
+        return false;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &recordingBatch->commandBuffer;
+
+    auto avkQueue = commandQueue.as<AVkCommandQueue> ();
+    {
+        std::unique_lock<std::mutex> l(avkQueue->submissionMutex);
+        error = vkQueueSubmit(avkQueue->queue, 1, &submitInfo, recordingBatch->fence);
+    }
+    if(error)
+        return false;
+
+    submittedBatches.push_back(std::move(recordingBatch));
+    return true;
+}
+
+void AVkAsyncTransferEngine::retireCompletedBatches()
+{
+    // The fence of the oldest batch may be being waited without the mutex.
+    if(isWaitingForFence)
+        return;
+
+    while(!submittedBatches.empty())
+    {
+        auto &batch = submittedBatches.front();
+        if(vkGetFenceStatus(device.device, batch->fence) != VK_SUCCESS)
+            break;
+
+        completedSerial = batch->serial;
+        recycleBatch(std::move(batch));
+        submittedBatches.pop_front();
+    }
+}
+
+void AVkAsyncTransferEngine::recycleBatch(std::unique_ptr<AVkTransferBatch> &&batch)
+{
+    for(auto &chunk : batch->chunks)
+        releaseChunk(chunk);
+    batch->chunks.clear();
+    batch->retainedBuffers.clear();
+    batch->retainedTextures.clear();
+
+    auto error = vkResetFences(device.device, 1, &batch->fence);
+    if(!error)
+        error = vkResetCommandPool(device.device, batch->commandPool, 0);
+    if(error)
+    {
+        destroyBatch(*batch);
+        return;
+    }
+
+    freeBatches.push_back(std::move(batch));
+}
+
+uint8_t *AVkAsyncTransferEngine::allocateStaging(size_t minimumSize, size_t requestedSize, size_t alignment, size_t &allocatedSize, VkBuffer &stagingBuffer, size_t &stagingOffset, bool &isBatchFull)
+{
+    isBatchFull = false;
+    if(!ensureRecordingBatch())
+        return nullptr;
+
+    auto &chunks = recordingBatch->chunks;
+    if(!chunks.empty())
+    {
+        auto &chunk = chunks.back();
+        auto offset = alignedTo(chunk.usedSize, alignment);
+        if(offset + minimumSize <= chunk.capacity)
+        {
+            allocatedSize = std::min(requestedSize, chunk.capacity - offset);
+            chunk.usedSize = offset + allocatedSize;
+            stagingBuffer = chunk.buffer;
+            stagingOffset = offset;
+            return chunk.mappedPointer + offset;
+        }
+
+        if(chunks.size() >= MaxChunksPerBatch)
+        {
+            isBatchFull = true;
+            return nullptr;
+        }
+    }
+
+    AVkStagingChunk chunk;
+    if(!acquireChunk(minimumSize, chunk))
+        return nullptr;
+
+    allocatedSize = std::min(requestedSize, chunk.capacity);
+    chunk.usedSize = allocatedSize;
+    chunks.push_back(chunk);
+    stagingBuffer = chunk.buffer;
+    stagingOffset = 0;
+    return chunk.mappedPointer;
+}
+
+bool AVkAsyncTransferEngine::uploadBufferData(VkBuffer destBuffer, size_t offset, size_t size, const void *data, const agpu::buffer_ref &retainedBuffer, uint64_t &serial)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    auto source = reinterpret_cast<const uint8_t*> (data);
+    while(size > 0)
+    {
+        size_t allocatedSize = 0;
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        size_t stagingOffset = 0;
+        bool isBatchFull = false;
+        auto stagingPointer = allocateStaging(1, size, 4, allocatedSize, stagingBuffer, stagingOffset, isBatchFull);
+        if(!stagingPointer)
+        {
+            if(isBatchFull && submitRecordingBatch())
+                continue;
+            return false;
+        }
+
+        memcpy(stagingPointer, source, allocatedSize);
+
+        VkBufferCopy region;
+        region.srcOffset = stagingOffset;
+        region.dstOffset = offset;
+        region.size = allocatedSize;
+        vkCmdCopyBuffer(recordingBatch->commandBuffer, stagingBuffer, destBuffer, 1, &region);
+
+        source += allocatedSize;
+        offset += allocatedSize;
+        size -= allocatedSize;
+    }
+
+    if(!ensureRecordingBatch())
+        return false;
+
+    if(retainedBuffer)
+        recordingBatch->retainedBuffers.push_back(retainedBuffer);
+    serial = recordingBatch->serial;
+    return true;
+}
+
+void AVkAsyncTransferEngine::recordImageTransition(const AVkImageUploadRequest &request, const VkImageSubresourceRange &range, agpu_texture_usage_mode_mask sourceUsage, agpu_texture_usage_mode_mask destUsage)
+{
+    if(sourceUsage == destUsage)
+        return;
+
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags destStages = 0;
+    auto barrier = barrierForImageUsageTransition(request.image, range, request.allowedUsages, sourceUsage, destUsage, srcStages, destStages);
+    vkCmdPipelineBarrier(recordingBatch->commandBuffer, srcStages, destStages, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+bool AVkAsyncTransferEngine::uploadImageData(const AVkImageUploadRequest &request, const agpu::texture_ref &retainedTexture, uint64_t &serial)
+{
+    return uploadImageSubresources(&request, 1, request.range, retainedTexture, serial);
+}
+
+bool AVkAsyncTransferEngine::uploadImageSubresources(const AVkImageUploadRequest *requests, size_t requestCount, const VkImageSubresourceRange &wholeRange, const agpu::texture_ref &retainedTexture, uint64_t &serial)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    if(!ensureRecordingBatch())
+        return false;
+
+    if(requestCount > 0)
+    {
+        auto &firstRequest = requests[0];
+        recordImageTransition(firstRequest, wholeRange, firstRequest.mainUsage, AGPU_TEXTURE_USAGE_COPY_DESTINATION);
+        for(size_t i = 0; i < requestCount; ++i)
+        {
+            if(!recordImageCopies(requests[i], wholeRange))
+                return false;
+        }
+        recordImageTransition(firstRequest, wholeRange, AGPU_TEXTURE_USAGE_COPY_DESTINATION, firstRequest.mainUsage);
+    }
+
+    if(retainedTexture)
+        recordingBatch->retainedTextures.push_back(retainedTexture);
+    serial = recordingBatch->serial;
+    return true;
+}
+
+bool AVkAsyncTransferEngine::recordImageCopies(const AVkImageUploadRequest &request, const VkImageSubresourceRange &transitionRange)
+{
+    auto alignment = leastCommonMultipleWithFour(request.texelBlockSize);
+    auto &extent = request.copy.imageExtent;
+    auto sourceSlice = request.data;
+    for(uint32_t z = 0; z < extent.depth; ++z)
+    {
+        auto sourceRow = sourceSlice;
+        size_t row = 0;
+        while(row < request.rowCount)
+        {
+            size_t allocatedSize = 0;
+            VkBuffer stagingBuffer = VK_NULL_HANDLE;
+            size_t stagingOffset = 0;
+            bool isBatchFull = false;
+            auto stagingPointer = allocateStaging(request.rowPitch, (request.rowCount - row)*request.rowPitch, alignment, allocatedSize, stagingBuffer, stagingOffset, isBatchFull);
+            if(!stagingPointer)
+            {
+                // Leave the image in its main usage mode at the end of each
+                // batch, including the batch of a failed upload.
+                recordImageTransition(request, transitionRange, AGPU_TEXTURE_USAGE_COPY_DESTINATION, request.mainUsage);
+                if(!isBatchFull)
+                    return false;
+
+                if(!submitRecordingBatch() || !ensureRecordingBatch())
+                    return false;
+                recordImageTransition(request, transitionRange, request.mainUsage, AGPU_TEXTURE_USAGE_COPY_DESTINATION);
+                continue;
+            }
+
+            // Copy the complete rows that fit into the staging memory.
+            auto rowsToCopy = allocatedSize / request.rowPitch;
+            if(request.sourcePitch == ptrdiff_t(request.rowPitch))
+            {
+                memcpy(stagingPointer, sourceRow, rowsToCopy*request.rowPitch);
+                sourceRow += rowsToCopy*request.rowPitch;
+            }
+            else
+            {
+                auto stagingRow = stagingPointer;
+                for(size_t i = 0; i < rowsToCopy; ++i)
+                {
+                    memcpy(stagingRow, sourceRow, request.rowCopySize);
+                    sourceRow += request.sourcePitch;
+                    stagingRow += request.rowPitch;
+                }
+            }
+
+            auto firstTexelRow = uint32_t(row*request.rowHeight);
+            VkBufferImageCopy region = request.copy;
+            region.bufferOffset = stagingOffset;
+            region.bufferImageHeight = uint32_t(rowsToCopy*request.rowHeight);
+            region.imageOffset.x = 0;
+            region.imageOffset.y = int32_t(firstTexelRow);
+            region.imageOffset.z = int32_t(z);
+            region.imageExtent.height = std::min(region.bufferImageHeight, extent.height - firstTexelRow);
+            region.imageExtent.depth = 1;
+            vkCmdCopyBufferToImage(recordingBatch->commandBuffer, stagingBuffer, request.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+            row += rowsToCopy;
+        }
+
+        sourceSlice += request.sourceSlicePitch;
+    }
+
+    return true;
+}
+
+bool AVkAsyncTransferEngine::flush()
+{
+    std::unique_lock<std::mutex> l(mutex);
+    return submitRecordingBatch();
+}
+
+bool AVkAsyncTransferEngine::isCompleted(uint64_t serial)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    retireCompletedBatches();
+    return serial <= completedSerial;
+}
+
+bool AVkAsyncTransferEngine::waitFor(uint64_t serial)
+{
+    return waitFor(serial, UINT64_MAX) == VK_SUCCESS;
+}
+
+VkResult AVkAsyncTransferEngine::waitFor(uint64_t serial, uint64_t timeout)
+{
+    auto hasDeadline = timeout < uint64_t(INT64_MAX/2);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(hasDeadline ? timeout : 0);
+
+    std::unique_lock<std::mutex> l(mutex);
+    if(recordingBatch && recordingBatch->serial <= serial && !submitRecordingBatch())
+        return VK_ERROR_DEVICE_LOST;
+
+    while(completedSerial < serial)
+    {
+        if(isWaitingForFence)
+        {
+            if(!hasDeadline)
+                completionCondition.wait(l);
+            else if(completionCondition.wait_until(l, deadline) == std::cv_status::timeout)
+                return VK_TIMEOUT;
+            continue;
+        }
+
+        retireCompletedBatches();
+        if(completedSerial >= serial || submittedBatches.empty())
+            break;
+
+        uint64_t fenceTimeout = UINT64_MAX;
+        if(hasDeadline)
+        {
+            auto now = std::chrono::steady_clock::now();
+            fenceTimeout = now < deadline ? uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds> (deadline - now).count()) : 0;
+        }
+
+        // Wait for the oldest batch without blocking the recording threads.
+        auto fence = submittedBatches.front()->fence;
+        isWaitingForFence = true;
+        l.unlock();
+        auto error = vkWaitForFences(device.device, 1, &fence, VK_TRUE, fenceTimeout);
+        l.lock();
+        isWaitingForFence = false;
+        completionCondition.notify_all();
+        if(error)
+            return error;
+    }
+
+    return completedSerial >= serial ? VK_SUCCESS : VK_ERROR_DEVICE_LOST;
+}
+
+} // End of namespace AgpuVulkan
@@ -0,0 +1,153 @@
+#ifndef AGPU_VULKAN_ASYNC_TRANSFER_ENGINE_HPP
+#define AGPU_VULKAN_ASYNC_TRANSFER_ENGINE_HPP
+
+#include "common.hpp"
+#include "include_vulkan.h"
+#include "vk_mem_alloc.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AgpuVulkan
+{
+class AVkDevice;
+
+/**
+ * I am a persistently mapped chunk of staging memory. The pooled chunks have
+ * a fixed size, and bigger chunks are only created for a texture row that
+ * does not fit into a pooled one.
+ */
+struct AVkStagingChunk
+{
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    uint8_t *mappedPointer;
+    size_t capacity;
+    size_t usedSize;
+};
+
+/**
+ * I am a batch of transfer commands. The uploads of all of the threads are
+ * recorded into the same batch until it is submitted with a single
+ * vkQueueSubmit. My serial identifies me in the fences that wait for me.
+ */
+struct AVkTransferBatch
+{
+    uint64_t serial;
+    VkCommandPool commandPool;
+    VkCommandBuffer commandBuffer;
+    VkFence fence;
+    std::vector<AVkStagingChunk> chunks;
+    std::vector<agpu::buffer_ref> retainedBuffers;
+    std::vector<agpu::texture_ref> retainedTextures;
+};
+
+/**
+ * I describe the upload of a single texture subresource into an image.
+ */
+struct AVkImageUploadRequest
+{
+    VkImage image;
+    VkImageSubresourceRange range;
+    agpu_texture_usage_mode_mask allowedUsages;
+    agpu_texture_usage_mode_mask mainUsage;
+
+    // The copy of the whole subresource, and its staging layout.
+    VkBufferImageCopy copy;
+    size_t rowPitch;
+    size_t rowCount;
+    uint32_t rowHeight;
+    size_t texelBlockSize;
+
+    // The client data.
+    const uint8_t *data;
+    ptrdiff_t sourcePitch;
+    ptrdiff_t sourceSlicePitch;
+    size_t rowCopySize;
+};
+
+/**
+ * I am an asynchronous transfer engine that streams uploads into a command
+ * queue through a pool of staging chunks. Uploads that do not fit into the
+ * staging memory of a batch are split across several batches. The client
+ * data is always copied before returning, and the completion of an upload is
+ * tracked with the serial of the batch that contains its last command.
+ */
+class AVkAsyncTransferEngine
+{
+public:
+    static constexpr size_t StagingChunkSize = 4*1024*1024;
+    static constexpr size_t MaxChunksPerBatch = 16;
+    static constexpr size_t MaxPooledChunks = 32;
+
+    AVkAsyncTransferEngine(AVkDevice &cdevice);
+    ~AVkAsyncTransferEngine();
+
+    bool initialize(const agpu::command_queue_ref &queue);
+    void destroy();
+
+    bool usesCommandQueue(const agpu::command_queue_ref &queue) const
+    {
+        return commandQueue == queue;
+    }
+
+    bool uploadBufferData(VkBuffer destBuffer, size_t offset, size_t size, const void *data, const agpu::buffer_ref &retainedBuffer, uint64_t &serial);
+    bool uploadImageData(const AVkImageUploadRequest &request, const agpu::texture_ref &retainedTexture, uint64_t &serial);
+
+    // I upload several subresources of the same image, with a single pair of
+    // transitions of the whole range for each batch that contains them.
+    bool uploadImageSubresources(const AVkImageUploadRequest *requests, size_t requestCount, const VkImageSubresourceRange &wholeRange, const agpu::texture_ref &retainedTexture, uint64_t &serial);
+
+    // I submit the batch that is being recorded, if there is one.
+    bool flush();
+
+    bool isCompleted(uint64_t serial);
+    bool waitFor(uint64_t serial);
+
+    // I submit the batch of the serial if needed, and I wait for its completion
+    // at most the given number of nanoseconds. VK_TIMEOUT is returned if the
+    // batch is not completed in time.
+    VkResult waitFor(uint64_t serial, uint64_t timeout);
+
+    AVkDevice &device;
+
+private:
+    bool ensureRecordingBatch();
+    bool submitRecordingBatch();
+    void retireCompletedBatches();
+    void recycleBatch(std::unique_ptr<AVkTransferBatch> &&batch);
+
+    bool createBatch(std::unique_ptr<AVkTransferBatch> &result);
+    void destroyBatch(AVkTransferBatch &batch);
+
+    bool acquireChunk(size_t minimumSize, AVkStagingChunk &chunk);
+    void releaseChunk(const AVkStagingChunk &chunk);
+    void destroyChunk(const AVkStagingChunk &chunk);
+
+    // I return a null pointer in isBatchFull, when the recording batch cannot
+    // grow anymore and it has to be submitted.
+    uint8_t *allocateStaging(size_t minimumSize, size_t requestedSize, size_t alignment, size_t &allocatedSize, VkBuffer &stagingBuffer, size_t &stagingOffset, bool &isBatchFull);
+
+    void recordImageTransition(const AVkImageUploadRequest &request, const VkImageSubresourceRange &range, agpu_texture_usage_mode_mask sourceUsage, agpu_texture_usage_mode_mask destUsage);
+    bool recordImageCopies(const AVkImageUploadRequest &request, const VkImageSubresourceRange &transitionRange);
+
+    std::mutex mutex;
+    std::condition_variable completionCondition;
+    bool isWaitingForFence;
+
+    agpu::command_queue_ref commandQueue;
+    uint32_t queueFamilyIndex;
+
+    uint64_t nextSerial;
+    uint64_t completedSerial;
+    std::unique_ptr<AVkTransferBatch> recordingBatch;
+    std::deque<std::unique_ptr<AVkTransferBatch>> submittedBatches;
+    std::vector<std::unique_ptr<AVkTransferBatch>> freeBatches;
+    std::vector<AVkStagingChunk> freeChunks;
+};
+
+} // End of namespace AgpuVulkan
+
+#endif //AGPU_VULKAN_ASYNC_TRANSFER_ENGINE_HPP
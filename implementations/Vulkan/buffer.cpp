@@ -1,4 +1,5 @@
 #include "buffer.hpp"
+#include "fence.hpp"
 
 namespace AgpuVulkan
 {
@@ -91,12 +92,19 @@ agpu::buffer_ref AVkBuffer::create(const agpu::device_ref &device, agpu_buffer_d
     // Upload the buffer initial data.
     if(initial_data)
     {
-        // We need the at least temporarily the AGPU_MAP_DYNAMIC_STORAGE_BIT mapping here.
-        avkBuffer->description.mapping_flags |= AGPU_MAP_DYNAMIC_STORAGE_BIT;
-        result->uploadBufferData(0, description.size, initial_data);
-
-        if((description.mapping_flags & AGPU_MAP_DYNAMIC_STORAGE_BIT) == 0)
-            avkBuffer->description.mapping_flags &= ~AGPU_MAP_DYNAMIC_STORAGE_BIT;
+        if(description.mapping_flags & AGPU_MAP_WRITE_BIT)
+        {
+            result->uploadBufferData(0, description.size, initial_data);
+        }
+        else
+        {
+            // Stream the initial data through the graphics queue without
+            // waiting for it. The commands that use this buffer are submitted
+            // later into the same queue, which flushes the pending uploads.
+            uint64_t serial = 0;
+            if(!deviceForVk->getImageTransferEngine().uploadBufferData(bufferHandle, 0, description.size, initial_data, result, serial))
+                return agpu::buffer_ref();
+        }
     }
 
     return result;
@@ -166,14 +174,14 @@ agpu_error AVkBuffer::getDescription(agpu_buffer_description* description)
     return AGPU_OK;
 }
 
-agpu_error AVkBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu_error AVkBuffer::uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     bool canBeSubUpdated = (description.mapping_flags & (AGPU_MAP_DYNAMIC_STORAGE_BIT | AGPU_MAP_WRITE_BIT)) != 0;
     if (!canBeSubUpdated)
         return AGPU_UNSUPPORTED;
 
     // Check the limits
-    if (offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_ERROR;
 
     // Do we have data to upload?
@@ -206,33 +214,60 @@ agpu_error AVkBuffer::uploadBufferData(agpu_size offset, agpu_size size, agpu_po
     if(!device)
         return AGPU_INVALID_OPERATION;
 
-    bool uploadResult = false;
-    deviceForVk->withUploadCommandListDo(size, 1, [&](AVkImplicitResourceUploadCommandList &uploadList) {
-        // Do we need to stream the buffer upload?.
-        if(size <= uploadList.currentStagingBufferSize)
+    // Stream the data through the staging memory, and wait only for its batch.
+    auto &transferEngine = deviceForVk->getBufferTransferEngine();
+    uint64_t serial = 0;
+    if(!transferEngine.uploadBufferData(handle, offset, size, data, agpu::buffer_ref(), serial))
+        return AGPU_ERROR;
+
+    return transferEngine.waitFor(serial) ? AGPU_OK : AGPU_ERROR;
+}
+
+agpu::fence_ptr AVkBuffer::uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
+{
+    auto device = weakDevice.lock();
+    if(!device)
+        return nullptr;
+
+    auto &transferEngine = deviceForVk->getBufferTransferEngine();
+    uint64_t serial = 0;
+
+    // The mapped buffers are uploaded immediately.
+    if((description.mapping_flags & AGPU_MAP_WRITE_BIT) || size == 0)
+    {
+        if(uploadBufferData(offset, size, data) != AGPU_OK)
+            return nullptr;
+    }
+    else
+    {
+        if((description.mapping_flags & AGPU_MAP_DYNAMIC_STORAGE_BIT) == 0)
         {
-            memcpy(uploadList.currentStagingBufferPointer, data, size);
-            uploadResult = uploadList.setupCommandBuffer()
-                && uploadList.uploadBufferData(handle, offset, size)
-                && uploadList.submitCommandBuffer();
+            printError("Asynchronous buffer uploads require a buffer with dynamic storage or write mapping.\n");
+            return nullptr;
         }
-        else
+        if(offset > description.size || size > description.size - offset)
         {
-            abort();
+            printError("Asynchronous buffer upload out of the buffer bounds.\n");
+            return nullptr;
         }
-    });
+        if(!data)
+            return nullptr;
+
+        if(!transferEngine.uploadBufferData(handle, offset, size, data, refFromThis<agpu::buffer> (), serial))
+            return nullptr;
+    }
 
-    return uploadResult ? AGPU_OK : AGPU_ERROR;
+    return AVkFence::createForTransfer(device, &transferEngine, serial).disown();
 }
 
-agpu_error AVkBuffer::readBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+agpu_error AVkBuffer::readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 {
     bool canBeSubReaded = (description.mapping_flags & (AGPU_MAP_DYNAMIC_STORAGE_BIT | AGPU_MAP_READ_BIT)) != 0;
     if (!canBeSubReaded)
         return AGPU_UNSUPPORTED;
 
     // Check the limits
-    if (offset + size > description.size)
+    if(offset > description.size || size > description.size - offset)
         return AGPU_ERROR;
 
     // Do we have data to upload?
@@ -47,4 +47,11 @@ agpu_error AVkCommandAllocator::reset()
     return AGPU_OK;
 }
 
+AgpuCommon::ComputeMipmapGenerator &AVkCommandAllocator::getMipmapGenerator()
+{
+    if(!mipmapGenerator)
+        mipmapGenerator.reset(new AgpuCommon::ComputeMipmapGenerator(device));
+    return *mipmapGenerator;
+}
+
 } // End of namespace AgpuVulkan
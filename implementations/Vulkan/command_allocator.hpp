@@ -2,6 +2,8 @@
 #define AGPU_COMMAND_ALLOCATOR_HPP
 
 #include "device.hpp"
+#include "../Common/compute_mipmap_generator.hpp"
+#include <memory>
 
 namespace AgpuVulkan
 {
@@ -16,10 +18,17 @@ public:
 
     virtual agpu_error reset() override;
 
+    AgpuCommon::ComputeMipmapGenerator &getMipmapGenerator();
+
     agpu::device_ref device;
     agpu_command_list_type type;
     agpu_uint queueFamilyIndex;
     VkCommandPool commandPool;
+
+private:
+    // The compute fallback of the mipmap generation is kept here, instead
+    // of in the device, because its pipelines hold a reference to the device.
+    std::unique_ptr<AgpuCommon::ComputeMipmapGenerator> mipmapGenerator;
 };
 
 } // End of namespace AgpuVulkan
@@ -11,6 +11,9 @@
 #include "shader_signature.hpp"
 #include "shader_resource_binding.hpp"
 #include "constants.hpp"
+#include "query_pool.hpp"
+#include "texture_format.hpp"
+#include <algorithm>
 
 namespace AgpuVulkan
 {
@@ -169,6 +172,7 @@ void AVkCommandList::resetState()
     shaderSignature.reset();
     waitSemaphores.clear();
     signalSemaphores.clear();
+    mipmapGenerationResources.clear();
 
     isSecondaryContent = false;
 
@@ -229,7 +233,7 @@ agpu_error AVkCommandList::useIndexBuffer(const agpu::buffer_ref &index_buffer)
     return useIndexBufferAt(index_buffer, 0, index_buffer.as<AVkBuffer> ()->description.stride);
 }
 
-agpu_error AVkCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_size offset, agpu_size index_size)
+agpu_error AVkCommandList::useIndexBufferAt(const agpu::buffer_ref &index_buffer, agpu_device_size offset, agpu_size index_size)
 {
     CHECK_POINTER(index_buffer);
     if ((index_buffer.as<AVkBuffer> ()->description.usage_modes & AGPU_ELEMENT_ARRAY_BUFFER) == 0)
@@ -272,6 +276,7 @@ agpu_error AVkCommandList::useShaderResourcesInSlot(const agpu::shader_resource_
         return AGPU_INVALID_OPERATION;
 
     auto avkBindings = binding.as<AVkShaderResourceBinding> ();
+    avkBindings->commitPendingWrites();
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
             shaderSignature.as<AVkShaderSignature> ()->layout,
             slot, 1, &avkBindings->descriptorSet, 0, nullptr);
@@ -291,6 +296,7 @@ agpu_error AVkCommandList::useComputeShaderResourcesInSlot(const agpu::shader_re
         return AGPU_INVALID_OPERATION;
 
     auto avkBindings = binding.as<AVkShaderResourceBinding> ();
+    avkBindings->commitPendingWrites();
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
             shaderSignature.as<AVkShaderSignature> ()->layout,
             slot, 1, &avkBindings->descriptorSet, 0, nullptr);
@@ -310,7 +316,7 @@ agpu_error AVkCommandList::drawArrays(agpu_uint vertex_count, agpu_uint instance
     return AGPU_OK;
 }
 
-agpu_error AVkCommandList::drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error AVkCommandList::drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     if (!drawIndirectBuffer)
         return AGPU_INVALID_OPERATION;
@@ -325,7 +331,7 @@ agpu_error AVkCommandList::drawElements(agpu_uint index_count, agpu_uint instanc
     return AGPU_OK;
 }
 
-agpu_error AVkCommandList::drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+agpu_error AVkCommandList::drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 {
     if (!drawIndirectBuffer)
         return AGPU_INVALID_OPERATION;
@@ -340,7 +346,7 @@ agpu_error AVkCommandList::dispatchCompute ( agpu_uint group_count_x, agpu_uint
     return AGPU_OK;
 }
 
-agpu_error AVkCommandList::dispatchComputeIndirect ( agpu_size offset )
+agpu_error AVkCommandList::dispatchComputeIndirect ( agpu_device_size offset )
 {
     if (!computeDispatchIndirectBuffer)
         return AGPU_INVALID_OPERATION;
@@ -621,7 +627,7 @@ agpu_error AVkCommandList::memoryBarrier(agpu_pipeline_stage_flags source_stage,
     return AGPU_OK;
 }
 
-agpu_error AVkCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+agpu_error AVkCommandList::bufferMemoryBarrier(const agpu::buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 {
     CHECK_POINTER(buffer);
 
@@ -733,7 +739,7 @@ agpu_error AVkCommandList::popTextureTransitionBarrier()
     return AGPU_OK;
 }
 
-agpu_error AVkCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+agpu_error AVkCommandList::copyBuffer(const agpu::buffer_ref & source_buffer, agpu_device_size source_offset, const agpu::buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 {
     CHECK_POINTER(source_buffer);
     CHECK_POINTER(dest_buffer);
@@ -835,6 +841,170 @@ agpu_error AVkCommandList::copyTexture(const agpu::texture_ref & source_texture,
     return AGPU_OK;
 }
 
+agpu_error AVkCommandList::generateMipmaps(const agpu::texture_ref & texture)
+{
+    CHECK_POINTER(texture);
+
+    // Neither the blits nor the compute dispatches are allowed inside of a
+    // render pass.
+    if(currentFramebuffer)
+        return AGPU_INVALID_OPERATION;
+
+    auto avkTexture = texture.as<AVkTexture> ();
+    auto &description = avkTexture->description;
+    if(description.miplevels <= 1)
+        return AGPU_OK;
+    if(avkTexture->imageAspect != VK_IMAGE_ASPECT_COLOR_BIT || description.sample_count > 1)
+        return AGPU_UNSUPPORTED;
+
+    VkFormatProperties formatProperties = {};
+    vkGetPhysicalDeviceFormatProperties(deviceForVk->physicalDevice, mapTextureFormat(description.format, false), &formatProperties);
+    auto features = formatProperties.optimalTilingFeatures;
+    VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+    auto supportsBlit = (features & blitFeatures) == blitFeatures;
+
+    // The blits of sRGB formats are filtered in linear space.
+    if(supportsBlit && (features & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+        return generateMipmapsWithBlits(avkTexture, VK_FILTER_LINEAR);
+
+    if((features & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) && AgpuCommon::ComputeMipmapGenerator::isTextureSupported(description))
+    {
+        auto &generator = allocator.as<AVkCommandAllocator> ()->getMipmapGenerator();
+        auto oldShaderSignature = shaderSignature;
+        auto error = generator.generate(refFromThis<agpu::command_list> (), texture, mipmapGenerationResources);
+        shaderSignature = oldShaderSignature;
+        return error;
+    }
+
+    // The formats that cannot be filtered, such as the integer ones, are
+    // point sampled.
+    if(supportsBlit)
+        return generateMipmapsWithBlits(avkTexture, VK_FILTER_NEAREST);
+
+    return AGPU_UNSUPPORTED;
+}
+
+agpu_error AVkCommandList::generateMipmapsWithBlits(AVkTexture *texture, VkFilter filter)
+{
+    auto &description = texture->description;
+    auto image = texture->image;
+
+    VkImageSubresourceRange range = {};
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.baseArrayLayer = 0;
+    range.layerCount = description.layers;
+
+    // The first level is only read, and the other ones are written first.
+    range.baseMipLevel = 0;
+    range.levelCount = 1;
+    transitionImageUsageMode(image, description.usage_modes, description.main_usage_mode, AGPU_TEXTURE_USAGE_COPY_SOURCE, range);
+
+    range.baseMipLevel = 1;
+    range.levelCount = description.miplevels - 1;
+    transitionImageUsageMode(image, description.usage_modes, description.main_usage_mode, AGPU_TEXTURE_USAGE_COPY_DESTINATION, range);
+
+    // Every layer of a level is blitted at once.
+    int32_t sourceWidth = description.width;
+    int32_t sourceHeight = description.height;
+    int32_t sourceDepth = description.type == AGPU_TEXTURE_3D ? description.depth : 1;
+    for(uint32_t level = 1; level < description.miplevels; ++level)
+    {
+        auto destWidth = std::max(sourceWidth / 2, 1);
+        auto destHeight = std::max(sourceHeight / 2, 1);
+        auto destDepth = std::max(sourceDepth / 2, 1);
+
+        VkImageBlit blit = {};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = description.layers;
+        blit.srcOffsets[1].x = sourceWidth;
+        blit.srcOffsets[1].y = sourceHeight;
+        blit.srcOffsets[1].z = sourceDepth;
+
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = description.layers;
+        blit.dstOffsets[1].x = destWidth;
+        blit.dstOffsets[1].y = destHeight;
+        blit.dstOffsets[1].z = destDepth;
+
+        vkCmdBlitImage(commandBuffer,
+                image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                1, &blit, filter);
+
+        // The level that was just written is the source of the next one.
+        range.baseMipLevel = level;
+        range.levelCount = 1;
+        transitionImageUsageMode(image, description.usage_modes, AGPU_TEXTURE_USAGE_COPY_DESTINATION, AGPU_TEXTURE_USAGE_COPY_SOURCE, range);
+
+        sourceWidth = destWidth;
+        sourceHeight = destHeight;
+        sourceDepth = destDepth;
+    }
+
+    range.baseMipLevel = 0;
+    range.levelCount = description.miplevels;
+    return transitionImageUsageMode(image, description.usage_modes, AGPU_TEXTURE_USAGE_COPY_SOURCE, description.main_usage_mode, range);
+}
+
+agpu_error AVkCommandList::resetQueryPool(const agpu::query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count)
+{
+    CHECK_POINTER(query_pool);
+
+    // The queries cannot be reset inside of a render pass.
+    if(currentFramebuffer)
+        return AGPU_INVALID_OPERATION;
+
+    auto avkQueryPool = query_pool.as<AVkQueryPool> ();
+    if(first_query > avkQueryPool->description.query_count || query_count > avkQueryPool->description.query_count - first_query)
+        return AGPU_OUT_OF_BOUNDS;
+
+    vkCmdResetQueryPool(commandBuffer, avkQueryPool->handle, first_query, query_count);
+    return AGPU_OK;
+}
+
+agpu_error AVkCommandList::writeTimestamp(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto avkQueryPool = query_pool.as<AVkQueryPool> ();
+    if(avkQueryPool->description.type != AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= avkQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, avkQueryPool->handle, query_index);
+    return AGPU_OK;
+}
+
+agpu_error AVkCommandList::beginQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto avkQueryPool = query_pool.as<AVkQueryPool> ();
+    if(avkQueryPool->description.type == AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= avkQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    vkCmdBeginQuery(commandBuffer, avkQueryPool->handle, query_index, 0);
+    return AGPU_OK;
+}
+
+agpu_error AVkCommandList::endQuery(const agpu::query_pool_ref & query_pool, agpu_uint query_index)
+{
+    CHECK_POINTER(query_pool);
+    auto avkQueryPool = query_pool.as<AVkQueryPool> ();
+    if(avkQueryPool->description.type == AGPU_QUERY_TYPE_TIMESTAMP)
+        return AGPU_INVALID_PARAMETER;
+    if(query_index >= avkQueryPool->description.query_count)
+        return AGPU_OUT_OF_BOUNDS;
+
+    vkCmdEndQuery(commandBuffer, avkQueryPool->handle, query_index);
+    return AGPU_OK;
+}
+
 void AVkCommandList::addWaitSemaphore(VkSemaphore semaphore, VkPipelineStageFlags dstStageMask)
 {
     for(size_t i = 0; i < waitSemaphores.size(); ++i)
@@ -6,13 +6,16 @@ namespace AgpuVulkan
 {
 
 AVkCommandQueue::AVkCommandQueue(const agpu::device_ref &device)
-    : weakDevice(device)
+    : weakDevice(device), timelineSemaphore(VK_NULL_HANDLE), lastSignaledTimelineValue(0)
 {
     queue = nullptr;
 }
 
 AVkCommandQueue::~AVkCommandQueue()
 {
+    // The queues are released by the device, so its handle is kept in the shared context.
+    if(timelineSemaphore)
+        vkDestroySemaphore(sharedContext->device, timelineSemaphore, nullptr);
 }
 
 agpu::command_queue_ref AVkCommandQueue::create(const agpu::device_ref &device, agpu_uint queueFamilyIndex, agpu_uint queueIndex, VkQueue queue, agpu_command_queue_type type)
@@ -23,6 +26,24 @@ agpu::command_queue_ref AVkCommandQueue::create(const agpu::device_ref &device,
     commandQueue->queueIndex = queueIndex;
     commandQueue->queue = queue;
     commandQueue->type = type;
+
+    if(deviceForVk->hasTimelineSemaphoreExtension)
+    {
+        VkSemaphoreTypeCreateInfoKHR typeInfo = {};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeInfo;
+
+        auto error = vkCreateSemaphore(deviceForVk->device, &createInfo, nullptr, &commandQueue->timelineSemaphore);
+        if(error)
+            return agpu::command_queue_ref();
+        commandQueue->sharedContext = deviceForVk->sharedContext;
+    }
+
     return result;
 }
 
@@ -34,6 +55,13 @@ bool AVkCommandQueue::supportsPresentingSurface(VkSurfaceKHR surface)
     return presentSupported != 0;
 }
 
+void AVkCommandQueue::flushPendingTransfers()
+{
+    auto device = weakDevice.lock();
+    if(device)
+        deviceForVk->flushTransfersForCommandQueue(refFromThis<agpu::command_queue> ());
+}
+
 agpu_error AVkCommandQueue::addCommandList(const agpu::command_list_ref &command_list)
 {
     CHECK_POINTER(command_list);
@@ -51,6 +79,9 @@ agpu_error AVkCommandQueue::addCommandList(const agpu::command_list_ref &command
     submitInfo.signalSemaphoreCount = uint32_t(avkCommandList->signalSemaphores.size());
     submitInfo.pSignalSemaphores = avkCommandList->signalSemaphores.data();
 
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
     auto error = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
     CONVERT_VULKAN_ERROR(error);
     return AGPU_OK;
@@ -81,8 +112,19 @@ agpu_error AVkCommandQueue::addCommandListsAndSignalFence(agpu_uint count, agpu:
 
     VkFence fenceHandle = VK_NULL_HANDLE;
     if(fence)
+    {
         fenceHandle = fence.as<AVkFence> ()->fence;
+        if(!fenceHandle)
+            return AGPU_INVALID_PARAMETER;
+
+        auto resetError = fence.as<AVkFence> ()->resetIfSignaled();
+        if(resetError)
+            return resetError;
+    }
 
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
     auto error = vkQueueSubmit(queue, uint32_t(submissionInfo.size()), submissionInfo.data(), fenceHandle);
     CONVERT_VULKAN_ERROR(error);
     return AGPU_OK;
@@ -90,6 +132,9 @@ agpu_error AVkCommandQueue::addCommandListsAndSignalFence(agpu_uint count, agpu:
 
 agpu_error AVkCommandQueue::finishExecution()
 {
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
     auto error = vkQueueWaitIdle(queue);
     CONVERT_VULKAN_ERROR(error);
     return AGPU_OK;
@@ -98,7 +143,13 @@ agpu_error AVkCommandQueue::finishExecution()
 agpu_error AVkCommandQueue::signalFence(const agpu::fence_ref &fence)
 {
     CHECK_POINTER(fence);
+    auto resetError = fence.as<AVkFence> ()->resetIfSignaled();
+    if(resetError)
+        return resetError;
 
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
     auto error = vkQueueSubmit(queue, 0, nullptr, fence.as<AVkFence> ()->fence);
     CONVERT_VULKAN_ERROR(error);
     return AGPU_OK;
@@ -110,4 +161,101 @@ agpu_error AVkCommandQueue::waitFence(const agpu::fence_ref &fence)
     return AGPU_UNSUPPORTED;
 }
 
+agpu_error AVkCommandQueue::signalTimelineValue(agpu_ulong value)
+{
+    if(!timelineSemaphore)
+        return AGPU_UNSUPPORTED;
+
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
+    if(value <= lastSignaledTimelineValue)
+        return AGPU_INVALID_PARAMETER;
+
+    // The signal operation is ordered after all of the previous submissions.
+    uint64_t signalValue = value;
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &timelineSemaphore;
+
+    auto error = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    CONVERT_VULKAN_ERROR(error);
+    lastSignaledTimelineValue = value;
+    return AGPU_OK;
+}
+
+agpu_error AVkCommandQueue::waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value)
+{
+    CHECK_POINTER(source_queue);
+    auto sourceQueue = source_queue.as<AVkCommandQueue> ();
+    if(!timelineSemaphore || !sourceQueue->timelineSemaphore)
+        return AGPU_UNSUPPORTED;
+
+    flushPendingTransfers();
+
+    std::unique_lock<std::mutex> l(submissionMutex);
+
+    // Waiting for a value that is signaled later in the same queue never completes.
+    if(sourceQueue == this && value > lastSignaledTimelineValue)
+        return AGPU_INVALID_OPERATION;
+
+    // The wait operation is ordered before all of the following submissions.
+    uint64_t waitValue = value;
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    timelineInfo.waitSemaphoreValueCount = 1;
+    timelineInfo.pWaitSemaphoreValues = &waitValue;
+
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &sourceQueue->timelineSemaphore;
+    submitInfo.pWaitDstStageMask = &waitStage;
+
+    auto error = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    CONVERT_VULKAN_ERROR(error);
+    return AGPU_OK;
+}
+
+agpu_ulong AVkCommandQueue::getCompletedTimelineValue()
+{
+    if(!timelineSemaphore)
+        return 0;
+
+    auto device = weakDevice.lock();
+    uint64_t value = 0;
+    if(deviceForVk->fpGetSemaphoreCounterValueKHR(deviceForVk->device, timelineSemaphore, &value))
+        return 0;
+    return value;
+}
+
+agpu_error AVkCommandQueue::waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns)
+{
+    if(!timelineSemaphore)
+        return AGPU_UNSUPPORTED;
+
+    uint64_t waitValue = value;
+    VkSemaphoreWaitInfoKHR waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &timelineSemaphore;
+    waitInfo.pValues = &waitValue;
+
+    auto device = weakDevice.lock();
+    auto error = deviceForVk->fpWaitSemaphoresKHR(deviceForVk->device, &waitInfo, timeout_ns);
+    if(error == VK_TIMEOUT)
+        return AGPU_TIMEOUT;
+    CONVERT_VULKAN_ERROR(error);
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuVulkan
@@ -20,13 +20,28 @@ public:
     virtual agpu_error signalFence(const agpu::fence_ref &fence) override;
     virtual agpu_error waitFence(const agpu::fence_ref &fence) override;
 
+    virtual agpu_error signalTimelineValue(agpu_ulong value) override;
+    virtual agpu_error waitTimelineValue(const agpu::command_queue_ref &source_queue, agpu_ulong value) override;
+    virtual agpu_ulong getCompletedTimelineValue() override;
+    virtual agpu_error waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns) override;
+
     bool supportsPresentingSurface(VkSurfaceKHR surface);
+    void flushPendingTransfers();
 
     agpu::device_weakref weakDevice;
     agpu_uint queueFamilyIndex;
     agpu_uint queueIndex;
     VkQueue queue;
     agpu_command_queue_type type;
+
+    // The submissions into a VkQueue must be externally synchronized.
+    std::mutex submissionMutex;
+
+    // The timeline of the queue is a timeline semaphore, that is only
+    // signaled by this queue with monotonically increasing values.
+    AVkDeviceSharedContextPtr sharedContext;
+    VkSemaphore timelineSemaphore;
+    uint64_t lastSignaledTimelineValue;
 };
 
 } // End of namespace AgpuVulkan
@@ -5,6 +5,59 @@
 namespace AgpuVulkan
 {
 
+/**
+ * I keep the transient block that the current thread allocates from, for
+ * each one of the descriptor set pools that it has used.
+ */
+class AVkThreadTransientDescriptorBlocks
+{
+public:
+    struct Entry
+    {
+        const AVkDescriptorSetPool *key;
+        std::weak_ptr<AVkDescriptorSetPool> pool;
+        AVkTransientDescriptorPoolBlock *block;
+    };
+
+    ~AVkThreadTransientDescriptorBlocks()
+    {
+        for(auto &entry : entries)
+        {
+            auto pool = entry.pool.lock();
+            if(pool && entry.block)
+                pool->releaseTransient(entry.block);
+        }
+    }
+
+    AVkTransientDescriptorPoolBlock *&blockFor(AVkDescriptorSetPool *pool)
+    {
+        // The address of a destroyed pool may be reused by a new one, so an
+        // entry only matches while its pool is alive.
+        for(auto &entry : entries)
+        {
+            if(entry.key == pool && !entry.pool.expired())
+                return entry.block;
+        }
+
+        // The entries of the destroyed pools are only pruned on a miss.
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry &entry) {
+            return entry.pool.expired();
+        }), entries.end());
+
+        Entry newEntry;
+        newEntry.key = pool;
+        newEntry.pool = pool->shared_from_this();
+        newEntry.block = nullptr;
+        entries.push_back(newEntry);
+        return entries.back().block;
+    }
+
+private:
+    std::vector<Entry> entries;
+};
+
+static thread_local AVkThreadTransientDescriptorBlocks currentThreadTransientDescriptorBlocks;
+
 void AVkDescriptorSetPoolAllocation::free()
 {
     owner->free(this);
@@ -72,14 +125,36 @@ void AVkDescriptorSetPoolBlock::free(AVkDescriptorSetPoolAllocation *allocation)
         owner->freeBlocks.push_back(shared_from_this());
 }
 
+AVkTransientDescriptorPoolBlock::AVkTransientDescriptorPoolBlock()
+    : referenceCount(0)
+{
+    owner = nullptr;
+    poolHandle = VK_NULL_HANDLE;
+    remainingAllocationCount = 0;
+}
+
+AVkTransientDescriptorPoolBlock::~AVkTransientDescriptorPoolBlock()
+{
+    auto &device = owner->device;
+    if(poolHandle != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(deviceForVk->device, poolHandle, nullptr);
+}
+
 AVkDescriptorSetPool::AVkDescriptorSetPool()
 {
+    descriptorCount = 0;
+    hasCreatedDescriptorUpdateTemplate = false;
+    descriptorUpdateTemplate = VK_NULL_HANDLE;
 }
 
 AVkDescriptorSetPool::~AVkDescriptorSetPool()
 {
     allocationBlocks.clear();
     freeBlocks.clear();
+    freeTransientBlocks.clear();
+    transientBlocks.clear();
+    if(descriptorUpdateTemplate != VK_NULL_HANDLE)
+        deviceForVk->fpDestroyDescriptorUpdateTemplateKHR(deviceForVk->device, descriptorUpdateTemplate, nullptr);
     if(setDescription.descriptorSetLayout != VK_NULL_HANDLE)
         vkDestroyDescriptorSetLayout(deviceForVk->device, setDescription.descriptorSetLayout, nullptr);
 }
@@ -113,6 +188,59 @@ AVkDescriptorSetPoolAllocation *AVkDescriptorSetPool::allocate()
     return freeBlocks.back()->allocate();
 }
 
+void AVkDescriptorSetPool::computeDescriptorLayout()
+{
+    bindingFirstDescriptors.clear();
+    bindingFirstDescriptors.reserve(setDescription.bindings.size());
+    descriptorCount = 0;
+    for(auto &binding : setDescription.bindings)
+    {
+        bindingFirstDescriptors.push_back(descriptorCount);
+        descriptorCount += binding.descriptorCount;
+    }
+}
+
+VkDescriptorUpdateTemplateKHR AVkDescriptorSetPool::getDescriptorUpdateTemplate()
+{
+    std::unique_lock<std::mutex> l(mutex);
+    if(hasCreatedDescriptorUpdateTemplate)
+        return descriptorUpdateTemplate;
+
+    hasCreatedDescriptorUpdateTemplate = true;
+    if(!deviceForVk->hasDescriptorUpdateTemplateExtension || descriptorCount == 0)
+        return VK_NULL_HANDLE;
+
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> entries;
+    entries.reserve(setDescription.bindings.size());
+    for(size_t i = 0; i < setDescription.bindings.size(); ++i)
+    {
+        auto &binding = setDescription.bindings[i];
+        if(binding.descriptorCount == 0)
+            continue;
+
+        VkDescriptorUpdateTemplateEntryKHR entry = {};
+        entry.dstBinding = binding.binding;
+        entry.dstArrayElement = 0;
+        entry.descriptorCount = binding.descriptorCount;
+        entry.descriptorType = binding.descriptorType;
+        entry.offset = bindingFirstDescriptors[i]*sizeof(AVkDescriptorInfo);
+        entry.stride = sizeof(AVkDescriptorInfo);
+        entries.push_back(entry);
+    }
+
+    VkDescriptorUpdateTemplateCreateInfoKHR createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    createInfo.descriptorUpdateEntryCount = uint32_t(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    createInfo.descriptorSetLayout = setDescription.descriptorSetLayout;
+
+    auto error = deviceForVk->fpCreateDescriptorUpdateTemplateKHR(deviceForVk->device, &createInfo, nullptr, &descriptorUpdateTemplate);
+    if(error)
+        descriptorUpdateTemplate = VK_NULL_HANDLE;
+    return descriptorUpdateTemplate;
+}
+
 void AVkDescriptorSetPool::allocationBlockCompleted(AVkDescriptorSetPoolBlockPtr block)
 {
     auto blockPosition = std::find(freeBlocks.begin(), freeBlocks.end(), block);
@@ -126,4 +254,97 @@ void AVkDescriptorSetPool::free(AVkDescriptorSetPoolAllocation *allocation)
     allocation->owner->free(allocation);
 }
 
+VkDescriptorSet AVkDescriptorSetPool::allocateTransient(AVkTransientDescriptorPoolBlock *&block)
+{
+    auto &threadBlock = currentThreadTransientDescriptorBlocks.blockFor(this);
+    for(;;)
+    {
+        if(!threadBlock)
+        {
+            threadBlock = acquireTransientBlock();
+            if(!threadBlock)
+                return VK_NULL_HANDLE;
+        }
+
+        if(threadBlock->remainingAllocationCount > 0)
+        {
+            VkDescriptorSetAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool = threadBlock->poolHandle;
+            allocateInfo.descriptorSetCount = 1;
+            allocateInfo.pSetLayouts = &setDescription.descriptorSetLayout;
+
+            VkDescriptorSet descriptorSet;
+            auto error = vkAllocateDescriptorSets(deviceForVk->device, &allocateInfo, &descriptorSet);
+            if(!error)
+            {
+                --threadBlock->remainingAllocationCount;
+                ++threadBlock->referenceCount;
+                block = threadBlock;
+                return descriptorSet;
+            }
+
+            if(error != VK_ERROR_OUT_OF_POOL_MEMORY && error != VK_ERROR_FRAGMENTED_POOL)
+            {
+                printError("Failed to allocate transient descriptor set.\n");
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        // The block is exhausted. Leave it to its sets, and move to a new one.
+        auto exhaustedBlock = threadBlock;
+        threadBlock = nullptr;
+        releaseTransient(exhaustedBlock);
+    }
+}
+
+void AVkDescriptorSetPool::releaseTransient(AVkTransientDescriptorPoolBlock *block)
+{
+    if(--block->referenceCount == 0)
+        recycleTransientBlock(block);
+}
+
+AVkTransientDescriptorPoolBlock *AVkDescriptorSetPool::acquireTransientBlock()
+{
+    std::unique_lock<std::mutex> l(mutex);
+
+    AVkTransientDescriptorPoolBlock *block = nullptr;
+    if(!freeTransientBlocks.empty())
+    {
+        block = freeTransientBlocks.back();
+        freeTransientBlocks.pop_back();
+    }
+    else
+    {
+        // Without the free descriptor set flag, the pool can be a linear allocator.
+        VkDescriptorPoolCreateInfo poolCreateInfo = {};
+        poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.maxSets = setDescription.maxBindings;
+        poolCreateInfo.poolSizeCount = (uint32_t)elementSizes.size();
+        poolCreateInfo.pPoolSizes = &elementSizes[0];
+
+        VkDescriptorPool poolHandle;
+        auto error = vkCreateDescriptorPool(deviceForVk->device, &poolCreateInfo, nullptr, &poolHandle);
+        if (error)
+            return nullptr;
+
+        std::unique_ptr<AVkTransientDescriptorPoolBlock> newBlock(new AVkTransientDescriptorPoolBlock);
+        newBlock->owner = this;
+        newBlock->poolHandle = poolHandle;
+        block = newBlock.get();
+        transientBlocks.push_back(std::move(newBlock));
+    }
+
+    block->remainingAllocationCount = setDescription.maxBindings;
+    block->referenceCount = 1;
+    return block;
+}
+
+void AVkDescriptorSetPool::recycleTransientBlock(AVkTransientDescriptorPoolBlock *block)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    vkResetDescriptorPool(deviceForVk->device, block->poolHandle, 0);
+    freeTransientBlocks.push_back(block);
+}
+
 } // End of namespace AgpuVulkan
@@ -3,6 +3,7 @@
 
 #include "device.hpp"
 #include "shader_signature_builder.hpp"
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -15,6 +16,16 @@ class AVkDescriptorSetPool;
 typedef std::shared_ptr<AVkDescriptorSetPoolBlock> AVkDescriptorSetPoolBlockPtr;
 typedef std::shared_ptr<AVkDescriptorSetPool> AVkDescriptorSetPoolPtr;
 
+/**
+ * I hold the content of a single descriptor, with the layout that is used
+ * as the source data of the descriptor update templates.
+ */
+union AVkDescriptorInfo
+{
+    VkDescriptorImageInfo image;
+    VkDescriptorBufferInfo buffer;
+};
+
 class AVkDescriptorSetPoolAllocation
 {
 public:
@@ -40,7 +51,27 @@ public:
     std::vector<AVkDescriptorSetPoolAllocation*> freeList;
 };
 
-class AVkDescriptorSetPool
+/**
+ * I am a linear descriptor pool for transient descriptor sets. I am only
+ * allocated from by a single thread at a time, and my sets are never freed
+ * individually. I am reset as a whole when my last set is released, and
+ * after my allocating thread has moved to another block.
+ */
+class AVkTransientDescriptorPoolBlock
+{
+public:
+    AVkTransientDescriptorPoolBlock();
+    ~AVkTransientDescriptorPoolBlock();
+
+    AVkDescriptorSetPool *owner;
+    VkDescriptorPool poolHandle;
+    uint32_t remainingAllocationCount;
+
+    // The live sets, plus one reference for the thread that allocates from me.
+    std::atomic_uint referenceCount;
+};
+
+class AVkDescriptorSetPool : public std::enable_shared_from_this<AVkDescriptorSetPool>
 {
 public:
     AVkDescriptorSetPool();
@@ -53,10 +84,35 @@ public:
     void allocationBlockCompleted(AVkDescriptorSetPoolBlockPtr block);
     void free(AVkDescriptorSetPoolAllocation *allocation);
 
+    // Transient sets come from a block that belongs to the calling thread, so
+    // the mutex is only taken when the thread needs a new block.
+    VkDescriptorSet allocateTransient(AVkTransientDescriptorPoolBlock *&block);
+    void releaseTransient(AVkTransientDescriptorPoolBlock *block);
+
+    // I compute where the descriptors of each binding start in the packed
+    // descriptor array of the sets.
+    void computeDescriptorLayout();
+
+    // I return the template that updates the whole packed descriptor array
+    // of a set, or a null handle when the extension is not available.
+    VkDescriptorUpdateTemplateKHR getDescriptorUpdateTemplate();
+
     ShaderSignatureElementDescription setDescription;
+    std::vector<uint32_t> bindingFirstDescriptors;
+    uint32_t descriptorCount;
+
+    bool hasCreatedDescriptorUpdateTemplate;
+    VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate;
     std::vector<AVkDescriptorSetPoolBlockPtr> allocationBlocks;
     std::vector<AVkDescriptorSetPoolBlockPtr> freeBlocks;
     std::vector<VkDescriptorPoolSize> elementSizes;
+
+    std::vector<std::unique_ptr<AVkTransientDescriptorPoolBlock>> transientBlocks;
+    std::vector<AVkTransientDescriptorPoolBlock*> freeTransientBlocks;
+
+private:
+    AVkTransientDescriptorPoolBlock *acquireTransientBlock();
+    void recycleTransientBlock(AVkTransientDescriptorPoolBlock *block);
 };
 
 } // End of namespace AgpuVulkan
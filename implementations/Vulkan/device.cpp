@@ -2,6 +2,7 @@
 #include "device.hpp"
 #include "command_queue.hpp"
 #include "swap_chain.hpp"
+#include "offscreen_swap_chain.hpp"
 #include "framebuffer.hpp"
 #include "renderpass.hpp"
 #include "texture.hpp"
@@ -17,10 +18,13 @@
 #include "vertex_binding.hpp"
 #include "buffer.hpp"
 #include "fence.hpp"
+#include "query_pool.hpp"
 #include "vr_system.hpp"
 #include "sampler.hpp"
+#include "../Common/fence_wait.hpp"
 #include "../Common/offline_shader_compiler.hpp"
 #include "../Common/state_tracker_cache.hpp"
+#include "../Common/buffer_pool.hpp"
 #include "../Common/window_scraper.hpp"
 
 #define GET_INSTANCE_PROC_ADDR(procName) \
@@ -190,7 +194,11 @@ AVkDeviceSharedContext::~AVkDeviceSharedContext()
 
     // Destroy the vulkan devices
     if (defaultPipelineCache)
+    {
+        if(pipelineCacheStore)
+            pipelineCacheStore->save(defaultPipelineCache);
         vkDestroyPipelineCache(device, defaultPipelineCache, nullptr);
+    }
 
     if(device)
         vkDestroyDevice(device, nullptr);
@@ -202,8 +210,8 @@ AVkDeviceSharedContext::~AVkDeviceSharedContext()
 AVkDevice::AVkDevice()
     :
     implicitResourceSetupCommandList(*this),
-    implicitResourceUploadCommandList(*this),
-    implicitResourceReadbackCommandList(*this)
+    implicitResourceReadbackCommandList(*this),
+    graphicsTransferEngine(*this)
 {
     vulkanInstance = VK_NULL_HANDLE;
     physicalDevice = VK_NULL_HANDLE;
@@ -212,13 +220,27 @@ AVkDevice::AVkDevice()
 
     isVRDisplaySupported = false;
     isVRInputDevicesSupported = false;
+
+    graphicsQueueFamilyIndex = 0;
+
+    hasDescriptorUpdateTemplateExtension = false;
+    fpCreateDescriptorUpdateTemplateKHR = nullptr;
+    fpDestroyDescriptorUpdateTemplateKHR = nullptr;
+    fpUpdateDescriptorSetWithTemplateKHR = nullptr;
+
+    hasPhysicalDeviceProperties2Extension = false;
+    hasTimelineSemaphoreExtension = false;
+    fpGetSemaphoreCounterValueKHR = nullptr;
+    fpWaitSemaphoresKHR = nullptr;
 }
 
 AVkDevice::~AVkDevice()
 {
+	// Destroy the transfer engines.
+	graphicsTransferEngine.destroy();
+
 	// Destroy the implicit command list.
 	implicitResourceSetupCommandList.destroy();
-	implicitResourceUploadCommandList.destroy();
 	implicitResourceReadbackCommandList.destroy();
 }
 
@@ -482,6 +504,12 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
         instanceExtensions.push_back("VK_EXT_debug_report");
     }
 
+    // Required by the optional device extensions that extend the device features.
+    hasPhysicalDeviceProperties2Extension = hasExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, instanceExtensionProperties);
+    if(hasPhysicalDeviceProperties2Extension &&
+        std::find(requiredInstanceExtensions.begin(), requiredInstanceExtensions.end(), VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == requiredInstanceExtensions.end())
+        instanceExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+
     // Set the enabled layers and extensions.
     if (!instanceLayers.empty())
     {
@@ -600,6 +628,17 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
     for(auto &extension: requiredDeviceExtensions)
         deviceExtensions.push_back(extension.c_str());
 
+    // Enable the optional device extensions.
+    hasDescriptorUpdateTemplateExtension = hasExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, deviceExtensionProperties);
+    if(hasDescriptorUpdateTemplateExtension &&
+        std::find(requiredDeviceExtensions.begin(), requiredDeviceExtensions.end(), VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == requiredDeviceExtensions.end())
+        deviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+
+    // The timeline semaphore feature is mandatory when its extension is exposed.
+    hasTimelineSemaphoreExtension = hasPhysicalDeviceProperties2Extension && hasExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, deviceExtensionProperties);
+    if(hasTimelineSemaphoreExtension)
+        deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+
     uint32_t queueFamilyCount;
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
     if (queueFamilyCount == 0)
@@ -647,6 +686,12 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
     deviceCreateInfo.pQueueCreateInfos = &createQueueInfos[0];
     deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
 
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures = {};
+    timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+    if(hasTimelineSemaphoreExtension)
+        deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+
     if (openInfo->debug_layer && hasValidationLayers(deviceLayerProperties))
     {
         for (size_t i = 0; i < validationLayerCount; ++i)
@@ -671,9 +716,26 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
     sharedContext->device = device;
     // Create the default pipeline cache.
     {
+        std::vector<uint8_t> initialData;
+        auto pipelineCacheDirectory = AVkPipelineCacheStore::getDirectoryFor(openInfo);
+        if(!pipelineCacheDirectory.empty())
+        {
+            sharedContext->pipelineCacheStore.reset(new AVkPipelineCacheStore(device, deviceProperties, pipelineCacheDirectory));
+            sharedContext->pipelineCacheStore->load(initialData);
+        }
+
         VkPipelineCacheCreateInfo createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
         error = vkCreatePipelineCache(device, &createInfo, nullptr, &defaultPipelineCache);
+        if (error && !initialData.empty())
+        {
+            // The driver rejected the stored blob. Start with an empty cache.
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            error = vkCreatePipelineCache(device, &createInfo, nullptr, &defaultPipelineCache);
+        }
         if (error)
             return false;
         sharedContext->defaultPipelineCache = defaultPipelineCache;
@@ -685,6 +747,21 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
     GET_DEVICE_PROC_ADDR(AcquireNextImageKHR);
     GET_DEVICE_PROC_ADDR(QueuePresentKHR);
 
+    if(hasDescriptorUpdateTemplateExtension)
+    {
+        fpCreateDescriptorUpdateTemplateKHR = (PFN_vkCreateDescriptorUpdateTemplateKHR)fpGetDeviceProcAddr(device, "vkCreateDescriptorUpdateTemplateKHR");
+        fpDestroyDescriptorUpdateTemplateKHR = (PFN_vkDestroyDescriptorUpdateTemplateKHR)fpGetDeviceProcAddr(device, "vkDestroyDescriptorUpdateTemplateKHR");
+        fpUpdateDescriptorSetWithTemplateKHR = (PFN_vkUpdateDescriptorSetWithTemplateKHR)fpGetDeviceProcAddr(device, "vkUpdateDescriptorSetWithTemplateKHR");
+        hasDescriptorUpdateTemplateExtension = fpCreateDescriptorUpdateTemplateKHR && fpDestroyDescriptorUpdateTemplateKHR && fpUpdateDescriptorSetWithTemplateKHR;
+    }
+
+    if(hasTimelineSemaphoreExtension)
+    {
+        fpGetSemaphoreCounterValueKHR = (PFN_vkGetSemaphoreCounterValueKHR)fpGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR");
+        fpWaitSemaphoresKHR = (PFN_vkWaitSemaphoresKHR)fpGetDeviceProcAddr(device, "vkWaitSemaphoresKHR");
+        hasTimelineSemaphoreExtension = fpGetSemaphoreCounterValueKHR && fpWaitSemaphoresKHR;
+    }
+
     // Get the queues.
     for (uint32_t i = 0; i < queueFamilyCount; ++i)
     {
@@ -738,9 +815,12 @@ bool AVkDevice::initialize(agpu_device_open_info* openInfo)
 
     // Store a copy to in the implicit resource command lists.
     implicitResourceSetupCommandList.commandQueue = graphicsCommandQueues[0];
-    implicitResourceUploadCommandList.commandQueue = graphicsCommandQueues[0];
     implicitResourceReadbackCommandList.commandQueue = graphicsCommandQueues[0];
 
+    // Initialize the asynchronous transfer engine.
+    graphicsQueueFamilyIndex = graphicsCommandQueues[0].as<AVkCommandQueue> ()->queueFamilyIndex;
+    graphicsTransferEngine.initialize(graphicsCommandQueues[0]);
+
     // Create the VR system.
     if(vrSystem)
     {
@@ -770,6 +850,7 @@ agpu_bool AVkDevice::isFeatureSupported(agpu_feature feature)
 	{
     case AGPU_FEATURE_VRDISPLAY: return isVRDisplaySupported;
     case AGPU_FEATURE_VRINPUT_DEVICES: return isVRInputDevicesSupported;
+    case AGPU_FEATURE_COMMAND_QUEUE_TIMELINE: return hasTimelineSemaphoreExtension;
 	default: return isFeatureSupportedOnGPU(feature, deviceProperties, memoryProperties, deviceFeatures);
 	}
 }
@@ -789,6 +870,29 @@ agpu::command_queue_ptr AVkDevice::getDefaultCommandQueue()
     return getGraphicsCommandQueue(0);
 }
 
+agpu::command_queue_ptr AVkDevice::getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index)
+{
+    // The graphics queues can also execute compute and transfer work, so
+    // they are used when the device has no dedicated queue family for them.
+    switch(queue_type)
+    {
+    case AGPU_COMMAND_QUEUE_TYPE_GRAPHICS:
+        return getGraphicsCommandQueue(index);
+    case AGPU_COMMAND_QUEUE_TYPE_COMPUTE:
+        if(computeCommandQueues.empty())
+            return getGraphicsCommandQueue(index);
+        return getComputeCommandQueue(index);
+    case AGPU_COMMAND_QUEUE_TYPE_TRANSFER:
+        if(!transferCommandQueues.empty())
+            return getTransferCommandQueue(index);
+        if(!computeCommandQueues.empty())
+            return getComputeCommandQueue(index);
+        return getGraphicsCommandQueue(index);
+    default:
+        return nullptr;
+    }
+}
+
 agpu::command_queue_ptr AVkDevice::getGraphicsCommandQueue(agpu_uint index)
 {
     if (index >= graphicsCommandQueues.size())
@@ -815,6 +919,8 @@ agpu::command_queue_ptr AVkDevice::getTransferCommandQueue(agpu_uint index)
 
 agpu::swap_chain_ptr AVkDevice::createSwapChain(const agpu::command_queue_ref &commandQueue, agpu_swap_chain_create_info* swapChainInfo)
 {
+    if(swapChainInfo && (swapChainInfo->flags & AGPU_SWAP_CHAIN_FLAG_HEADLESS) != 0)
+        return AVkOffscreenSwapChain::create(refFromThis<agpu::device> (), commandQueue, swapChainInfo).disown();
     return AVkSwapChain::create(refFromThis<agpu::device> (), commandQueue, swapChainInfo).disown();
 }
 
@@ -903,6 +1009,36 @@ agpu::fence_ptr AVkDevice::createFence()
     return AVkFence::create(refFromThis<agpu::device> ()).disown();
 }
 
+agpu_error AVkDevice::waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+{
+    if(count == 0)
+        return AGPU_OK;
+    CHECK_POINTER(fences);
+
+    // The fences of the transfer engines are not backed by a single VkFence.
+    std::vector<VkFence> fenceHandles;
+    fenceHandles.reserve(count);
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        CHECK_POINTER(fences[i]);
+        auto avkFence = fences[i].as<AVkFence> ();
+        if(avkFence->transferEngine)
+            return AgpuCommon::waitForFencesByPolling(count, fences, wait_all, timeout_ns);
+        fenceHandles.push_back(avkFence->fence);
+    }
+
+    auto error = vkWaitForFences(device, count, fenceHandles.data(), wait_all ? VK_TRUE : VK_FALSE, timeout_ns);
+    if(error == VK_TIMEOUT)
+        return AGPU_TIMEOUT;
+    CONVERT_VULKAN_ERROR(error);
+    return AGPU_OK;
+}
+
+agpu::query_pool_ptr AVkDevice::createQueryPool(agpu_query_pool_description* description)
+{
+    return AVkQueryPool::create(refFromThis<agpu::device> (), description).disown();
+}
+
 AGPU_EXPORT agpu_bool agpuHasBottomLeftTextureCoordinates(agpu_device *device)
 {
     return false;
@@ -938,9 +1074,30 @@ agpu::state_tracker_cache_ptr AVkDevice::createStateTrackerCache(const agpu::com
 	return AgpuCommon::StateTrackerCache::create(refFromThis<agpu::device> (), 0).disown();
 }
 
+agpu::buffer_pool_ptr AVkDevice::createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment)
+{
+	return AgpuCommon::BufferPool::create(refFromThis<agpu::device> (), block_description, alignment).disown();
+}
+
 agpu_error AVkDevice::finishExecution()
 {
+    graphicsTransferEngine.flush();
+
     vkDeviceWaitIdle(device);
     return AGPU_OK;
 }
+
+agpu_error AVkDevice::flushPipelineCache()
+{
+    if(!sharedContext->pipelineCacheStore)
+        return AGPU_OK;
+
+    return sharedContext->pipelineCacheStore->save(defaultPipelineCache);
+}
+
+void AVkDevice::flushTransfersForCommandQueue(const agpu::command_queue_ref &queue)
+{
+    if(graphicsTransferEngine.usesCommandQueue(queue))
+        graphicsTransferEngine.flush();
+}
 } // End of namespace AgpuVulkan
@@ -2,6 +2,8 @@
 #define AGPU_VULKAN_DEVICE_HPP
 
 #include "implicit_resource_command_list.hpp"
+#include "async_transfer_engine.hpp"
+#include "pipeline_cache.hpp"
 #include <string.h>
 #include <memory>
 #include <mutex>
@@ -28,6 +30,7 @@ public:
     VkDevice device;
     VmaAllocator memoryAllocator;
     VkPipelineCache defaultPipelineCache;
+    std::unique_ptr<AVkPipelineCacheStore> pipelineCacheStore;
     vr::IVRSystem *vrSystem;
 };
 
@@ -51,6 +54,7 @@ public:
     bool initialize(agpu_device_open_info* openInfo);
 
     virtual agpu::command_queue_ptr getDefaultCommandQueue() override;
+    virtual agpu::command_queue_ptr getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index) override;
     virtual agpu::command_queue_ptr getGraphicsCommandQueue(agpu_uint index);
     virtual agpu::command_queue_ptr getComputeCommandQueue(agpu_uint index);
     virtual agpu::command_queue_ptr getTransferCommandQueue(agpu_uint index);
@@ -73,6 +77,8 @@ public:
 	virtual agpu::texture_ptr createTexture(agpu_texture_description* description) override;
 	virtual agpu::sampler_ptr createSampler(agpu_sampler_description* description) override;
 	virtual agpu::fence_ptr createFence() override;
+    virtual agpu_error waitForFences(agpu_uint count, agpu::fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns) override;
+	virtual agpu::query_pool_ptr createQueryPool(agpu_query_pool_description* description) override;
 	virtual agpu_int getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count) override;
 	virtual agpu_bool hasTopLeftNdcOrigin() override;
 	virtual agpu_bool hasBottomLeftTextureCoordinates() override;
@@ -84,8 +90,10 @@ public:
 	virtual agpu::window_scraper_ptr createWindowScraper() override;
     virtual agpu::offline_shader_compiler_ptr createOfflineShaderCompiler() override;
     virtual agpu::state_tracker_cache_ptr createStateTrackerCache(const agpu::command_queue_ref & command_queue_family) override;
+    virtual agpu::buffer_pool_ptr createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment) override;
 
     virtual agpu_error finishExecution() override;
+    virtual agpu_error flushPipelineCache() override;
 
 public:
     std::vector<VkPhysicalDevice> physicalDevices;
@@ -121,6 +129,17 @@ public:
     DECLARE_VK_EXTENSION_FP(AcquireNextImageKHR);
     DECLARE_VK_EXTENSION_FP(QueuePresentKHR);
 
+    // Optional extension pointers.
+    bool hasPhysicalDeviceProperties2Extension;
+    bool hasDescriptorUpdateTemplateExtension;
+    DECLARE_VK_EXTENSION_FP(CreateDescriptorUpdateTemplateKHR);
+    DECLARE_VK_EXTENSION_FP(DestroyDescriptorUpdateTemplateKHR);
+    DECLARE_VK_EXTENSION_FP(UpdateDescriptorSetWithTemplateKHR);
+
+    bool hasTimelineSemaphoreExtension;
+    DECLARE_VK_EXTENSION_FP(GetSemaphoreCounterValueKHR);
+    DECLARE_VK_EXTENSION_FP(WaitSemaphoresKHR);
+
     // VR support
     bool isVRDisplaySupported;
     bool isVRInputDevicesSupported;
@@ -144,15 +163,6 @@ public:
         f(implicitResourceSetupCommandList);
     }
 
-    template<typename FT>
-    void withUploadCommandListDo(size_t requiredCpuBufferSize, size_t requiredCpuBufferAlignment, const FT &f)
-    {
-        std::unique_lock<std::mutex> l(implicitResourceUploadCommandList.mutex);
-        implicitResourceUploadCommandList.ensureValidCPUStagingBuffer(requiredCpuBufferSize, requiredCpuBufferAlignment);
-
-        f(implicitResourceUploadCommandList);
-    }
-
     template<typename FT>
     void withReadbackCommandListDo(size_t requiredCpuBufferSize, size_t requiredCpuBufferAlignment, const FT &f)
     {
@@ -162,6 +172,24 @@ public:
         f(implicitResourceReadbackCommandList);
     }
 
+    // Buffers and images are uploaded through the graphics queue, so that
+    // the submission order of that queue orders the uploads before the
+    // commands that use them.
+    AVkAsyncTransferEngine &getBufferTransferEngine()
+    {
+        return graphicsTransferEngine;
+    }
+
+    AVkAsyncTransferEngine &getImageTransferEngine()
+    {
+        return graphicsTransferEngine;
+    }
+
+    // I submit the pending uploads that are ordered before the commands of the queue.
+    void flushTransfersForCommandQueue(const agpu::command_queue_ref &queue);
+
+    uint32_t graphicsQueueFamilyIndex;
+
 private:
     bool checkDebugReportExtension();
 
@@ -169,8 +197,9 @@ private:
     bool submitSetupCommandBuffer();*/
 
     AVkImplicitResourceSetupCommandList implicitResourceSetupCommandList;
-    AVkImplicitResourceUploadCommandList implicitResourceUploadCommandList;
     AVkImplicitResourceReadbackCommandList implicitResourceReadbackCommandList;
+
+    AVkAsyncTransferEngine graphicsTransferEngine;
 };
 
 inline VmaMemoryUsage mapHeapType(agpu_memory_heap_type type)
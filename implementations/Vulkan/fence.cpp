@@ -4,13 +4,14 @@ namespace AgpuVulkan
 {
 
 AVkFence::AVkFence(const agpu::device_ref &device)
-    : device(device)
+    : device(device), fence(VK_NULL_HANDLE), transferEngine(nullptr), transferSerial(0)
 {
 }
 
 AVkFence::~AVkFence()
 {
-    vkDestroyFence(deviceForVk->device, fence, nullptr);
+    if(fence)
+        vkDestroyFence(deviceForVk->device, fence, nullptr);
 }
 
 agpu::fence_ref AVkFence::create(const agpu::device_ref &device)
@@ -24,14 +25,27 @@ agpu::fence_ref AVkFence::create(const agpu::device_ref &device)
     if (error)
         return agpu::fence_ref();
 
-    auto result = agpu::makeObject<AVkFence> (device);
+    auto result = agpu::makePooledObject<AVkFence> (device);
     auto avkFence = result.as<AVkFence> ();
     avkFence->fence = fence;
     return result;
 }
 
+agpu::fence_ref AVkFence::createForTransfer(const agpu::device_ref &device, AVkAsyncTransferEngine *transferEngine, uint64_t transferSerial)
+{
+    auto result = agpu::makePooledObject<AVkFence> (device);
+    auto avkFence = result.as<AVkFence> ();
+    avkFence->transferEngine = transferEngine;
+    avkFence->transferSerial = transferSerial;
+    return result;
+}
+
 agpu_error AVkFence::waitOnClient()
 {
+    // Transfer fences are never reset, and waiting for them submits their batch.
+    if(transferEngine)
+        return transferEngine->waitFor(transferSerial) ? AGPU_OK : AGPU_ERROR;
+
     auto result = vkGetFenceStatus(deviceForVk->device, fence);
     if (result == VK_SUCCESS)
     {
@@ -55,4 +69,42 @@ agpu_error AVkFence::waitOnClient()
 
 }
 
+agpu_bool AVkFence::isSignaled()
+{
+    // Polling a transfer fence submits its batch, so that it eventually completes.
+    if(transferEngine)
+        return transferEngine->waitFor(transferSerial, 0) == VK_SUCCESS;
+
+    return vkGetFenceStatus(deviceForVk->device, fence) == VK_SUCCESS;
+}
+
+agpu_error AVkFence::waitWithTimeout(agpu_ulong timeout_ns)
+{
+    VkResult result;
+    if(transferEngine)
+        result = transferEngine->waitFor(transferSerial, timeout_ns);
+    else
+        result = vkWaitForFences(deviceForVk->device, 1, &fence, VK_TRUE, timeout_ns);
+
+    if(result == VK_TIMEOUT)
+        return AGPU_TIMEOUT;
+    CONVERT_VULKAN_ERROR(result);
+    return AGPU_OK;
+}
+
+agpu_error AVkFence::resetIfSignaled()
+{
+    if(!fence)
+        return AGPU_INVALID_PARAMETER;
+
+    auto result = vkGetFenceStatus(deviceForVk->device, fence);
+    if(result == VK_NOT_READY)
+        return AGPU_OK;
+    CONVERT_VULKAN_ERROR(result);
+
+    auto error = vkResetFences(deviceForVk->device, 1, &fence);
+    CONVERT_VULKAN_ERROR(error);
+    return AGPU_OK;
+}
+
 } // End of namespace AgpuVulkan
@@ -14,10 +14,22 @@ public:
 
     static agpu::fence_ref create(const agpu::device_ref &device);
 
+    // I create a fence that is signaled by a batch of an asynchronous transfer engine.
+    static agpu::fence_ref createForTransfer(const agpu::device_ref &device, AVkAsyncTransferEngine *transferEngine, uint64_t transferSerial);
+
     virtual agpu_error waitOnClient() override;
+    virtual agpu_bool isSignaled() override;
+    virtual agpu_error waitWithTimeout(agpu_ulong timeout_ns) override;
+
+    // I am called before submitting a signal of the fence. Polling and timed
+    // waits do not reset the fence, so it may still be in the signaled state.
+    agpu_error resetIfSignaled();
 
     agpu::device_ref device;
     VkFence fence;
+
+    AVkAsyncTransferEngine *transferEngine;
+    uint64_t transferSerial;
 };
 
 } // End of namespace AgpuVulkan
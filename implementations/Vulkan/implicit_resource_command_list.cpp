@@ -193,11 +193,16 @@ bool AVkImplicitResourceSetupCommandList::submitCommandBuffer()
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
 
-    error = vkQueueSubmit(commandQueue.as<AVkCommandQueue> ()->queue, 1, &submitInfo, VK_NULL_HANDLE);
+    // Keep the order with the pending asynchronous uploads.
+    device.flushTransfersForCommandQueue(commandQueue);
+
+    auto avkQueue = commandQueue.as<AVkCommandQueue> ();
+    std::unique_lock<std::mutex> l(avkQueue->submissionMutex);
+    error = vkQueueSubmit(avkQueue->queue, 1, &submitInfo, VK_NULL_HANDLE);
     if (error)
         abort();
 
-    error = vkQueueWaitIdle(commandQueue.as<AVkCommandQueue> ()->queue);
+    error = vkQueueWaitIdle(avkQueue->queue);
     if (error)
         abort();
 
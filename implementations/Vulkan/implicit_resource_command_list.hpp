@@ -151,7 +151,6 @@ protected:
     VmaAllocation allocationHandle;
 };
 
-typedef AVkImplicitResourceStagingCommandList<AGPU_MEMORY_HEAP_TYPE_HOST_TO_DEVICE, 2048*2048*4> AVkImplicitResourceUploadCommandList;
 typedef AVkImplicitResourceStagingCommandList<AGPU_MEMORY_HEAP_TYPE_DEVICE_TO_HOST, 2048*2048*4> AVkImplicitResourceReadbackCommandList;
 
 } // End of namespace AgpuVulkan
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include "offscreen_swap_chain.hpp"
+#include "buffer.hpp"
+#include "command_list.hpp"
+#include "fence.hpp"
+#include "framebuffer.hpp"
+#include "texture.hpp"
+#include "texture_format.hpp"
+
+namespace AgpuVulkan
+{
+
+AVkOffscreenSwapChain::AVkOffscreenSwapChain(const agpu::device_ref &device)
+    : device(device), width(0), height(0), format(AGPU_TEXTURE_FORMAT_UNKNOWN), readbackPitch(0),
+      currentBackBufferIndex(0), pendingFrameCount(0)
+{
+}
+
+AVkOffscreenSwapChain::~AVkOffscreenSwapChain()
+{
+    // The readback copies may still be in flight.
+    for(auto &image : images)
+    {
+        if(image.readbackBuffer && image.readbackPointer)
+            image.readbackBuffer->unmapBuffer();
+    }
+
+    if(graphicsQueue)
+        graphicsQueue->finishExecution();
+}
+
+agpu::swap_chain_ref AVkOffscreenSwapChain::create(const agpu::device_ref &device, const agpu::command_queue_ref &graphicsCommandQueue, agpu_swap_chain_create_info *createInfo)
+{
+    if (!graphicsCommandQueue || !createInfo || !createInfo->width || !createInfo->height)
+        return agpu::swap_chain_ref();
+
+    auto format = createInfo->colorbuffer_format;
+    if(format == AGPU_TEXTURE_FORMAT_UNKNOWN)
+        format = AGPU_TEXTURE_FORMAT_B8G8R8A8_UNORM;
+
+    auto pixelSize = pixelSizeOfTextureFormat(format);
+    if(!pixelSize || isCompressedTextureFormat(format))
+    {
+        printError("Unsupported offscreen swap chain color buffer format.\n");
+        return agpu::swap_chain_ref();
+    }
+
+    auto result = agpu::makeObject<AVkOffscreenSwapChain> (device);
+    auto swapChain = result.as<AVkOffscreenSwapChain> ();
+    swapChain->graphicsQueue = graphicsCommandQueue;
+    swapChain->width = createInfo->width;
+    swapChain->height = createInfo->height;
+    swapChain->format = format;
+    swapChain->readbackPitch = pixelSize * createInfo->width;
+
+    createInfo->colorbuffer_format = format;
+    createInfo->layers = 1;
+    createInfo->buffer_count = std::max(2u, createInfo->buffer_count);
+
+    // Color buffers descriptions
+    agpu_texture_description colorDesc = {};
+    colorDesc.type = AGPU_TEXTURE_2D;
+    colorDesc.width = createInfo->width;
+    colorDesc.height = createInfo->height;
+    colorDesc.depth = 1;
+    colorDesc.layers = 1;
+    colorDesc.format = format;
+    colorDesc.usage_modes = agpu_texture_usage_mode_mask(AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT | AGPU_TEXTURE_USAGE_COPY_SOURCE);
+    colorDesc.main_usage_mode = AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT;
+    colorDesc.heap_type = AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL;
+    colorDesc.miplevels = 1;
+    colorDesc.sample_count = 1;
+
+    // Since the depth stencil buffer is used exclusively on the GPU, it is
+    // shared by all of the images.
+    agpu::texture_view_ref depthStencilView;
+    bool hasDepth = hasDepthComponent(createInfo->depth_stencil_format);
+    bool hasStencil = hasStencilComponent(createInfo->depth_stencil_format);
+    if(hasDepth || hasStencil)
+    {
+        agpu_texture_description depthStencilDesc = {};
+        depthStencilDesc.type = AGPU_TEXTURE_2D;
+        depthStencilDesc.width = createInfo->width;
+        depthStencilDesc.height = createInfo->height;
+        depthStencilDesc.depth = 1;
+        depthStencilDesc.layers = 1;
+        depthStencilDesc.format = createInfo->depth_stencil_format;
+        depthStencilDesc.heap_type = AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL;
+        depthStencilDesc.miplevels = 1;
+        depthStencilDesc.sample_count = 1;
+        depthStencilDesc.clear_value.depth_stencil.depth = 1.0f;
+        depthStencilDesc.clear_value.depth_stencil.stencil = 0;
+        if (hasDepth)
+            depthStencilDesc.usage_modes = agpu_texture_usage_mode_mask(depthStencilDesc.usage_modes | AGPU_TEXTURE_USAGE_DEPTH_ATTACHMENT);
+        if (hasStencil)
+            depthStencilDesc.usage_modes = agpu_texture_usage_mode_mask(depthStencilDesc.usage_modes | AGPU_TEXTURE_USAGE_STENCIL_ATTACHMENT);
+        depthStencilDesc.main_usage_mode = depthStencilDesc.usage_modes;
+
+        auto depthStencilBuffer = AVkTexture::create(device, &depthStencilDesc);
+        if (!depthStencilBuffer)
+            return agpu::swap_chain_ref();
+
+        depthStencilView = agpu::texture_view_ref(depthStencilBuffer->getOrCreateFullView());
+    }
+
+    swapChain->images.resize(createInfo->buffer_count);
+    for(auto &image : swapChain->images)
+    {
+        if(!swapChain->initializeImage(image, colorDesc, depthStencilView))
+            return agpu::swap_chain_ref();
+    }
+
+    return result;
+}
+
+bool AVkOffscreenSwapChain::initializeImage(AVkOffscreenSwapChainImage &image, agpu_texture_description &colorDesc, const agpu::texture_view_ref &depthStencilView)
+{
+    image.readbackPointer = nullptr;
+
+    // Create the color buffer and its framebuffer.
+    image.colorBuffer = AVkTexture::create(device, &colorDesc);
+    if(!image.colorBuffer)
+        return false;
+
+    auto colorBufferView = agpu::texture_view_ref(image.colorBuffer->getOrCreateFullView());
+    image.framebuffer = AVkFramebuffer::create(device, width, height, 1, &colorBufferView, depthStencilView);
+    if(!image.framebuffer)
+        return false;
+
+    // Create the persistently mapped readback buffer.
+    agpu_buffer_description readbackDesc = {};
+    readbackDesc.size = agpu_size(readbackPitch * height);
+    readbackDesc.heap_type = AGPU_MEMORY_HEAP_TYPE_DEVICE_TO_HOST;
+    readbackDesc.usage_modes = AGPU_COPY_DESTINATION_BUFFER;
+    readbackDesc.main_usage_mode = AGPU_COPY_DESTINATION_BUFFER;
+    readbackDesc.mapping_flags = AGPU_MAP_READ_BIT | AGPU_MAP_PERSISTENT_BIT;
+    image.readbackBuffer = AVkBuffer::create(device, &readbackDesc, nullptr);
+    if(!image.readbackBuffer)
+        return false;
+
+    image.readbackPointer = reinterpret_cast<uint8_t*> (image.readbackBuffer->mapBuffer(AGPU_READ_ONLY));
+    if(!image.readbackPointer)
+        return false;
+
+    image.readbackFence = AVkFence::create(device);
+    if(!image.readbackFence)
+        return false;
+
+    // Record the copy once. It is submitted again every time that the image is presented.
+    image.commandAllocator = agpu::command_allocator_ref(device->createCommandAllocator(AGPU_COMMAND_LIST_TYPE_DIRECT, graphicsQueue));
+    if(!image.commandAllocator)
+        return false;
+
+    image.readbackCommandList = agpu::command_list_ref(device->createCommandList(AGPU_COMMAND_LIST_TYPE_DIRECT, image.commandAllocator, agpu::pipeline_state_ref()));
+    if(!image.readbackCommandList)
+        return false;
+
+    agpu_texture_subresource_range range = {};
+    range.aspect = AGPU_TEXTURE_ASPECT_COLOR;
+    range.level_count = 1;
+    range.layer_count = 1;
+
+    agpu_buffer_image_copy_region copyRegion = {};
+    copyRegion.buffer_pitch = agpu_size(readbackPitch);
+    copyRegion.buffer_slice_pitch = agpu_size(readbackPitch * height);
+    copyRegion.texture_usage_mode = AGPU_TEXTURE_USAGE_COPY_SOURCE;
+    copyRegion.texture_subresource_level.aspect = AGPU_TEXTURE_ASPECT_COLOR;
+    copyRegion.texture_subresource_level.layer_count = 1;
+    copyRegion.texture_region.width = width;
+    copyRegion.texture_region.height = height;
+    copyRegion.texture_region.depth = 1;
+
+    auto &list = image.readbackCommandList;
+    list->pushTextureTransitionBarrier(image.colorBuffer, AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT, AGPU_TEXTURE_USAGE_COPY_SOURCE, &range);
+    list->copyTextureToBuffer(image.colorBuffer, image.readbackBuffer, &copyRegion);
+    list->popTextureTransitionBarrier();
+
+    // Make the copy visible to the host.
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = image.readbackBuffer.as<AVkBuffer> ()->handle;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(list.as<AVkCommandList> ()->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+            0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    return list->close() == AGPU_OK;
+}
+
+agpu_error AVkOffscreenSwapChain::swapBuffers()
+{
+    std::unique_lock<std::mutex> l(presentationMutex);
+    auto &image = images[currentBackBufferIndex];
+
+    // The oldest unread frame is stored in this image. Drop it.
+    if(pendingFrameCount == images.size())
+    {
+        auto error = image.readbackFence->waitOnClient();
+        if(error)
+            return error;
+        --pendingFrameCount;
+    }
+
+    auto error = graphicsQueue->addCommandListsAndSignalFence(1, &image.readbackCommandList, image.readbackFence);
+    if(error)
+        return error;
+
+    ++pendingFrameCount;
+    currentBackBufferIndex = (currentBackBufferIndex + 1) % images.size();
+    return AGPU_OK;
+}
+
+agpu_error AVkOffscreenSwapChain::readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+{
+    CHECK_POINTER(buffer);
+    if(pitch < 0 || slicePitch < 0 || size_t(pitch) < readbackPitch || size_t(slicePitch) < size_t(pitch) * height)
+        return AGPU_INVALID_PARAMETER;
+
+    std::unique_lock<std::mutex> l(presentationMutex);
+    if(pendingFrameCount == 0)
+        return AGPU_NOT_READY;
+
+    // Poll the fence of the oldest presented frame, without waiting for it.
+    auto &image = images[(currentBackBufferIndex + images.size() - pendingFrameCount) % images.size()];
+    auto fence = image.readbackFence.as<AVkFence> ()->fence;
+    auto status = vkGetFenceStatus(deviceForVk->device, fence);
+    if(status == VK_NOT_READY)
+        return AGPU_NOT_READY;
+    CONVERT_VULKAN_ERROR(status);
+
+    auto error = vkResetFences(deviceForVk->device, 1, &fence);
+    CONVERT_VULKAN_ERROR(error);
+    --pendingFrameCount;
+
+    image.readbackBuffer->invalidateWholeBuffer();
+    auto source = image.readbackPointer;
+    auto destination = reinterpret_cast<uint8_t*> (buffer);
+    if(size_t(pitch) == readbackPitch)
+    {
+        memcpy(destination, source, readbackPitch * height);
+    }
+    else
+    {
+        for(agpu_uint y = 0; y < height; ++y)
+        {
+            memcpy(destination, source, readbackPitch);
+            source += readbackPitch;
+            destination += pitch;
+        }
+    }
+
+    return AGPU_OK;
+}
+
+agpu::framebuffer_ptr AVkOffscreenSwapChain::getCurrentBackBuffer()
+{
+    return getCurrentBackBufferForLayer(0);
+}
+
+agpu::framebuffer_ptr AVkOffscreenSwapChain::getCurrentBackBufferForLayer(agpu_uint layer)
+{
+    if(layer != 0)
+        return nullptr;
+    return images[currentBackBufferIndex].framebuffer.disownedNewRef();
+}
+
+agpu_size AVkOffscreenSwapChain::getCurrentBackBufferIndex()
+{
+    return currentBackBufferIndex;
+}
+
+agpu_size AVkOffscreenSwapChain::getFramebufferCount()
+{
+    return (agpu_size)images.size();
+}
+
+agpu_error AVkOffscreenSwapChain::setOverlayPosition(agpu_int x, agpu_int y)
+{
+    return AGPU_OK;
+}
+
+agpu_size AVkOffscreenSwapChain::getWidth()
+{
+    return width;
+}
+
+agpu_size AVkOffscreenSwapChain::getHeight()
+{
+    return height;
+}
+
+agpu_size AVkOffscreenSwapChain::getLayerCount()
+{
+    return 1;
+}
+
+} // End of namespace AgpuVulkan
@@ -0,0 +1,74 @@
+#ifndef AGPU_VULKAN_OFFSCREEN_SWAP_CHAIN_HPP
+#define AGPU_VULKAN_OFFSCREEN_SWAP_CHAIN_HPP
+
+#include "device.hpp"
+#include <mutex>
+#include <vector>
+
+namespace AgpuVulkan
+{
+
+/**
+ * I am one of the images of an offscreen swap chain, together with the
+ * persistently mapped buffer that receives its contents when it is presented.
+ */
+struct AVkOffscreenSwapChainImage
+{
+    agpu::texture_ref colorBuffer;
+    agpu::framebuffer_ref framebuffer;
+    agpu::buffer_ref readbackBuffer;
+    uint8_t *readbackPointer;
+    agpu::command_allocator_ref commandAllocator;
+    agpu::command_list_ref readbackCommandList;
+    agpu::fence_ref readbackFence;
+};
+
+/**
+ * I am a swap chain that is not attached to any window. Presenting an image
+ * submits a prerecorded copy into its readback buffer, right after the
+ * command lists of the frame. The presented frames are read back in order
+ * without blocking, once their copy is completed. A frame that is not read
+ * before its image is presented again is dropped.
+ */
+struct AVkOffscreenSwapChain : public agpu::swap_chain
+{
+public:
+    AVkOffscreenSwapChain(const agpu::device_ref &device);
+    ~AVkOffscreenSwapChain();
+
+    static agpu::swap_chain_ref create(const agpu::device_ref &device, const agpu::command_queue_ref &graphicsCommandQueue, agpu_swap_chain_create_info *createInfo);
+
+    virtual agpu_error swapBuffers() override;
+    virtual agpu::framebuffer_ptr getCurrentBackBuffer() override;
+    virtual agpu::framebuffer_ptr getCurrentBackBufferForLayer(agpu_uint layer) override;
+    virtual agpu_size getCurrentBackBufferIndex() override;
+    virtual agpu_size getFramebufferCount() override;
+
+    virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) override;
+    virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
+
+    virtual agpu_size getWidth() override;
+    virtual agpu_size getHeight() override;
+    virtual agpu_size getLayerCount() override;
+
+    agpu::device_ref device;
+    agpu::command_queue_ref graphicsQueue;
+
+    agpu_uint width;
+    agpu_uint height;
+    agpu_texture_format format;
+    size_t readbackPitch;
+
+    std::vector<AVkOffscreenSwapChainImage> images;
+
+    std::mutex presentationMutex;
+    uint32_t currentBackBufferIndex;
+    uint32_t pendingFrameCount;
+
+private:
+    bool initializeImage(AVkOffscreenSwapChainImage &image, agpu_texture_description &colorDesc, const agpu::texture_view_ref &depthStencilView);
+};
+
+} // End of namespace AgpuVulkan
+
+#endif //AGPU_VULKAN_OFFSCREEN_SWAP_CHAIN_HPP
@@ -0,0 +1,184 @@
+#include "pipeline_cache.hpp"
+#include "../Common/disk_cache_utils.hpp"
+#include "../Common/utility.hpp"
+#include <stddef.h>
+
+namespace AgpuVulkan
+{
+
+static const uint32_t PipelineCacheFileMagic = 0x43504741; // AGPC
+static const uint32_t PipelineCacheFileVersion = 1;
+
+static uint64_t computeHeaderChecksum(const AVkPipelineCacheFileHeader &header)
+{
+    return AgpuCommon::hashBytes(&header, offsetof(AVkPipelineCacheFileHeader, headerChecksum));
+}
+
+AVkPipelineCacheStore::AVkPipelineCacheStore(VkDevice device, const VkPhysicalDeviceProperties &deviceProperties, const std::string &directory)
+    : device(device)
+{
+    vendorID = deviceProperties.vendorID;
+    deviceID = deviceProperties.deviceID;
+    driverVersion = deviceProperties.driverVersion;
+    memcpy(pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    char baseName[64];
+    snprintf(baseName, sizeof(baseName), "agpu-vulkan-pipeline-cache-%08x-%08x.bin", vendorID, deviceID);
+
+    fileName = directory;
+    if(!fileName.empty() && fileName.back() != '/' && fileName.back() != '\\')
+        fileName += '/';
+    fileName += baseName;
+}
+
+AVkPipelineCacheStore::~AVkPipelineCacheStore()
+{
+}
+
+std::string AVkPipelineCacheStore::getDirectoryFor(agpu_device_open_info *openInfo)
+{
+    if(openInfo->pipeline_cache_directory && *openInfo->pipeline_cache_directory)
+        return openInfo->pipeline_cache_directory;
+
+    return AgpuCommon::getStringFromEnvironment("AGPU_PIPELINE_CACHE_DIR");
+}
+
+bool AVkPipelineCacheStore::load(std::vector<uint8_t> &result)
+{
+    std::unique_lock<std::mutex> l(mutex);
+    return readValidatedBlob(result);
+}
+
+agpu_error AVkPipelineCacheStore::save(VkPipelineCache pipelineCache)
+{
+    std::unique_lock<std::mutex> l(mutex);
+
+    // Start from what other processes may have stored since we loaded the
+    // blob. The merge destination must be externally synchronized, so we
+    // merge into a scratch cache instead of the live device cache.
+    std::vector<uint8_t> diskData;
+    readValidatedBlob(diskData);
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = diskData.size();
+    createInfo.pInitialData = diskData.empty() ? nullptr : diskData.data();
+
+    VkPipelineCache mergedCache = VK_NULL_HANDLE;
+    auto error = vkCreatePipelineCache(device, &createInfo, nullptr, &mergedCache);
+    if(error && !diskData.empty())
+    {
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        error = vkCreatePipelineCache(device, &createInfo, nullptr, &mergedCache);
+    }
+    CONVERT_VULKAN_ERROR(error);
+
+    error = vkMergePipelineCaches(device, mergedCache, 1, &pipelineCache);
+    if(error)
+    {
+        vkDestroyPipelineCache(device, mergedCache, nullptr);
+        return AGPU_ERROR;
+    }
+
+    size_t dataSize = 0;
+    error = vkGetPipelineCacheData(device, mergedCache, &dataSize, nullptr);
+    std::vector<uint8_t> data(dataSize);
+    if(!error && dataSize > 0)
+        error = vkGetPipelineCacheData(device, mergedCache, &dataSize, data.data());
+    vkDestroyPipelineCache(device, mergedCache, nullptr);
+    CONVERT_VULKAN_ERROR(error);
+
+    data.resize(dataSize);
+    if(data.empty())
+        return AGPU_OK;
+
+    return writeBlobAtomically(data) ? AGPU_OK : AGPU_ERROR;
+}
+
+bool AVkPipelineCacheStore::isValidHeader(const AVkPipelineCacheFileHeader &header)
+{
+    return header.magic == PipelineCacheFileMagic &&
+        header.version == PipelineCacheFileVersion &&
+        header.headerSize == sizeof(AVkPipelineCacheFileHeader) &&
+        header.headerChecksum == computeHeaderChecksum(header) &&
+        header.vendorID == vendorID &&
+        header.deviceID == deviceID &&
+        header.driverVersion == driverVersion &&
+        memcmp(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+bool AVkPipelineCacheStore::isValidVulkanPipelineCacheData(const std::vector<uint8_t> &data)
+{
+    // Layout of VK_PIPELINE_CACHE_HEADER_VERSION_ONE.
+    struct VulkanHeader
+    {
+        uint32_t headerSize;
+        uint32_t headerVersion;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    };
+
+    if(data.size() < sizeof(VulkanHeader))
+        return false;
+
+    VulkanHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    return header.headerSize >= sizeof(VulkanHeader) &&
+        header.headerSize <= data.size() &&
+        header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.vendorID == vendorID &&
+        header.deviceID == deviceID &&
+        memcmp(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+bool AVkPipelineCacheStore::readValidatedBlob(std::vector<uint8_t> &result)
+{
+    result.clear();
+
+    auto file = fopen(fileName.c_str(), "rb");
+    if(!file)
+        return false;
+
+    AVkPipelineCacheFileHeader header;
+    auto isValid = fread(&header, sizeof(header), 1, file) == 1 && isValidHeader(header);
+    if(isValid)
+    {
+        result.resize(size_t(header.dataSize));
+        isValid = result.empty() || fread(result.data(), result.size(), 1, file) == 1;
+    }
+    fclose(file);
+
+    if(isValid)
+        isValid = AgpuCommon::hashBytes(result.data(), result.size()) == header.dataChecksum &&
+            isValidVulkanPipelineCacheData(result);
+
+    if(!isValid)
+    {
+        printError("Ignoring stale or corrupted pipeline cache %s\n", fileName.c_str());
+        result.clear();
+    }
+
+    return isValid;
+}
+
+bool AVkPipelineCacheStore::writeBlobAtomically(const std::vector<uint8_t> &data)
+{
+    AVkPipelineCacheFileHeader header = {};
+    header.magic = PipelineCacheFileMagic;
+    header.version = PipelineCacheFileVersion;
+    header.headerSize = sizeof(AVkPipelineCacheFileHeader);
+    header.vendorID = vendorID;
+    header.deviceID = deviceID;
+    header.driverVersion = driverVersion;
+    memcpy(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = data.size();
+    header.dataChecksum = AgpuCommon::hashBytes(data.data(), data.size());
+    header.headerChecksum = computeHeaderChecksum(header);
+
+    return AgpuCommon::writeFileAtomically(fileName, &header, sizeof(header),
+        data.data(), data.size(), "pipeline cache file", printError);
+}
+
+} // End of namespace AgpuVulkan
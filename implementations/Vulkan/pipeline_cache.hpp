@@ -0,0 +1,72 @@
+#ifndef AGPU_VULKAN_PIPELINE_CACHE_HPP
+#define AGPU_VULKAN_PIPELINE_CACHE_HPP
+
+#include "common.hpp"
+#include "include_vulkan.h"
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AgpuVulkan
+{
+
+/**
+ * Header that precedes the vulkan pipeline cache data in the on-disk blob.
+ */
+struct AVkPipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t dataChecksum;
+    uint64_t headerChecksum;
+};
+
+/**
+ * Persistent on-disk storage for the default pipeline cache of a device.
+ * The blob is only accepted when it was produced by the same vendor, device,
+ * driver version and pipeline cache UUID, and when its checksums match.
+ * Saving merges with the blob that is currently on disk, so that several
+ * processes sharing the same directory accumulate their pipelines, and the
+ * result is written into a temporary file that atomically replaces the old one.
+ */
+class AVkPipelineCacheStore
+{
+public:
+    AVkPipelineCacheStore(VkDevice device, const VkPhysicalDeviceProperties &deviceProperties, const std::string &directory);
+    ~AVkPipelineCacheStore();
+
+    static std::string getDirectoryFor(agpu_device_open_info *openInfo);
+
+    const std::string &getFileName() const
+    {
+        return fileName;
+    }
+
+    bool load(std::vector<uint8_t> &result);
+    agpu_error save(VkPipelineCache pipelineCache);
+
+private:
+    bool readValidatedBlob(std::vector<uint8_t> &result);
+    bool writeBlobAtomically(const std::vector<uint8_t> &data);
+    bool isValidHeader(const AVkPipelineCacheFileHeader &header);
+    bool isValidVulkanPipelineCacheData(const std::vector<uint8_t> &data);
+
+    VkDevice device;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    std::string fileName;
+    std::mutex mutex;
+};
+
+} // End of namespace AgpuVulkan
+
+#endif //AGPU_VULKAN_PIPELINE_CACHE_HPP
@@ -32,6 +32,8 @@ agpu_bool isFeatureSupportedOnGPU(agpu_feature feature, VkPhysicalDeviceProperti
 	case AGPU_FEATURE_SHADER_INT_16: return deviceFeatures.shaderInt16;
 	case AGPU_FEATURE_SAMPLE_SHADING: return deviceFeatures.sampleRateShading;
 	case AGPU_FEATURE_FILL_MODE_NON_SOLID: return deviceFeatures.fillModeNonSolid;
+	case AGPU_FEATURE_TIMESTAMP_QUERY: return deviceProperties.limits.timestampComputeAndGraphics;
+	case AGPU_FEATURE_PIPELINE_STATISTICS_QUERY: return deviceFeatures.pipelineStatisticsQuery;
 
 	default: return false;
 	}
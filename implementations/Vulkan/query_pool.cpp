@@ -0,0 +1,115 @@
+#include "query_pool.hpp"
+
+namespace AgpuVulkan
+{
+
+static agpu_uint countBits(agpu_bitfield value)
+{
+    agpu_uint count = 0;
+    for(; value != 0; value &= value - 1)
+        ++count;
+    return count;
+}
+
+AVkQueryPool::AVkQueryPool(const agpu::device_ref &device)
+    : device(device)
+{
+    handle = VK_NULL_HANDLE;
+    resultValueCount = 1;
+}
+
+AVkQueryPool::~AVkQueryPool()
+{
+    if(handle)
+        vkDestroyQueryPool(deviceForVk->device, handle, nullptr);
+}
+
+agpu::query_pool_ref AVkQueryPool::create(const agpu::device_ref &device, agpu_query_pool_description *description)
+{
+    if(!description || description->query_count == 0)
+        return agpu::query_pool_ref();
+
+    VkQueryPoolCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    info.queryCount = description->query_count;
+
+    agpu_uint resultValueCount = 1;
+    switch(description->type)
+    {
+    case AGPU_QUERY_TYPE_TIMESTAMP:
+        if(!deviceForVk->deviceProperties.limits.timestampComputeAndGraphics)
+            return agpu::query_pool_ref();
+        info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        break;
+    case AGPU_QUERY_TYPE_OCCLUSION:
+        info.queryType = VK_QUERY_TYPE_OCCLUSION;
+        break;
+    case AGPU_QUERY_TYPE_PIPELINE_STATISTICS:
+        // The statistic flags have the same values than in Vulkan.
+        if(!deviceForVk->deviceFeatures.pipelineStatisticsQuery || description->pipeline_statistics == 0)
+            return agpu::query_pool_ref();
+        info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        info.pipelineStatistics = VkQueryPipelineStatisticFlags(description->pipeline_statistics);
+        resultValueCount = countBits(description->pipeline_statistics);
+        break;
+    default:
+        return agpu::query_pool_ref();
+    }
+
+    VkQueryPool handle;
+    auto error = vkCreateQueryPool(deviceForVk->device, &info, nullptr, &handle);
+    if(error)
+        return agpu::query_pool_ref();
+
+    auto result = agpu::makeObject<AVkQueryPool> (device);
+    auto queryPool = result.as<AVkQueryPool> ();
+    queryPool->description = *description;
+    queryPool->handle = handle;
+    queryPool->resultValueCount = resultValueCount;
+    return result;
+}
+
+agpu_error AVkQueryPool::getDescription(agpu_query_pool_description* description)
+{
+    CHECK_POINTER(description);
+    *description = this->description;
+    return AGPU_OK;
+}
+
+agpu_uint AVkQueryPool::getResultValueCount()
+{
+    return resultValueCount;
+}
+
+agpu_float AVkQueryPool::getTimestampPeriod()
+{
+    return deviceForVk->deviceProperties.limits.timestampPeriod;
+}
+
+agpu_error AVkQueryPool::getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags)
+{
+    CHECK_POINTER(results);
+    if(first_query > description.query_count || query_count > description.query_count - first_query)
+        return AGPU_OUT_OF_BOUNDS;
+    if(query_count == 0)
+        return AGPU_OK;
+
+    VkQueryResultFlags resultFlags = VK_QUERY_RESULT_64_BIT;
+    auto stride = resultValueCount;
+    if(flags & AGPU_QUERY_RESULT_WAIT)
+        resultFlags |= VK_QUERY_RESULT_WAIT_BIT;
+    if(flags & AGPU_QUERY_RESULT_WITH_AVAILABILITY)
+    {
+        resultFlags |= VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+        ++stride;
+    }
+
+    auto error = vkGetQueryPoolResults(deviceForVk->device, handle, first_query, query_count,
+        query_count*stride*sizeof(agpu_ulong), results, stride*sizeof(agpu_ulong), resultFlags);
+    if(error == VK_NOT_READY)
+        return AGPU_NOT_READY;
+    CONVERT_VULKAN_ERROR(error);
+    return AGPU_OK;
+}
+
+} // End of namespace AgpuVulkan
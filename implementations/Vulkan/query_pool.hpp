@@ -0,0 +1,35 @@
+#ifndef AGPU_VULKAN_QUERY_POOL_HPP
+#define AGPU_VULKAN_QUERY_POOL_HPP
+
+#include "device.hpp"
+
+namespace AgpuVulkan
+{
+
+/**
+ * I am a pool of timestamp, occlusion or pipeline statistics queries. My
+ * results are read back with vkGetQueryPoolResults, which does not block
+ * unless it is explicitly requested.
+ */
+class AVkQueryPool : public agpu::query_pool
+{
+public:
+    AVkQueryPool(const agpu::device_ref &device);
+    ~AVkQueryPool();
+
+    static agpu::query_pool_ref create(const agpu::device_ref &device, agpu_query_pool_description *description);
+
+    virtual agpu_error getDescription(agpu_query_pool_description* description) override;
+    virtual agpu_uint getResultValueCount() override;
+    virtual agpu_float getTimestampPeriod() override;
+    virtual agpu_error getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags) override;
+
+    agpu::device_ref device;
+    agpu_query_pool_description description;
+    VkQueryPool handle;
+    agpu_uint resultValueCount;
+};
+
+} // End of namespace AgpuVulkan
+
+#endif //AGPU_VULKAN_QUERY_POOL_HPP
@@ -9,9 +9,31 @@
 namespace AgpuVulkan
 {
 
+static agpu_error computeBufferDescriptorRange(const agpu_buffer_description &description, agpu_device_size offset, agpu_device_size size, agpu_device_size maxRange, VkDeviceSize *outRange)
+{
+    if(offset > description.size || size > description.size - offset)
+        return AGPU_OUT_OF_BOUNDS;
+    if(size > maxRange)
+        return AGPU_OUT_OF_BOUNDS;
+
+    // Align the size to 256 bytes, without going past the end of the buffer
+    // or the device range limit.
+    VkDeviceSize range = (size + 255) & ~VkDeviceSize(255);
+    if(range > description.size - offset || range > maxRange)
+        range = size;
+
+    *outRange = range;
+    return AGPU_OK;
+}
+
 AVkShaderResourceBinding::AVkShaderResourceBinding(const agpu::device_ref &device)
     : device(device)
 {
+    descriptorSet = VK_NULL_HANDLE;
+    descriptorSetAllocation = nullptr;
+    transientBlock = nullptr;
+    writtenDescriptorCount = 0;
+    hasPendingWrites = false;
 }
 
 AVkShaderResourceBinding::~AVkShaderResourceBinding()
@@ -21,13 +43,19 @@ AVkShaderResourceBinding::~AVkShaderResourceBinding()
         descriptorSetPool->free(descriptorSetAllocation);
         descriptorSetAllocation = nullptr;
     }
+
+    if(descriptorSetPool && transientBlock)
+    {
+        descriptorSetPool->releaseTransient(transientBlock);
+        transientBlock = nullptr;
+    }
 }
 
 agpu::shader_resource_binding_ref AVkShaderResourceBinding::create(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex,
     const AVkDescriptorSetPoolPtr &descriptorSetPool,
     AVkDescriptorSetPoolAllocation *descriptorSetAllocation)
 {
-    auto result = agpu::makeObject<AVkShaderResourceBinding> (device);
+    auto result = agpu::makePooledObject<AVkShaderResourceBinding> (device);
     auto resourceBinding = result.as<AVkShaderResourceBinding> ();
     resourceBinding->elementIndex = elementIndex;
     resourceBinding->signature = signature;
@@ -35,9 +63,118 @@ agpu::shader_resource_binding_ref AVkShaderResourceBinding::create(const agpu::d
     resourceBinding->descriptorSetAllocation = descriptorSetAllocation;
     resourceBinding->descriptorSetPool = descriptorSetPool;
     resourceBinding->bindingDescription = &descriptorSetPool->setDescription;
+    resourceBinding->descriptors.resize(descriptorSetPool->descriptorCount);
+    resourceBinding->descriptorStates.resize(descriptorSetPool->descriptorCount, 0);
     return result;
 }
 
+agpu::shader_resource_binding_ref AVkShaderResourceBinding::createTransient(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex,
+    const AVkDescriptorSetPoolPtr &descriptorSetPool)
+{
+    AVkTransientDescriptorPoolBlock *transientBlock = nullptr;
+    auto descriptorSet = descriptorSetPool->allocateTransient(transientBlock);
+    if(!descriptorSet)
+        return agpu::shader_resource_binding_ref();
+
+    auto result = agpu::makePooledObject<AVkShaderResourceBinding> (device);
+    auto resourceBinding = result.as<AVkShaderResourceBinding> ();
+    resourceBinding->elementIndex = elementIndex;
+    resourceBinding->signature = signature;
+    resourceBinding->descriptorSet = descriptorSet;
+    resourceBinding->transientBlock = transientBlock;
+    resourceBinding->descriptorSetPool = descriptorSetPool;
+    resourceBinding->bindingDescription = &descriptorSetPool->setDescription;
+    resourceBinding->descriptors.resize(descriptorSetPool->descriptorCount);
+    resourceBinding->descriptorStates.resize(descriptorSetPool->descriptorCount, 0);
+    return result;
+}
+
+void AVkShaderResourceBinding::setDescriptor(agpu_int location, uint32_t arrayElement, const AVkDescriptorInfo &descriptor)
+{
+    auto index = descriptorSetPool->bindingFirstDescriptors[location] + arrayElement;
+    auto &state = descriptorStates[index];
+    if((state & DescriptorWritten) == 0)
+        ++writtenDescriptorCount;
+
+    descriptors[index] = descriptor;
+    state = DescriptorWritten | DescriptorDirty;
+    hasPendingWrites = true;
+}
+
+void AVkShaderResourceBinding::commitPendingWrites()
+{
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    if(!hasPendingWrites)
+        return;
+    hasPendingWrites = false;
+
+    // A template rewrites the whole set, so every descriptor has to be valid.
+    if(writtenDescriptorCount == descriptorSetPool->descriptorCount)
+    {
+        auto updateTemplate = descriptorSetPool->getDescriptorUpdateTemplate();
+        if(updateTemplate != VK_NULL_HANDLE)
+        {
+            deviceForVk->fpUpdateDescriptorSetWithTemplateKHR(deviceForVk->device, descriptorSet, updateTemplate, descriptors.data());
+            for(auto &state : descriptorStates)
+                state &= ~DescriptorDirty;
+            return;
+        }
+    }
+
+    // Coalesce the consecutive dirty descriptors of each binding into a single write.
+    std::vector<VkWriteDescriptorSet> writes;
+    std::vector<VkDescriptorImageInfo> imageInfos;
+    std::vector<VkDescriptorBufferInfo> bufferInfos;
+    imageInfos.reserve(descriptors.size());
+    bufferInfos.reserve(descriptors.size());
+
+    auto &bindings = bindingDescription->bindings;
+    for(size_t location = 0; location < bindings.size(); ++location)
+    {
+        auto &binding = bindings[location];
+        auto firstDescriptor = descriptorSetPool->bindingFirstDescriptors[location];
+        auto isBuffer = binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+            binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+        uint32_t element = 0;
+        while(element < binding.descriptorCount)
+        {
+            if((descriptorStates[firstDescriptor + element] & DescriptorDirty) == 0)
+            {
+                ++element;
+                continue;
+            }
+
+            VkWriteDescriptorSet write = {};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.descriptorType = binding.descriptorType;
+            write.dstSet = descriptorSet;
+            write.dstBinding = binding.binding;
+            write.dstArrayElement = element;
+            if(isBuffer)
+                write.pBufferInfo = bufferInfos.data() + bufferInfos.size();
+            else
+                write.pImageInfo = imageInfos.data() + imageInfos.size();
+
+            for(; element < binding.descriptorCount && (descriptorStates[firstDescriptor + element] & DescriptorDirty) != 0; ++element)
+            {
+                auto index = firstDescriptor + element;
+                descriptorStates[index] &= ~DescriptorDirty;
+                if(isBuffer)
+                    bufferInfos.push_back(descriptors[index].buffer);
+                else
+                    imageInfos.push_back(descriptors[index].image);
+                ++write.descriptorCount;
+            }
+
+            writes.push_back(write);
+        }
+    }
+
+    if(!writes.empty())
+        vkUpdateDescriptorSets(deviceForVk->device, uint32_t(writes.size()), writes.data(), 0, nullptr);
+}
+
 agpu_error AVkShaderResourceBinding::bindUniformBuffer(agpu_int location, const agpu::buffer_ref &uniform_buffer)
 {
     CHECK_POINTER(uniform_buffer);
@@ -50,7 +187,7 @@ agpu_error AVkShaderResourceBinding::bindUniformBuffer(agpu_int location, const
     return bindUniformBufferRange(location, uniform_buffer, 0, uniform_buffer.as<AVkBuffer> ()->description.size);
 }
 
-agpu_error AVkShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size)
+agpu_error AVkShaderResourceBinding::bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size)
 {
     CHECK_POINTER(uniform_buffer);
 
@@ -61,21 +198,19 @@ agpu_error AVkShaderResourceBinding::bindUniformBufferRange(agpu_int location, c
     if (bindingDescription->types[location] != AGPU_SHADER_BINDING_TYPE_UNIFORM_BUFFER)
         return AGPU_INVALID_OPERATION;
 
-    // Align the size to 256 Kb
-    VkDescriptorBufferInfo bufferInfo;
-    bufferInfo.buffer = uniform_buffer.as<AVkBuffer> ()->handle;
-    bufferInfo.offset = offset;
-    bufferInfo.range = (size + 255) & (~255);
+    VkDeviceSize range;
+    auto error = computeBufferDescriptorRange(uniform_buffer.as<AVkBuffer> ()->description, offset, size,
+        deviceForVk->deviceProperties.limits.maxUniformBufferRange, &range);
+    if(error)
+        return error;
 
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = 1;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstBinding = location;
-    write.pBufferInfo = &bufferInfo;
+    AVkDescriptorInfo descriptor = {};
+    descriptor.buffer.buffer = uniform_buffer.as<AVkBuffer> ()->handle;
+    descriptor.buffer.offset = offset;
+    descriptor.buffer.range = range;
 
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    setDescriptor(location, 0, descriptor);
 
     return AGPU_OK;
 }
@@ -92,7 +227,7 @@ agpu_error AVkShaderResourceBinding::bindStorageBuffer(agpu_int location, const
     return bindStorageBufferRange(location, storage_buffer, 0, storage_buffer.as<AVkBuffer> ()->description.size);
 }
 
-agpu_error AVkShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_size offset, agpu_size size)
+agpu_error AVkShaderResourceBinding::bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_device_size offset, agpu_device_size size)
 {
     CHECK_POINTER(storage_buffer);
 
@@ -103,21 +238,19 @@ agpu_error AVkShaderResourceBinding::bindStorageBufferRange(agpu_int location, c
     if (bindingDescription->types[location] != AGPU_SHADER_BINDING_TYPE_STORAGE_BUFFER)
         return AGPU_INVALID_OPERATION;
 
-    // Align the size to 256 bytes.
-    VkDescriptorBufferInfo bufferInfo;
-    bufferInfo.buffer = storage_buffer.as<AVkBuffer> ()->handle;
-    bufferInfo.offset = offset;
-    bufferInfo.range = (size + 255) & (~255);
+    VkDeviceSize range;
+    auto error = computeBufferDescriptorRange(storage_buffer.as<AVkBuffer> ()->description, offset, size,
+        deviceForVk->deviceProperties.limits.maxStorageBufferRange, &range);
+    if(error)
+        return error;
 
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = 1;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstBinding = location;
-    write.pBufferInfo = &bufferInfo;
+    AVkDescriptorInfo descriptor = {};
+    descriptor.buffer.buffer = storage_buffer.as<AVkBuffer> ()->handle;
+    descriptor.buffer.offset = offset;
+    descriptor.buffer.range = range;
 
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    setDescriptor(location, 0, descriptor);
 
     return AGPU_OK;
 }
@@ -134,20 +267,13 @@ agpu_error AVkShaderResourceBinding::bindSampledTextureView(agpu_int location, c
 
     auto avkView = view.as<AVkTextureView> ();
 
-    VkDescriptorImageInfo imageInfo = {};
-    imageInfo.imageLayout = avkView->imageLayout;
-    imageInfo.imageView = avkView->handle;
-    imageInfo.sampler = VK_NULL_HANDLE;
+    AVkDescriptorInfo descriptor = {};
+    descriptor.image.imageLayout = avkView->imageLayout;
+    descriptor.image.imageView = avkView->handle;
+    descriptor.image.sampler = VK_NULL_HANDLE;
 
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = 1;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstBinding = location;
-    write.pImageInfo = &imageInfo;
-
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    setDescriptor(location, 0, descriptor);
     return AGPU_OK;
 }
 
@@ -160,29 +286,20 @@ agpu_error AVkShaderResourceBinding::bindArrayOfSampledTextureView(agpu_int loca
     if (bindingDescription->types[location] != AGPU_SHADER_BINDING_TYPE_SAMPLED_IMAGE)
         return AGPU_INVALID_OPERATION;
 
-    std::vector<VkDescriptorImageInfo> imageInfos;
-    imageInfos.reserve(count);
+    if (first_index < 0 || first_index + count > bindingDescription->bindings[location].descriptorCount)
+        return AGPU_OUT_OF_BOUNDS;
+
+    std::unique_lock<std::mutex> l(descriptorsMutex);
     for(size_t i = 0; i < count; ++i)
     {
         auto avkView = views[i].as<AVkTextureView> ();
 
-        VkDescriptorImageInfo imageInfo = {};
-        imageInfo.imageLayout = avkView->imageLayout;
-        imageInfo.imageView = avkView->handle;
-        imageInfo.sampler = VK_NULL_HANDLE;
-        imageInfos.push_back(imageInfo);
+        AVkDescriptorInfo descriptor = {};
+        descriptor.image.imageLayout = avkView->imageLayout;
+        descriptor.image.imageView = avkView->handle;
+        descriptor.image.sampler = VK_NULL_HANDLE;
+        setDescriptor(location, uint32_t(first_index + i), descriptor);
     }
-
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = count;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstArrayElement = first_index;
-    write.dstBinding = location;
-    write.pImageInfo = imageInfos.data();
-
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
     return AGPU_OK;
 }
 
@@ -197,20 +314,13 @@ agpu_error AVkShaderResourceBinding::bindStorageImageView(agpu_int location, con
 
     auto avkView = view.as<AVkTextureView> ();
 
-    VkDescriptorImageInfo imageInfo = {};
-    imageInfo.imageLayout = avkView->imageLayout;
-    imageInfo.imageView = avkView->handle;
-    imageInfo.sampler = VK_NULL_HANDLE;
+    AVkDescriptorInfo descriptor = {};
+    descriptor.image.imageLayout = avkView->imageLayout;
+    descriptor.image.imageView = avkView->handle;
+    descriptor.image.sampler = VK_NULL_HANDLE;
 
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = 1;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstBinding = location;
-    write.pImageInfo = &imageInfo;
-
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    setDescriptor(location, 0, descriptor);
     return AGPU_OK;
 }
 
@@ -223,19 +333,12 @@ agpu_error AVkShaderResourceBinding::bindSampler(agpu_int location, const agpu::
     if (bindingDescription->types[location] != AGPU_SHADER_BINDING_TYPE_SAMPLER)
         return AGPU_INVALID_OPERATION;
 
-    VkDescriptorImageInfo imageInfo = {};
-    imageInfo.imageView = VK_NULL_HANDLE;
-    imageInfo.sampler = sampler.as<AVkSampler> ()->handle;
-
-    VkWriteDescriptorSet write = {};
-    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.descriptorCount = 1;
-    write.descriptorType = bindingDescription->bindings[location].descriptorType;
-    write.dstSet = descriptorSet;
-    write.dstBinding = location;
-    write.pImageInfo = &imageInfo;
+    AVkDescriptorInfo descriptor = {};
+    descriptor.image.imageView = VK_NULL_HANDLE;
+    descriptor.image.sampler = sampler.as<AVkSampler> ()->handle;
 
-    vkUpdateDescriptorSets(deviceForVk->device, 1, &write, 0, nullptr);
+    std::unique_lock<std::mutex> l(descriptorsMutex);
+    setDescriptor(location, 0, descriptor);
     return AGPU_OK;
 }
 
@@ -8,6 +8,12 @@
 namespace AgpuVulkan
 {
 
+/**
+ * I am a descriptor set. My bind methods only record the new descriptors,
+ * and all of the pending writes are committed with a single update when I am
+ * bound by a command list. A descriptor update template is used for the
+ * commit when the extension is available and every descriptor is valid.
+ */
 class AVkShaderResourceBinding : public agpu::shader_resource_binding
 {
 public:
@@ -17,23 +23,41 @@ public:
     static agpu::shader_resource_binding_ref create(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex,
         const AVkDescriptorSetPoolPtr &descriptorSetPool,
         AVkDescriptorSetPoolAllocation *descriptorSetAllocation);
+    static agpu::shader_resource_binding_ref createTransient(const agpu::device_ref &device, const agpu::shader_signature_ref &signature, agpu_uint elementIndex,
+        const AVkDescriptorSetPoolPtr &descriptorSetPool);
 
     virtual agpu_error bindUniformBuffer(agpu_int location, const agpu::buffer_ref &uniform_buffer) override;
-    virtual agpu_error bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bindUniformBufferRange(agpu_int location, const agpu::buffer_ref &uniform_buffer, agpu_device_size offset, agpu_device_size size) override;
     virtual agpu_error bindStorageBuffer(agpu_int location, const agpu::buffer_ref &storage_buffer) override;
-    virtual agpu_error bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_size offset, agpu_size size) override;
+    virtual agpu_error bindStorageBufferRange(agpu_int location, const agpu::buffer_ref &storage_buffer, agpu_device_size offset, agpu_device_size size) override;
 	virtual agpu_error bindSampledTextureView(agpu_int location, const agpu::texture_view_ref &view) override;
     virtual agpu_error bindArrayOfSampledTextureView(agpu_int location, agpu_int first_index, agpu_uint count, agpu::texture_view_ref* views) override;
 	virtual agpu_error bindStorageImageView(agpu_int location, const agpu::texture_view_ref &view) override;
 	virtual agpu_error bindSampler(agpu_int location, const agpu::sampler_ref &sampler) override;
 
+    // I must be called before the descriptor set is used by a command list.
+    void commitPendingWrites();
+
     agpu::device_ref device;
     agpu::shader_signature_ref signature;
     agpu_uint elementIndex;
     VkDescriptorSet descriptorSet;
     AVkDescriptorSetPoolPtr descriptorSetPool;
     AVkDescriptorSetPoolAllocation *descriptorSetAllocation;
+    AVkTransientDescriptorPoolBlock *transientBlock;
     const ShaderSignatureElementDescription *bindingDescription;
+
+private:
+    static constexpr uint8_t DescriptorWritten = 1;
+    static constexpr uint8_t DescriptorDirty = 2;
+
+    void setDescriptor(agpu_int location, uint32_t arrayElement, const AVkDescriptorInfo &descriptor);
+
+    std::mutex descriptorsMutex;
+    std::vector<AVkDescriptorInfo> descriptors;
+    std::vector<uint8_t> descriptorStates;
+    uint32_t writtenDescriptorCount;
+    bool hasPendingWrites;
 };
 
 } // End of namespace AgpuVulkan
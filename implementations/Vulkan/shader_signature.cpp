@@ -34,6 +34,17 @@ agpu::shader_resource_binding_ptr AVkShaderSignature::createShaderResourceBindin
             .disown();
 }
 
+agpu::shader_resource_binding_ptr AVkShaderSignature::createTransientShaderResourceBinding(agpu_uint element)
+{
+    if (element >= descriptorPools.size())
+        return nullptr;
+
+    return AVkShaderResourceBinding::createTransient(device,
+            refFromThis<agpu::shader_signature> (),
+            element, descriptorPools[element])
+            .disown();
+}
+
 agpu::shader_signature_ref AVkShaderSignature::create(const agpu::device_ref &device, AVkShaderSignatureBuilder *builder, VkPipelineLayout layout)
 {
     // Allocate the signature and copy its parameters.
@@ -68,6 +79,7 @@ agpu::shader_signature_ref AVkShaderSignature::create(const agpu::device_ref &de
         poolAllocator->device = device;
         poolAllocator->setDescription = element;
         poolAllocator->elementSizes = poolSizes;
+        poolAllocator->computeDescriptorLayout();
         signature->descriptorPools.push_back(poolAllocator);
     }
 
@@ -17,6 +17,7 @@ public:
     static agpu::shader_signature_ref create(const agpu::device_ref &device, AVkShaderSignatureBuilder *builder, VkPipelineLayout layout);
 
     virtual agpu::shader_resource_binding_ptr createShaderResourceBinding(agpu_uint element) override;
+    virtual agpu::shader_resource_binding_ptr createTransientShaderResourceBinding(agpu_uint element) override;
 
     agpu::device_ref device;
     VkPipelineLayout layout;
@@ -608,4 +608,9 @@ agpu_error AVkSwapChain::setOverlayPosition(agpu_int x, agpu_int y)
     return overlayWindow->setPosition(x, y);
 }
 
+agpu_error AVkSwapChain::readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+{
+    return AGPU_UNSUPPORTED;
+}
+
 } // End of namespace AgpuVulkan
@@ -27,6 +27,7 @@ public:
     virtual agpu_size getFramebufferCount() override;
 
     virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) override;
+    virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) override;
 
 	virtual agpu_size getWidth() override;
 	virtual agpu_size getHeight() override;
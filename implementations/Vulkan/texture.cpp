@@ -3,6 +3,7 @@
 #include "texture_format.hpp"
 #include "texture_view.hpp"
 #include "buffer.hpp"
+#include "fence.hpp"
 #include "constants.hpp"
 
 namespace AgpuVulkan
@@ -469,68 +470,121 @@ agpu_error AVkTexture::uploadTextureSubData (agpu_int level, agpu_int arrayIndex
         return AGPU_INVALID_OPERATION;
     }
 
-	VkImageSubresourceRange range = {};
-    range.baseMipLevel = level;
-    range.baseArrayLayer = arrayIndex;
-    range.layerCount = 1;
-    range.levelCount = 1;
-	range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    AVkImageUploadRequest request;
+    makeImageUploadRequest(level, arrayIndex, pitch, slicePitch, data, request);
 
-    VkSubresourceLayout layout;
-    VkBufferImageCopy copy;
-    computeBufferImageTransferLayout(level, &layout, &copy);
+    // Wait only for the batch that contains this upload.
+    auto &transferEngine = deviceForVk->getImageTransferEngine();
+    uint64_t serial = 0;
+    if(!transferEngine.uploadImageData(request, agpu::texture_ref(), serial))
+        return AGPU_ERROR;
 
-    copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copy.imageSubresource.mipLevel = level;
-    copy.imageSubresource.baseArrayLayer = arrayIndex;
-    copy.imageSubresource.layerCount = 1;
+    return transferEngine.waitFor(serial) ? AGPU_OK : AGPU_ERROR;
+}
 
-    agpu_error resultCode = AGPU_OK;
-    deviceForVk->withUploadCommandListDo(layout.size, 1, [&](AVkImplicitResourceUploadCommandList &uploadList) {
-        if(uploadList.currentStagingBufferSize < layout.size)
-        {
-            resultCode = AGPU_OUT_OF_MEMORY;
-            return;
-        }
+agpu_error AVkTexture::uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources)
+{
+    CHECK_POINTER(subresources);
+    if ((description.usage_modes & AGPU_TEXTURE_USAGE_UPLOADED) == 0)
+    {
+        return AGPU_INVALID_OPERATION;
+    }
 
-        // Copy the image data into the staging buffer.
-        auto bufferPointer = uploadList.currentStagingBufferPointer;
-        auto &extent = copy.imageExtent;
-        if (agpu_uint(pitch) == layout.rowPitch && agpu_uint(slicePitch) == layout.depthPitch && !sourceSize && !destRegion)
+    std::vector<AVkImageUploadRequest> requests(count);
+    VkImageSubresourceRange wholeRange = {};
+    wholeRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    wholeRange.baseMipLevel = description.miplevels;
+    wholeRange.baseArrayLayer = description.layers;
+    agpu_uint lastMipLevel = 0;
+    agpu_uint lastArrayLayer = 0;
+    for(agpu_uint i = 0; i < count; ++i)
+    {
+        auto &subresource = subresources[i];
+        CHECK_POINTER(subresource.data);
+        if(subresource.level >= description.miplevels || subresource.array_index >= description.layers)
+            return AGPU_OUT_OF_BOUNDS;
+
+        // A zero pitch selects tightly packed rows and slices.
+        auto pitch = subresource.pitch;
+        auto slicePitch = subresource.slice_pitch;
+        if(pitch == 0)
         {
-            memcpy(bufferPointer, data, slicePitch);
+            auto extent = getLevelExtent(subresource.level);
+            pitch = agpu_int(tightlyPackedPitchOfTextureFormat(description.format, extent.width));
+            if(slicePitch == 0)
+                slicePitch = agpu_int(pitch * tightlyPackedRowCountOfTextureFormat(description.format, extent.height));
         }
-        else
-        {
-            auto srcSlice = reinterpret_cast<uint8_t*> (data);
-            auto dstSlice = reinterpret_cast<uint8_t*> (bufferPointer);
-            auto absPitch = pitch < 0 ? -pitch : pitch;
-            auto rowCopySize = std::min(absPitch, agpu_int(layout.rowPitch));
-            for(uint32_t z = 0; z < extent.depth; ++z)
-            {
-                auto srcRow = srcSlice;
-                auto dstRow = dstSlice;
-                for (uint32_t y = 0; y < extent.height; ++y)
-                {
-                    memcpy(dstRow, srcRow, rowCopySize);
-                    srcRow += pitch;
-                    dstRow += layout.rowPitch;
-                }
 
-                srcSlice += slicePitch;
-                dstSlice += layout.depthPitch;
-            }
-        }
+        makeImageUploadRequest(subresource.level, subresource.array_index, pitch, slicePitch, subresource.data, requests[i]);
 
-        auto success = uploadList.setupCommandBuffer() &&
-            uploadList.transitionImageUsageMode(image, description.usage_modes, description.main_usage_mode, AGPU_TEXTURE_USAGE_COPY_DESTINATION, range) &&
-            uploadList.uploadBufferDataToImage(image, copy) &&
-            uploadList.transitionImageUsageMode(image, description.usage_modes, AGPU_TEXTURE_USAGE_COPY_DESTINATION, description.main_usage_mode, range) &&
-            uploadList.submitCommandBuffer();
-        resultCode = success ? AGPU_OK : AGPU_ERROR;
-    });
+        wholeRange.baseMipLevel = std::min(wholeRange.baseMipLevel, subresource.level);
+        wholeRange.baseArrayLayer = std::min(wholeRange.baseArrayLayer, subresource.array_index);
+        lastMipLevel = std::max(lastMipLevel, subresource.level);
+        lastArrayLayer = std::max(lastArrayLayer, subresource.array_index);
+    }
 
-    return resultCode;
+    if(count == 0)
+        return AGPU_OK;
+
+    wholeRange.levelCount = lastMipLevel - wholeRange.baseMipLevel + 1;
+    wholeRange.layerCount = lastArrayLayer - wholeRange.baseArrayLayer + 1;
+
+    // All of the subresources are recorded into the same batches, and we wait
+    // only for the last one of them.
+    auto &transferEngine = deviceForVk->getImageTransferEngine();
+    uint64_t serial = 0;
+    if(!transferEngine.uploadImageSubresources(requests.data(), requests.size(), wholeRange, agpu::texture_ref(), serial))
+        return AGPU_ERROR;
+
+    return transferEngine.waitFor(serial) ? AGPU_OK : AGPU_ERROR;
+}
+
+agpu::fence_ptr AVkTexture::uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data)
+{
+    if(!data || (description.usage_modes & AGPU_TEXTURE_USAGE_UPLOADED) == 0)
+        return nullptr;
+
+    AVkImageUploadRequest request;
+    makeImageUploadRequest(level, arrayIndex, pitch, slicePitch, data, request);
+
+    auto &transferEngine = deviceForVk->getImageTransferEngine();
+    uint64_t serial = 0;
+    if(!transferEngine.uploadImageData(request, refFromThis<agpu::texture> (), serial))
+        return nullptr;
+
+    return AVkFence::createForTransfer(device, &transferEngine, serial).disown();
+}
+
+void AVkTexture::makeImageUploadRequest(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data, AVkImageUploadRequest &request)
+{
+    VkSubresourceLayout layout;
+    computeBufferImageTransferLayout(level, &layout, &request.copy);
+    request.copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    request.copy.imageSubresource.mipLevel = level;
+    request.copy.imageSubresource.baseArrayLayer = arrayIndex;
+    request.copy.imageSubresource.layerCount = 1;
+
+    request.image = image;
+    request.range = {};
+    request.range.baseMipLevel = level;
+    request.range.baseArrayLayer = arrayIndex;
+    request.range.layerCount = 1;
+    request.range.levelCount = 1;
+    request.range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    request.allowedUsages = description.usage_modes;
+    request.mainUsage = description.main_usage_mode;
+
+    // The rows of the staging layout are rows of texel blocks.
+    request.rowPitch = size_t(layout.rowPitch);
+    request.rowCount = size_t(layout.depthPitch / layout.rowPitch);
+    request.rowHeight = std::max(uint32_t(texelHeight), 1u);
+    request.texelBlockSize = texelSize;
+
+    auto absPitch = pitch < 0 ? -pitch : pitch;
+    request.data = reinterpret_cast<const uint8_t*> (data);
+    request.sourcePitch = pitch;
+    request.sourceSlicePitch = slicePitch;
+    request.rowCopySize = std::min(size_t(absPitch), request.rowPitch);
 }
 
 } // End of namespace AgpuVulkan
@@ -23,6 +23,8 @@ public:
 	virtual agpu_error readTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer) override;
 	virtual agpu_error uploadTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
     virtual agpu_error uploadTextureSubData ( agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data ) override;
+    virtual agpu_error uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources) override;
+    virtual agpu::fence_ptr uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) override;
     virtual agpu::texture_view_ptr createView(agpu_texture_view_description* description) override;
 	virtual agpu::texture_view_ptr getOrCreateFullView() override;
 
@@ -39,6 +41,7 @@ public:
 
     VkExtent3D getLevelExtent(int level);
     void computeBufferImageTransferLayout(int level, VkSubresourceLayout *layout, VkBufferImageCopy *copy);
+    void makeImageUploadRequest(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data, AVkImageUploadRequest &request);
 };
 
 } // End of namespace AgpuVulkan
@@ -14,7 +14,7 @@ AVkTextureView::~AVkTextureView()
 
 agpu::texture_view_ref AVkTextureView::create(const agpu::device_ref &device, const agpu::texture_ref &texture, VkImageView handle, VkImageLayout imageLayout, const agpu_texture_view_description &description)
 {
-    auto result = agpu::makeObject<AVkTextureView> (device);
+    auto result = agpu::makePooledObject<AVkTextureView> (device);
     auto view = result.as<AVkTextureView> ();
     view->handle = handle;
     view->texture = texture;
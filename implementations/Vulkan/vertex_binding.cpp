@@ -15,7 +15,7 @@ AVkVertexBinding::~AVkVertexBinding()
 
 agpu::vertex_binding_ref AVkVertexBinding::create(const agpu::device_ref &device, const agpu::vertex_layout_ref &layout)
 {
-    return agpu::makeObject<AVkVertexBinding> (device);
+    return agpu::makePooledObject<AVkVertexBinding> (device);
 }
 
 agpu_error AVkVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_ref* vertex_buffers)
@@ -24,7 +24,7 @@ agpu_error AVkVertexBinding::bindVertexBuffers(agpu_uint count, agpu::buffer_ref
 }
 
 
-agpu_error AVkVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_size* offsets)
+agpu_error AVkVertexBinding::bindVertexBuffersWithOffsets(agpu_uint count, agpu::buffer_ref* vertex_buffers, agpu_device_size* offsets)
 {
     for (size_t i = 0; i < count; ++i)
     {
@@ -32,6 +32,7 @@ typedef unsigned int agpu_size;
 typedef int agpu_enum;
 typedef int agpu_bool;
 typedef unsigned long long agpu_ulong;
+typedef unsigned long long agpu_device_size;
 typedef float agpu_float;
 typedef double agpu_double;
 typedef unsigned int agpu_bitfield;
@@ -66,13 +67,16 @@ typedef struct _agpu_shader_signature_builder agpu_shader_signature_builder;
 typedef struct _agpu_shader_signature agpu_shader_signature;
 typedef struct _agpu_shader_resource_binding agpu_shader_resource_binding;
 typedef struct _agpu_fence agpu_fence;
+typedef struct _agpu_query_pool agpu_query_pool;
 typedef struct _agpu_offline_shader_compiler agpu_offline_shader_compiler;
+typedef struct _agpu_buffer_pool agpu_buffer_pool;
 typedef struct _agpu_state_tracker_cache agpu_state_tracker_cache;
 typedef struct _agpu_state_tracker agpu_state_tracker;
 typedef struct _agpu_immediate_renderer agpu_immediate_renderer;
 
 typedef enum {
 	AGPU_OK = 0,
+	AGPU_TIMEOUT = 1,
 	AGPU_ERROR = -1,
 	AGPU_NULL_POINTER = -2,
 	AGPU_INVALID_OPERATION = -3,
@@ -87,17 +91,20 @@ typedef enum {
 	AGPU_OUT_OF_MEMORY = -12,
 	AGPU_OUT_OF_DATE = -13,
 	AGPU_SUBOPTIMAL = -14,
+	AGPU_NOT_READY = -15,
 } agpu_error;
 
 typedef enum {
 	AGPU_DEVICE_OPEN_FLAG_NONE = 0,
 	AGPU_DEVICE_OPEN_FLAG_ALLOW_VR = 1,
+	AGPU_DEVICE_OPEN_FLAG_HEADLESS = 2,
 } agpu_device_open_flags;
 
 typedef enum {
 	AGPU_SWAP_CHAIN_FLAG_NONE = 0,
 	AGPU_SWAP_CHAIN_FLAG_OVERLAY_WINDOW = 1,
 	AGPU_SWAP_CHAIN_FLAG_APPLY_SCALE_FACTOR_FOR_HI_DPI = 2,
+	AGPU_SWAP_CHAIN_FLAG_HEADLESS = 4,
 } agpu_swap_chain_flags;
 
 typedef enum {
@@ -213,6 +220,9 @@ typedef enum {
 	AGPU_FEATURE_SHADER_INT_16 = 21,
 	AGPU_FEATURE_SAMPLE_SHADING = 22,
 	AGPU_FEATURE_FILL_MODE_NON_SOLID = 23,
+	AGPU_FEATURE_TIMESTAMP_QUERY = 24,
+	AGPU_FEATURE_PIPELINE_STATISTICS_QUERY = 25,
+	AGPU_FEATURE_COMMAND_QUEUE_TIMELINE = 26,
 } agpu_feature;
 
 typedef enum {
@@ -258,6 +268,31 @@ typedef enum {
 	AGPU_LIMIT_MIN_TEXTURE_DATA_PITCH_ALIGNMENT = 40,
 } agpu_limit;
 
+typedef enum {
+	AGPU_QUERY_TYPE_TIMESTAMP = 0,
+	AGPU_QUERY_TYPE_OCCLUSION = 1,
+	AGPU_QUERY_TYPE_PIPELINE_STATISTICS = 2,
+} agpu_query_type;
+
+typedef enum {
+	AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES = 1,
+	AGPU_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES = 2,
+	AGPU_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS = 4,
+	AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS = 8,
+	AGPU_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES = 16,
+	AGPU_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS = 32,
+	AGPU_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES = 64,
+	AGPU_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS = 128,
+	AGPU_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES = 256,
+	AGPU_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS = 512,
+	AGPU_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS = 1024,
+} agpu_pipeline_statistic_flags;
+
+typedef enum {
+	AGPU_QUERY_RESULT_WAIT = 1,
+	AGPU_QUERY_RESULT_WITH_AVAILABILITY = 2,
+} agpu_query_result_flags;
+
 typedef enum {
 	AGPU_ATTACHMENT_KEEP = 0,
 	AGPU_ATTACHMENT_CLEAR = 1,
@@ -753,6 +788,7 @@ typedef struct agpu_device_open_info {
 	agpu_uint engine_version;
 	agpu_int gpu_index;
 	agpu_device_open_flags open_flags;
+	agpu_cstring pipeline_cache_directory;
 } agpu_device_open_info;
 
 /* Structure agpu_swap_chain_create_info. */
@@ -779,7 +815,7 @@ typedef struct agpu_swap_chain_create_info {
 
 /* Structure agpu_buffer_description. */
 typedef struct agpu_buffer_description {
-	agpu_uint size;
+	agpu_device_size size;
 	agpu_memory_heap_type heap_type;
 	agpu_buffer_usage_mask usage_modes;
 	agpu_buffer_usage_mask main_usage_mode;
@@ -1011,7 +1047,7 @@ typedef struct agpu_region3d {
 
 /* Structure agpu_buffer_image_copy_region. */
 typedef struct agpu_buffer_image_copy_region {
-	agpu_size buffer_offset;
+	agpu_device_size buffer_offset;
 	agpu_size buffer_pitch;
 	agpu_size buffer_slice_pitch;
 	agpu_texture_usage_mode_mask texture_usage_mode;
@@ -1019,6 +1055,15 @@ typedef struct agpu_buffer_image_copy_region {
 	agpu_region3d texture_region;
 } agpu_buffer_image_copy_region;
 
+/* Structure agpu_texture_subresource_data. */
+typedef struct agpu_texture_subresource_data {
+	agpu_uint level;
+	agpu_uint array_index;
+	agpu_int pitch;
+	agpu_int slice_pitch;
+	agpu_pointer data;
+} agpu_texture_subresource_data;
+
 /* Structure agpu_image_copy_region. */
 typedef struct agpu_image_copy_region {
 	agpu_texture_usage_mode_mask source_usage_mode;
@@ -1030,6 +1075,13 @@ typedef struct agpu_image_copy_region {
 	agpu_size3d extent;
 } agpu_image_copy_region;
 
+/* Structure agpu_query_pool_description. */
+typedef struct agpu_query_pool_description {
+	agpu_query_type type;
+	agpu_uint query_count;
+	agpu_bitfield pipeline_statistics;
+} agpu_query_pool_description;
+
 /* Structure agpu_vr_tracked_device_pose. */
 typedef struct agpu_vr_tracked_device_pose {
 	agpu_uint device_id;
@@ -1194,6 +1246,16 @@ typedef union agpu_immediate_renderer_material {
 	agpu_immediate_renderer_material_flat_color flat_color;
 } agpu_immediate_renderer_material;
 
+/* Structure agpu_immediate_renderer_shader_variant. */
+typedef struct agpu_immediate_renderer_shader_variant {
+	agpu_bool flat_shading;
+	agpu_bool texturing_enabled;
+	agpu_bool tangent_space_enabled;
+	agpu_bool skinning_enabled;
+	agpu_bool lighting_enabled;
+	agpu_immediate_renderer_lighting_model lighting_model;
+} agpu_immediate_renderer_shader_variant;
+
 /* Global functions. */
 typedef agpu_error (*agpuGetPlatforms_FUN) (agpu_size numplatforms, agpu_platform** platforms, agpu_size* ret_numplatforms);
 
@@ -1232,6 +1294,7 @@ AGPU_EXPORT agpu_offline_shader_compiler* agpuCreateOfflineShaderCompiler(agpu_p
 typedef agpu_error (*agpuAddDeviceReference_FUN) (agpu_device* device);
 typedef agpu_error (*agpuReleaseDevice_FUN) (agpu_device* device);
 typedef agpu_command_queue* (*agpuGetDefaultCommandQueue_FUN) (agpu_device* device);
+typedef agpu_command_queue* (*agpuGetCommandQueue_FUN) (agpu_device* device, agpu_command_queue_type queue_type, agpu_uint index);
 typedef agpu_swap_chain* (*agpuCreateSwapChain_FUN) (agpu_device* device, agpu_command_queue* commandQueue, agpu_swap_chain_create_info* swapChainInfo);
 typedef agpu_buffer* (*agpuCreateBuffer_FUN) (agpu_device* device, agpu_buffer_description* description, agpu_pointer initial_data);
 typedef agpu_vertex_layout* (*agpuCreateVertexLayout_FUN) (agpu_device* device);
@@ -1250,6 +1313,8 @@ typedef agpu_renderpass* (*agpuCreateRenderPass_FUN) (agpu_device* device, agpu_
 typedef agpu_texture* (*agpuCreateTexture_FUN) (agpu_device* device, agpu_texture_description* description);
 typedef agpu_sampler* (*agpuCreateSampler_FUN) (agpu_device* device, agpu_sampler_description* description);
 typedef agpu_fence* (*agpuCreateFence_FUN) (agpu_device* device);
+typedef agpu_error (*agpuWaitForFences_FUN) (agpu_device* device, agpu_uint count, agpu_fence** fences, agpu_bool wait_all, agpu_ulong timeout_ns);
+typedef agpu_query_pool* (*agpuCreateQueryPool_FUN) (agpu_device* device, agpu_query_pool_description* description);
 typedef agpu_int (*agpuGetMultiSampleQualityLevels_FUN) (agpu_device* device, agpu_texture_format format, agpu_uint sample_count);
 typedef agpu_bool (*agpuHasTopLeftNdcOrigin_FUN) (agpu_device* device);
 typedef agpu_bool (*agpuHasBottomLeftTextureCoordinates_FUN) (agpu_device* device);
@@ -1261,11 +1326,14 @@ typedef agpu_vr_system* (*agpuGetVRSystem_FUN) (agpu_device* device);
 typedef agpu_window_scraper* (*agpuCreateWindowScraper_FUN) (agpu_device* device);
 typedef agpu_offline_shader_compiler* (*agpuCreateOfflineShaderCompilerForDevice_FUN) (agpu_device* device);
 typedef agpu_state_tracker_cache* (*agpuCreateStateTrackerCache_FUN) (agpu_device* device, agpu_command_queue* command_queue_family);
+typedef agpu_buffer_pool* (*agpuCreateBufferPool_FUN) (agpu_device* device, agpu_buffer_description* block_description, agpu_device_size alignment);
 typedef agpu_error (*agpuFinishDeviceExecution_FUN) (agpu_device* device);
+typedef agpu_error (*agpuFlushDevicePipelineCache_FUN) (agpu_device* device);
 
 AGPU_EXPORT agpu_error agpuAddDeviceReference(agpu_device* device);
 AGPU_EXPORT agpu_error agpuReleaseDevice(agpu_device* device);
 AGPU_EXPORT agpu_command_queue* agpuGetDefaultCommandQueue(agpu_device* device);
+AGPU_EXPORT agpu_command_queue* agpuGetCommandQueue(agpu_device* device, agpu_command_queue_type queue_type, agpu_uint index);
 AGPU_EXPORT agpu_swap_chain* agpuCreateSwapChain(agpu_device* device, agpu_command_queue* commandQueue, agpu_swap_chain_create_info* swapChainInfo);
 AGPU_EXPORT agpu_buffer* agpuCreateBuffer(agpu_device* device, agpu_buffer_description* description, agpu_pointer initial_data);
 AGPU_EXPORT agpu_vertex_layout* agpuCreateVertexLayout(agpu_device* device);
@@ -1284,6 +1352,8 @@ AGPU_EXPORT agpu_renderpass* agpuCreateRenderPass(agpu_device* device, agpu_rend
 AGPU_EXPORT agpu_texture* agpuCreateTexture(agpu_device* device, agpu_texture_description* description);
 AGPU_EXPORT agpu_sampler* agpuCreateSampler(agpu_device* device, agpu_sampler_description* description);
 AGPU_EXPORT agpu_fence* agpuCreateFence(agpu_device* device);
+AGPU_EXPORT agpu_error agpuWaitForFences(agpu_device* device, agpu_uint count, agpu_fence** fences, agpu_bool wait_all, agpu_ulong timeout_ns);
+AGPU_EXPORT agpu_query_pool* agpuCreateQueryPool(agpu_device* device, agpu_query_pool_description* description);
 AGPU_EXPORT agpu_int agpuGetMultiSampleQualityLevels(agpu_device* device, agpu_texture_format format, agpu_uint sample_count);
 AGPU_EXPORT agpu_bool agpuHasTopLeftNdcOrigin(agpu_device* device);
 AGPU_EXPORT agpu_bool agpuHasBottomLeftTextureCoordinates(agpu_device* device);
@@ -1295,7 +1365,9 @@ AGPU_EXPORT agpu_vr_system* agpuGetVRSystem(agpu_device* device);
 AGPU_EXPORT agpu_window_scraper* agpuCreateWindowScraper(agpu_device* device);
 AGPU_EXPORT agpu_offline_shader_compiler* agpuCreateOfflineShaderCompilerForDevice(agpu_device* device);
 AGPU_EXPORT agpu_state_tracker_cache* agpuCreateStateTrackerCache(agpu_device* device, agpu_command_queue* command_queue_family);
+AGPU_EXPORT agpu_buffer_pool* agpuCreateBufferPool(agpu_device* device, agpu_buffer_description* block_description, agpu_device_size alignment);
 AGPU_EXPORT agpu_error agpuFinishDeviceExecution(agpu_device* device);
+AGPU_EXPORT agpu_error agpuFlushDevicePipelineCache(agpu_device* device);
 
 /* Methods for interface agpu_vr_system. */
 typedef agpu_error (*agpuAddVRSystemReference_FUN) (agpu_vr_system* vr_system);
@@ -1380,6 +1452,7 @@ typedef agpu_uint (*agpuGetSwapChainWidth_FUN) (agpu_swap_chain* swap_chain);
 typedef agpu_uint (*agpuGetSwapChainHeight_FUN) (agpu_swap_chain* swap_chain);
 typedef agpu_uint (*agpuGetSwapChainLayerCount_FUN) (agpu_swap_chain* swap_chain);
 typedef agpu_error (*agpuSetSwapChainOverlayPosition_FUN) (agpu_swap_chain* swap_chain, agpu_int x, agpu_int y);
+typedef agpu_error (*agpuReadSwapChainPresentedFrame_FUN) (agpu_swap_chain* swap_chain, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer);
 
 AGPU_EXPORT agpu_error agpuAddSwapChainReference(agpu_swap_chain* swap_chain);
 AGPU_EXPORT agpu_error agpuReleaseSwapChain(agpu_swap_chain* swap_chain);
@@ -1392,6 +1465,7 @@ AGPU_EXPORT agpu_uint agpuGetSwapChainWidth(agpu_swap_chain* swap_chain);
 AGPU_EXPORT agpu_uint agpuGetSwapChainHeight(agpu_swap_chain* swap_chain);
 AGPU_EXPORT agpu_uint agpuGetSwapChainLayerCount(agpu_swap_chain* swap_chain);
 AGPU_EXPORT agpu_error agpuSetSwapChainOverlayPosition(agpu_swap_chain* swap_chain, agpu_int x, agpu_int y);
+AGPU_EXPORT agpu_error agpuReadSwapChainPresentedFrame(agpu_swap_chain* swap_chain, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer);
 
 /* Methods for interface agpu_compute_pipeline_builder. */
 typedef agpu_error (*agpuAddComputePipelineBuilderReference_FUN) (agpu_compute_pipeline_builder* compute_pipeline_builder);
@@ -1480,6 +1554,10 @@ typedef agpu_error (*agpuAddCommandListsAndSignalFence_FUN) (agpu_command_queue*
 typedef agpu_error (*agpuFinishQueueExecution_FUN) (agpu_command_queue* command_queue);
 typedef agpu_error (*agpuSignalFence_FUN) (agpu_command_queue* command_queue, agpu_fence* fence);
 typedef agpu_error (*agpuWaitFence_FUN) (agpu_command_queue* command_queue, agpu_fence* fence);
+typedef agpu_error (*agpuSignalQueueTimelineValue_FUN) (agpu_command_queue* command_queue, agpu_ulong value);
+typedef agpu_error (*agpuWaitQueueTimelineValue_FUN) (agpu_command_queue* command_queue, agpu_command_queue* source_queue, agpu_ulong value);
+typedef agpu_ulong (*agpuGetQueueCompletedTimelineValue_FUN) (agpu_command_queue* command_queue);
+typedef agpu_error (*agpuWaitQueueTimelineValueOnClient_FUN) (agpu_command_queue* command_queue, agpu_ulong value, agpu_ulong timeout_ns);
 
 AGPU_EXPORT agpu_error agpuAddCommandQueueReference(agpu_command_queue* command_queue);
 AGPU_EXPORT agpu_error agpuReleaseCommandQueue(agpu_command_queue* command_queue);
@@ -1488,6 +1566,10 @@ AGPU_EXPORT agpu_error agpuAddCommandListsAndSignalFence(agpu_command_queue* com
 AGPU_EXPORT agpu_error agpuFinishQueueExecution(agpu_command_queue* command_queue);
 AGPU_EXPORT agpu_error agpuSignalFence(agpu_command_queue* command_queue, agpu_fence* fence);
 AGPU_EXPORT agpu_error agpuWaitFence(agpu_command_queue* command_queue, agpu_fence* fence);
+AGPU_EXPORT agpu_error agpuSignalQueueTimelineValue(agpu_command_queue* command_queue, agpu_ulong value);
+AGPU_EXPORT agpu_error agpuWaitQueueTimelineValue(agpu_command_queue* command_queue, agpu_command_queue* source_queue, agpu_ulong value);
+AGPU_EXPORT agpu_ulong agpuGetQueueCompletedTimelineValue(agpu_command_queue* command_queue);
+AGPU_EXPORT agpu_error agpuWaitQueueTimelineValueOnClient(agpu_command_queue* command_queue, agpu_ulong value, agpu_ulong timeout_ns);
 
 /* Methods for interface agpu_command_allocator. */
 typedef agpu_error (*agpuAddCommandAllocatorReference_FUN) (agpu_command_allocator* command_allocator);
@@ -1507,7 +1589,7 @@ typedef agpu_error (*agpuSetScissor_FUN) (agpu_command_list* command_list, agpu_
 typedef agpu_error (*agpuUsePipelineState_FUN) (agpu_command_list* command_list, agpu_pipeline_state* pipeline);
 typedef agpu_error (*agpuUseVertexBinding_FUN) (agpu_command_list* command_list, agpu_vertex_binding* vertex_binding);
 typedef agpu_error (*agpuUseIndexBuffer_FUN) (agpu_command_list* command_list, agpu_buffer* index_buffer);
-typedef agpu_error (*agpuUseIndexBufferAt_FUN) (agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+typedef agpu_error (*agpuUseIndexBufferAt_FUN) (agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 typedef agpu_error (*agpuUseDrawIndirectBuffer_FUN) (agpu_command_list* command_list, agpu_buffer* draw_buffer);
 typedef agpu_error (*agpuUseComputeDispatchIndirectBuffer_FUN) (agpu_command_list* command_list, agpu_buffer* buffer);
 typedef agpu_error (*agpuUseShaderResources_FUN) (agpu_command_list* command_list, agpu_shader_resource_binding* binding);
@@ -1515,11 +1597,11 @@ typedef agpu_error (*agpuUseShaderResourcesInSlot_FUN) (agpu_command_list* comma
 typedef agpu_error (*agpuUseComputeShaderResources_FUN) (agpu_command_list* command_list, agpu_shader_resource_binding* binding);
 typedef agpu_error (*agpuUseComputeShaderResourcesInSlot_FUN) (agpu_command_list* command_list, agpu_shader_resource_binding* binding, agpu_uint slot);
 typedef agpu_error (*agpuDrawArrays_FUN) (agpu_command_list* command_list, agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance);
-typedef agpu_error (*agpuDrawArraysIndirect_FUN) (agpu_command_list* command_list, agpu_size offset, agpu_size drawcount);
+typedef agpu_error (*agpuDrawArraysIndirect_FUN) (agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount);
 typedef agpu_error (*agpuDrawElements_FUN) (agpu_command_list* command_list, agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance);
-typedef agpu_error (*agpuDrawElementsIndirect_FUN) (agpu_command_list* command_list, agpu_size offset, agpu_size drawcount);
+typedef agpu_error (*agpuDrawElementsIndirect_FUN) (agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount);
 typedef agpu_error (*agpuDispatchCompute_FUN) (agpu_command_list* command_list, agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z);
-typedef agpu_error (*agpuDispatchComputeIndirect_FUN) (agpu_command_list* command_list, agpu_size offset);
+typedef agpu_error (*agpuDispatchComputeIndirect_FUN) (agpu_command_list* command_list, agpu_device_size offset);
 typedef agpu_error (*agpuSetStencilReference_FUN) (agpu_command_list* command_list, agpu_uint reference);
 typedef agpu_error (*agpuExecuteBundle_FUN) (agpu_command_list* command_list, agpu_command_list* bundle);
 typedef agpu_error (*agpuCloseCommandList_FUN) (agpu_command_list* command_list);
@@ -1531,16 +1613,21 @@ typedef agpu_error (*agpuResolveFramebuffer_FUN) (agpu_command_list* command_lis
 typedef agpu_error (*agpuResolveTexture_FUN) (agpu_command_list* command_list, agpu_texture* sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, agpu_texture* destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect);
 typedef agpu_error (*agpuPushConstants_FUN) (agpu_command_list* command_list, agpu_uint offset, agpu_uint size, agpu_pointer values);
 typedef agpu_error (*agpuMemoryBarrier_FUN) (agpu_command_list* command_list, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses);
-typedef agpu_error (*agpuBufferMemoryBarrier_FUN) (agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size);
+typedef agpu_error (*agpuBufferMemoryBarrier_FUN) (agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size);
 typedef agpu_error (*agpuTextureMemoryBarrier_FUN) (agpu_command_list* command_list, agpu_texture* texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 typedef agpu_error (*agpuPushBufferTransitionBarrier_FUN) (agpu_command_list* command_list, agpu_buffer* buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage);
 typedef agpu_error (*agpuPushTextureTransitionBarrier_FUN) (agpu_command_list* command_list, agpu_texture* texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 typedef agpu_error (*agpuPopBufferTransitionBarrier_FUN) (agpu_command_list* command_list);
 typedef agpu_error (*agpuPopTextureTransitionBarrier_FUN) (agpu_command_list* command_list);
-typedef agpu_error (*agpuCopyBuffer_FUN) (agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size);
+typedef agpu_error (*agpuCopyBuffer_FUN) (agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size);
 typedef agpu_error (*agpuCopyBufferToTexture_FUN) (agpu_command_list* command_list, agpu_buffer* buffer, agpu_texture* texture, agpu_buffer_image_copy_region* copy_region);
 typedef agpu_error (*agpuCopyTextureToBuffer_FUN) (agpu_command_list* command_list, agpu_texture* texture, agpu_buffer* buffer, agpu_buffer_image_copy_region* copy_region);
 typedef agpu_error (*agpuCopyTexture_FUN) (agpu_command_list* command_list, agpu_texture* source_texture, agpu_texture* dest_texture, agpu_image_copy_region* copy_region);
+typedef agpu_error (*agpuGenerateMipmaps_FUN) (agpu_command_list* command_list, agpu_texture* texture);
+typedef agpu_error (*agpuResetQueryPool_FUN) (agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count);
+typedef agpu_error (*agpuWriteTimestamp_FUN) (agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
+typedef agpu_error (*agpuBeginQuery_FUN) (agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
+typedef agpu_error (*agpuEndQuery_FUN) (agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
 
 AGPU_EXPORT agpu_error agpuAddCommandListReference(agpu_command_list* command_list);
 AGPU_EXPORT agpu_error agpuReleaseCommandList(agpu_command_list* command_list);
@@ -1550,7 +1637,7 @@ AGPU_EXPORT agpu_error agpuSetScissor(agpu_command_list* command_list, agpu_int
 AGPU_EXPORT agpu_error agpuUsePipelineState(agpu_command_list* command_list, agpu_pipeline_state* pipeline);
 AGPU_EXPORT agpu_error agpuUseVertexBinding(agpu_command_list* command_list, agpu_vertex_binding* vertex_binding);
 AGPU_EXPORT agpu_error agpuUseIndexBuffer(agpu_command_list* command_list, agpu_buffer* index_buffer);
-AGPU_EXPORT agpu_error agpuUseIndexBufferAt(agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+AGPU_EXPORT agpu_error agpuUseIndexBufferAt(agpu_command_list* command_list, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 AGPU_EXPORT agpu_error agpuUseDrawIndirectBuffer(agpu_command_list* command_list, agpu_buffer* draw_buffer);
 AGPU_EXPORT agpu_error agpuUseComputeDispatchIndirectBuffer(agpu_command_list* command_list, agpu_buffer* buffer);
 AGPU_EXPORT agpu_error agpuUseShaderResources(agpu_command_list* command_list, agpu_shader_resource_binding* binding);
@@ -1558,11 +1645,11 @@ AGPU_EXPORT agpu_error agpuUseShaderResourcesInSlot(agpu_command_list* command_l
 AGPU_EXPORT agpu_error agpuUseComputeShaderResources(agpu_command_list* command_list, agpu_shader_resource_binding* binding);
 AGPU_EXPORT agpu_error agpuUseComputeShaderResourcesInSlot(agpu_command_list* command_list, agpu_shader_resource_binding* binding, agpu_uint slot);
 AGPU_EXPORT agpu_error agpuDrawArrays(agpu_command_list* command_list, agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance);
-AGPU_EXPORT agpu_error agpuDrawArraysIndirect(agpu_command_list* command_list, agpu_size offset, agpu_size drawcount);
+AGPU_EXPORT agpu_error agpuDrawArraysIndirect(agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount);
 AGPU_EXPORT agpu_error agpuDrawElements(agpu_command_list* command_list, agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance);
-AGPU_EXPORT agpu_error agpuDrawElementsIndirect(agpu_command_list* command_list, agpu_size offset, agpu_size drawcount);
+AGPU_EXPORT agpu_error agpuDrawElementsIndirect(agpu_command_list* command_list, agpu_device_size offset, agpu_size drawcount);
 AGPU_EXPORT agpu_error agpuDispatchCompute(agpu_command_list* command_list, agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z);
-AGPU_EXPORT agpu_error agpuDispatchComputeIndirect(agpu_command_list* command_list, agpu_size offset);
+AGPU_EXPORT agpu_error agpuDispatchComputeIndirect(agpu_command_list* command_list, agpu_device_size offset);
 AGPU_EXPORT agpu_error agpuSetStencilReference(agpu_command_list* command_list, agpu_uint reference);
 AGPU_EXPORT agpu_error agpuExecuteBundle(agpu_command_list* command_list, agpu_command_list* bundle);
 AGPU_EXPORT agpu_error agpuCloseCommandList(agpu_command_list* command_list);
@@ -1574,16 +1661,21 @@ AGPU_EXPORT agpu_error agpuResolveFramebuffer(agpu_command_list* command_list, a
 AGPU_EXPORT agpu_error agpuResolveTexture(agpu_command_list* command_list, agpu_texture* sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, agpu_texture* destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect);
 AGPU_EXPORT agpu_error agpuPushConstants(agpu_command_list* command_list, agpu_uint offset, agpu_uint size, agpu_pointer values);
 AGPU_EXPORT agpu_error agpuMemoryBarrier(agpu_command_list* command_list, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses);
-AGPU_EXPORT agpu_error agpuBufferMemoryBarrier(agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size);
+AGPU_EXPORT agpu_error agpuBufferMemoryBarrier(agpu_command_list* command_list, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size);
 AGPU_EXPORT agpu_error agpuTextureMemoryBarrier(agpu_command_list* command_list, agpu_texture* texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 AGPU_EXPORT agpu_error agpuPushBufferTransitionBarrier(agpu_command_list* command_list, agpu_buffer* buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage);
 AGPU_EXPORT agpu_error agpuPushTextureTransitionBarrier(agpu_command_list* command_list, agpu_texture* texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 AGPU_EXPORT agpu_error agpuPopBufferTransitionBarrier(agpu_command_list* command_list);
 AGPU_EXPORT agpu_error agpuPopTextureTransitionBarrier(agpu_command_list* command_list);
-AGPU_EXPORT agpu_error agpuCopyBuffer(agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size);
+AGPU_EXPORT agpu_error agpuCopyBuffer(agpu_command_list* command_list, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size);
 AGPU_EXPORT agpu_error agpuCopyBufferToTexture(agpu_command_list* command_list, agpu_buffer* buffer, agpu_texture* texture, agpu_buffer_image_copy_region* copy_region);
 AGPU_EXPORT agpu_error agpuCopyTextureToBuffer(agpu_command_list* command_list, agpu_texture* texture, agpu_buffer* buffer, agpu_buffer_image_copy_region* copy_region);
 AGPU_EXPORT agpu_error agpuCopyTexture(agpu_command_list* command_list, agpu_texture* source_texture, agpu_texture* dest_texture, agpu_image_copy_region* copy_region);
+AGPU_EXPORT agpu_error agpuGenerateMipmaps(agpu_command_list* command_list, agpu_texture* texture);
+AGPU_EXPORT agpu_error agpuResetQueryPool(agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count);
+AGPU_EXPORT agpu_error agpuWriteTimestamp(agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
+AGPU_EXPORT agpu_error agpuBeginQuery(agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
+AGPU_EXPORT agpu_error agpuEndQuery(agpu_command_list* command_list, agpu_query_pool* query_pool, agpu_uint query_index);
 
 /* Methods for interface agpu_texture. */
 typedef agpu_error (*agpuAddTextureReference_FUN) (agpu_texture* texture);
@@ -1594,7 +1686,9 @@ typedef agpu_error (*agpuUnmapTextureLevel_FUN) (agpu_texture* texture);
 typedef agpu_error (*agpuReadTextureData_FUN) (agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer);
 typedef agpu_error (*agpuReadTextureSubData_FUN) (agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer);
 typedef agpu_error (*agpuUploadTextureData_FUN) (agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data);
+typedef agpu_fence* (*agpuUploadTextureDataAsynchronously_FUN) (agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data);
 typedef agpu_error (*agpuUploadTextureSubData_FUN) (agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data);
+typedef agpu_error (*agpuUploadTextureSubresources_FUN) (agpu_texture* texture, agpu_uint count, agpu_texture_subresource_data* subresources);
 typedef agpu_error (*agpuGetTextureFullViewDescription_FUN) (agpu_texture* texture, agpu_texture_view_description* result);
 typedef agpu_texture_view* (*agpuCreateTextureView_FUN) (agpu_texture* texture, agpu_texture_view_description* description);
 typedef agpu_texture_view* (*agpuGetOrCreateFullTextureView_FUN) (agpu_texture* texture);
@@ -1607,7 +1701,9 @@ AGPU_EXPORT agpu_error agpuUnmapTextureLevel(agpu_texture* texture);
 AGPU_EXPORT agpu_error agpuReadTextureData(agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer);
 AGPU_EXPORT agpu_error agpuReadTextureSubData(agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer);
 AGPU_EXPORT agpu_error agpuUploadTextureData(agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data);
+AGPU_EXPORT agpu_fence* agpuUploadTextureDataAsynchronously(agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data);
 AGPU_EXPORT agpu_error agpuUploadTextureSubData(agpu_texture* texture, agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data);
+AGPU_EXPORT agpu_error agpuUploadTextureSubresources(agpu_texture* texture, agpu_uint count, agpu_texture_subresource_data* subresources);
 AGPU_EXPORT agpu_error agpuGetTextureFullViewDescription(agpu_texture* texture, agpu_texture_view_description* result);
 AGPU_EXPORT agpu_texture_view* agpuCreateTextureView(agpu_texture* texture, agpu_texture_view_description* description);
 AGPU_EXPORT agpu_texture_view* agpuGetOrCreateFullTextureView(agpu_texture* texture);
@@ -1634,8 +1730,9 @@ typedef agpu_error (*agpuReleaseBuffer_FUN) (agpu_buffer* buffer);
 typedef agpu_pointer (*agpuMapBuffer_FUN) (agpu_buffer* buffer, agpu_mapping_access flags);
 typedef agpu_error (*agpuUnmapBuffer_FUN) (agpu_buffer* buffer);
 typedef agpu_error (*agpuGetBufferDescription_FUN) (agpu_buffer* buffer, agpu_buffer_description* description);
-typedef agpu_error (*agpuUploadBufferData_FUN) (agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data);
-typedef agpu_error (*agpuReadBufferData_FUN) (agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data);
+typedef agpu_error (*agpuUploadBufferData_FUN) (agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
+typedef agpu_fence* (*agpuUploadBufferDataAsynchronously_FUN) (agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
+typedef agpu_error (*agpuReadBufferData_FUN) (agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
 typedef agpu_error (*agpuFlushWholeBuffer_FUN) (agpu_buffer* buffer);
 typedef agpu_error (*agpuInvalidateWholeBuffer_FUN) (agpu_buffer* buffer);
 
@@ -1644,8 +1741,9 @@ AGPU_EXPORT agpu_error agpuReleaseBuffer(agpu_buffer* buffer);
 AGPU_EXPORT agpu_pointer agpuMapBuffer(agpu_buffer* buffer, agpu_mapping_access flags);
 AGPU_EXPORT agpu_error agpuUnmapBuffer(agpu_buffer* buffer);
 AGPU_EXPORT agpu_error agpuGetBufferDescription(agpu_buffer* buffer, agpu_buffer_description* description);
-AGPU_EXPORT agpu_error agpuUploadBufferData(agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data);
-AGPU_EXPORT agpu_error agpuReadBufferData(agpu_buffer* buffer, agpu_size offset, agpu_size size, agpu_pointer data);
+AGPU_EXPORT agpu_error agpuUploadBufferData(agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
+AGPU_EXPORT agpu_fence* agpuUploadBufferDataAsynchronously(agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
+AGPU_EXPORT agpu_error agpuReadBufferData(agpu_buffer* buffer, agpu_device_size offset, agpu_device_size size, agpu_pointer data);
 AGPU_EXPORT agpu_error agpuFlushWholeBuffer(agpu_buffer* buffer);
 AGPU_EXPORT agpu_error agpuInvalidateWholeBuffer(agpu_buffer* buffer);
 
@@ -1653,12 +1751,12 @@ AGPU_EXPORT agpu_error agpuInvalidateWholeBuffer(agpu_buffer* buffer);
 typedef agpu_error (*agpuAddVertexBindingReference_FUN) (agpu_vertex_binding* vertex_binding);
 typedef agpu_error (*agpuReleaseVertexBinding_FUN) (agpu_vertex_binding* vertex_binding);
 typedef agpu_error (*agpuBindVertexBuffers_FUN) (agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers);
-typedef agpu_error (*agpuBindVertexBuffersWithOffsets_FUN) (agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_size* offsets);
+typedef agpu_error (*agpuBindVertexBuffersWithOffsets_FUN) (agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_device_size* offsets);
 
 AGPU_EXPORT agpu_error agpuAddVertexBindingReference(agpu_vertex_binding* vertex_binding);
 AGPU_EXPORT agpu_error agpuReleaseVertexBinding(agpu_vertex_binding* vertex_binding);
 AGPU_EXPORT agpu_error agpuBindVertexBuffers(agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers);
-AGPU_EXPORT agpu_error agpuBindVertexBuffersWithOffsets(agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_size* offsets);
+AGPU_EXPORT agpu_error agpuBindVertexBuffersWithOffsets(agpu_vertex_binding* vertex_binding, agpu_uint count, agpu_buffer** vertex_buffers, agpu_device_size* offsets);
 
 /* Methods for interface agpu_vertex_layout. */
 typedef agpu_error (*agpuAddVertexLayoutReference_FUN) (agpu_vertex_layout* vertex_layout);
@@ -1739,18 +1837,20 @@ AGPU_EXPORT agpu_error agpuAddShaderSignatureBindingBankArray(agpu_shader_signat
 typedef agpu_error (*agpuAddShaderSignature_FUN) (agpu_shader_signature* shader_signature);
 typedef agpu_error (*agpuReleaseShaderSignature_FUN) (agpu_shader_signature* shader_signature);
 typedef agpu_shader_resource_binding* (*agpuCreateShaderResourceBinding_FUN) (agpu_shader_signature* shader_signature, agpu_uint element);
+typedef agpu_shader_resource_binding* (*agpuCreateTransientShaderResourceBinding_FUN) (agpu_shader_signature* shader_signature, agpu_uint element);
 
 AGPU_EXPORT agpu_error agpuAddShaderSignature(agpu_shader_signature* shader_signature);
 AGPU_EXPORT agpu_error agpuReleaseShaderSignature(agpu_shader_signature* shader_signature);
 AGPU_EXPORT agpu_shader_resource_binding* agpuCreateShaderResourceBinding(agpu_shader_signature* shader_signature, agpu_uint element);
+AGPU_EXPORT agpu_shader_resource_binding* agpuCreateTransientShaderResourceBinding(agpu_shader_signature* shader_signature, agpu_uint element);
 
 /* Methods for interface agpu_shader_resource_binding. */
 typedef agpu_error (*agpuAddShaderResourceBindingReference_FUN) (agpu_shader_resource_binding* shader_resource_binding);
 typedef agpu_error (*agpuReleaseShaderResourceBinding_FUN) (agpu_shader_resource_binding* shader_resource_binding);
 typedef agpu_error (*agpuBindUniformBuffer_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer);
-typedef agpu_error (*agpuBindUniformBufferRange_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_size offset, agpu_size size);
+typedef agpu_error (*agpuBindUniformBufferRange_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_device_size offset, agpu_device_size size);
 typedef agpu_error (*agpuBindStorageBuffer_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer);
-typedef agpu_error (*agpuBindStorageBufferRange_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_size offset, agpu_size size);
+typedef agpu_error (*agpuBindStorageBufferRange_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_device_size offset, agpu_device_size size);
 typedef agpu_error (*agpuBindSampledTextureView_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_texture_view* view);
 typedef agpu_error (*agpuBindArrayOfSampledTextureView_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_int first_index, agpu_uint count, agpu_texture_view** views);
 typedef agpu_error (*agpuBindStorageImageView_FUN) (agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_texture_view* view);
@@ -1759,9 +1859,9 @@ typedef agpu_error (*agpuBindSampler_FUN) (agpu_shader_resource_binding* shader_
 AGPU_EXPORT agpu_error agpuAddShaderResourceBindingReference(agpu_shader_resource_binding* shader_resource_binding);
 AGPU_EXPORT agpu_error agpuReleaseShaderResourceBinding(agpu_shader_resource_binding* shader_resource_binding);
 AGPU_EXPORT agpu_error agpuBindUniformBuffer(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer);
-AGPU_EXPORT agpu_error agpuBindUniformBufferRange(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_size offset, agpu_size size);
+AGPU_EXPORT agpu_error agpuBindUniformBufferRange(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* uniform_buffer, agpu_device_size offset, agpu_device_size size);
 AGPU_EXPORT agpu_error agpuBindStorageBuffer(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer);
-AGPU_EXPORT agpu_error agpuBindStorageBufferRange(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_size offset, agpu_size size);
+AGPU_EXPORT agpu_error agpuBindStorageBufferRange(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_buffer* storage_buffer, agpu_device_size offset, agpu_device_size size);
 AGPU_EXPORT agpu_error agpuBindSampledTextureView(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_texture_view* view);
 AGPU_EXPORT agpu_error agpuBindArrayOfSampledTextureView(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_int first_index, agpu_uint count, agpu_texture_view** views);
 AGPU_EXPORT agpu_error agpuBindStorageImageView(agpu_shader_resource_binding* shader_resource_binding, agpu_int location, agpu_texture_view* view);
@@ -1771,10 +1871,29 @@ AGPU_EXPORT agpu_error agpuBindSampler(agpu_shader_resource_binding* shader_reso
 typedef agpu_error (*agpuAddFenceReference_FUN) (agpu_fence* fence);
 typedef agpu_error (*agpuReleaseFenceReference_FUN) (agpu_fence* fence);
 typedef agpu_error (*agpuWaitOnClient_FUN) (agpu_fence* fence);
+typedef agpu_bool (*agpuIsFenceSignaled_FUN) (agpu_fence* fence);
+typedef agpu_error (*agpuWaitFenceWithTimeout_FUN) (agpu_fence* fence, agpu_ulong timeout_ns);
 
 AGPU_EXPORT agpu_error agpuAddFenceReference(agpu_fence* fence);
 AGPU_EXPORT agpu_error agpuReleaseFenceReference(agpu_fence* fence);
 AGPU_EXPORT agpu_error agpuWaitOnClient(agpu_fence* fence);
+AGPU_EXPORT agpu_bool agpuIsFenceSignaled(agpu_fence* fence);
+AGPU_EXPORT agpu_error agpuWaitFenceWithTimeout(agpu_fence* fence, agpu_ulong timeout_ns);
+
+/* Methods for interface agpu_query_pool. */
+typedef agpu_error (*agpuAddQueryPoolReference_FUN) (agpu_query_pool* query_pool);
+typedef agpu_error (*agpuReleaseQueryPool_FUN) (agpu_query_pool* query_pool);
+typedef agpu_error (*agpuGetQueryPoolDescription_FUN) (agpu_query_pool* query_pool, agpu_query_pool_description* description);
+typedef agpu_uint (*agpuGetQueryPoolResultValueCount_FUN) (agpu_query_pool* query_pool);
+typedef agpu_float (*agpuGetQueryPoolTimestampPeriod_FUN) (agpu_query_pool* query_pool);
+typedef agpu_error (*agpuGetQueryPoolResults_FUN) (agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags);
+
+AGPU_EXPORT agpu_error agpuAddQueryPoolReference(agpu_query_pool* query_pool);
+AGPU_EXPORT agpu_error agpuReleaseQueryPool(agpu_query_pool* query_pool);
+AGPU_EXPORT agpu_error agpuGetQueryPoolDescription(agpu_query_pool* query_pool, agpu_query_pool_description* description);
+AGPU_EXPORT agpu_uint agpuGetQueryPoolResultValueCount(agpu_query_pool* query_pool);
+AGPU_EXPORT agpu_float agpuGetQueryPoolTimestampPeriod(agpu_query_pool* query_pool);
+AGPU_EXPORT agpu_error agpuGetQueryPoolResults(agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags);
 
 /* Methods for interface agpu_offline_shader_compiler. */
 typedef agpu_error (*agpuAddOfflineShaderCompilerReference_FUN) (agpu_offline_shader_compiler* offline_shader_compiler);
@@ -1801,6 +1920,19 @@ AGPU_EXPORT agpu_size agpuGetOfflineShaderCompilationResultLength(agpu_offline_s
 AGPU_EXPORT agpu_error agpuGetOfflineShaderCompilationResult(agpu_offline_shader_compiler* offline_shader_compiler, agpu_size buffer_size, agpu_string_buffer buffer);
 AGPU_EXPORT agpu_shader* agpuGetOfflineShaderCompilerResultAsShader(agpu_offline_shader_compiler* offline_shader_compiler);
 
+/* Methods for interface agpu_buffer_pool. */
+typedef agpu_error (*agpuAddBufferPoolReference_FUN) (agpu_buffer_pool* buffer_pool);
+typedef agpu_error (*agpuReleaseBufferPool_FUN) (agpu_buffer_pool* buffer_pool);
+typedef agpu_buffer* (*agpuAllocateBufferPoolRange_FUN) (agpu_buffer_pool* buffer_pool, agpu_device_size size, agpu_device_size* offset);
+typedef agpu_error (*agpuFreeBufferPoolRange_FUN) (agpu_buffer_pool* buffer_pool, agpu_buffer* buffer, agpu_device_size offset);
+typedef agpu_device_size (*agpuGetBufferPoolAlignment_FUN) (agpu_buffer_pool* buffer_pool);
+
+AGPU_EXPORT agpu_error agpuAddBufferPoolReference(agpu_buffer_pool* buffer_pool);
+AGPU_EXPORT agpu_error agpuReleaseBufferPool(agpu_buffer_pool* buffer_pool);
+AGPU_EXPORT agpu_buffer* agpuAllocateBufferPoolRange(agpu_buffer_pool* buffer_pool, agpu_device_size size, agpu_device_size* offset);
+AGPU_EXPORT agpu_error agpuFreeBufferPoolRange(agpu_buffer_pool* buffer_pool, agpu_buffer* buffer, agpu_device_size offset);
+AGPU_EXPORT agpu_device_size agpuGetBufferPoolAlignment(agpu_buffer_pool* buffer_pool);
+
 /* Methods for interface agpu_state_tracker_cache. */
 typedef agpu_error (*agpuAddStateTrackerCacheReference_FUN) (agpu_state_tracker_cache* state_tracker_cache);
 typedef agpu_error (*agpuReleaseStateTrackerCacheReference_FUN) (agpu_state_tracker_cache* state_tracker_cache);
@@ -1808,6 +1940,16 @@ typedef agpu_state_tracker* (*agpuCreateStateTracker_FUN) (agpu_state_tracker_ca
 typedef agpu_state_tracker* (*agpuCreateStateTrackerWithCommandAllocator_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_command_list_type type, agpu_command_queue* command_queue, agpu_command_allocator* command_allocator);
 typedef agpu_state_tracker* (*agpuCreateStateTrackerWithFrameBuffering_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_command_list_type type, agpu_command_queue* command_queue, agpu_uint framebuffering_count);
 typedef agpu_immediate_renderer* (*agpuCreateImmediateRenderer_FUN) (agpu_state_tracker_cache* state_tracker_cache);
+typedef agpu_error (*agpuStateTrackerCacheRegisterManifestShader_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_shader* shader, agpu_pointer content, agpu_size content_size);
+typedef agpu_error (*agpuStateTrackerCacheRegisterManifestShaderSignature_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_shader_signature* shader_signature, agpu_cstring key);
+typedef agpu_error (*agpuStateTrackerCacheRegisterManifestVertexLayout_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_vertex_layout* vertex_layout, agpu_cstring key);
+typedef agpu_error (*agpuStateTrackerCacheSavePipelineManifest_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name);
+typedef agpu_error (*agpuStateTrackerCacheLoadPipelineManifest_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name, agpu_uint worker_count);
+typedef agpu_error (*agpuStateTrackerCacheWaitForPipelineManifestReplay_FUN) (agpu_state_tracker_cache* state_tracker_cache);
+typedef agpu_ulong (*agpuStateTrackerCacheGetPipelineManifestHitCount_FUN) (agpu_state_tracker_cache* state_tracker_cache);
+typedef agpu_ulong (*agpuStateTrackerCacheGetPipelineManifestMissCount_FUN) (agpu_state_tracker_cache* state_tracker_cache);
+typedef agpu_error (*agpuStateTrackerCacheSetShaderCacheDirectory_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_cstring directory);
+typedef agpu_error (*agpuStateTrackerCachePrecompileImmediateRendererShaderVariants_FUN) (agpu_state_tracker_cache* state_tracker_cache, agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count);
 
 AGPU_EXPORT agpu_error agpuAddStateTrackerCacheReference(agpu_state_tracker_cache* state_tracker_cache);
 AGPU_EXPORT agpu_error agpuReleaseStateTrackerCacheReference(agpu_state_tracker_cache* state_tracker_cache);
@@ -1815,6 +1957,16 @@ AGPU_EXPORT agpu_state_tracker* agpuCreateStateTracker(agpu_state_tracker_cache*
 AGPU_EXPORT agpu_state_tracker* agpuCreateStateTrackerWithCommandAllocator(agpu_state_tracker_cache* state_tracker_cache, agpu_command_list_type type, agpu_command_queue* command_queue, agpu_command_allocator* command_allocator);
 AGPU_EXPORT agpu_state_tracker* agpuCreateStateTrackerWithFrameBuffering(agpu_state_tracker_cache* state_tracker_cache, agpu_command_list_type type, agpu_command_queue* command_queue, agpu_uint framebuffering_count);
 AGPU_EXPORT agpu_immediate_renderer* agpuCreateImmediateRenderer(agpu_state_tracker_cache* state_tracker_cache);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestShader(agpu_state_tracker_cache* state_tracker_cache, agpu_shader* shader, agpu_pointer content, agpu_size content_size);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestShaderSignature(agpu_state_tracker_cache* state_tracker_cache, agpu_shader_signature* shader_signature, agpu_cstring key);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheRegisterManifestVertexLayout(agpu_state_tracker_cache* state_tracker_cache, agpu_vertex_layout* vertex_layout, agpu_cstring key);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheSavePipelineManifest(agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheLoadPipelineManifest(agpu_state_tracker_cache* state_tracker_cache, agpu_cstring file_name, agpu_uint worker_count);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheWaitForPipelineManifestReplay(agpu_state_tracker_cache* state_tracker_cache);
+AGPU_EXPORT agpu_ulong agpuStateTrackerCacheGetPipelineManifestHitCount(agpu_state_tracker_cache* state_tracker_cache);
+AGPU_EXPORT agpu_ulong agpuStateTrackerCacheGetPipelineManifestMissCount(agpu_state_tracker_cache* state_tracker_cache);
+AGPU_EXPORT agpu_error agpuStateTrackerCacheSetShaderCacheDirectory(agpu_state_tracker_cache* state_tracker_cache, agpu_cstring directory);
+AGPU_EXPORT agpu_error agpuStateTrackerCachePrecompileImmediateRendererShaderVariants(agpu_state_tracker_cache* state_tracker_cache, agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count);
 
 /* Methods for interface agpu_state_tracker. */
 typedef agpu_error (*agpuAddStateTrackerReference_FUN) (agpu_state_tracker* state_tracker);
@@ -1856,7 +2008,7 @@ typedef agpu_error (*agpuStateTrackerSetViewport_FUN) (agpu_state_tracker* state
 typedef agpu_error (*agpuStateTrackerSetScissor_FUN) (agpu_state_tracker* state_tracker, agpu_int x, agpu_int y, agpu_int w, agpu_int h);
 typedef agpu_error (*agpuStateTrackerUseVertexBinding_FUN) (agpu_state_tracker* state_tracker, agpu_vertex_binding* vertex_binding);
 typedef agpu_error (*agpuStateTrackerUseIndexBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* index_buffer);
-typedef agpu_error (*agpuStateTrackerUseIndexBufferAt_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+typedef agpu_error (*agpuStateTrackerUseIndexBufferAt_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 typedef agpu_error (*agpuStateTrackerUseDrawIndirectBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* draw_buffer);
 typedef agpu_error (*agpuStateTrackerUseComputeDispatchIndirectBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* buffer);
 typedef agpu_error (*agpuStateTrackerUseShaderResources_FUN) (agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding);
@@ -1864,11 +2016,11 @@ typedef agpu_error (*agpuStateTrackerUseShaderResourcesInSlot_FUN) (agpu_state_t
 typedef agpu_error (*agpuStateTrackerUseComputeShaderResources_FUN) (agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding);
 typedef agpu_error (*agpuStateTrackerUseComputeShaderResourcesInSlot_FUN) (agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding, agpu_uint slot);
 typedef agpu_error (*agpuStateTrackerDrawArrays_FUN) (agpu_state_tracker* state_tracker, agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance);
-typedef agpu_error (*agpuStateTrackerDrawArraysIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount);
+typedef agpu_error (*agpuStateTrackerDrawArraysIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount);
 typedef agpu_error (*agpuStateTrackerDrawElements_FUN) (agpu_state_tracker* state_tracker, agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance);
-typedef agpu_error (*agpuStateTrackerDrawElementsIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount);
+typedef agpu_error (*agpuStateTrackerDrawElementsIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount);
 typedef agpu_error (*agpuStateTrackerDispatchCompute_FUN) (agpu_state_tracker* state_tracker, agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z);
-typedef agpu_error (*agpuStateTrackerDispatchComputeIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_size offset);
+typedef agpu_error (*agpuStateTrackerDispatchComputeIndirect_FUN) (agpu_state_tracker* state_tracker, agpu_device_size offset);
 typedef agpu_error (*agpuStateTrackerSetStencilReference_FUN) (agpu_state_tracker* state_tracker, agpu_uint reference);
 typedef agpu_error (*agpuStateTrackerExecuteBundle_FUN) (agpu_state_tracker* state_tracker, agpu_command_list* bundle);
 typedef agpu_error (*agpuStateTrackerBeginRenderPass_FUN) (agpu_state_tracker* state_tracker, agpu_renderpass* renderpass, agpu_framebuffer* framebuffer, agpu_bool bundle_content);
@@ -1877,16 +2029,25 @@ typedef agpu_error (*agpuStateTrackerResolveFramebuffer_FUN) (agpu_state_tracker
 typedef agpu_error (*agpuStateTrackerResolveTexture_FUN) (agpu_state_tracker* state_tracker, agpu_texture* sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, agpu_texture* destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect);
 typedef agpu_error (*agpuStateTrackerPushConstants_FUN) (agpu_state_tracker* state_tracker, agpu_uint offset, agpu_uint size, agpu_pointer values);
 typedef agpu_error (*agpuStateTrackerMemoryBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses);
-typedef agpu_error (*agpuStateTrackerBufferMemoryBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size);
+typedef agpu_error (*agpuStateTrackerBufferMemoryBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size);
 typedef agpu_error (*agpuStateTrackerTextureMemoryBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 typedef agpu_error (*agpuStateTrackerPushBufferTransitionBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage);
 typedef agpu_error (*agpuStateTrackerPushTextureTransitionBarrier_FUN) (agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 typedef agpu_error (*agpuStateTrackerPopBufferTransitionBarrier_FUN) (agpu_state_tracker* state_tracker);
 typedef agpu_error (*agpuStateTrackerPopTextureTransitionBarrier_FUN) (agpu_state_tracker* state_tracker);
-typedef agpu_error (*agpuStateTrackerCopyBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size);
+typedef agpu_error (*agpuStateTrackerCopyBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size);
 typedef agpu_error (*agpuStateTrackerCopyBufferToTexture_FUN) (agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_texture* texture, agpu_buffer_image_copy_region* copy_region);
 typedef agpu_error (*agpuStateTrackerCopyTextureToBuffer_FUN) (agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_buffer* buffer, agpu_buffer_image_copy_region* copy_region);
 typedef agpu_error (*agpuStateTrackerCopyTexture_FUN) (agpu_state_tracker* state_tracker, agpu_texture* source_texture, agpu_texture* dest_texture, agpu_image_copy_region* copy_region);
+typedef agpu_error (*agpuStateTrackerGenerateMipmaps_FUN) (agpu_state_tracker* state_tracker, agpu_texture* texture);
+typedef agpu_error (*agpuStateTrackerSetAsynchronousPipelineCompilation_FUN) (agpu_state_tracker* state_tracker, agpu_bool enabled);
+typedef agpu_error (*agpuStateTrackerSetFallbackGraphicsPipeline_FUN) (agpu_state_tracker* state_tracker, agpu_pipeline_state* pipeline);
+typedef agpu_ulong (*agpuStateTrackerGetDeferredDrawCount_FUN) (agpu_state_tracker* state_tracker);
+typedef agpu_ulong (*agpuStateTrackerGetSkippedDrawCount_FUN) (agpu_state_tracker* state_tracker);
+typedef agpu_error (*agpuStateTrackerResetQueryPool_FUN) (agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count);
+typedef agpu_error (*agpuStateTrackerWriteTimestamp_FUN) (agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
+typedef agpu_error (*agpuStateTrackerBeginQuery_FUN) (agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
+typedef agpu_error (*agpuStateTrackerEndQuery_FUN) (agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
 
 AGPU_EXPORT agpu_error agpuAddStateTrackerReference(agpu_state_tracker* state_tracker);
 AGPU_EXPORT agpu_error agpuReleaseStateTrackerReference(agpu_state_tracker* state_tracker);
@@ -1927,7 +2088,7 @@ AGPU_EXPORT agpu_error agpuStateTrackerSetViewport(agpu_state_tracker* state_tra
 AGPU_EXPORT agpu_error agpuStateTrackerSetScissor(agpu_state_tracker* state_tracker, agpu_int x, agpu_int y, agpu_int w, agpu_int h);
 AGPU_EXPORT agpu_error agpuStateTrackerUseVertexBinding(agpu_state_tracker* state_tracker, agpu_vertex_binding* vertex_binding);
 AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBuffer(agpu_state_tracker* state_tracker, agpu_buffer* index_buffer);
-AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBufferAt(agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+AGPU_EXPORT agpu_error agpuStateTrackerUseIndexBufferAt(agpu_state_tracker* state_tracker, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 AGPU_EXPORT agpu_error agpuStateTrackerUseDrawIndirectBuffer(agpu_state_tracker* state_tracker, agpu_buffer* draw_buffer);
 AGPU_EXPORT agpu_error agpuStateTrackerUseComputeDispatchIndirectBuffer(agpu_state_tracker* state_tracker, agpu_buffer* buffer);
 AGPU_EXPORT agpu_error agpuStateTrackerUseShaderResources(agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding);
@@ -1935,11 +2096,11 @@ AGPU_EXPORT agpu_error agpuStateTrackerUseShaderResourcesInSlot(agpu_state_track
 AGPU_EXPORT agpu_error agpuStateTrackerUseComputeShaderResources(agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding);
 AGPU_EXPORT agpu_error agpuStateTrackerUseComputeShaderResourcesInSlot(agpu_state_tracker* state_tracker, agpu_shader_resource_binding* binding, agpu_uint slot);
 AGPU_EXPORT agpu_error agpuStateTrackerDrawArrays(agpu_state_tracker* state_tracker, agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance);
-AGPU_EXPORT agpu_error agpuStateTrackerDrawArraysIndirect(agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount);
+AGPU_EXPORT agpu_error agpuStateTrackerDrawArraysIndirect(agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount);
 AGPU_EXPORT agpu_error agpuStateTrackerDrawElements(agpu_state_tracker* state_tracker, agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance);
-AGPU_EXPORT agpu_error agpuStateTrackerDrawElementsIndirect(agpu_state_tracker* state_tracker, agpu_size offset, agpu_size drawcount);
+AGPU_EXPORT agpu_error agpuStateTrackerDrawElementsIndirect(agpu_state_tracker* state_tracker, agpu_device_size offset, agpu_size drawcount);
 AGPU_EXPORT agpu_error agpuStateTrackerDispatchCompute(agpu_state_tracker* state_tracker, agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z);
-AGPU_EXPORT agpu_error agpuStateTrackerDispatchComputeIndirect(agpu_state_tracker* state_tracker, agpu_size offset);
+AGPU_EXPORT agpu_error agpuStateTrackerDispatchComputeIndirect(agpu_state_tracker* state_tracker, agpu_device_size offset);
 AGPU_EXPORT agpu_error agpuStateTrackerSetStencilReference(agpu_state_tracker* state_tracker, agpu_uint reference);
 AGPU_EXPORT agpu_error agpuStateTrackerExecuteBundle(agpu_state_tracker* state_tracker, agpu_command_list* bundle);
 AGPU_EXPORT agpu_error agpuStateTrackerBeginRenderPass(agpu_state_tracker* state_tracker, agpu_renderpass* renderpass, agpu_framebuffer* framebuffer, agpu_bool bundle_content);
@@ -1948,16 +2109,25 @@ AGPU_EXPORT agpu_error agpuStateTrackerResolveFramebuffer(agpu_state_tracker* st
 AGPU_EXPORT agpu_error agpuStateTrackerResolveTexture(agpu_state_tracker* state_tracker, agpu_texture* sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, agpu_texture* destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect);
 AGPU_EXPORT agpu_error agpuStateTrackerPushConstants(agpu_state_tracker* state_tracker, agpu_uint offset, agpu_uint size, agpu_pointer values);
 AGPU_EXPORT agpu_error agpuStateTrackerMemoryBarrier(agpu_state_tracker* state_tracker, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses);
-AGPU_EXPORT agpu_error agpuStateTrackerBufferMemoryBarrier(agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size);
+AGPU_EXPORT agpu_error agpuStateTrackerBufferMemoryBarrier(agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size);
 AGPU_EXPORT agpu_error agpuStateTrackerTextureMemoryBarrier(agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 AGPU_EXPORT agpu_error agpuStateTrackerPushBufferTransitionBarrier(agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage);
 AGPU_EXPORT agpu_error agpuStateTrackerPushTextureTransitionBarrier(agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range);
 AGPU_EXPORT agpu_error agpuStateTrackerPopBufferTransitionBarrier(agpu_state_tracker* state_tracker);
 AGPU_EXPORT agpu_error agpuStateTrackerPopTextureTransitionBarrier(agpu_state_tracker* state_tracker);
-AGPU_EXPORT agpu_error agpuStateTrackerCopyBuffer(agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_size source_offset, agpu_buffer* dest_buffer, agpu_size dest_offset, agpu_size copy_size);
+AGPU_EXPORT agpu_error agpuStateTrackerCopyBuffer(agpu_state_tracker* state_tracker, agpu_buffer* source_buffer, agpu_device_size source_offset, agpu_buffer* dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size);
 AGPU_EXPORT agpu_error agpuStateTrackerCopyBufferToTexture(agpu_state_tracker* state_tracker, agpu_buffer* buffer, agpu_texture* texture, agpu_buffer_image_copy_region* copy_region);
 AGPU_EXPORT agpu_error agpuStateTrackerCopyTextureToBuffer(agpu_state_tracker* state_tracker, agpu_texture* texture, agpu_buffer* buffer, agpu_buffer_image_copy_region* copy_region);
 AGPU_EXPORT agpu_error agpuStateTrackerCopyTexture(agpu_state_tracker* state_tracker, agpu_texture* source_texture, agpu_texture* dest_texture, agpu_image_copy_region* copy_region);
+AGPU_EXPORT agpu_error agpuStateTrackerGenerateMipmaps(agpu_state_tracker* state_tracker, agpu_texture* texture);
+AGPU_EXPORT agpu_error agpuStateTrackerSetAsynchronousPipelineCompilation(agpu_state_tracker* state_tracker, agpu_bool enabled);
+AGPU_EXPORT agpu_error agpuStateTrackerSetFallbackGraphicsPipeline(agpu_state_tracker* state_tracker, agpu_pipeline_state* pipeline);
+AGPU_EXPORT agpu_ulong agpuStateTrackerGetDeferredDrawCount(agpu_state_tracker* state_tracker);
+AGPU_EXPORT agpu_ulong agpuStateTrackerGetSkippedDrawCount(agpu_state_tracker* state_tracker);
+AGPU_EXPORT agpu_error agpuStateTrackerResetQueryPool(agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint first_query, agpu_uint query_count);
+AGPU_EXPORT agpu_error agpuStateTrackerWriteTimestamp(agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
+AGPU_EXPORT agpu_error agpuStateTrackerBeginQuery(agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
+AGPU_EXPORT agpu_error agpuStateTrackerEndQuery(agpu_state_tracker* state_tracker, agpu_query_pool* query_pool, agpu_uint query_index);
 
 /* Methods for interface agpu_immediate_renderer. */
 typedef agpu_error (*agpuAddImmediateRendererReference_FUN) (agpu_immediate_renderer* immediate_renderer);
@@ -2022,7 +2192,7 @@ typedef agpu_error (*agpuAddImmediateRendererVertex_FUN) (agpu_immediate_rendere
 typedef agpu_error (*agpuBeginImmediateRendererMeshWithVertices_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_size vertexCount, agpu_size stride, agpu_size elementCount, agpu_pointer vertices);
 typedef agpu_error (*agpuBeginImmediateRendererMeshWithVertexBinding_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_vertex_layout* layout, agpu_vertex_binding* vertices);
 typedef agpu_error (*agpuImmediateRendererUseIndexBuffer_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer);
-typedef agpu_error (*agpuImmediateRendererUseIndexBufferAt_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+typedef agpu_error (*agpuImmediateRendererUseIndexBufferAt_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 typedef agpu_error (*agpuSetImmediateRendererCurrentMeshColors_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer colors);
 typedef agpu_error (*agpuSetImmediateRendererCurrentMeshNormals_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer normals);
 typedef agpu_error (*agpuSetImmediateRendererCurrentMeshTexCoords_FUN) (agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer texcoords);
@@ -2094,7 +2264,7 @@ AGPU_EXPORT agpu_error agpuAddImmediateRendererVertex(agpu_immediate_renderer* i
 AGPU_EXPORT agpu_error agpuBeginImmediateRendererMeshWithVertices(agpu_immediate_renderer* immediate_renderer, agpu_size vertexCount, agpu_size stride, agpu_size elementCount, agpu_pointer vertices);
 AGPU_EXPORT agpu_error agpuBeginImmediateRendererMeshWithVertexBinding(agpu_immediate_renderer* immediate_renderer, agpu_vertex_layout* layout, agpu_vertex_binding* vertices);
 AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBuffer(agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer);
-AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBufferAt(agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_size offset, agpu_size index_size);
+AGPU_EXPORT agpu_error agpuImmediateRendererUseIndexBufferAt(agpu_immediate_renderer* immediate_renderer, agpu_buffer* index_buffer, agpu_device_size offset, agpu_size index_size);
 AGPU_EXPORT agpu_error agpuSetImmediateRendererCurrentMeshColors(agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer colors);
 AGPU_EXPORT agpu_error agpuSetImmediateRendererCurrentMeshNormals(agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer normals);
 AGPU_EXPORT agpu_error agpuSetImmediateRendererCurrentMeshTexCoords(agpu_immediate_renderer* immediate_renderer, agpu_size stride, agpu_size elementCount, agpu_pointer texcoords);
@@ -2124,6 +2294,7 @@ typedef struct _agpu_icd_dispatch {
 	agpuAddDeviceReference_FUN agpuAddDeviceReference;
 	agpuReleaseDevice_FUN agpuReleaseDevice;
 	agpuGetDefaultCommandQueue_FUN agpuGetDefaultCommandQueue;
+	agpuGetCommandQueue_FUN agpuGetCommandQueue;
 	agpuCreateSwapChain_FUN agpuCreateSwapChain;
 	agpuCreateBuffer_FUN agpuCreateBuffer;
 	agpuCreateVertexLayout_FUN agpuCreateVertexLayout;
@@ -2142,6 +2313,8 @@ typedef struct _agpu_icd_dispatch {
 	agpuCreateTexture_FUN agpuCreateTexture;
 	agpuCreateSampler_FUN agpuCreateSampler;
 	agpuCreateFence_FUN agpuCreateFence;
+	agpuWaitForFences_FUN agpuWaitForFences;
+	agpuCreateQueryPool_FUN agpuCreateQueryPool;
 	agpuGetMultiSampleQualityLevels_FUN agpuGetMultiSampleQualityLevels;
 	agpuHasTopLeftNdcOrigin_FUN agpuHasTopLeftNdcOrigin;
 	agpuHasBottomLeftTextureCoordinates_FUN agpuHasBottomLeftTextureCoordinates;
@@ -2153,7 +2326,9 @@ typedef struct _agpu_icd_dispatch {
 	agpuCreateWindowScraper_FUN agpuCreateWindowScraper;
 	agpuCreateOfflineShaderCompilerForDevice_FUN agpuCreateOfflineShaderCompilerForDevice;
 	agpuCreateStateTrackerCache_FUN agpuCreateStateTrackerCache;
+	agpuCreateBufferPool_FUN agpuCreateBufferPool;
 	agpuFinishDeviceExecution_FUN agpuFinishDeviceExecution;
+	agpuFlushDevicePipelineCache_FUN agpuFlushDevicePipelineCache;
 	agpuAddVRSystemReference_FUN agpuAddVRSystemReference;
 	agpuReleaseVRSystem_FUN agpuReleaseVRSystem;
 	agpuGetVRSystemName_FUN agpuGetVRSystemName;
@@ -2196,6 +2371,7 @@ typedef struct _agpu_icd_dispatch {
 	agpuGetSwapChainHeight_FUN agpuGetSwapChainHeight;
 	agpuGetSwapChainLayerCount_FUN agpuGetSwapChainLayerCount;
 	agpuSetSwapChainOverlayPosition_FUN agpuSetSwapChainOverlayPosition;
+	agpuReadSwapChainPresentedFrame_FUN agpuReadSwapChainPresentedFrame;
 	agpuAddComputePipelineBuilderReference_FUN agpuAddComputePipelineBuilderReference;
 	agpuReleaseComputePipelineBuilder_FUN agpuReleaseComputePipelineBuilder;
 	agpuBuildComputePipelineState_FUN agpuBuildComputePipelineState;
@@ -2238,6 +2414,10 @@ typedef struct _agpu_icd_dispatch {
 	agpuFinishQueueExecution_FUN agpuFinishQueueExecution;
 	agpuSignalFence_FUN agpuSignalFence;
 	agpuWaitFence_FUN agpuWaitFence;
+	agpuSignalQueueTimelineValue_FUN agpuSignalQueueTimelineValue;
+	agpuWaitQueueTimelineValue_FUN agpuWaitQueueTimelineValue;
+	agpuGetQueueCompletedTimelineValue_FUN agpuGetQueueCompletedTimelineValue;
+	agpuWaitQueueTimelineValueOnClient_FUN agpuWaitQueueTimelineValueOnClient;
 	agpuAddCommandAllocatorReference_FUN agpuAddCommandAllocatorReference;
 	agpuReleaseCommandAllocator_FUN agpuReleaseCommandAllocator;
 	agpuResetCommandAllocator_FUN agpuResetCommandAllocator;
@@ -2283,6 +2463,11 @@ typedef struct _agpu_icd_dispatch {
 	agpuCopyBufferToTexture_FUN agpuCopyBufferToTexture;
 	agpuCopyTextureToBuffer_FUN agpuCopyTextureToBuffer;
 	agpuCopyTexture_FUN agpuCopyTexture;
+	agpuGenerateMipmaps_FUN agpuGenerateMipmaps;
+	agpuResetQueryPool_FUN agpuResetQueryPool;
+	agpuWriteTimestamp_FUN agpuWriteTimestamp;
+	agpuBeginQuery_FUN agpuBeginQuery;
+	agpuEndQuery_FUN agpuEndQuery;
 	agpuAddTextureReference_FUN agpuAddTextureReference;
 	agpuReleaseTexture_FUN agpuReleaseTexture;
 	agpuGetTextureDescription_FUN agpuGetTextureDescription;
@@ -2291,7 +2476,9 @@ typedef struct _agpu_icd_dispatch {
 	agpuReadTextureData_FUN agpuReadTextureData;
 	agpuReadTextureSubData_FUN agpuReadTextureSubData;
 	agpuUploadTextureData_FUN agpuUploadTextureData;
+	agpuUploadTextureDataAsynchronously_FUN agpuUploadTextureDataAsynchronously;
 	agpuUploadTextureSubData_FUN agpuUploadTextureSubData;
+	agpuUploadTextureSubresources_FUN agpuUploadTextureSubresources;
 	agpuGetTextureFullViewDescription_FUN agpuGetTextureFullViewDescription;
 	agpuCreateTextureView_FUN agpuCreateTextureView;
 	agpuGetOrCreateFullTextureView_FUN agpuGetOrCreateFullTextureView;
@@ -2306,6 +2493,7 @@ typedef struct _agpu_icd_dispatch {
 	agpuUnmapBuffer_FUN agpuUnmapBuffer;
 	agpuGetBufferDescription_FUN agpuGetBufferDescription;
 	agpuUploadBufferData_FUN agpuUploadBufferData;
+	agpuUploadBufferDataAsynchronously_FUN agpuUploadBufferDataAsynchronously;
 	agpuReadBufferData_FUN agpuReadBufferData;
 	agpuFlushWholeBuffer_FUN agpuFlushWholeBuffer;
 	agpuInvalidateWholeBuffer_FUN agpuInvalidateWholeBuffer;
@@ -2346,6 +2534,7 @@ typedef struct _agpu_icd_dispatch {
 	agpuAddShaderSignature_FUN agpuAddShaderSignature;
 	agpuReleaseShaderSignature_FUN agpuReleaseShaderSignature;
 	agpuCreateShaderResourceBinding_FUN agpuCreateShaderResourceBinding;
+	agpuCreateTransientShaderResourceBinding_FUN agpuCreateTransientShaderResourceBinding;
 	agpuAddShaderResourceBindingReference_FUN agpuAddShaderResourceBindingReference;
 	agpuReleaseShaderResourceBinding_FUN agpuReleaseShaderResourceBinding;
 	agpuBindUniformBuffer_FUN agpuBindUniformBuffer;
@@ -2359,6 +2548,14 @@ typedef struct _agpu_icd_dispatch {
 	agpuAddFenceReference_FUN agpuAddFenceReference;
 	agpuReleaseFenceReference_FUN agpuReleaseFenceReference;
 	agpuWaitOnClient_FUN agpuWaitOnClient;
+	agpuIsFenceSignaled_FUN agpuIsFenceSignaled;
+	agpuWaitFenceWithTimeout_FUN agpuWaitFenceWithTimeout;
+	agpuAddQueryPoolReference_FUN agpuAddQueryPoolReference;
+	agpuReleaseQueryPool_FUN agpuReleaseQueryPool;
+	agpuGetQueryPoolDescription_FUN agpuGetQueryPoolDescription;
+	agpuGetQueryPoolResultValueCount_FUN agpuGetQueryPoolResultValueCount;
+	agpuGetQueryPoolTimestampPeriod_FUN agpuGetQueryPoolTimestampPeriod;
+	agpuGetQueryPoolResults_FUN agpuGetQueryPoolResults;
 	agpuAddOfflineShaderCompilerReference_FUN agpuAddOfflineShaderCompilerReference;
 	agpuReleaseOfflineShaderCompiler_FUN agpuReleaseOfflineShaderCompiler;
 	agpuIsShaderLanguageSupportedByOfflineCompiler_FUN agpuIsShaderLanguageSupportedByOfflineCompiler;
@@ -2370,12 +2567,27 @@ typedef struct _agpu_icd_dispatch {
 	agpuGetOfflineShaderCompilationResultLength_FUN agpuGetOfflineShaderCompilationResultLength;
 	agpuGetOfflineShaderCompilationResult_FUN agpuGetOfflineShaderCompilationResult;
 	agpuGetOfflineShaderCompilerResultAsShader_FUN agpuGetOfflineShaderCompilerResultAsShader;
+	agpuAddBufferPoolReference_FUN agpuAddBufferPoolReference;
+	agpuReleaseBufferPool_FUN agpuReleaseBufferPool;
+	agpuAllocateBufferPoolRange_FUN agpuAllocateBufferPoolRange;
+	agpuFreeBufferPoolRange_FUN agpuFreeBufferPoolRange;
+	agpuGetBufferPoolAlignment_FUN agpuGetBufferPoolAlignment;
 	agpuAddStateTrackerCacheReference_FUN agpuAddStateTrackerCacheReference;
 	agpuReleaseStateTrackerCacheReference_FUN agpuReleaseStateTrackerCacheReference;
 	agpuCreateStateTracker_FUN agpuCreateStateTracker;
 	agpuCreateStateTrackerWithCommandAllocator_FUN agpuCreateStateTrackerWithCommandAllocator;
 	agpuCreateStateTrackerWithFrameBuffering_FUN agpuCreateStateTrackerWithFrameBuffering;
 	agpuCreateImmediateRenderer_FUN agpuCreateImmediateRenderer;
+	agpuStateTrackerCacheRegisterManifestShader_FUN agpuStateTrackerCacheRegisterManifestShader;
+	agpuStateTrackerCacheRegisterManifestShaderSignature_FUN agpuStateTrackerCacheRegisterManifestShaderSignature;
+	agpuStateTrackerCacheRegisterManifestVertexLayout_FUN agpuStateTrackerCacheRegisterManifestVertexLayout;
+	agpuStateTrackerCacheSavePipelineManifest_FUN agpuStateTrackerCacheSavePipelineManifest;
+	agpuStateTrackerCacheLoadPipelineManifest_FUN agpuStateTrackerCacheLoadPipelineManifest;
+	agpuStateTrackerCacheWaitForPipelineManifestReplay_FUN agpuStateTrackerCacheWaitForPipelineManifestReplay;
+	agpuStateTrackerCacheGetPipelineManifestHitCount_FUN agpuStateTrackerCacheGetPipelineManifestHitCount;
+	agpuStateTrackerCacheGetPipelineManifestMissCount_FUN agpuStateTrackerCacheGetPipelineManifestMissCount;
+	agpuStateTrackerCacheSetShaderCacheDirectory_FUN agpuStateTrackerCacheSetShaderCacheDirectory;
+	agpuStateTrackerCachePrecompileImmediateRendererShaderVariants_FUN agpuStateTrackerCachePrecompileImmediateRendererShaderVariants;
 	agpuAddStateTrackerReference_FUN agpuAddStateTrackerReference;
 	agpuReleaseStateTrackerReference_FUN agpuReleaseStateTrackerReference;
 	agpuStateTrackerBeginRecordingCommands_FUN agpuStateTrackerBeginRecordingCommands;
@@ -2446,6 +2658,15 @@ typedef struct _agpu_icd_dispatch {
 	agpuStateTrackerCopyBufferToTexture_FUN agpuStateTrackerCopyBufferToTexture;
 	agpuStateTrackerCopyTextureToBuffer_FUN agpuStateTrackerCopyTextureToBuffer;
 	agpuStateTrackerCopyTexture_FUN agpuStateTrackerCopyTexture;
+	agpuStateTrackerGenerateMipmaps_FUN agpuStateTrackerGenerateMipmaps;
+	agpuStateTrackerSetAsynchronousPipelineCompilation_FUN agpuStateTrackerSetAsynchronousPipelineCompilation;
+	agpuStateTrackerSetFallbackGraphicsPipeline_FUN agpuStateTrackerSetFallbackGraphicsPipeline;
+	agpuStateTrackerGetDeferredDrawCount_FUN agpuStateTrackerGetDeferredDrawCount;
+	agpuStateTrackerGetSkippedDrawCount_FUN agpuStateTrackerGetSkippedDrawCount;
+	agpuStateTrackerResetQueryPool_FUN agpuStateTrackerResetQueryPool;
+	agpuStateTrackerWriteTimestamp_FUN agpuStateTrackerWriteTimestamp;
+	agpuStateTrackerBeginQuery_FUN agpuStateTrackerBeginQuery;
+	agpuStateTrackerEndQuery_FUN agpuStateTrackerEndQuery;
 	agpuAddImmediateRendererReference_FUN agpuAddImmediateRendererReference;
 	agpuReleaseImmediateRendererReference_FUN agpuReleaseImmediateRendererReference;
 	agpuBeginImmediateRendering_FUN agpuBeginImmediateRendering;
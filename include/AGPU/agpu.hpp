@@ -215,6 +215,11 @@ public:
 		return agpuGetDefaultCommandQueue(this);
 	}
 
+	inline agpu_ref<agpu_command_queue> getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index)
+	{
+		return agpuGetCommandQueue(this, queue_type, index);
+	}
+
 	inline agpu_ref<agpu_swap_chain> createSwapChain(const agpu_ref<agpu_command_queue>& commandQueue, agpu_swap_chain_create_info* swapChainInfo)
 	{
 		return agpuCreateSwapChain(this, commandQueue.get(), swapChainInfo);
@@ -305,6 +310,16 @@ public:
 		return agpuCreateFence(this);
 	}
 
+	inline void waitForFences(agpu_uint count, agpu_ref<agpu_fence>* fences, agpu_bool wait_all, agpu_ulong timeout_ns)
+	{
+		agpuThrowIfFailed(agpuWaitForFences(this, count, reinterpret_cast<agpu_fence**> (fences), wait_all, timeout_ns));
+	}
+
+	inline agpu_ref<agpu_query_pool> createQueryPool(agpu_query_pool_description* description)
+	{
+		return agpuCreateQueryPool(this, description);
+	}
+
 	inline agpu_int getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count)
 	{
 		return agpuGetMultiSampleQualityLevels(this, format, sample_count);
@@ -360,11 +375,21 @@ public:
 		return agpuCreateStateTrackerCache(this, command_queue_family.get());
 	}
 
+	inline agpu_ref<agpu_buffer_pool> createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment)
+	{
+		return agpuCreateBufferPool(this, block_description, alignment);
+	}
+
 	inline void finishExecution()
 	{
 		agpuThrowIfFailed(agpuFinishDeviceExecution(this));
 	}
 
+	inline void flushPipelineCache()
+	{
+		agpuThrowIfFailed(agpuFlushDevicePipelineCache(this));
+	}
+
 };
 
 typedef agpu_ref<agpu_device> agpu_device_ref;
@@ -619,6 +644,11 @@ public:
 		agpuThrowIfFailed(agpuSetSwapChainOverlayPosition(this, x, y));
 	}
 
+	inline void readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer)
+	{
+		agpuThrowIfFailed(agpuReadSwapChainPresentedFrame(this, pitch, slicePitch, buffer));
+	}
+
 };
 
 typedef agpu_ref<agpu_swap_chain> agpu_swap_chain_ref;
@@ -873,6 +903,26 @@ public:
 		agpuThrowIfFailed(agpuWaitFence(this, fence.get()));
 	}
 
+	inline void signalTimelineValue(agpu_ulong value)
+	{
+		agpuThrowIfFailed(agpuSignalQueueTimelineValue(this, value));
+	}
+
+	inline void waitTimelineValue(const agpu_ref<agpu_command_queue>& source_queue, agpu_ulong value)
+	{
+		agpuThrowIfFailed(agpuWaitQueueTimelineValue(this, source_queue.get(), value));
+	}
+
+	inline agpu_ulong getCompletedTimelineValue()
+	{
+		return agpuGetQueueCompletedTimelineValue(this);
+	}
+
+	inline void waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns)
+	{
+		agpuThrowIfFailed(agpuWaitQueueTimelineValueOnClient(this, value, timeout_ns));
+	}
+
 };
 
 typedef agpu_ref<agpu_command_queue> agpu_command_queue_ref;
@@ -950,7 +1000,7 @@ public:
 		agpuThrowIfFailed(agpuUseIndexBuffer(this, index_buffer.get()));
 	}
 
-	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_size offset, agpu_size index_size)
+	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_device_size offset, agpu_size index_size)
 	{
 		agpuThrowIfFailed(agpuUseIndexBufferAt(this, index_buffer.get(), offset, index_size));
 	}
@@ -990,7 +1040,7 @@ public:
 		agpuThrowIfFailed(agpuDrawArrays(this, vertex_count, instance_count, first_vertex, base_instance));
 	}
 
-	inline void drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+	inline void drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 	{
 		agpuThrowIfFailed(agpuDrawArraysIndirect(this, offset, drawcount));
 	}
@@ -1000,7 +1050,7 @@ public:
 		agpuThrowIfFailed(agpuDrawElements(this, index_count, instance_count, first_index, base_vertex, base_instance));
 	}
 
-	inline void drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+	inline void drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 	{
 		agpuThrowIfFailed(agpuDrawElementsIndirect(this, offset, drawcount));
 	}
@@ -1010,7 +1060,7 @@ public:
 		agpuThrowIfFailed(agpuDispatchCompute(this, group_count_x, group_count_y, group_count_z));
 	}
 
-	inline void dispatchComputeIndirect(agpu_size offset)
+	inline void dispatchComputeIndirect(agpu_device_size offset)
 	{
 		agpuThrowIfFailed(agpuDispatchComputeIndirect(this, offset));
 	}
@@ -1070,7 +1120,7 @@ public:
 		agpuThrowIfFailed(agpuMemoryBarrier(this, source_stage, dest_stage, source_accesses, dest_accesses));
 	}
 
-	inline void bufferMemoryBarrier(const agpu_ref<agpu_buffer>& buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+	inline void bufferMemoryBarrier(const agpu_ref<agpu_buffer>& buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 	{
 		agpuThrowIfFailed(agpuBufferMemoryBarrier(this, buffer.get(), source_stage, dest_stage, source_accesses, dest_accesses, offset, size));
 	}
@@ -1100,7 +1150,7 @@ public:
 		agpuThrowIfFailed(agpuPopTextureTransitionBarrier(this));
 	}
 
-	inline void copyBuffer(const agpu_ref<agpu_buffer>& source_buffer, agpu_size source_offset, const agpu_ref<agpu_buffer>& dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+	inline void copyBuffer(const agpu_ref<agpu_buffer>& source_buffer, agpu_device_size source_offset, const agpu_ref<agpu_buffer>& dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 	{
 		agpuThrowIfFailed(agpuCopyBuffer(this, source_buffer.get(), source_offset, dest_buffer.get(), dest_offset, copy_size));
 	}
@@ -1120,6 +1170,31 @@ public:
 		agpuThrowIfFailed(agpuCopyTexture(this, source_texture.get(), dest_texture.get(), copy_region));
 	}
 
+	inline void generateMipmaps(const agpu_ref<agpu_texture>& texture)
+	{
+		agpuThrowIfFailed(agpuGenerateMipmaps(this, texture.get()));
+	}
+
+	inline void resetQueryPool(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint first_query, agpu_uint query_count)
+	{
+		agpuThrowIfFailed(agpuResetQueryPool(this, query_pool.get(), first_query, query_count));
+	}
+
+	inline void writeTimestamp(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuWriteTimestamp(this, query_pool.get(), query_index));
+	}
+
+	inline void beginQuery(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuBeginQuery(this, query_pool.get(), query_index));
+	}
+
+	inline void endQuery(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuEndQuery(this, query_pool.get(), query_index));
+	}
+
 };
 
 typedef agpu_ref<agpu_command_list> agpu_command_list_ref;
@@ -1171,11 +1246,21 @@ public:
 		agpuThrowIfFailed(agpuUploadTextureData(this, level, arrayIndex, pitch, slicePitch, data));
 	}
 
+	inline agpu_ref<agpu_fence> uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data)
+	{
+		return agpuUploadTextureDataAsynchronously(this, level, arrayIndex, pitch, slicePitch, data);
+	}
+
 	inline void uploadTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data)
 	{
 		agpuThrowIfFailed(agpuUploadTextureSubData(this, level, arrayIndex, pitch, slicePitch, sourceSize, destRegion, data));
 	}
 
+	inline void uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources)
+	{
+		agpuThrowIfFailed(agpuUploadTextureSubresources(this, count, subresources));
+	}
+
 	inline void getFullViewDescription(agpu_texture_view_description* result)
 	{
 		agpuThrowIfFailed(agpuGetTextureFullViewDescription(this, result));
@@ -1274,12 +1359,17 @@ public:
 		agpuThrowIfFailed(agpuGetBufferDescription(this, description));
 	}
 
-	inline void uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+	inline void uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 	{
 		agpuThrowIfFailed(agpuUploadBufferData(this, offset, size, data));
 	}
 
-	inline void readBufferData(agpu_size offset, agpu_size size, agpu_pointer data)
+	inline agpu_ref<agpu_fence> uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
+	{
+		return agpuUploadBufferDataAsynchronously(this, offset, size, data);
+	}
+
+	inline void readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data)
 	{
 		agpuThrowIfFailed(agpuReadBufferData(this, offset, size, data));
 	}
@@ -1320,7 +1410,7 @@ public:
 		agpuThrowIfFailed(agpuBindVertexBuffers(this, count, reinterpret_cast<agpu_buffer**> (vertex_buffers)));
 	}
 
-	inline void bindVertexBuffersWithOffsets(agpu_uint count, agpu_ref<agpu_buffer>* vertex_buffers, agpu_size* offsets)
+	inline void bindVertexBuffersWithOffsets(agpu_uint count, agpu_ref<agpu_buffer>* vertex_buffers, agpu_device_size* offsets)
 	{
 		agpuThrowIfFailed(agpuBindVertexBuffersWithOffsets(this, count, reinterpret_cast<agpu_buffer**> (vertex_buffers), offsets));
 	}
@@ -1556,6 +1646,11 @@ public:
 		return agpuCreateShaderResourceBinding(this, element);
 	}
 
+	inline agpu_ref<agpu_shader_resource_binding> createTransientShaderResourceBinding(agpu_uint element)
+	{
+		return agpuCreateTransientShaderResourceBinding(this, element);
+	}
+
 };
 
 typedef agpu_ref<agpu_shader_signature> agpu_shader_signature_ref;
@@ -1582,7 +1677,7 @@ public:
 		agpuThrowIfFailed(agpuBindUniformBuffer(this, location, uniform_buffer.get()));
 	}
 
-	inline void bindUniformBufferRange(agpu_int location, const agpu_ref<agpu_buffer>& uniform_buffer, agpu_size offset, agpu_size size)
+	inline void bindUniformBufferRange(agpu_int location, const agpu_ref<agpu_buffer>& uniform_buffer, agpu_device_size offset, agpu_device_size size)
 	{
 		agpuThrowIfFailed(agpuBindUniformBufferRange(this, location, uniform_buffer.get(), offset, size));
 	}
@@ -1592,7 +1687,7 @@ public:
 		agpuThrowIfFailed(agpuBindStorageBuffer(this, location, storage_buffer.get()));
 	}
 
-	inline void bindStorageBufferRange(agpu_int location, const agpu_ref<agpu_buffer>& storage_buffer, agpu_size offset, agpu_size size)
+	inline void bindStorageBufferRange(agpu_int location, const agpu_ref<agpu_buffer>& storage_buffer, agpu_device_size offset, agpu_device_size size)
 	{
 		agpuThrowIfFailed(agpuBindStorageBufferRange(this, location, storage_buffer.get(), offset, size));
 	}
@@ -1643,10 +1738,61 @@ public:
 		agpuThrowIfFailed(agpuWaitOnClient(this));
 	}
 
+	inline agpu_bool isSignaled()
+	{
+		return agpuIsFenceSignaled(this);
+	}
+
+	inline void waitWithTimeout(agpu_ulong timeout_ns)
+	{
+		agpuThrowIfFailed(agpuWaitFenceWithTimeout(this, timeout_ns));
+	}
+
 };
 
 typedef agpu_ref<agpu_fence> agpu_fence_ref;
 
+// Interface wrapper for agpu_query_pool.
+struct _agpu_query_pool
+{
+private:
+	_agpu_query_pool() {}
+
+public:
+	inline void addReference()
+	{
+		agpuThrowIfFailed(agpuAddQueryPoolReference(this));
+	}
+
+	inline void release()
+	{
+		agpuThrowIfFailed(agpuReleaseQueryPool(this));
+	}
+
+	inline void getDescription(agpu_query_pool_description* description)
+	{
+		agpuThrowIfFailed(agpuGetQueryPoolDescription(this, description));
+	}
+
+	inline agpu_uint getResultValueCount()
+	{
+		return agpuGetQueryPoolResultValueCount(this);
+	}
+
+	inline agpu_float getTimestampPeriod()
+	{
+		return agpuGetQueryPoolTimestampPeriod(this);
+	}
+
+	inline void getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags)
+	{
+		agpuThrowIfFailed(agpuGetQueryPoolResults(this, first_query, query_count, results, flags));
+	}
+
+};
+
+typedef agpu_ref<agpu_query_pool> agpu_query_pool_ref;
+
 // Interface wrapper for agpu_offline_shader_compiler.
 struct _agpu_offline_shader_compiler
 {
@@ -1713,6 +1859,42 @@ public:
 
 typedef agpu_ref<agpu_offline_shader_compiler> agpu_offline_shader_compiler_ref;
 
+// Interface wrapper for agpu_buffer_pool.
+struct _agpu_buffer_pool
+{
+private:
+	_agpu_buffer_pool() {}
+
+public:
+	inline void addReference()
+	{
+		agpuThrowIfFailed(agpuAddBufferPoolReference(this));
+	}
+
+	inline void release()
+	{
+		agpuThrowIfFailed(agpuReleaseBufferPool(this));
+	}
+
+	inline agpu_ref<agpu_buffer> allocateRange(agpu_device_size size, agpu_device_size* offset)
+	{
+		return agpuAllocateBufferPoolRange(this, size, offset);
+	}
+
+	inline void freeRange(const agpu_ref<agpu_buffer>& buffer, agpu_device_size offset)
+	{
+		agpuThrowIfFailed(agpuFreeBufferPoolRange(this, buffer.get(), offset));
+	}
+
+	inline agpu_device_size getAlignment()
+	{
+		return agpuGetBufferPoolAlignment(this);
+	}
+
+};
+
+typedef agpu_ref<agpu_buffer_pool> agpu_buffer_pool_ref;
+
 // Interface wrapper for agpu_state_tracker_cache.
 struct _agpu_state_tracker_cache
 {
@@ -1750,6 +1932,56 @@ public:
 		return agpuCreateImmediateRenderer(this);
 	}
 
+	inline void registerManifestShader(const agpu_ref<agpu_shader>& shader, agpu_pointer content, agpu_size content_size)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheRegisterManifestShader(this, shader.get(), content, content_size));
+	}
+
+	inline void registerManifestShaderSignature(const agpu_ref<agpu_shader_signature>& shader_signature, agpu_cstring key)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheRegisterManifestShaderSignature(this, shader_signature.get(), key));
+	}
+
+	inline void registerManifestVertexLayout(const agpu_ref<agpu_vertex_layout>& vertex_layout, agpu_cstring key)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheRegisterManifestVertexLayout(this, vertex_layout.get(), key));
+	}
+
+	inline void savePipelineManifest(agpu_cstring file_name)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheSavePipelineManifest(this, file_name));
+	}
+
+	inline void loadPipelineManifest(agpu_cstring file_name, agpu_uint worker_count)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheLoadPipelineManifest(this, file_name, worker_count));
+	}
+
+	inline void waitForPipelineManifestReplay()
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheWaitForPipelineManifestReplay(this));
+	}
+
+	inline agpu_ulong getPipelineManifestHitCount()
+	{
+		return agpuStateTrackerCacheGetPipelineManifestHitCount(this);
+	}
+
+	inline agpu_ulong getPipelineManifestMissCount()
+	{
+		return agpuStateTrackerCacheGetPipelineManifestMissCount(this);
+	}
+
+	inline void setShaderCacheDirectory(agpu_cstring directory)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCacheSetShaderCacheDirectory(this, directory));
+	}
+
+	inline void precompileImmediateRendererShaderVariants(agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count)
+	{
+		agpuThrowIfFailed(agpuStateTrackerCachePrecompileImmediateRendererShaderVariants(this, variant_count, variants, worker_count));
+	}
+
 };
 
 typedef agpu_ref<agpu_state_tracker_cache> agpu_state_tracker_cache_ref;
@@ -1956,7 +2188,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerUseIndexBuffer(this, index_buffer.get()));
 	}
 
-	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_size offset, agpu_size index_size)
+	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_device_size offset, agpu_size index_size)
 	{
 		agpuThrowIfFailed(agpuStateTrackerUseIndexBufferAt(this, index_buffer.get(), offset, index_size));
 	}
@@ -1996,7 +2228,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerDrawArrays(this, vertex_count, instance_count, first_vertex, base_instance));
 	}
 
-	inline void drawArraysIndirect(agpu_size offset, agpu_size drawcount)
+	inline void drawArraysIndirect(agpu_device_size offset, agpu_size drawcount)
 	{
 		agpuThrowIfFailed(agpuStateTrackerDrawArraysIndirect(this, offset, drawcount));
 	}
@@ -2006,7 +2238,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerDrawElements(this, index_count, instance_count, first_index, base_vertex, base_instance));
 	}
 
-	inline void drawElementsIndirect(agpu_size offset, agpu_size drawcount)
+	inline void drawElementsIndirect(agpu_device_size offset, agpu_size drawcount)
 	{
 		agpuThrowIfFailed(agpuStateTrackerDrawElementsIndirect(this, offset, drawcount));
 	}
@@ -2016,7 +2248,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerDispatchCompute(this, group_count_x, group_count_y, group_count_z));
 	}
 
-	inline void dispatchComputeIndirect(agpu_size offset)
+	inline void dispatchComputeIndirect(agpu_device_size offset)
 	{
 		agpuThrowIfFailed(agpuStateTrackerDispatchComputeIndirect(this, offset));
 	}
@@ -2061,7 +2293,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerMemoryBarrier(this, source_stage, dest_stage, source_accesses, dest_accesses));
 	}
 
-	inline void bufferMemoryBarrier(const agpu_ref<agpu_buffer>& buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size)
+	inline void bufferMemoryBarrier(const agpu_ref<agpu_buffer>& buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size)
 	{
 		agpuThrowIfFailed(agpuStateTrackerBufferMemoryBarrier(this, buffer.get(), source_stage, dest_stage, source_accesses, dest_accesses, offset, size));
 	}
@@ -2091,7 +2323,7 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerPopTextureTransitionBarrier(this));
 	}
 
-	inline void copyBuffer(const agpu_ref<agpu_buffer>& source_buffer, agpu_size source_offset, const agpu_ref<agpu_buffer>& dest_buffer, agpu_size dest_offset, agpu_size copy_size)
+	inline void copyBuffer(const agpu_ref<agpu_buffer>& source_buffer, agpu_device_size source_offset, const agpu_ref<agpu_buffer>& dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size)
 	{
 		agpuThrowIfFailed(agpuStateTrackerCopyBuffer(this, source_buffer.get(), source_offset, dest_buffer.get(), dest_offset, copy_size));
 	}
@@ -2111,6 +2343,51 @@ public:
 		agpuThrowIfFailed(agpuStateTrackerCopyTexture(this, source_texture.get(), dest_texture.get(), copy_region));
 	}
 
+	inline void generateMipmaps(const agpu_ref<agpu_texture>& texture)
+	{
+		agpuThrowIfFailed(agpuStateTrackerGenerateMipmaps(this, texture.get()));
+	}
+
+	inline void setAsynchronousPipelineCompilation(agpu_bool enabled)
+	{
+		agpuThrowIfFailed(agpuStateTrackerSetAsynchronousPipelineCompilation(this, enabled));
+	}
+
+	inline void setFallbackGraphicsPipeline(const agpu_ref<agpu_pipeline_state>& pipeline)
+	{
+		agpuThrowIfFailed(agpuStateTrackerSetFallbackGraphicsPipeline(this, pipeline.get()));
+	}
+
+	inline agpu_ulong getDeferredDrawCount()
+	{
+		return agpuStateTrackerGetDeferredDrawCount(this);
+	}
+
+	inline agpu_ulong getSkippedDrawCount()
+	{
+		return agpuStateTrackerGetSkippedDrawCount(this);
+	}
+
+	inline void resetQueryPool(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint first_query, agpu_uint query_count)
+	{
+		agpuThrowIfFailed(agpuStateTrackerResetQueryPool(this, query_pool.get(), first_query, query_count));
+	}
+
+	inline void writeTimestamp(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuStateTrackerWriteTimestamp(this, query_pool.get(), query_index));
+	}
+
+	inline void beginQuery(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuStateTrackerBeginQuery(this, query_pool.get(), query_index));
+	}
+
+	inline void endQuery(const agpu_ref<agpu_query_pool>& query_pool, agpu_uint query_index)
+	{
+		agpuThrowIfFailed(agpuStateTrackerEndQuery(this, query_pool.get(), query_index));
+	}
+
 };
 
 typedef agpu_ref<agpu_state_tracker> agpu_state_tracker_ref;
@@ -2432,7 +2709,7 @@ public:
 		agpuThrowIfFailed(agpuImmediateRendererUseIndexBuffer(this, index_buffer.get()));
 	}
 
-	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_size offset, agpu_size index_size)
+	inline void useIndexBufferAt(const agpu_ref<agpu_buffer>& index_buffer, agpu_device_size offset, agpu_size index_size)
 	{
 		agpuThrowIfFailed(agpuImmediateRendererUseIndexBufferAt(this, index_buffer.get(), offset, index_size));
 	}
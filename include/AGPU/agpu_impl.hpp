@@ -6,21 +6,35 @@
 #include <stdexcept>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <new>
+#include <cstddef>
+#include <utility>
 
 namespace agpu
 {
 
 extern agpu_icd_dispatch cppRefcountedDispatchTable;
 
+/**
+ * Function that releases the storage shared by a reference counter and its
+ * object. The storage starts with the reference counter.
+ */
+typedef void (*ref_counter_storage_release_function)(void *storage);
+
 /**
  * Phanapi reference counter
+ *
+ * When I am allocated together with my object, the object is destroyed in
+ * place when the last strong reference is released, and the shared storage is
+ * released with the last weak reference.
  */
 template <typename T>
 class ref_counter
 {
 public:
-    ref_counter(T *cobject)
-        : dispatchTable(&cppRefcountedDispatchTable), object(cobject), strongCount(1), weakCount(1)
+    ref_counter(T *cobject, ref_counter_storage_release_function cstorageRelease = nullptr)
+        : dispatchTable(&cppRefcountedDispatchTable), object(cobject), strongCount(1), weakCount(1), storageRelease(cstorageRelease)
     {
         object->setRefCounterPointer(this);
     }
@@ -46,7 +60,10 @@ public:
         auto old = strongCount.fetch_sub(1, std::memory_order_acq_rel);
         if(old == 1)
         {
-            delete object;
+            if(storageRelease)
+                object->~T();
+            else
+                delete object;
             weakRelease();
         }
 
@@ -76,7 +93,16 @@ public:
         if(old == 1)
         {
             // Nobody else is referencing me.
-            delete this;
+            if(storageRelease)
+            {
+                auto release = storageRelease;
+                this->~ref_counter();
+                release(this);
+            }
+            else
+            {
+                delete this;
+            }
         }
     }
 
@@ -84,6 +110,7 @@ public:
     T * object;
     std::atomic_uint strongCount;
     std::atomic_uint weakCount;
+    ref_counter_storage_release_function storageRelease;
 };
 
 template<typename T>
@@ -307,18 +334,248 @@ public:
     }
 };
 
+/**
+ * I am a pool of fixed size blocks, that are carved from slabs of
+ * SlabBlockCount blocks. Each thread keeps a small cache of free blocks, that
+ * is refilled from and flushed into the shared free list in batches, so the
+ * shared lock is only taken once every BatchSize allocations.
+ *
+ * The slabs are never returned to the system, because objects may still be
+ * released while the program is terminating.
+ */
+template<size_t BlockSize, size_t BlockAlignment>
+class object_slab_pool
+{
+public:
+    static const size_t SlabBlockCount = 64;
+    static const size_t BatchSize = 32;
+    static const size_t ThreadCacheCapacity = 64;
+
+    static void *allocate()
+    {
+        auto &cache = threadCache();
+        if(cache.destroyed)
+            return sharedPool().allocateOne();
+
+        if(!cache.freeList)
+        {
+            registerThreadCacheFlusher();
+            cache.count = sharedPool().takeBatch(&cache.freeList);
+        }
+
+        auto block = cache.freeList;
+        cache.freeList = block->next;
+        --cache.count;
+        return block;
+    }
+
+    static void deallocate(void *storage)
+    {
+        auto block = reinterpret_cast<FreeBlock*> (storage);
+        auto &cache = threadCache();
+        if(cache.destroyed)
+        {
+            block->next = nullptr;
+            sharedPool().putChain(block, block);
+            return;
+        }
+
+        if(!cache.freeList)
+            registerThreadCacheFlusher();
+
+        block->next = cache.freeList;
+        cache.freeList = block;
+        if(++cache.count <= ThreadCacheCapacity)
+            return;
+
+        // Give a batch back, so that blocks freed by another thread than
+        // the one that allocated them do not accumulate here.
+        auto last = cache.freeList;
+        for(size_t i = 1; i < BatchSize; ++i)
+            last = last->next;
+        auto first = cache.freeList;
+        cache.freeList = last->next;
+        cache.count -= BatchSize;
+        last->next = nullptr;
+        sharedPool().putChain(first, last);
+    }
+
+private:
+    union FreeBlock
+    {
+        FreeBlock *next;
+        alignas(BlockAlignment) unsigned char storage[BlockSize];
+    };
+
+    static_assert(BlockAlignment <= alignof(std::max_align_t), "Over-aligned blocks are not supported.");
+
+    struct SharedPool
+    {
+        std::mutex mutex;
+        FreeBlock *freeList = nullptr;
+
+        void allocateSlab()
+        {
+            auto slab = reinterpret_cast<FreeBlock*> (::operator new(sizeof(FreeBlock)*SlabBlockCount));
+            for(size_t i = 0; i < SlabBlockCount; ++i)
+                slab[i].next = i + 1 < SlabBlockCount ? &slab[i + 1] : freeList;
+            freeList = slab;
+        }
+
+        size_t takeBatch(FreeBlock **destination)
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            if(!freeList)
+                allocateSlab();
+
+            size_t count = 1;
+            auto last = freeList;
+            while(count < BatchSize && last->next)
+            {
+                last = last->next;
+                ++count;
+            }
+
+            *destination = freeList;
+            freeList = last->next;
+            last->next = nullptr;
+            return count;
+        }
+
+        void *allocateOne()
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            if(!freeList)
+                allocateSlab();
+
+            auto block = freeList;
+            freeList = block->next;
+            return block;
+        }
+
+        void putChain(FreeBlock *first, FreeBlock *last)
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            last->next = freeList;
+            freeList = first;
+        }
+    };
+
+    // This is trivially destructible, so it can still be used while the
+    // thread local variables of an exiting thread are being destroyed.
+    struct ThreadCache
+    {
+        FreeBlock *freeList;
+        size_t count;
+        bool destroyed;
+    };
+
+    struct ThreadCacheFlusher
+    {
+        ~ThreadCacheFlusher()
+        {
+            auto &cache = threadCache();
+            cache.destroyed = true;
+            if(!cache.freeList)
+                return;
+
+            auto last = cache.freeList;
+            while(last->next)
+                last = last->next;
+            sharedPool().putChain(cache.freeList, last);
+            cache.freeList = nullptr;
+            cache.count = 0;
+        }
+    };
+
+    static void registerThreadCacheFlusher()
+    {
+        static thread_local ThreadCacheFlusher flusher;
+        (void)flusher;
+    }
+
+    static SharedPool &sharedPool()
+    {
+        static SharedPool *pool = new SharedPool();
+        return *pool;
+    }
+
+    static ThreadCache &threadCache()
+    {
+        static thread_local ThreadCache cache = {nullptr, 0, false};
+        return cache;
+    }
+};
+
+/**
+ * I describe the storage of an object that is allocated together with its
+ * reference counter. The counter comes first, so that the storage can be
+ * released from the counter pointer.
+ */
+template<typename I, typename T>
+struct co_allocated_object_layout
+{
+    typedef ref_counter<I> Counter;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned objects are not supported.");
+
+    static const size_t Alignment = alignof(T) > alignof(Counter) ? alignof(T) : alignof(Counter);
+    static const size_t ObjectOffset = (sizeof(Counter) + alignof(T) - 1) / alignof(T) * alignof(T);
+    static const size_t Size = ObjectOffset + sizeof(T);
+
+    template<typename...Args>
+    static ref<I> construct(void *storage, ref_counter_storage_release_function storageRelease, Args&&... args)
+    {
+        T *object;
+        try
+        {
+            object = new (reinterpret_cast<char*> (storage) + ObjectOffset) T(std::forward<Args> (args)...);
+        }
+        catch(...)
+        {
+            storageRelease(storage);
+            throw;
+        }
+
+        return ref<I> (new (storage) Counter(object, storageRelease));
+    }
+};
+
+inline void releaseCoAllocatedObjectStorage(void *storage)
+{
+    ::operator delete(storage);
+}
+
+template<typename I, typename T, typename...Args>
+inline ref<I> makeObjectWithInterface(Args&&... args)
+{
+    typedef co_allocated_object_layout<I, T> Layout;
+    return Layout::construct(::operator new(Layout::Size), &releaseCoAllocatedObjectStorage, std::forward<Args> (args)...);
+}
+
+template<typename T, typename...Args>
+inline ref<typename T::main_interface> makeObject(Args&&... args)
+{
+   return makeObjectWithInterface<typename T::main_interface, T> (std::forward<Args> (args)...);
+}
+
+/**
+ * I make an object whose storage is taken from a slab pool that is shared by
+ * the objects of the same size. This is meant for the small objects that are
+ * created and destroyed at a high rate.
+ */
 template<typename I, typename T, typename...Args>
-inline ref<I> makeObjectWithInterface(Args... args)
+inline ref<I> makePooledObjectWithInterface(Args&&... args)
 {
-    std::unique_ptr<T> object(new T(args...));
-    std::unique_ptr<ref_counter<I>> counter(new ref_counter<I> (object.release()));
-    return ref<I> (counter.release());
+    typedef co_allocated_object_layout<I, T> Layout;
+    typedef object_slab_pool<Layout::Size, Layout::Alignment> Pool;
+    return Layout::construct(Pool::allocate(), &Pool::deallocate, std::forward<Args> (args)...);
 }
 
 template<typename T, typename...Args>
-inline ref<typename T::main_interface> makeObject(Args... args)
+inline ref<typename T::main_interface> makePooledObject(Args&&... args)
 {
-   return makeObjectWithInterface<typename T::main_interface, T> (args...);
+   return makePooledObjectWithInterface<typename T::main_interface, T> (std::forward<Args> (args)...);
 }
 
 /**
@@ -495,11 +752,21 @@ typedef ref_counter<fence> *fence_ptr;
 typedef ref<fence> fence_ref;
 typedef weak_ref<fence> fence_weakref;
 
+struct query_pool;
+typedef ref_counter<query_pool> *query_pool_ptr;
+typedef ref<query_pool> query_pool_ref;
+typedef weak_ref<query_pool> query_pool_weakref;
+
 struct offline_shader_compiler;
 typedef ref_counter<offline_shader_compiler> *offline_shader_compiler_ptr;
 typedef ref<offline_shader_compiler> offline_shader_compiler_ref;
 typedef weak_ref<offline_shader_compiler> offline_shader_compiler_weakref;
 
+struct buffer_pool;
+typedef ref_counter<buffer_pool> *buffer_pool_ptr;
+typedef ref<buffer_pool> buffer_pool_ref;
+typedef weak_ref<buffer_pool> buffer_pool_weakref;
+
 struct state_tracker_cache;
 typedef ref_counter<state_tracker_cache> *state_tracker_cache_ptr;
 typedef ref<state_tracker_cache> state_tracker_cache_ref;
@@ -542,6 +809,7 @@ struct device : base_interface
 public:
 	typedef device main_interface;
 	virtual command_queue_ptr getDefaultCommandQueue() = 0;
+	virtual command_queue_ptr getCommandQueue(agpu_command_queue_type queue_type, agpu_uint index) = 0;
 	virtual swap_chain_ptr createSwapChain(const command_queue_ref & commandQueue, agpu_swap_chain_create_info* swapChainInfo) = 0;
 	virtual buffer_ptr createBuffer(agpu_buffer_description* description, agpu_pointer initial_data) = 0;
 	virtual vertex_layout_ptr createVertexLayout() = 0;
@@ -560,6 +828,8 @@ public:
 	virtual texture_ptr createTexture(agpu_texture_description* description) = 0;
 	virtual sampler_ptr createSampler(agpu_sampler_description* description) = 0;
 	virtual fence_ptr createFence() = 0;
+	virtual agpu_error waitForFences(agpu_uint count, fence_ref* fences, agpu_bool wait_all, agpu_ulong timeout_ns) = 0;
+	virtual query_pool_ptr createQueryPool(agpu_query_pool_description* description) = 0;
 	virtual agpu_int getMultiSampleQualityLevels(agpu_texture_format format, agpu_uint sample_count) = 0;
 	virtual agpu_bool hasTopLeftNdcOrigin() = 0;
 	virtual agpu_bool hasBottomLeftTextureCoordinates() = 0;
@@ -571,7 +841,9 @@ public:
 	virtual window_scraper_ptr createWindowScraper() = 0;
 	virtual offline_shader_compiler_ptr createOfflineShaderCompiler() = 0;
 	virtual state_tracker_cache_ptr createStateTrackerCache(const command_queue_ref & command_queue_family) = 0;
+	virtual buffer_pool_ptr createBufferPool(agpu_buffer_description* block_description, agpu_device_size alignment) = 0;
 	virtual agpu_error finishExecution() = 0;
+	virtual agpu_error flushPipelineCache() = 0;
 };
 
 
@@ -638,6 +910,7 @@ public:
 	virtual agpu_uint getHeight() = 0;
 	virtual agpu_uint getLayerCount() = 0;
 	virtual agpu_error setOverlayPosition(agpu_int x, agpu_int y) = 0;
+	virtual agpu_error readPresentedFrame(agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) = 0;
 };
 
 
@@ -704,6 +977,10 @@ public:
 	virtual agpu_error finishExecution() = 0;
 	virtual agpu_error signalFence(const fence_ref & fence) = 0;
 	virtual agpu_error waitFence(const fence_ref & fence) = 0;
+	virtual agpu_error signalTimelineValue(agpu_ulong value) = 0;
+	virtual agpu_error waitTimelineValue(const command_queue_ref & source_queue, agpu_ulong value) = 0;
+	virtual agpu_ulong getCompletedTimelineValue() = 0;
+	virtual agpu_error waitTimelineValueOnClient(agpu_ulong value, agpu_ulong timeout_ns) = 0;
 };
 
 
@@ -727,7 +1004,7 @@ public:
 	virtual agpu_error usePipelineState(const pipeline_state_ref & pipeline) = 0;
 	virtual agpu_error useVertexBinding(const vertex_binding_ref & vertex_binding) = 0;
 	virtual agpu_error useIndexBuffer(const buffer_ref & index_buffer) = 0;
-	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_size offset, agpu_size index_size) = 0;
+	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size) = 0;
 	virtual agpu_error useDrawIndirectBuffer(const buffer_ref & draw_buffer) = 0;
 	virtual agpu_error useComputeDispatchIndirectBuffer(const buffer_ref & buffer) = 0;
 	virtual agpu_error useShaderResources(const shader_resource_binding_ref & binding) = 0;
@@ -735,11 +1012,11 @@ public:
 	virtual agpu_error useComputeShaderResources(const shader_resource_binding_ref & binding) = 0;
 	virtual agpu_error useComputeShaderResourcesInSlot(const shader_resource_binding_ref & binding, agpu_uint slot) = 0;
 	virtual agpu_error drawArrays(agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance) = 0;
-	virtual agpu_error drawArraysIndirect(agpu_size offset, agpu_size drawcount) = 0;
+	virtual agpu_error drawArraysIndirect(agpu_device_size offset, agpu_size drawcount) = 0;
 	virtual agpu_error drawElements(agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance) = 0;
-	virtual agpu_error drawElementsIndirect(agpu_size offset, agpu_size drawcount) = 0;
+	virtual agpu_error drawElementsIndirect(agpu_device_size offset, agpu_size drawcount) = 0;
 	virtual agpu_error dispatchCompute(agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z) = 0;
-	virtual agpu_error dispatchComputeIndirect(agpu_size offset) = 0;
+	virtual agpu_error dispatchComputeIndirect(agpu_device_size offset) = 0;
 	virtual agpu_error setStencilReference(agpu_uint reference) = 0;
 	virtual agpu_error executeBundle(const command_list_ref & bundle) = 0;
 	virtual agpu_error close() = 0;
@@ -751,16 +1028,21 @@ public:
 	virtual agpu_error resolveTexture(const texture_ref & sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, const texture_ref & destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect) = 0;
 	virtual agpu_error pushConstants(agpu_uint offset, agpu_uint size, agpu_pointer values) = 0;
 	virtual agpu_error memoryBarrier(agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses) = 0;
-	virtual agpu_error bufferMemoryBarrier(const buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size) = 0;
+	virtual agpu_error bufferMemoryBarrier(const buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size) = 0;
 	virtual agpu_error textureMemoryBarrier(const texture_ref & texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) = 0;
 	virtual agpu_error pushBufferTransitionBarrier(const buffer_ref & buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage) = 0;
 	virtual agpu_error pushTextureTransitionBarrier(const texture_ref & texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) = 0;
 	virtual agpu_error popBufferTransitionBarrier() = 0;
 	virtual agpu_error popTextureTransitionBarrier() = 0;
-	virtual agpu_error copyBuffer(const buffer_ref & source_buffer, agpu_size source_offset, const buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size) = 0;
+	virtual agpu_error copyBuffer(const buffer_ref & source_buffer, agpu_device_size source_offset, const buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size) = 0;
 	virtual agpu_error copyBufferToTexture(const buffer_ref & buffer, const texture_ref & texture, agpu_buffer_image_copy_region* copy_region) = 0;
 	virtual agpu_error copyTextureToBuffer(const texture_ref & texture, const buffer_ref & buffer, agpu_buffer_image_copy_region* copy_region) = 0;
 	virtual agpu_error copyTexture(const texture_ref & source_texture, const texture_ref & dest_texture, agpu_image_copy_region* copy_region) = 0;
+	virtual agpu_error generateMipmaps(const texture_ref & texture) = 0;
+	virtual agpu_error resetQueryPool(const query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count) = 0;
+	virtual agpu_error writeTimestamp(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
+	virtual agpu_error beginQuery(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
+	virtual agpu_error endQuery(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
 };
 
 
@@ -775,7 +1057,9 @@ public:
 	virtual agpu_error readTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer buffer) = 0;
 	virtual agpu_error readTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_region3d* sourceRegion, agpu_size3d* destSize, agpu_pointer buffer) = 0;
 	virtual agpu_error uploadTextureData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) = 0;
+	virtual fence_ptr uploadTextureDataAsynchronously(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_pointer data) = 0;
 	virtual agpu_error uploadTextureSubData(agpu_int level, agpu_int arrayIndex, agpu_int pitch, agpu_int slicePitch, agpu_size3d* sourceSize, agpu_region3d* destRegion, agpu_pointer data) = 0;
+	virtual agpu_error uploadTextureSubresources(agpu_uint count, agpu_texture_subresource_data* subresources) = 0;
 	virtual agpu_error getFullViewDescription(agpu_texture_view_description* result) = 0;
 	virtual texture_view_ptr createView(agpu_texture_view_description* description) = 0;
 	virtual texture_view_ptr getOrCreateFullView() = 0;
@@ -807,8 +1091,9 @@ public:
 	virtual agpu_pointer mapBuffer(agpu_mapping_access flags) = 0;
 	virtual agpu_error unmapBuffer() = 0;
 	virtual agpu_error getDescription(agpu_buffer_description* description) = 0;
-	virtual agpu_error uploadBufferData(agpu_size offset, agpu_size size, agpu_pointer data) = 0;
-	virtual agpu_error readBufferData(agpu_size offset, agpu_size size, agpu_pointer data) = 0;
+	virtual agpu_error uploadBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) = 0;
+	virtual fence_ptr uploadBufferDataAsynchronously(agpu_device_size offset, agpu_device_size size, agpu_pointer data) = 0;
+	virtual agpu_error readBufferData(agpu_device_size offset, agpu_device_size size, agpu_pointer data) = 0;
 	virtual agpu_error flushWholeBuffer() = 0;
 	virtual agpu_error invalidateWholeBuffer() = 0;
 };
@@ -820,7 +1105,7 @@ struct vertex_binding : base_interface
 public:
 	typedef vertex_binding main_interface;
 	virtual agpu_error bindVertexBuffers(agpu_uint count, buffer_ref* vertex_buffers) = 0;
-	virtual agpu_error bindVertexBuffersWithOffsets(agpu_uint count, buffer_ref* vertex_buffers, agpu_size* offsets) = 0;
+	virtual agpu_error bindVertexBuffersWithOffsets(agpu_uint count, buffer_ref* vertex_buffers, agpu_device_size* offsets) = 0;
 };
 
 
@@ -890,6 +1175,7 @@ struct shader_signature : base_interface
 public:
 	typedef shader_signature main_interface;
 	virtual shader_resource_binding_ptr createShaderResourceBinding(agpu_uint element) = 0;
+	virtual shader_resource_binding_ptr createTransientShaderResourceBinding(agpu_uint element) = 0;
 };
 
 
@@ -899,9 +1185,9 @@ struct shader_resource_binding : base_interface
 public:
 	typedef shader_resource_binding main_interface;
 	virtual agpu_error bindUniformBuffer(agpu_int location, const buffer_ref & uniform_buffer) = 0;
-	virtual agpu_error bindUniformBufferRange(agpu_int location, const buffer_ref & uniform_buffer, agpu_size offset, agpu_size size) = 0;
+	virtual agpu_error bindUniformBufferRange(agpu_int location, const buffer_ref & uniform_buffer, agpu_device_size offset, agpu_device_size size) = 0;
 	virtual agpu_error bindStorageBuffer(agpu_int location, const buffer_ref & storage_buffer) = 0;
-	virtual agpu_error bindStorageBufferRange(agpu_int location, const buffer_ref & storage_buffer, agpu_size offset, agpu_size size) = 0;
+	virtual agpu_error bindStorageBufferRange(agpu_int location, const buffer_ref & storage_buffer, agpu_device_size offset, agpu_device_size size) = 0;
 	virtual agpu_error bindSampledTextureView(agpu_int location, const texture_view_ref & view) = 0;
 	virtual agpu_error bindArrayOfSampledTextureView(agpu_int location, agpu_int first_index, agpu_uint count, texture_view_ref* views) = 0;
 	virtual agpu_error bindStorageImageView(agpu_int location, const texture_view_ref & view) = 0;
@@ -915,6 +1201,20 @@ struct fence : base_interface
 public:
 	typedef fence main_interface;
 	virtual agpu_error waitOnClient() = 0;
+	virtual agpu_bool isSignaled() = 0;
+	virtual agpu_error waitWithTimeout(agpu_ulong timeout_ns) = 0;
+};
+
+
+// Interface wrapper for agpu_query_pool.
+struct query_pool : base_interface
+{
+public:
+	typedef query_pool main_interface;
+	virtual agpu_error getDescription(agpu_query_pool_description* description) = 0;
+	virtual agpu_uint getResultValueCount() = 0;
+	virtual agpu_float getTimestampPeriod() = 0;
+	virtual agpu_error getResults(agpu_uint first_query, agpu_uint query_count, agpu_ulong* results, agpu_bitfield flags) = 0;
 };
 
 
@@ -935,6 +1235,17 @@ public:
 };
 
 
+// Interface wrapper for agpu_buffer_pool.
+struct buffer_pool : base_interface
+{
+public:
+	typedef buffer_pool main_interface;
+	virtual buffer_ptr allocateRange(agpu_device_size size, agpu_device_size* offset) = 0;
+	virtual agpu_error freeRange(const buffer_ref & buffer, agpu_device_size offset) = 0;
+	virtual agpu_device_size getAlignment() = 0;
+};
+
+
 // Interface wrapper for agpu_state_tracker_cache.
 struct state_tracker_cache : base_interface
 {
@@ -944,6 +1255,16 @@ public:
 	virtual state_tracker_ptr createStateTrackerWithCommandAllocator(agpu_command_list_type type, const command_queue_ref & command_queue, const command_allocator_ref & command_allocator) = 0;
 	virtual state_tracker_ptr createStateTrackerWithFrameBuffering(agpu_command_list_type type, const command_queue_ref & command_queue, agpu_uint framebuffering_count) = 0;
 	virtual immediate_renderer_ptr createImmediateRenderer() = 0;
+	virtual agpu_error registerManifestShader(const shader_ref & shader, agpu_pointer content, agpu_size content_size) = 0;
+	virtual agpu_error registerManifestShaderSignature(const shader_signature_ref & shader_signature, agpu_cstring key) = 0;
+	virtual agpu_error registerManifestVertexLayout(const vertex_layout_ref & vertex_layout, agpu_cstring key) = 0;
+	virtual agpu_error savePipelineManifest(agpu_cstring file_name) = 0;
+	virtual agpu_error loadPipelineManifest(agpu_cstring file_name, agpu_uint worker_count) = 0;
+	virtual agpu_error waitForPipelineManifestReplay() = 0;
+	virtual agpu_ulong getPipelineManifestHitCount() = 0;
+	virtual agpu_ulong getPipelineManifestMissCount() = 0;
+	virtual agpu_error setShaderCacheDirectory(agpu_cstring directory) = 0;
+	virtual agpu_error precompileImmediateRendererShaderVariants(agpu_uint variant_count, agpu_immediate_renderer_shader_variant* variants, agpu_uint worker_count) = 0;
 };
 
 
@@ -989,7 +1310,7 @@ public:
 	virtual agpu_error setScissor(agpu_int x, agpu_int y, agpu_int w, agpu_int h) = 0;
 	virtual agpu_error useVertexBinding(const vertex_binding_ref & vertex_binding) = 0;
 	virtual agpu_error useIndexBuffer(const buffer_ref & index_buffer) = 0;
-	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_size offset, agpu_size index_size) = 0;
+	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size) = 0;
 	virtual agpu_error useDrawIndirectBuffer(const buffer_ref & draw_buffer) = 0;
 	virtual agpu_error useComputeDispatchIndirectBuffer(const buffer_ref & buffer) = 0;
 	virtual agpu_error useShaderResources(const shader_resource_binding_ref & binding) = 0;
@@ -997,11 +1318,11 @@ public:
 	virtual agpu_error useComputeShaderResources(const shader_resource_binding_ref & binding) = 0;
 	virtual agpu_error useComputeShaderResourcesInSlot(const shader_resource_binding_ref & binding, agpu_uint slot) = 0;
 	virtual agpu_error drawArrays(agpu_uint vertex_count, agpu_uint instance_count, agpu_uint first_vertex, agpu_uint base_instance) = 0;
-	virtual agpu_error drawArraysIndirect(agpu_size offset, agpu_size drawcount) = 0;
+	virtual agpu_error drawArraysIndirect(agpu_device_size offset, agpu_size drawcount) = 0;
 	virtual agpu_error drawElements(agpu_uint index_count, agpu_uint instance_count, agpu_uint first_index, agpu_int base_vertex, agpu_uint base_instance) = 0;
-	virtual agpu_error drawElementsIndirect(agpu_size offset, agpu_size drawcount) = 0;
+	virtual agpu_error drawElementsIndirect(agpu_device_size offset, agpu_size drawcount) = 0;
 	virtual agpu_error dispatchCompute(agpu_uint group_count_x, agpu_uint group_count_y, agpu_uint group_count_z) = 0;
-	virtual agpu_error dispatchComputeIndirect(agpu_size offset) = 0;
+	virtual agpu_error dispatchComputeIndirect(agpu_device_size offset) = 0;
 	virtual agpu_error setStencilReference(agpu_uint reference) = 0;
 	virtual agpu_error executeBundle(const command_list_ref & bundle) = 0;
 	virtual agpu_error beginRenderPass(const renderpass_ref & renderpass, const framebuffer_ref & framebuffer, agpu_bool bundle_content) = 0;
@@ -1010,16 +1331,25 @@ public:
 	virtual agpu_error resolveTexture(const texture_ref & sourceTexture, agpu_uint sourceLevel, agpu_uint sourceLayer, const texture_ref & destTexture, agpu_uint destLevel, agpu_uint destLayer, agpu_uint levelCount, agpu_uint layerCount, agpu_texture_aspect aspect) = 0;
 	virtual agpu_error pushConstants(agpu_uint offset, agpu_uint size, agpu_pointer values) = 0;
 	virtual agpu_error memoryBarrier(agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses) = 0;
-	virtual agpu_error bufferMemoryBarrier(const buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_size offset, agpu_size size) = 0;
+	virtual agpu_error bufferMemoryBarrier(const buffer_ref & buffer, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_device_size offset, agpu_device_size size) = 0;
 	virtual agpu_error textureMemoryBarrier(const texture_ref & texture, agpu_pipeline_stage_flags source_stage, agpu_pipeline_stage_flags dest_stage, agpu_access_flags source_accesses, agpu_access_flags dest_accesses, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) = 0;
 	virtual agpu_error pushBufferTransitionBarrier(const buffer_ref & buffer, agpu_buffer_usage_mask old_usage, agpu_buffer_usage_mask new_usage) = 0;
 	virtual agpu_error pushTextureTransitionBarrier(const texture_ref & texture, agpu_texture_usage_mode_mask old_usage, agpu_texture_usage_mode_mask new_usage, agpu_texture_subresource_range* subresource_range) = 0;
 	virtual agpu_error popBufferTransitionBarrier() = 0;
 	virtual agpu_error popTextureTransitionBarrier() = 0;
-	virtual agpu_error copyBuffer(const buffer_ref & source_buffer, agpu_size source_offset, const buffer_ref & dest_buffer, agpu_size dest_offset, agpu_size copy_size) = 0;
+	virtual agpu_error copyBuffer(const buffer_ref & source_buffer, agpu_device_size source_offset, const buffer_ref & dest_buffer, agpu_device_size dest_offset, agpu_device_size copy_size) = 0;
 	virtual agpu_error copyBufferToTexture(const buffer_ref & buffer, const texture_ref & texture, agpu_buffer_image_copy_region* copy_region) = 0;
 	virtual agpu_error copyTextureToBuffer(const texture_ref & texture, const buffer_ref & buffer, agpu_buffer_image_copy_region* copy_region) = 0;
 	virtual agpu_error copyTexture(const texture_ref & source_texture, const texture_ref & dest_texture, agpu_image_copy_region* copy_region) = 0;
+	virtual agpu_error generateMipmaps(const texture_ref & texture) = 0;
+	virtual agpu_error setAsynchronousPipelineCompilation(agpu_bool enabled) = 0;
+	virtual agpu_error setFallbackGraphicsPipeline(const pipeline_state_ref & pipeline) = 0;
+	virtual agpu_ulong getDeferredDrawCount() = 0;
+	virtual agpu_ulong getSkippedDrawCount() = 0;
+	virtual agpu_error resetQueryPool(const query_pool_ref & query_pool, agpu_uint first_query, agpu_uint query_count) = 0;
+	virtual agpu_error writeTimestamp(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
+	virtual agpu_error beginQuery(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
+	virtual agpu_error endQuery(const query_pool_ref & query_pool, agpu_uint query_index) = 0;
 };
 
 
@@ -1088,7 +1418,7 @@ public:
 	virtual agpu_error beginMeshWithVertices(agpu_size vertexCount, agpu_size stride, agpu_size elementCount, agpu_pointer vertices) = 0;
 	virtual agpu_error beginMeshWithVertexBinding(const vertex_layout_ref & layout, const vertex_binding_ref & vertices) = 0;
 	virtual agpu_error useIndexBuffer(const buffer_ref & index_buffer) = 0;
-	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_size offset, agpu_size index_size) = 0;
+	virtual agpu_error useIndexBufferAt(const buffer_ref & index_buffer, agpu_device_size offset, agpu_size index_size) = 0;
 	virtual agpu_error setCurrentMeshColors(agpu_size stride, agpu_size elementCount, agpu_pointer colors) = 0;
 	virtual agpu_error setCurrentMeshNormals(agpu_size stride, agpu_size elementCount, agpu_pointer normals) = 0;
 	virtual agpu_error setCurrentMeshTexCoords(agpu_size stride, agpu_size elementCount, agpu_pointer texcoords) = 0;
@@ -0,0 +1,178 @@
+#include "SampleBase.hpp"
+#include "SampleVertex.hpp"
+#include <chrono>
+
+static SampleVertex vertices[] = {
+    SampleVertex::onlyColor(-1.0, -1.0, 0.0, 1.0, 0.0, 0.0, 1.0),
+    SampleVertex::onlyColor(0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0),
+    SampleVertex::onlyColor(1.0, -1.0, 0.0, 0.0, 0.0, 1.0, 1.0),
+};
+
+struct TransformationState
+{
+    glm::mat4 projectionMatrix;
+    glm::mat4 viewMatrix;
+    glm::mat4 modelMatrix;
+};
+
+/**
+ * I measure the cost of recording a command list with 100k draws into an
+ * offscreen framebuffer, and the cost of replaying it. The list is replayed
+ * twice, so the second replay shows the cost of submitting a closed list
+ * again. With the OpenGL backend this measures its command packet stream,
+ * and it can run on llvmpipe.
+ */
+class SampleDrawRecordingBenchmark: public ComputeSampleBase
+{
+public:
+    static const agpu_uint DrawCount = 100000;
+    static const agpu_uint FramebufferSize = 256;
+    static const int IterationCount = 5;
+    static const agpu_texture_format OffscreenColorFormat = AGPU_TEXTURE_FORMAT_B8G8R8A8_UNORM;
+
+    int run(int argc, const char **argv)
+    {
+        if(!createRenderingObjects())
+            return 1;
+
+        auto commandAllocator = device->createCommandAllocator(AGPU_COMMAND_LIST_TYPE_DIRECT, commandQueue);
+        auto commandList = device->createCommandList(AGPU_COMMAND_LIST_TYPE_DIRECT, commandAllocator, nullptr);
+        commandList->close();
+
+        printMessage("%d draws per command list\n", DrawCount);
+        printMessage("%-10s %16s %16s %16s\n", "Iteration", "Record (ns)", "Replay (ns)", "Resubmit (ns)");
+        for(int i = 0; i < IterationCount; ++i)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+            commandAllocator->reset();
+            commandList->reset(commandAllocator, nullptr);
+            recordDraws(commandList);
+            auto recordedTime = std::chrono::steady_clock::now();
+
+            commandQueue->addCommandList(commandList);
+            commandQueue->finishExecution();
+            auto replayedTime = std::chrono::steady_clock::now();
+
+            commandQueue->addCommandList(commandList);
+            commandQueue->finishExecution();
+            auto resubmittedTime = std::chrono::steady_clock::now();
+
+            printMessage("%-10d %16.2f %16.2f %16.2f\n", i,
+                nanosecondsPerDraw(startTime, recordedTime),
+                nanosecondsPerDraw(recordedTime, replayedTime),
+                nanosecondsPerDraw(replayedTime, resubmittedTime));
+        }
+
+        return 0;
+    }
+
+    void recordDraws(const agpu_command_list_ref &commandList)
+    {
+        commandList->setShaderSignature(shaderSignature);
+        commandList->beginRenderPass(renderPass, framebuffer, false);
+        commandList->setViewport(0, 0, FramebufferSize, FramebufferSize);
+        commandList->setScissor(0, 0, FramebufferSize, FramebufferSize);
+
+        commandList->usePipelineState(pipeline);
+        commandList->useVertexBinding(vertexBinding);
+        commandList->useShaderResources(shaderBindings);
+        for(agpu_uint i = 0; i < DrawCount; ++i)
+            commandList->drawArrays(3, 1, 0, 0);
+
+        commandList->endRenderPass();
+        commandList->close();
+    }
+
+    bool createRenderingObjects()
+    {
+        auto shaderSignatureBuilder = device->createShaderSignatureBuilder();
+        shaderSignatureBuilder->beginBindingBank(1);
+        shaderSignatureBuilder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_UNIFORM_BUFFER, 1);
+        shaderSignature = shaderSignatureBuilder->build();
+        if(!shaderSignature)
+            return false;
+
+        auto vertexShader = compileShaderFromFile("data/shaders/simpleVertex.glsl", AGPU_VERTEX_SHADER);
+        auto fragmentShader = compileShaderFromFile("data/shaders/simpleFragment.glsl", AGPU_FRAGMENT_SHADER);
+        if(!vertexShader || !fragmentShader)
+            return false;
+
+        auto pipelineBuilder = device->createPipelineBuilder();
+        pipelineBuilder->setRenderTargetFormat(0, OffscreenColorFormat);
+        pipelineBuilder->setDepthStencilFormat(AGPU_TEXTURE_FORMAT_UNKNOWN);
+        pipelineBuilder->setShaderSignature(shaderSignature);
+        pipelineBuilder->attachShader(vertexShader);
+        pipelineBuilder->attachShader(fragmentShader);
+        pipelineBuilder->setVertexLayout(getSampleVertexLayout());
+        pipelineBuilder->setPrimitiveType(AGPU_TRIANGLES);
+        pipeline = buildPipeline(pipelineBuilder);
+        if(!pipeline)
+            return false;
+
+        // Create the offscreen framebuffer.
+        agpu_texture_description colorDescription = {};
+        colorDescription.type = AGPU_TEXTURE_2D;
+        colorDescription.width = FramebufferSize;
+        colorDescription.height = FramebufferSize;
+        colorDescription.depth = 1;
+        colorDescription.layers = 1;
+        colorDescription.miplevels = 1;
+        colorDescription.format = OffscreenColorFormat;
+        colorDescription.usage_modes = AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT;
+        colorDescription.main_usage_mode = AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT;
+        colorDescription.heap_type = AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL;
+        colorDescription.sample_count = 1;
+        colorTexture = device->createTexture(&colorDescription);
+        if(!colorTexture)
+            return false;
+
+        auto colorView = colorTexture->getOrCreateFullView();
+        framebuffer = device->createFrameBuffer(FramebufferSize, FramebufferSize, 1, &colorView, nullptr);
+        if(!framebuffer)
+            return false;
+
+        agpu_renderpass_color_attachment_description colorAttachment = {};
+        colorAttachment.format = OffscreenColorFormat;
+        colorAttachment.begin_action = AGPU_ATTACHMENT_CLEAR;
+        colorAttachment.end_action = AGPU_ATTACHMENT_KEEP;
+        colorAttachment.sample_count = 1;
+
+        agpu_renderpass_description renderPassDescription = {};
+        renderPassDescription.color_attachment_count = 1;
+        renderPassDescription.color_attachments = &colorAttachment;
+        renderPass = device->createRenderPass(&renderPassDescription);
+        if(!renderPass)
+            return false;
+
+        // Create the vertices and the transformation.
+        vertexBuffer = createImmutableVertexBuffer(3, sizeof(vertices[0]), vertices);
+        vertexBinding = device->createVertexBinding(getSampleVertexLayout());
+        vertexBinding->bindVertexBuffers(1, &vertexBuffer);
+
+        TransformationState transformationState;
+        transformationState.projectionMatrix = glm::mat4(1.0f);
+        transformationState.viewMatrix = glm::mat4(1.0f);
+        transformationState.modelMatrix = glm::mat4(1.0f);
+        transformationBuffer = createUploadableUniformBuffer(sizeof(TransformationState), &transformationState);
+        shaderBindings = shaderSignature->createShaderResourceBinding(0);
+        shaderBindings->bindUniformBuffer(0, transformationBuffer);
+        return true;
+    }
+
+    static double nanosecondsPerDraw(std::chrono::steady_clock::time_point startTime, std::chrono::steady_clock::time_point endTime)
+    {
+        return std::chrono::duration<double, std::nano> (endTime - startTime).count() / DrawCount;
+    }
+
+    agpu_shader_signature_ref shaderSignature;
+    agpu_pipeline_state_ref pipeline;
+    agpu_texture_ref colorTexture;
+    agpu_framebuffer_ref framebuffer;
+    agpu_renderpass_ref renderPass;
+    agpu_buffer_ref vertexBuffer;
+    agpu_vertex_binding_ref vertexBinding;
+    agpu_buffer_ref transformationBuffer;
+    agpu_shader_resource_binding_ref shaderBindings;
+};
+
+SAMPLE_MAIN(SampleDrawRecordingBenchmark)
@@ -0,0 +1,114 @@
+#include <AGPU/agpu_impl.hpp>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+/**
+ * I compare the ways of allocating the reference counted objects of the
+ * implementations, by creating and destroying one million objects with each
+ * one of them. I do not need a device.
+ */
+
+namespace agpu
+{
+// The objects of this benchmark are never given to the C interface.
+agpu_icd_dispatch cppRefcountedDispatchTable;
+} // End of namespace agpu
+
+class BenchmarkInterface : public agpu::base_interface
+{
+public:
+    typedef BenchmarkInterface main_interface;
+};
+
+typedef agpu::ref<BenchmarkInterface> BenchmarkRef;
+
+/**
+ * I am similar to a small implementation object, such as a texture view,
+ * which keeps a reference to its parent.
+ */
+class BenchmarkObject : public BenchmarkInterface
+{
+public:
+    BenchmarkObject(const BenchmarkRef &parent, int value)
+        : parent(parent), value(value) {}
+
+    BenchmarkRef parent;
+    int value;
+    int payload[8];
+};
+
+// The previous path, with two allocations and the arguments taken by value.
+template<typename I, typename T, typename...Args>
+inline agpu::ref<I> makeSeparatelyAllocatedObject(Args... args)
+{
+    std::unique_ptr<T> object(new T(args...));
+    std::unique_ptr<agpu::ref_counter<I>> counter(new agpu::ref_counter<I> (object.release()));
+    return agpu::ref<I> (counter.release());
+}
+
+static const size_t ObjectCount = 1000000;
+static const size_t BulkBatchSize = 1000;
+
+typedef BenchmarkRef (*MakeFunction)(const BenchmarkRef &parent, int value);
+
+static BenchmarkRef makeSeparately(const BenchmarkRef &parent, int value)
+{
+    return makeSeparatelyAllocatedObject<BenchmarkInterface, BenchmarkObject> (parent, value);
+}
+
+static BenchmarkRef makeCoAllocated(const BenchmarkRef &parent, int value)
+{
+    return agpu::makeObject<BenchmarkObject> (parent, value);
+}
+
+static BenchmarkRef makePooled(const BenchmarkRef &parent, int value)
+{
+    return agpu::makePooledObject<BenchmarkObject> (parent, value);
+}
+
+static double measure(MakeFunction makeFunction, const BenchmarkRef &parent, size_t batchSize)
+{
+    std::vector<BenchmarkRef> objects;
+    objects.reserve(batchSize);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < ObjectCount; i += batchSize)
+    {
+        for(size_t j = 0; j < batchSize; ++j)
+            objects.push_back(makeFunction(parent, int(i + j)));
+        objects.clear();
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano> (endTime - startTime).count() / ObjectCount;
+}
+
+int main(int argc, char *argv[])
+{
+    auto parent = makeCoAllocated(BenchmarkRef(), 0);
+
+    struct
+    {
+        const char *name;
+        MakeFunction makeFunction;
+    } paths[] = {
+        {"separate allocations", &makeSeparately},
+        {"makeObject", &makeCoAllocated},
+        {"makePooledObject", &makePooled},
+    };
+
+    // Warm up the allocators and the pools.
+    for(auto &path : paths)
+        measure(path.makeFunction, parent, BulkBatchSize);
+
+    printf("%-24s %16s %16s\n", "Path", "One by one (ns)", "Batches (ns)");
+    for(auto &path : paths)
+    {
+        auto oneByOne = measure(path.makeFunction, parent, 1);
+        auto batches = measure(path.makeFunction, parent, BulkBatchSize);
+        printf("%-24s %16.2f %16.2f\n", path.name, oneByOne, batches);
+    }
+
+    return 0;
+}
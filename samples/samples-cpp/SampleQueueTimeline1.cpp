@@ -0,0 +1,182 @@
+#include "SampleBase.hpp"
+
+/**
+ * I run a compute dispatch on the compute queue, and make the graphics queue
+ * wait for it on the GPU through the queue timelines. The graphics queue
+ * measures its own work with timestamp queries.
+ */
+class SampleQueueTimeline1: public ComputeSampleBase
+{
+public:
+    int run(int argc, const char **argv)
+    {
+        if(!device->isFeatureSupported(AGPU_FEATURE_COMMAND_QUEUE_TIMELINE))
+        {
+            printMessage("Command queue timelines are not supported by this device.\n");
+            return 0;
+        }
+
+        // The compute queue may be the same as the graphics queue, when the
+        // device does not have a dedicated one.
+        auto computeQueue = device->getCommandQueue(AGPU_COMMAND_QUEUE_TYPE_COMPUTE, 0);
+        if(!computeQueue)
+        {
+            printError("Failed to get a compute queue.\n");
+            return 1;
+        }
+
+        // Create the compute pipeline.
+        auto computeShader = compileShaderFromFile("data/shaders/computeAdd.glsl", AGPU_COMPUTE_SHADER);
+        if(!computeShader)
+            return 1;
+
+        auto shaderSignatureBuilder = device->createShaderSignatureBuilder();
+        shaderSignatureBuilder->beginBindingBank(1);
+        shaderSignatureBuilder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_STORAGE_BUFFER, 1);
+        shaderSignatureBuilder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_STORAGE_BUFFER, 1);
+        shaderSignatureBuilder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_STORAGE_BUFFER, 1);
+        auto shaderSignature = shaderSignatureBuilder->build();
+        if(!shaderSignature)
+            return 1;
+
+        auto pipelineBuilder = device->createComputePipelineBuilder();
+        pipelineBuilder->setShaderSignature(shaderSignature);
+        pipelineBuilder->attachShader(computeShader);
+        auto pipeline = buildComputePipeline(pipelineBuilder);
+        if(!pipeline)
+            return 1;
+
+        // Create the buffers. The compute queue is the only one that uses them.
+        agpu_size arraySize = 256;
+        agpu_size arrayByteSize = arraySize*sizeof(float);
+        agpu_size bufferByteSize = arrayByteSize*3;
+        auto uploadBuffer = createMappableUploadBuffer(bufferByteSize, nullptr);
+        auto readbackBuffer = createMappableReadbackBuffer(bufferByteSize, nullptr);
+        auto storageBuffer = createStorageBuffer(bufferByteSize, sizeof(float), nullptr);
+
+        auto shaderBindings = shaderSignature->createShaderResourceBinding(0);
+        shaderBindings->bindStorageBufferRange(0, storageBuffer, 0, arrayByteSize);
+        shaderBindings->bindStorageBufferRange(1, storageBuffer, arrayByteSize, arrayByteSize);
+        shaderBindings->bindStorageBufferRange(2, storageBuffer, arrayByteSize*2, arrayByteSize);
+
+        auto inputs = (float*)uploadBuffer->mapBuffer(AGPU_WRITE_ONLY);
+        for(agpu_size i = 0; i < arraySize; ++i)
+        {
+            inputs[i] = 1.0f + float(i);
+            inputs[arraySize + i] = 1.0f + float(i)*2;
+        }
+        uploadBuffer->unmapBuffer();
+
+        // Record the compute work.
+        auto computeAllocator = device->createCommandAllocator(AGPU_COMMAND_LIST_TYPE_COMPUTE, computeQueue);
+        auto computeList = device->createCommandList(AGPU_COMMAND_LIST_TYPE_COMPUTE, computeAllocator, pipeline);
+        computeList->pushBufferTransitionBarrier(storageBuffer, AGPU_STORAGE_BUFFER, AGPU_COPY_DESTINATION_BUFFER);
+        computeList->copyBuffer(uploadBuffer, 0, storageBuffer, 0, bufferByteSize);
+        computeList->popBufferTransitionBarrier();
+
+        computeList->setShaderSignature(shaderSignature);
+        computeList->useComputeShaderResources(shaderBindings);
+        computeList->dispatchCompute(arraySize, 1, 1);
+
+        computeList->pushBufferTransitionBarrier(storageBuffer, AGPU_STORAGE_BUFFER, AGPU_COPY_SOURCE_BUFFER);
+        computeList->copyBuffer(storageBuffer, 0, readbackBuffer, 0, bufferByteSize);
+        computeList->popBufferTransitionBarrier();
+        computeList->close();
+
+        // Record the graphics work, which is bracketed with timestamps.
+        auto hasTimestamps = device->isFeatureSupported(AGPU_FEATURE_TIMESTAMP_QUERY);
+        agpu_query_pool_ref queryPool;
+        if(hasTimestamps)
+        {
+            agpu_query_pool_description queryPoolDescription = {};
+            queryPoolDescription.type = AGPU_QUERY_TYPE_TIMESTAMP;
+            queryPoolDescription.query_count = 2;
+            queryPool = device->createQueryPool(&queryPoolDescription);
+            if(!queryPool)
+            {
+                printError("Failed to create the timestamp query pool.\n");
+                return 1;
+            }
+        }
+
+        auto graphicsSourceBuffer = createMappableUploadBuffer(bufferByteSize, nullptr);
+        auto graphicsDestinationBuffer = createMappableReadbackBuffer(bufferByteSize, nullptr);
+
+        auto graphicsAllocator = device->createCommandAllocator(AGPU_COMMAND_LIST_TYPE_DIRECT, commandQueue);
+        auto graphicsList = device->createCommandList(AGPU_COMMAND_LIST_TYPE_DIRECT, graphicsAllocator, agpu_pipeline_state_ref());
+        if(queryPool)
+        {
+            graphicsList->resetQueryPool(queryPool, 0, 2);
+            graphicsList->writeTimestamp(queryPool, 0);
+        }
+        graphicsList->copyBuffer(graphicsSourceBuffer, 0, graphicsDestinationBuffer, 0, bufferByteSize);
+        if(queryPool)
+            graphicsList->writeTimestamp(queryPool, 1);
+        graphicsList->close();
+
+        // Join the two queues on the GPU. Each queue has its own timeline, and
+        // the values are distinct in case both queues are the same one.
+        const agpu_ulong computeDoneValue = 1;
+        const agpu_ulong graphicsDoneValue = 2;
+        computeQueue->addCommandList(computeList);
+        computeQueue->signalTimelineValue(computeDoneValue);
+
+        commandQueue->waitTimelineValue(computeQueue, computeDoneValue);
+        commandQueue->addCommandList(graphicsList);
+        commandQueue->signalTimelineValue(graphicsDoneValue);
+
+        // This is the only client wait.
+        commandQueue->waitTimelineValueOnClient(graphicsDoneValue, 10000000000ull);
+
+        int exitCode = 0;
+        if(computeQueue->getCompletedTimelineValue() < computeDoneValue)
+        {
+            printError("The graphics queue has finished before the compute queue.\n");
+            exitCode = 1;
+        }
+
+        // Check the results of the compute queue.
+        auto mappedPointer = (float*)readbackBuffer->mapBuffer(AGPU_READ_ONLY);
+        auto leftInput = mappedPointer;
+        auto rightInput = mappedPointer + arraySize;
+        auto output = mappedPointer + arraySize*2;
+        for(agpu_size i = 0; i < arraySize; ++i)
+        {
+            auto expected = leftInput[i] + rightInput[i];
+            if(output[i] != expected || expected == 0)
+            {
+                printError("%d: %f + %f = %f\n", (int)i, leftInput[i], rightInput[i], output[i]);
+                exitCode = 1;
+            }
+        }
+        readbackBuffer->unmapBuffer();
+
+        // Read back the timestamps.
+        if(queryPool)
+        {
+            agpu_ulong timestamps[2] = {};
+            queryPool->getResults(0, 2, timestamps, AGPU_QUERY_RESULT_WAIT);
+            if(timestamps[1] < timestamps[0])
+            {
+                printError("The timestamps are not ordered: %llu %llu\n", (unsigned long long)timestamps[0], (unsigned long long)timestamps[1]);
+                exitCode = 1;
+            }
+            else
+            {
+                auto elapsed = double(timestamps[1] - timestamps[0])*queryPool->getTimestampPeriod();
+                printMessage("Graphics queue work: %.3f us\n", elapsed/1000.0);
+            }
+        }
+        else
+        {
+            printMessage("Timestamp queries are not supported by this device.\n");
+        }
+
+        if(exitCode == 0)
+            printMessage("Success\n");
+
+        return exitCode;
+    }
+};
+
+SAMPLE_MAIN(SampleQueueTimeline1)
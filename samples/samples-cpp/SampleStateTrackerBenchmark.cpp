@@ -0,0 +1,166 @@
+#include "SampleBase.hpp"
+#include "SampleVertex.hpp"
+#include <chrono>
+
+static SampleVertex vertices[] = {
+    SampleVertex::onlyColor(-1.0, -1.0, 0.0, 1.0, 0.0, 0.0, 1.0),
+    SampleVertex::onlyColor(0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0),
+    SampleVertex::onlyColor(1.0, -1.0, 0.0, 0.0, 0.0, 1.0, 1.0),
+};
+
+struct TransformationState
+{
+    glm::mat4 projectionMatrix;
+    glm::mat4 viewMatrix;
+    glm::mat4 modelMatrix;
+};
+
+/**
+ * I measure the cost per draw of looking up the graphics pipelines of a state
+ * tracker. Every draw of the measured loop changes the cull mode, so the state
+ * tracker has to find the pipeline of the new description in its cache. A
+ * loop whose draws do not change any state is the baseline. The difference
+ * between both loops is the cost of the lookup, plus binding the pipeline.
+ */
+class SampleStateTrackerBenchmark: public ComputeSampleBase
+{
+public:
+    static const agpu_uint DrawCount = 100000;
+    static const agpu_uint FramebufferSize = 256;
+    static const int IterationCount = 5;
+    static const agpu_texture_format OffscreenColorFormat = AGPU_TEXTURE_FORMAT_B8G8R8A8_UNORM;
+
+    int run(int argc, const char **argv)
+    {
+        if(!createRenderingObjects())
+            return 1;
+
+        stateTrackerCache = device->createStateTrackerCache(commandQueue);
+        stateTracker = stateTrackerCache->createStateTracker(AGPU_COMMAND_LIST_TYPE_DIRECT, commandQueue);
+
+        // Build the pipelines of both cull modes before measuring.
+        recordDraws(true);
+
+        printMessage("%d draws per iteration\n", DrawCount);
+        printMessage("%-10s %16s %16s %16s\n", "Iteration", "Baseline (ns)", "Changing (ns)", "Difference (ns)");
+        for(int i = 0; i < IterationCount; ++i)
+        {
+            auto baseline = recordDraws(false);
+            auto changing = recordDraws(true);
+            printMessage("%-10d %16.2f %16.2f %16.2f\n", i, baseline, changing, changing - baseline);
+        }
+
+        return 0;
+    }
+
+    double recordDraws(bool changeStateOnEachDraw)
+    {
+        stateTracker->beginRecordingCommands();
+        stateTracker->beginRenderPass(renderPass, framebuffer, false);
+        stateTracker->setViewport(0, 0, FramebufferSize, FramebufferSize);
+        stateTracker->setScissor(0, 0, FramebufferSize, FramebufferSize);
+
+        stateTracker->setShaderSignature(shaderSignature);
+        stateTracker->setVertexStage(vertexShader, "main");
+        stateTracker->setFragmentStage(fragmentShader, "main");
+        stateTracker->setPrimitiveType(AGPU_TRIANGLES);
+        stateTracker->setVertexLayout(getSampleVertexLayout());
+        stateTracker->setCullMode(AGPU_CULL_MODE_NONE);
+        stateTracker->useVertexBinding(vertexBinding);
+        stateTracker->useShaderResources(shaderBindings);
+
+        auto startTime = std::chrono::steady_clock::now();
+        for(agpu_uint i = 0; i < DrawCount; ++i)
+        {
+            if(changeStateOnEachDraw)
+                stateTracker->setCullMode((i & 1) ? AGPU_CULL_MODE_BACK : AGPU_CULL_MODE_NONE);
+            stateTracker->drawArrays(3, 1, 0, 0);
+        }
+        auto endTime = std::chrono::steady_clock::now();
+
+        stateTracker->endRenderPass();
+        stateTracker->endRecordingAndFlushCommands();
+        commandQueue->finishExecution();
+
+        return std::chrono::duration<double, std::nano> (endTime - startTime).count() / DrawCount;
+    }
+
+    bool createRenderingObjects()
+    {
+        auto shaderSignatureBuilder = device->createShaderSignatureBuilder();
+        shaderSignatureBuilder->beginBindingBank(1);
+        shaderSignatureBuilder->addBindingBankElement(AGPU_SHADER_BINDING_TYPE_UNIFORM_BUFFER, 1);
+        shaderSignature = shaderSignatureBuilder->build();
+        if(!shaderSignature)
+            return false;
+
+        vertexShader = compileShaderFromFile("data/shaders/simpleVertex.glsl", AGPU_VERTEX_SHADER);
+        fragmentShader = compileShaderFromFile("data/shaders/simpleFragment.glsl", AGPU_FRAGMENT_SHADER);
+        if(!vertexShader || !fragmentShader)
+            return false;
+
+        // Create the offscreen framebuffer.
+        agpu_texture_description colorDescription = {};
+        colorDescription.type = AGPU_TEXTURE_2D;
+        colorDescription.width = FramebufferSize;
+        colorDescription.height = FramebufferSize;
+        colorDescription.depth = 1;
+        colorDescription.layers = 1;
+        colorDescription.miplevels = 1;
+        colorDescription.format = OffscreenColorFormat;
+        colorDescription.usage_modes = AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT;
+        colorDescription.main_usage_mode = AGPU_TEXTURE_USAGE_COLOR_ATTACHMENT;
+        colorDescription.heap_type = AGPU_MEMORY_HEAP_TYPE_DEVICE_LOCAL;
+        colorDescription.sample_count = 1;
+        colorTexture = device->createTexture(&colorDescription);
+        if(!colorTexture)
+            return false;
+
+        auto colorView = colorTexture->getOrCreateFullView();
+        framebuffer = device->createFrameBuffer(FramebufferSize, FramebufferSize, 1, &colorView, nullptr);
+        if(!framebuffer)
+            return false;
+
+        agpu_renderpass_color_attachment_description colorAttachment = {};
+        colorAttachment.format = OffscreenColorFormat;
+        colorAttachment.begin_action = AGPU_ATTACHMENT_CLEAR;
+        colorAttachment.end_action = AGPU_ATTACHMENT_KEEP;
+        colorAttachment.sample_count = 1;
+
+        agpu_renderpass_description renderPassDescription = {};
+        renderPassDescription.color_attachment_count = 1;
+        renderPassDescription.color_attachments = &colorAttachment;
+        renderPass = device->createRenderPass(&renderPassDescription);
+        if(!renderPass)
+            return false;
+
+        // Create the vertices and the transformation.
+        vertexBuffer = createImmutableVertexBuffer(3, sizeof(vertices[0]), vertices);
+        vertexBinding = device->createVertexBinding(getSampleVertexLayout());
+        vertexBinding->bindVertexBuffers(1, &vertexBuffer);
+
+        TransformationState transformationState;
+        transformationState.projectionMatrix = glm::mat4(1.0f);
+        transformationState.viewMatrix = glm::mat4(1.0f);
+        transformationState.modelMatrix = glm::mat4(1.0f);
+        transformationBuffer = createUploadableUniformBuffer(sizeof(TransformationState), &transformationState);
+        shaderBindings = shaderSignature->createShaderResourceBinding(0);
+        shaderBindings->bindUniformBuffer(0, transformationBuffer);
+        return true;
+    }
+
+    agpu_state_tracker_cache_ref stateTrackerCache;
+    agpu_state_tracker_ref stateTracker;
+    agpu_shader_signature_ref shaderSignature;
+    agpu_shader_ref vertexShader;
+    agpu_shader_ref fragmentShader;
+    agpu_texture_ref colorTexture;
+    agpu_framebuffer_ref framebuffer;
+    agpu_renderpass_ref renderPass;
+    agpu_buffer_ref vertexBuffer;
+    agpu_vertex_binding_ref vertexBinding;
+    agpu_buffer_ref transformationBuffer;
+    agpu_shader_resource_binding_ref shaderBindings;
+};
+
+SAMPLE_MAIN(SampleStateTrackerBenchmark)